@@ -0,0 +1,391 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BATCH_DRIVER_HPP
+#define GUARD_MIOPEN_BATCH_DRIVER_HPP
+
+#include "driver.hpp"
+
+#include <miopen/stringutils.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// Runs the layer set up by argv (argv[1] is the base argument) on the driver.
+/// When deferred is not null and the verification of the driver only touches host memory, the
+/// verification is stored there instead of being run, so the caller can overlap it with the next
+/// layers. The driver has to outlive the deferred verification.
+inline int RunDriver(Driver& drv, int argc, char* argv[], std::function<int()>* deferred = nullptr)
+{
+    const std::string base_arg = argv[1];
+
+    drv.AddCmdLineArgs();
+    int rc = drv.ParseCmdLineArgs(argc, argv);
+    if(rc != 0)
+    {
+        std::cout << "ParseCmdLineArgs() FAILED, rc = " << rc << std::endl;
+        return rc;
+    }
+    drv.GetandSetData();
+    rc = drv.AllocateBuffersAndCopy();
+    if(rc != 0)
+    {
+        std::cout << "AllocateBuffersAndCopy() FAILED, rc = " << rc << std::endl;
+        return rc;
+    }
+
+    int fargval =
+        !miopen::StartsWith(base_arg, "CBAInfer") ? drv.GetInputFlags().GetValueInt("forw") : 1;
+    bool bnFwdInVer   = (fargval == 2 && miopen::StartsWith(base_arg, "bnorm"));
+    bool verifyarg    = (drv.GetInputFlags().GetValueInt("verify") == 1);
+    bool defer        = (deferred != nullptr && drv.IsVerificationHostOnly());
+    bool verify_fwd   = false;
+    bool verify_bwd   = false;
+    int cumulative_rc = 0; // Do not stop running tests in case of errors.
+
+    if(fargval & 1 || fargval == 0 || bnFwdInVer)
+    {
+        rc = drv.RunForwardGPU();
+        cumulative_rc |= rc;
+        if(rc != 0)
+            std::cout << "RunForwardGPU() FAILED, rc = "
+                      << "0x" << std::hex << rc << std::dec << std::endl;
+        if(verifyarg) // Verify even if Run() failed.
+        {
+            if(defer)
+                verify_fwd = true;
+            else
+                cumulative_rc |= drv.VerifyForward();
+        }
+    }
+
+    if(fargval != 1)
+    {
+        rc = drv.RunBackwardGPU();
+        cumulative_rc |= rc;
+        if(rc != 0)
+            std::cout << "RunBackwardGPU() FAILED, rc = "
+                      << "0x" << std::hex << rc << std::dec << std::endl;
+        if(verifyarg) // Verify even if Run() failed.
+        {
+            if(defer)
+                verify_bwd = true;
+            else
+                cumulative_rc |= drv.VerifyBackward();
+        }
+    }
+
+    if(verify_fwd || verify_bwd)
+    {
+        *deferred = [&drv, verify_fwd, verify_bwd]() {
+            int verify_rc = 0;
+            if(verify_fwd)
+                verify_rc |= drv.VerifyForward();
+            if(verify_bwd)
+                verify_rc |= drv.VerifyBackward();
+            return verify_rc;
+        };
+    }
+
+    return cumulative_rc;
+}
+
+struct BatchTimingStats
+{
+    double mean   = 0;
+    double median = 0;
+    double p95    = 0;
+};
+
+/// The first iteration is left out as a warm-up when there are more, like the driver does for
+/// its average time.
+inline BatchTimingStats GetBatchTimingStats(std::vector<float> times)
+{
+    BatchTimingStats stats;
+    if(times.size() > 1)
+        times.erase(times.begin());
+    if(times.empty())
+        return stats;
+
+    std::sort(times.begin(), times.end());
+    stats.mean   = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    stats.median = times.size() % 2 != 0
+                       ? times[times.size() / 2]
+                       : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2.0;
+    const auto p95_rank = static_cast<std::size_t>(std::ceil(0.95 * times.size()));
+    stats.p95           = times[std::max<std::size_t>(p95_rank, 1) - 1];
+    return stats;
+}
+
+inline double GetBatchGflops(double flop_count, double time_ms)
+{
+    return time_ms > 0 ? flop_count / time_ms / 1e6 : 0.0;
+}
+
+struct BatchLayer
+{
+    std::string command;
+    int rc = 0;
+    std::vector<DriverTiming> timings;
+};
+
+inline void PrintBatchSummary(const std::vector<BatchLayer>& layers)
+{
+    struct Aggregate
+    {
+        std::size_t count = 0;
+        BatchTimingStats total;
+        double flop_count = 0;
+    };
+    std::map<std::string, Aggregate> aggregates;
+
+    printf("\nBatch summary per layer (ms, the first iteration is a warm-up):\n");
+    printf("%6s %4s %12s %12s %12s %10s  %s\n",
+           "layer",
+           "dir",
+           "mean",
+           "median",
+           "p95",
+           "GFLOPs",
+           "solver");
+    for(std::size_t i = 0; i < layers.size(); ++i)
+    {
+        const auto& layer = layers[i];
+        if(layer.timings.empty())
+            printf("%6zu %4s %12s %12s %12s %10s  %s\n",
+                   i + 1,
+                   "-",
+                   "-",
+                   "-",
+                   "-",
+                   "-",
+                   layer.rc != 0 ? "FAILED" : "<no kernel timings>");
+
+        for(const auto& timing : layer.timings)
+        {
+            const auto stats = GetBatchTimingStats(timing.times);
+            printf("%6zu %4s %12.4f %12.4f %12.4f %10.1f  %s%s\n",
+                   i + 1,
+                   timing.direction.c_str(),
+                   stats.mean,
+                   stats.median,
+                   stats.p95,
+                   GetBatchGflops(timing.flop_count, stats.mean),
+                   timing.solver.c_str(),
+                   layer.rc != 0 ? " (FAILED)" : "");
+
+            for(auto* aggregate : {&aggregates[timing.direction], &aggregates["all"]})
+            {
+                aggregate->count++;
+                aggregate->total.mean += stats.mean;
+                aggregate->total.median += stats.median;
+                aggregate->total.p95 += stats.p95;
+                aggregate->flop_count += timing.flop_count;
+            }
+        }
+    }
+
+    printf("\nBatch summary per direction (sums over the layers, ms):\n");
+    printf("%4s %6s %12s %12s %12s %10s\n", "dir", "layers", "mean", "median", "p95", "GFLOPs");
+    for(const auto& direction : {"fwd", "bwd", "wrw", "all"})
+    {
+        const auto it = aggregates.find(direction);
+        if(it == aggregates.end())
+            continue;
+        const auto& aggregate = it->second;
+        printf("%4s %6zu %12.4f %12.4f %12.4f %10.1f\n",
+               direction,
+               aggregate.count,
+               aggregate.total.mean,
+               aggregate.total.median,
+               aggregate.total.p95,
+               GetBatchGflops(aggregate.flop_count, aggregate.total.mean));
+    }
+
+    const auto failed = std::count_if(
+        layers.begin(), layers.end(), [](const BatchLayer& layer) { return layer.rc != 0; });
+    printf("\n%zu layers, %ld FAILED\n", layers.size(), static_cast<long>(failed));
+    for(std::size_t i = 0; i < layers.size(); ++i)
+        if(layers[i].rc != 0)
+            printf("FAILED layer %zu: %s\n", i + 1, layers[i].command.c_str());
+}
+
+/// Batch mode: `--batch <file|-> [--jobs <n>]` runs every MIOpenDriver command line of the file
+/// (or of stdin for "-") in this process. All the drivers share one handle, so the kernels and
+/// the find results are built and loaded once per batch. Anything in front of the base argument
+/// of a line (e.g. "./bin/MIOpenDriver") is skipped, as are lines without a base argument and
+/// comments starting with '#'. With --jobs n, up to n - 1 host-only verifications run
+/// concurrently with the following layers; their messages are printed once they finish.
+inline int RunBatch(int argc, char* argv[], Driver* (*make_driver)(const std::string&))
+{
+    std::string path;
+    int jobs = 1;
+    for(int i = 2; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if((arg == "--jobs" || arg == "-j") && i + 1 < argc)
+            jobs = std::max(std::atoi(argv[++i]), 1);
+        else if(path.empty())
+            path = arg;
+        else
+        {
+            printf("FAILED: Unexpected batch argument %s\n", arg.c_str());
+            Usage();
+        }
+    }
+    if(path.empty())
+    {
+        printf("FAILED: No batch file\n");
+        Usage();
+    }
+
+    std::ifstream file;
+    if(path != "-")
+    {
+        file.open(path);
+        if(!file)
+        {
+            printf("FAILED: Cannot open the batch file %s\n", path.c_str());
+            return 1;
+        }
+    }
+    std::istream& input = path == "-" ? std::cin : file;
+
+    struct PendingVerification
+    {
+        std::unique_ptr<Driver> driver;
+        std::unique_ptr<std::ostringstream> log;
+        std::size_t layer;
+        std::future<int> rc;
+    };
+    std::deque<PendingVerification> pending;
+    std::vector<BatchLayer> layers;
+
+    // The messages of a deferred verification are printed by this thread only, in the order of
+    // the layers, so they never interleave with the output of the other layers.
+    const auto finish_oldest = [&]() {
+        auto& oldest = pending.front();
+        layers[oldest.layer].rc |= oldest.rc.get();
+        std::cout << "Verification of layer " << oldest.layer + 1 << ": "
+                  << layers[oldest.layer].command << std::endl
+                  << oldest.log->str() << std::flush;
+        pending.pop_front();
+    };
+    const auto finish_ready = [&]() {
+        const auto is_ready = [](const PendingVerification& verification) {
+            return verification.rc.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+        };
+        while(!pending.empty() && is_ready(pending.front()))
+            finish_oldest();
+    };
+
+    SharedDriverHandle() = CreateDriverHandle();
+
+    std::string line;
+    while(std::getline(input, line))
+    {
+        const auto first = line.find_first_not_of(" \t\r");
+        if(first == std::string::npos || line[first] == '#')
+            continue;
+
+        const auto words = miopen::SplitCommandLine(line);
+        const auto base  = std::find_if(words.begin(), words.end(), IsDriverBaseArg);
+        if(base == words.end())
+            continue;
+
+        // Kernel times are needed for the summary; "-t 0" in the line still turns them off.
+        auto args = std::vector<std::string>{argv[0], *base, "--time", "1"};
+        args.insert(args.end(), base + 1, words.end());
+        std::vector<char*> layer_argv;
+        for(auto& arg : args)
+            layer_argv.push_back(&arg[0]);
+        layer_argv.push_back(nullptr);
+
+        finish_ready();
+
+        BatchLayer layer;
+        layer.command = "MIOpenDriver";
+        for(auto it = base; it != words.end(); ++it)
+            layer.command += " " + *it;
+        std::cout << layer.command << std::endl;
+
+        std::unique_ptr<Driver> drv(make_driver(*base));
+        if(drv == nullptr)
+        {
+            printf("Incorrect BaseArg\n");
+            layer.rc = 1;
+            layers.push_back(layer);
+            continue;
+        }
+
+        std::function<int()> verification;
+        layer.rc = RunDriver(*drv,
+                             static_cast<int>(args.size()),
+                             layer_argv.data(),
+                             jobs > 1 ? &verification : nullptr);
+        layer.timings = drv->GetTimings();
+        layers.push_back(layer);
+
+        if(verification)
+        {
+            while(pending.size() >= static_cast<std::size_t>(jobs - 1))
+                finish_oldest();
+            auto log = std::make_unique<std::ostringstream>();
+            drv->SetVerificationLog(*log);
+            pending.push_back({std::move(drv),
+                               std::move(log),
+                               layers.size() - 1,
+                               std::async(std::launch::async, verification)});
+        }
+    }
+
+    while(!pending.empty())
+        finish_oldest();
+
+    miopenDestroy(SharedDriverHandle());
+    SharedDriverHandle() = nullptr;
+
+    PrintBatchSummary(layers);
+
+    const auto any_failed = std::any_of(
+        layers.begin(), layers.end(), [](const BatchLayer& layer) { return layer.rc != 0; });
+    return any_failed ? 1 : 0;
+}
+
+#endif // GUARD_MIOPEN_BATCH_DRIVER_HPP
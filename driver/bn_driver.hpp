@@ -59,8 +59,6 @@
 #endif
 #endif
 
-#define MIO_DRIVER_BN_REFERENCE_COMPUTE_3D_AS_2D 1 // Resolves issue #1974
-
 //#define BN_RUNFOR_PROFILER
 
 template <typename Tgpu, typename Tref, typename Tmix = Tgpu>
@@ -956,13 +954,8 @@ void BatchNormDriver<Tgpu, Tref, Tmix>::runCPUFwdTrain(
     { // 1xCxHxW
         miopenBNFwdTrainPerActivationRunHost<Tgpu, Tref>(/* alpha, beta, */ batch_sz,
                                                          channels,
-#if MIO_DRIVER_BN_REFERENCE_COMPUTE_3D_AS_2D
-                                                         1,
-                                                         height * (isDepthSpecified ? depth : 1),
-#else
                                                          (isDepthSpecified ? depth : 1),
                                                          height,
-#endif
                                                          width,
                                                          in.data(),
                                                          out_host.data(),
@@ -981,13 +974,8 @@ void BatchNormDriver<Tgpu, Tref, Tmix>::runCPUFwdTrain(
     { // 1xCx1x1
         miopenBNFwdTrainSpatialRunHost<Tgpu, Tref>(/* alpha, beta, */ batch_sz,
                                                    channels,
-#if MIO_DRIVER_BN_REFERENCE_COMPUTE_3D_AS_2D
-                                                   1,
-                                                   height * (isDepthSpecified ? depth : 1),
-#else
                                                    (isDepthSpecified ? depth : 1),
                                                    height,
-#endif
                                                    width,
                                                    in.data(),
                                                    out_host.data(),
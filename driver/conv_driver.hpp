@@ -47,6 +47,7 @@
 #include <float.h>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <miopen/miopen.h>
 #include <miopen/miopen_internal.h>
 #include <miopen/tensor.hpp>
@@ -139,39 +140,59 @@ private:
 };
 
 template <typename T>
-void dumpBufferToFile(const char* fileName, T* data, size_t dataNumItems)
+void dumpBufferToFile(const char* fileName, T* data, size_t dataNumItems, std::ostream& log)
 {
     std::ofstream outFile(fileName, std::ios::binary);
     if(outFile)
     {
         outFile.write(reinterpret_cast<char*>(data), dataNumItems * sizeof(T));
         outFile.close();
-        printf("Wrote output to file %s\n", fileName);
+        log << "Wrote output to file " << fileName << std::endl;
     }
     else
     {
-        printf("Could not open file %s for writing\n", fileName);
+        log << "Could not open file " << fileName << " for writing" << std::endl;
     }
 }
 
 template <typename T>
-bool readBufferFromFile(T* data, size_t dataNumItems, const char* fileName)
+void dumpBufferToFile(const char* fileName, T* data, size_t dataNumItems)
+{
+    dumpBufferToFile(fileName, data, dataNumItems, std::cout);
+}
+
+template <typename T>
+bool readBufferFromFile(T* data, size_t dataNumItems, const char* fileName, std::ostream& log)
 {
     std::ifstream infile(fileName, std::ios::binary);
     if(infile)
     {
         infile.read(reinterpret_cast<char*>(data), dataNumItems * sizeof(T));
         infile.close();
-        printf("Read data from input file %s\n", fileName);
+        log << "Read data from input file " << fileName << std::endl;
         return true;
     }
     else
     {
-        printf("Could not open file %s for reading\n", fileName);
+        log << "Could not open file " << fileName << " for reading" << std::endl;
         return false;
     }
 }
 
+template <typename T>
+bool readBufferFromFile(T* data, size_t dataNumItems, const char* fileName)
+{
+    return readBufferFromFile(data, dataNumItems, fileName, std::cout);
+}
+
+/// Guards the verification cache files: the deferred verifications of a batch run concurrently
+/// and two of them may share a file, e.g. when a layer is listed with different algorithms.
+inline std::mutex& GetVerificationCacheMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
 // Tgpu and Tref are the data-type in GPU memory and CPU memory respectively.
 // They are not necessarily the same as the computation type on GPU or CPU
 template <typename Tgpu, typename Tref>
@@ -234,7 +255,8 @@ public:
 
     int AllocateBuffersAndCopy() override;
 
-    bool UseGPUReference();
+    bool UseGPUReference() const;
+    bool IsVerificationHostOnly() const override { return !UseGPUReference(); }
 
     int FindForward(int& ret_algo_count,
                     int request_algo_count,
@@ -364,6 +386,7 @@ private:
     Timer2 bwd_auxiliary_gwss;
     Timer2 wrw_auxiliary_gwss;
     Timer2 warmup_wall_total; // Counts also auxiliary time.
+    std::vector<float> iteration_times; // Kernel times of the last timed loop.
 
     void PrintForwardTime(float kernel_total_time, float kernel_first_time) const;
     int RunForwardGpuImmed(bool is_transform);
@@ -417,6 +440,29 @@ private:
                   << ", name: " << miopen::solver::Id(s.solution_id).ToString() << std::endl;
     }
 
+    double GetFlopCount() const
+    {
+        const auto& in_lens    = miopen::deref(inputTensor).GetLengths();
+        const auto& wei_lens   = miopen::deref(weightTensor).GetLengths();
+        const auto& out_lens   = miopen::deref(outputTensor).GetLengths();
+        const auto group_count = std::max(inflags.GetValueInt("group_count"), 1);
+
+        double flops = 2.0 * in_lens[0] * in_lens[1] * out_lens[1] / group_count;
+        for(std::size_t i = 2; i < in_lens.size(); ++i)
+            flops *= static_cast<double>(wei_lens[i]) * out_lens[i];
+        return flops;
+    }
+
+    /// Keeps the kernel times of the last timed loop for the batch mode.
+    void RecordTiming(const char* direction, const miopenConvSolution_t& s)
+    {
+        timings.push_back({direction,
+                           (s.solution_id != 0) ? miopen::solver::Id(s.solution_id).ToString()
+                                                : std::string("UNKNOWN"),
+                           iteration_times,
+                           GetFlopCount()});
+    }
+
     std::string AlgorithmSolutionToString(const miopenConvSolution_t& s) const
     {
         std::ostringstream oss;
@@ -1491,7 +1537,7 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 }
 
 template <typename Tgpu, typename Tref>
-bool ConvDriver<Tgpu, Tref>::UseGPUReference()
+bool ConvDriver<Tgpu, Tref>::UseGPUReference() const
 {
     if(!miopen::IsDisabled(MIOPEN_DRIVER_USE_GPU_REFERENCE{}))
     {
@@ -1905,6 +1951,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuFind(const bool is_transform)
 
     float kernel_total_time = 0.0;
     float kernel_first_time = 0.0;
+    iteration_times.clear();
 
     const auto algo    = perf_results[0].fwd_algo; // use the fastest algo
     const auto ws_size = perf_results[0].memory;
@@ -1941,6 +1988,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuFind(const bool is_transform)
             float time = 0.0;
             miopenGetKernelTime(GetHandle(), &time);
             kernel_total_time += time;
+            iteration_times.push_back(time);
             if(i == 0)
                 kernel_first_time = time;
         }
@@ -1963,6 +2011,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuFind(const bool is_transform)
             perf_results[0], Direction::Fwd, in_tens, wei_tens, outputTensor, solution);
         std::cout << "MIOpen Forward Conv. " << AlgorithmSolutionToString(solution) << std::endl;
         PrintForwardTime(kernel_total_time, kernel_first_time);
+        RecordTiming("fwd", solution);
     }
 
     return rc;
@@ -2069,6 +2118,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuImmed(const bool is_transform)
 
     float kernel_total_time = 0.0;
     float kernel_first_time = 0.0;
+    iteration_times.clear();
 
     wall.start(wall_enabled);
 
@@ -2094,6 +2144,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuImmed(const bool is_transform)
             float time = 0.0;
             miopenGetKernelTime(GetHandle(), &time);
             kernel_total_time += time;
+            iteration_times.push_back(time);
             if(i == 0)
             {
                 kernel_first_time = time;
@@ -2118,6 +2169,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuImmed(const bool is_transform)
     {
         std::cout << "MIOpen Forward Conv. " << AlgorithmSolutionToString(*selected) << std::endl;
         PrintForwardTime(kernel_total_time, kernel_first_time);
+        RecordTiming("fwd", *selected);
     }
 
     is_fwd_igemm = (selected->algorithm == miopenConvolutionAlgoImplicitGEMM);
@@ -2166,7 +2218,10 @@ int ConvDriver<Tgpu, Tref>::RunForwardCPU()
 
     if(inflags.GetValueInt("dump_output"))
     {
-        dumpBufferToFile<Tref>("dump_fwd_out_cpu.bin", outhost.data.data(), outhost.data.size());
+        dumpBufferToFile<Tref>("dump_fwd_out_cpu.bin",
+                               outhost.data.data(),
+                               outhost.data.size(),
+                               *verification_log);
     }
 
     TrySaveVerificationCache(Direction::Fwd, outhost.data);
@@ -2369,6 +2424,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuFind()
 
     float kernel_total_time = 0.0;
     float kernel_first_time = 0.0;
+    iteration_times.clear();
     float alpha = static_cast<float>(1), beta = static_cast<float>(0);
 
     const auto algo    = perf_results_data[0].bwd_data_algo;
@@ -2402,6 +2458,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuFind()
             float time = 0.0;
             miopenGetKernelTime(GetHandle(), &time);
             kernel_total_time += time;
+            iteration_times.push_back(time);
             if(i == 0)
                 kernel_first_time = time;
         }
@@ -2429,6 +2486,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuFind()
         std::cout << "MIOpen Backward Data Conv. " << AlgorithmSolutionToString(solution)
                   << std::endl;
         PrintBackwardDataTime(kernel_total_time, kernel_first_time);
+        RecordTiming("bwd", solution);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
@@ -2575,6 +2633,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuFind()
 
     kernel_total_time = 0.0;
     kernel_first_time = 0.0;
+    iteration_times.clear();
 
     const auto algo    = perf_results_weights[0].bwd_weights_algo;
     const auto ws_size = perf_results_weights[0].memory;
@@ -2608,6 +2667,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuFind()
             float time = 0.0;
             miopenGetKernelTime(GetHandle(), &time);
             kernel_total_time += time;
+            iteration_times.push_back(time);
             if(i == 0)
                 kernel_first_time = time;
         }
@@ -2635,6 +2695,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuFind()
         std::cout << "MIOpen Backward Weights Conv. " << AlgorithmSolutionToString(solution)
                   << std::endl;
         PrintBackwardWrwTime(kernel_total_time, kernel_first_time);
+        RecordTiming("wrw", solution);
     }
 
     dwei_dev->FromGPU(GetStream(), dwei.data());
@@ -2822,6 +2883,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuImmed()
 
     float kernel_total_time = 0.0;
     float kernel_first_time = 0.0;
+    iteration_times.clear();
 
     wall.start(wall_enabled);
 
@@ -2846,6 +2908,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuImmed()
             float time = 0.0;
             miopenGetKernelTime(GetHandle(), &time);
             kernel_total_time += time;
+            iteration_times.push_back(time);
             if(i == 0)
             {
                 kernel_first_time = time;
@@ -2871,6 +2934,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuImmed()
         std::cout << "MIOpen Backward Data Conv. " << AlgorithmSolutionToString(*selected)
                   << std::endl;
         PrintBackwardDataTime(kernel_total_time, kernel_first_time);
+        RecordTiming("bwd", *selected);
     }
 
     is_bwd_igemm = (selected->algorithm == miopenConvolutionAlgoImplicitGEMM);
@@ -2955,6 +3019,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuImmed()
 
     float kernel_total_time = 0.0;
     float kernel_first_time = 0.0;
+    iteration_times.clear();
 
     wall.start(wall_enabled);
 
@@ -2979,6 +3044,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuImmed()
             float time = 0.0;
             miopenGetKernelTime(GetHandle(), &time);
             kernel_total_time += time;
+            iteration_times.push_back(time);
             if(i == 0)
             {
                 kernel_first_time = time;
@@ -3004,6 +3070,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuImmed()
         std::cout << "MIOpen Backward Weights Conv. " << AlgorithmSolutionToString(*selected)
                   << std::endl;
         PrintBackwardWrwTime(kernel_total_time, kernel_first_time);
+        RecordTiming("wrw", *selected);
     }
 
     is_wrw_winograd = (selected->algorithm == miopenConvolutionAlgoWinograd);
@@ -3040,8 +3107,10 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWeightsCPU()
 
     if(inflags.GetValueInt("dump_output"))
     {
-        dumpBufferToFile<Tref>(
-            "dump_bwd_dwei_cpu.bin", dwei_host.data.data(), dwei_host.data.size());
+        dumpBufferToFile<Tref>("dump_bwd_dwei_cpu.bin",
+                               dwei_host.data.data(),
+                               dwei_host.data.size(),
+                               *verification_log);
     }
 
     TrySaveVerificationCache(Direction::WrW, dwei_host.data);
@@ -3076,7 +3145,10 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataCPU()
 
     if(inflags.GetValueInt("dump_output"))
     {
-        dumpBufferToFile<Tref>("dump_bwd_din_cpu.bin", din_host.data.data(), din_host.data.size());
+        dumpBufferToFile<Tref>("dump_bwd_din_cpu.bin",
+                               din_host.data.data(),
+                               din_host.data.size(),
+                               *verification_log);
     }
 
     TrySaveVerificationCache(Direction::Bwd, din_host.data);
@@ -3090,7 +3162,8 @@ int ConvDriver<Tgpu, Tref>::RunBackwardBiasCPU()
 
     if(inflags.GetValueInt("dump_output"))
     {
-        dumpBufferToFile<Tref>("dump_bwd_db_cpu.bin", db_host.data.data(), db_host.data.size());
+        dumpBufferToFile<Tref>(
+            "dump_bwd_db_cpu.bin", db_host.data.data(), db_host.data.size(), *verification_log);
     }
 
     TrySaveVerificationCache(Direction::BwdBias, db_host.data);
@@ -3286,9 +3359,11 @@ bool ConvDriver<Tgpu, Tref>::TryReadVerificationCache(
         const auto file_path =
             verification_cache_path + "/" + GetVerificationCacheFileName(direction);
 
+        std::lock_guard<std::mutex> lock(GetVerificationCacheMutex());
         if(std::ifstream(file_path).good())
         {
-            if(readBufferFromFile<Tref>(data, GetTensorSize(tensorDesc), file_path.c_str()))
+            if(readBufferFromFile<Tref>(
+                   data, GetTensorSize(tensorDesc), file_path.c_str(), *verification_log))
             {
                 return true;
             }
@@ -3307,7 +3382,8 @@ void ConvDriver<Tgpu, Tref>::TrySaveVerificationCache(
     {
         const auto file_path =
             verification_cache_path + "/" + GetVerificationCacheFileName(direction);
-        dumpBufferToFile<Tref>(file_path.c_str(), data.data(), data.size());
+        std::lock_guard<std::mutex> lock(GetVerificationCacheMutex());
+        dumpBufferToFile<Tref>(file_path.c_str(), data.data(), data.size(), *verification_log);
     }
 }
 
@@ -3339,12 +3415,14 @@ int ConvDriver<Tgpu, Tref>::VerifyForward()
 
     if(!std::isfinite(error) || error > tolerance)
     {
-        std::cout << "Forward Convolution FAILED: " << error << " > " << tolerance << std::endl;
+        *verification_log << "Forward Convolution FAILED: " << error << " > " << tolerance
+                          << std::endl;
         return EC_VerifyFwd;
     }
 
-    std::cout << "Forward Convolution Verifies OK on " << (UseGPUReference() ? "GPU" : "CPU")
-              << " reference (" << error << ')' << std::endl;
+    *verification_log << "Forward Convolution Verifies OK on "
+                      << (UseGPUReference() ? "GPU" : "CPU") << " reference (" << error << ')'
+                      << std::endl;
     return 0;
 }
 
@@ -3353,7 +3431,7 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
 {
     if(data_type == miopenInt8 || data_type == miopenInt8x4)
     {
-        std::cout << "Int8 Backward Convolution is not supported" << std::endl;
+        *verification_log << "Int8 Backward Convolution is not supported" << std::endl;
         return 0;
     }
 
@@ -3383,15 +3461,15 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
 
         if(!std::isfinite(error_data) || error_data > tolerance)
         {
-            std::cout << "Backward Convolution Data FAILED: " << error_data << " > " << tolerance
-                      << std::endl;
+            *verification_log << "Backward Convolution Data FAILED: " << error_data << " > "
+                              << tolerance << std::endl;
             cumulative_rc |= EC_VerifyBwd;
         }
         else
         {
-            std::cout << "Backward Convolution Data Verifies OK on "
-                      << (UseGPUReference() ? "GPU" : "CPU") << " reference (" << error_data << ')'
-                      << std::endl;
+            *verification_log << "Backward Convolution Data Verifies OK on "
+                              << (UseGPUReference() ? "GPU" : "CPU") << " reference ("
+                              << error_data << ')' << std::endl;
         }
     }
 
@@ -3431,15 +3509,15 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
 
         if(!std::isfinite(error_weights) || error_weights > tolerance)
         {
-            std::cout << "Backward Convolution Weights FAILED: " << error_weights << " > "
-                      << tolerance << std::endl;
+            *verification_log << "Backward Convolution Weights FAILED: " << error_weights
+                              << " > " << tolerance << std::endl;
             cumulative_rc |= EC_VerifyWrw;
         }
         else
         {
-            std::cout << "Backward Convolution Weights Verifies OK on "
-                      << (UseGPUReference() ? "GPU" : "CPU") << " reference (" << error_weights
-                      << ')' << std::endl;
+            *verification_log << "Backward Convolution Weights Verifies OK on "
+                              << (UseGPUReference() ? "GPU" : "CPU") << " reference ("
+                              << error_weights << ')' << std::endl;
         }
     }
 
@@ -3454,15 +3532,15 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
         const auto tolerance = GetDefaultTolerance();
         if(!std::isfinite(error_bias) || error_bias > tolerance)
         {
-            std::cout << "Backward Convolution Bias FAILED: " << error_bias << " > " << tolerance
-                      << std::endl;
+            *verification_log << "Backward Convolution Bias FAILED: " << error_bias << " > "
+                              << tolerance << std::endl;
             cumulative_rc |= EC_VerifyBwdBias;
         }
         else
         {
-            std::cout << "Backward Convolution Bias Verifies OK on "
-                      << (UseGPUReference() ? "GPU" : "CPU") << " reference (" << error_bias << ')'
-                      << std::endl;
+            *verification_log << "Backward Convolution Bias Verifies OK on "
+                              << (UseGPUReference() ? "GPU" : "CPU") << " reference ("
+                              << error_bias << ')' << std::endl;
         }
     }
 
@@ -37,10 +37,12 @@ using float16 = half_float::half;
 #include <cstdio>
 #include <cstdlib>
 #include <cfloat>
+#include <iostream>
 #include <memory>
 #include <miopen/miopen.h>
 #include <miopen/bfloat16.hpp>
 #include <numeric>
+#include <string>
 #include <vector>
 
 #if MIOPEN_BACKEND_OPENCL
@@ -139,6 +141,7 @@ inline void PadBufferSize(size_t& sz, int datatype_sz)
 [[gnu::noreturn]] inline void Usage()
 {
     printf("Usage: ./driver *base_arg* *other_args*\n");
+    printf("       ./driver --batch <file|-> [--jobs <n>]\n");
     printf("Supported Base Arguments: conv[fp16|int8|bfp16], CBAInfer[fp16], "
            "pool[fp16], lrn[fp16], "
            "activ[fp16], softmax[fp16], bnorm[fp16], rnn[fp16], gemm, ctc, dropout[fp16], "
@@ -146,6 +149,17 @@ inline void PadBufferSize(size_t& sz, int datatype_sz)
     exit(0); // NOLINT (concurrency-mt-unsafe)
 }
 
+inline bool IsDriverBaseArg(const std::string& arg)
+{
+    return arg == "conv" || arg == "convfp16" || arg == "convint8" || arg == "convbfp16" ||
+           arg == "CBAInfer" || arg == "CBAInferfp16" || arg == "pool" || arg == "poolfp16" ||
+           arg == "lrn" || arg == "lrnfp16" || arg == "activ" || arg == "activfp16" ||
+           arg == "softmax" || arg == "softmaxfp16" || arg == "bnorm" || arg == "bnormfp16" ||
+           arg == "rnn" || arg == "rnnfp16" || arg == "gemm" /*|| arg == "gemmfp16"*/ ||
+           arg == "ctc" || arg == "dropout" || arg == "dropoutfp16" || arg == "tensorop" ||
+           arg == "tensoropfp16" || arg == "reduce" || arg == "reducefp16" || arg == "reducefp64";
+}
+
 inline std::string ParseBaseArg(int argc, char* argv[])
 {
     if(argc < 2)
@@ -156,13 +170,7 @@ inline std::string ParseBaseArg(int argc, char* argv[])
 
     std::string arg = argv[1];
 
-    if(arg != "conv" && arg != "convfp16" && arg != "convint8" && arg != "convbfp16" &&
-       arg != "CBAInfer" && arg != "CBAInferfp16" && arg != "pool" && arg != "poolfp16" &&
-       arg != "lrn" && arg != "lrnfp16" && arg != "activ" && arg != "activfp16" &&
-       arg != "softmax" && arg != "softmaxfp16" && arg != "bnorm" && arg != "bnormfp16" &&
-       arg != "rnn" && arg != "rnnfp16" && arg != "gemm" /*&& arg != "gemmfp16"*/ && arg != "ctc" &&
-       arg != "dropout" && arg != "dropoutfp16" && arg != "tensorop" && arg != "tensoropfp16" &&
-       arg != "reduce" && arg != "reducefp16" && arg != "reducefp64" && arg != "--version")
+    if(!IsDriverBaseArg(arg) && arg != "--version" && arg != "--batch")
     {
         printf("FAILED: Invalid Base Input Argument\n");
         Usage();
@@ -173,19 +181,44 @@ inline std::string ParseBaseArg(int argc, char* argv[])
         return arg;
 }
 
+inline miopenHandle_t CreateDriverHandle()
+{
+    miopenHandle_t handle;
+#if MIOPEN_BACKEND_OPENCL
+    miopenCreate(&handle);
+#elif MIOPEN_BACKEND_HIP
+    hipStream_t s;
+    hipStreamCreate(&s);
+    miopenCreateWithStream(&handle, s);
+#endif
+    return handle;
+}
+
+/// The handle shared by all the drivers of a batch (see RunBatch()), or nullptr when each driver
+/// creates its own handle.
+inline miopenHandle_t& SharedDriverHandle()
+{
+    static miopenHandle_t handle = nullptr;
+    return handle;
+}
+
+/// The kernel times of a direction of a layer, collected for the batch mode.
+struct DriverTiming
+{
+    std::string direction;
+    std::string solver;
+    std::vector<float> times; // ms, one per iteration
+    double flop_count;
+};
+
 class Driver
 {
 public:
     Driver()
     {
-        data_type = miopenFloat;
-#if MIOPEN_BACKEND_OPENCL
-        miopenCreate(&handle);
-#elif MIOPEN_BACKEND_HIP
-        hipStream_t s;
-        hipStreamCreate(&s);
-        miopenCreateWithStream(&handle, s);
-#endif
+        data_type   = miopenFloat;
+        owns_handle = SharedDriverHandle() == nullptr;
+        handle      = owns_handle ? CreateDriverHandle() : SharedDriverHandle();
 
         miopenGetStream(handle, &q);
     }
@@ -198,7 +231,21 @@ public:
 #elif MIOPEN_BACKEND_HIP
     hipStream_t& GetStream() { return q; }
 #endif
-    virtual ~Driver() { miopenDestroy(handle); }
+    virtual ~Driver()
+    {
+        if(owns_handle)
+            miopenDestroy(handle);
+    }
+
+    const std::vector<DriverTiming>& GetTimings() const { return timings; }
+
+    /// True when the verification only touches host memory, so it may run
+    /// concurrently with the GPU work of the next layer of a batch.
+    virtual bool IsVerificationHostOnly() const { return false; }
+
+    /// Redirects the messages of the host-only verification, so a batch can collect them while
+    /// the verification runs concurrently with the next layers.
+    void SetVerificationLog(std::ostream& log) { verification_log = &log; }
 
     // TODO: add timing APIs
     virtual int AddCmdLineArgs()                         = 0;
@@ -215,7 +262,10 @@ protected:
     template <typename Tgpu>
     void InitDataType();
     miopenHandle_t handle;
+    bool owns_handle;
     miopenDataType_t data_type;
+    std::vector<DriverTiming> timings;
+    std::ostream* verification_log = &std::cout;
 
 #if MIOPEN_BACKEND_OPENCL
     cl_command_queue q;
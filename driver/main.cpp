@@ -27,6 +27,7 @@
 #include <cstdio>
 
 #include "activ_driver.hpp"
+#include "batch_driver.hpp"
 #include "bn_driver.hpp"
 #include "conv_driver.hpp"
 #include "CBAInferFusion_driver.hpp"
@@ -43,190 +44,156 @@
 #include <miopen/config.h>
 #include <miopen/stringutils.hpp>
 
-int main(int argc, char* argv[])
+static Driver* MakeDriver(const std::string& base_arg)
 {
-
-    std::string base_arg = ParseBaseArg(argc, argv);
-
-    if(base_arg == "--version")
-    {
-        size_t major, minor, patch;
-        miopenGetVersion(&major, &minor, &patch);
-        std::cout << "MIOpen (version: " << major << "." << minor << "." << patch << ")"
-                  << std::endl;
-        exit(0); // NOLINT (concurrency-mt-unsafe)
-    }
-
-    // show command
-    std::cout << "MIOpenDriver";
-    for(int i = 1; i < argc; i++)
-        std::cout << " " << argv[i];
-    std::cout << std::endl;
-
-    Driver* drv;
     if(base_arg == "conv")
     {
-        drv = new ConvDriver<float, float>();
+        return new ConvDriver<float, float>();
     }
     else if(base_arg == "convfp16")
     {
-        drv = new ConvDriver<float16, float>();
+        return new ConvDriver<float16, float>();
     }
     else if(base_arg == "convbfp16")
     {
-        drv = new ConvDriver<bfloat16, float>();
+        return new ConvDriver<bfloat16, float>();
     }
     else if(base_arg == "convint8")
     {
-        drv = new ConvDriver<int8_t, int32_t>();
+        return new ConvDriver<int8_t, int32_t>();
     }
     else if(base_arg == "CBAInfer")
     {
-        drv = new CBAInferFusionDriver<float, double>();
+        return new CBAInferFusionDriver<float, double>();
     }
     else if(base_arg == "CBAInferfp16")
     {
-        drv = new CBAInferFusionDriver<float16, double>();
+        return new CBAInferFusionDriver<float16, double>();
     }
     else if(base_arg == "pool")
     {
-        drv = new PoolDriver<float, double>();
+        return new PoolDriver<float, double>();
     }
     else if(base_arg == "poolfp16")
     {
-        drv = new PoolDriver<float16, double>();
+        return new PoolDriver<float16, double>();
     }
     else if(base_arg == "lrn")
     {
-        drv = new LRNDriver<float, double>();
+        return new LRNDriver<float, double>();
     }
     else if(base_arg == "lrnfp16")
     {
-        drv = new LRNDriver<float16, double>();
+        return new LRNDriver<float16, double>();
     }
     else if(base_arg == "activ")
     {
-        drv = new ActivationDriver<float, double>();
+        return new ActivationDriver<float, double>();
     }
     else if(base_arg == "activfp16")
     {
-        drv = new ActivationDriver<float16, double>();
+        return new ActivationDriver<float16, double>();
     }
     else if(base_arg == "softmax")
     {
-        drv = new SoftmaxDriver<float, double>();
+        return new SoftmaxDriver<float, double>();
     }
     else if(base_arg == "softmaxfp16")
     {
-        drv = new SoftmaxDriver<float16, double>();
+        return new SoftmaxDriver<float16, double>();
     }
 #if MIOPEN_USE_GEMM
     else if(base_arg == "gemm")
     {
-        drv = new GemmDriver<float>();
+        return new GemmDriver<float>();
     }
 // TODO half is not supported in gemm
 //    else if(base_arg == "gemmfp16")
 //    {
-//        drv = new GemmDriver<float16>();
+//        return new GemmDriver<float16>();
 //    }
 #endif
     else if(base_arg == "bnorm")
     {
-        drv = new BatchNormDriver<float, double>();
+        return new BatchNormDriver<float, double>();
     }
     else if(base_arg == "bnormfp16")
     {
-        drv = new BatchNormDriver<float16, double, float>();
+        return new BatchNormDriver<float16, double, float>();
     }
     else if(base_arg == "rnn")
     {
-        drv = new RNNDriver<float, double>();
+        return new RNNDriver<float, double>();
     }
     else if(base_arg == "rnnfp16")
     {
-        drv = new RNNDriver<float16, double>();
+        return new RNNDriver<float16, double>();
     }
     else if(base_arg == "ctc")
     {
-        drv = new CTCDriver<float>();
+        return new CTCDriver<float>();
     }
     else if(base_arg == "dropout")
     {
-        drv = new DropoutDriver<float, float>();
+        return new DropoutDriver<float, float>();
     }
     else if(base_arg == "dropoutfp16")
     {
-        drv = new DropoutDriver<float16, float>();
+        return new DropoutDriver<float16, float>();
     }
     else if(base_arg == "tensorop")
     {
-        drv = new TensorOpDriver<float, float>();
+        return new TensorOpDriver<float, float>();
     }
     else if(base_arg == "tensoropfp16")
     {
-        drv = new TensorOpDriver<float16, float>();
+        return new TensorOpDriver<float16, float>();
     }
     else if(base_arg == "reduce")
     {
-        drv = new ReduceDriver<float, float>();
+        return new ReduceDriver<float, float>();
     }
     else if(base_arg == "reducefp16")
     {
-        drv = new ReduceDriver<float16, float>();
+        return new ReduceDriver<float16, float>();
     }
     else if(base_arg == "reducefp64")
     {
-        drv = new ReduceDriver<double, double>();
-    }
-    else
-    {
-        printf("Incorrect BaseArg\n");
-        exit(0); // NOLINT (concurrency-mt-unsafe)
+        return new ReduceDriver<double, double>();
     }
 
-    drv->AddCmdLineArgs();
-    int rc = drv->ParseCmdLineArgs(argc, argv);
-    if(rc != 0)
-    {
-        std::cout << "ParseCmdLineArgs() FAILED, rc = " << rc << std::endl;
-        return rc;
-    }
-    drv->GetandSetData();
-    rc = drv->AllocateBuffersAndCopy();
-    if(rc != 0)
-    {
-        std::cout << "AllocateBuffersAndCopy() FAILED, rc = " << rc << std::endl;
-        return rc;
-    }
+    return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
 
-    int fargval =
-        !miopen::StartsWith(base_arg, "CBAInfer") ? drv->GetInputFlags().GetValueInt("forw") : 1;
-    bool bnFwdInVer   = (fargval == 2 && miopen::StartsWith(base_arg, "bnorm"));
-    bool verifyarg    = (drv->GetInputFlags().GetValueInt("verify") == 1);
-    int cumulative_rc = 0; // Do not stop running tests in case of errors.
+    std::string base_arg = ParseBaseArg(argc, argv);
 
-    if(fargval & 1 || fargval == 0 || bnFwdInVer)
+    if(base_arg == "--version")
     {
-        rc = drv->RunForwardGPU();
-        cumulative_rc |= rc;
-        if(rc != 0)
-            std::cout << "RunForwardGPU() FAILED, rc = "
-                      << "0x" << std::hex << rc << std::dec << std::endl;
-        if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyForward();
+        size_t major, minor, patch;
+        miopenGetVersion(&major, &minor, &patch);
+        std::cout << "MIOpen (version: " << major << "." << minor << "." << patch << ")"
+                  << std::endl;
+        exit(0); // NOLINT (concurrency-mt-unsafe)
     }
 
-    if(fargval != 1)
+    if(base_arg == "--batch")
+        return RunBatch(argc, argv, MakeDriver);
+
+    // show command
+    std::cout << "MIOpenDriver";
+    for(int i = 1; i < argc; i++)
+        std::cout << " " << argv[i];
+    std::cout << std::endl;
+
+    std::unique_ptr<Driver> drv(MakeDriver(base_arg));
+    if(drv == nullptr)
     {
-        rc = drv->RunBackwardGPU();
-        cumulative_rc |= rc;
-        if(rc != 0)
-            std::cout << "RunBackwardGPU() FAILED, rc = "
-                      << "0x" << std::hex << rc << std::dec << std::endl;
-        if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyBackward();
+        printf("Incorrect BaseArg\n");
+        exit(0); // NOLINT (concurrency-mt-unsafe)
     }
 
-    return cumulative_rc;
+    return RunDriver(*drv, argc, argv);
 }
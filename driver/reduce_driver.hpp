@@ -100,8 +100,6 @@ private:
 
     miopenTensorDescriptor_t inputTensor;
     miopenTensorDescriptor_t outputTensor;
-    std::vector<int> dimsToReduce;
-    std::vector<int> dimsInvariant;
 
     std::unique_ptr<GPUMem> in_dev;
     std::unique_ptr<GPUMem> out_dev;
@@ -139,7 +137,6 @@ int ReduceDriver<Tgpu, Tref>::GetandSetData()
     std::vector<int> inLengths    = GetInputTensorLengthsFromCmdLine();
     std::vector<int> toReduceDims = GetDimsToReduceFromCmdLine();
     std::vector<int> outLengths   = inLengths;
-    std::vector<int> invariantDims;
 
     assert(toReduceDims.size() <= inLengths.size());
     for(int i = 0; i < toReduceDims.size(); i++)
@@ -153,14 +150,6 @@ int ReduceDriver<Tgpu, Tref>::GetandSetData()
     SetTensorNd(outputTensor, outLengths, data_type);
     SetReduceTensorDescriptorFromCmdLineArgs();
 
-    this->dimsToReduce = toReduceDims;
-
-    for(int i = 0; i < inLengths.size(); i++)
-        if(inLengths[i] == outLengths[i])
-            invariantDims.push_back(i);
-
-    this->dimsInvariant = invariantDims;
-
     return (0);
 }
 
@@ -465,11 +454,8 @@ int ReduceDriver<Tgpu, Tref>::RunBackwardGPU()
 template <typename Tgpu, typename Tref>
 int ReduceDriver<Tgpu, Tref>::VerifyForward()
 {
-    miopenReductionHost<Tgpu, Tref> hostReduction(this->reduceDesc,
-                                                  this->inputTensor,
-                                                  this->outputTensor,
-                                                  this->dimsInvariant,
-                                                  this->dimsToReduce);
+    miopenReductionHost<Tgpu, Tref> hostReduction(
+        this->reduceDesc, this->inputTensor, this->outputTensor);
 
     auto alpha = static_cast<float>(this->inflags.GetValueDouble("alpha"));
     auto beta  = static_cast<float>(this->inflags.GetValueDouble("beta"));
@@ -249,6 +249,83 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
  */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Kernel cache statistics
+ *
+ * The hits, the misses and the evictions are counted since the start of the process.
+ */
+typedef struct
+{
+    size_t hits;      /*!< Kernels loaded from the cache */
+    size_t misses;    /*!< Kernels not found in the cache, which have been built */
+    size_t bytes;     /*!< Size of the user kernel cache of the device of the handle in bytes */
+    size_t evictions; /*!< Kernels removed from the cache to keep it within its size limit */
+} miopenKernelCacheStats_t;
+
+/*! @brief Get the statistics of the kernel cache
+ *
+ * The size limit of the user kernel cache is set by the MIOPEN_CACHE_SIZE_LIMIT environment
+ * variable in MiB, the least recently used kernels are evicted beyond it.
+ * @param handle     MIOpen handle (input)
+ * @param stats      Pointer to the statistics of the kernel cache (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetKernelCacheStats(miopenHandle_t handle,
+                                                       miopenKernelCacheStats_t* stats);
+
+/*! @brief Compact the kernel cache
+ *
+ * Evicts the least recently used kernels beyond the size limit from the user kernel cache of the
+ * device of the handle, and returns the space freed by the evicted kernels to the filesystem.
+ * The kernel cache must not be used by other processes for the compaction to succeed.
+ * @param handle     MIOpen handle (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCompactKernelCache(miopenHandle_t handle);
+
+/*! @brief Memory pool statistics
+ *
+ * The hits, the misses and the releases are counted since the creation of the handle.
+ */
+typedef struct
+{
+    size_t limit;        /*!< Most bytes the pool keeps from the allocator, 0 when disabled */
+    size_t bytes_in_use; /*!< Bytes of the pool blocks used by MIOpen */
+    size_t bytes_cached; /*!< Bytes of the freed blocks kept for reuse */
+    size_t peak_bytes;   /*!< High-water mark of the bytes in use and cached */
+    size_t hits;         /*!< Allocations served by cached blocks */
+    size_t misses;       /*!< Allocations passed to the allocator */
+    size_t releases;     /*!< Cached blocks returned to the allocator */
+} miopenMemoryPoolStats_t;
+
+/*! @brief Set the size limit of the memory pool of the handle
+ *
+ * The memory pool caches the buffers MIOpen allocates internally through the allocator of the
+ * handle (see miopenSetAllocator), and hands them out again to allocations of a similar size
+ * on the same stream. The least recently freed buffers are returned to the allocator to keep
+ * the pool within the limit. The pool is disabled by default, unless the
+ * MIOPEN_MEMORY_POOL_LIMIT environment variable sets a limit in MiB.
+ * @param handle     MIOpen handle (input)
+ * @param limit      Size limit of the pool in bytes, 0 disables the pool (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetMemoryPoolLimit(miopenHandle_t handle, size_t limit);
+
+/*! @brief Get the statistics of the memory pool of the handle
+ *
+ * @param handle     MIOpen handle (input)
+ * @param stats      Pointer to the statistics of the memory pool (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetMemoryPoolStats(miopenHandle_t handle,
+                                                      miopenMemoryPoolStats_t* stats);
+
+/*! @brief Return the cached buffers of the memory pool of the handle to its allocator
+ *
+ * @param handle     MIOpen handle (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenReleaseMemoryPool(miopenHandle_t handle);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -4944,6 +5021,30 @@ MIOPEN_EXPORT miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
                                                  size_t* numSolutions,
                                                  size_t maxSolutions);
 
+/*! @brief Finds solutions to several problems, e.g. all the convolutions of a network. Problems
+ * with the same configuration are solved once and the kernels of all the problems are compiled in
+ * a single parallel pass, which reduces the time to load a model. Memory is automatically
+ * allocated.
+ *
+ * @param handle       Handle to execute the kernels
+ * @param nProblems    Number of problems
+ * @param problems     Problems to solve
+ * @param options      Find options. When null default values would be used. Preallocated tensors
+ *                     can not be used with several problems
+ * @param solutions    Pointer to the first result. Results of the i-th problem start at
+ *                     solutions + i * maxSolutions. Must not be null
+ * @param numSolutions Pointer to the amounts of results of each problem. Ignored if null
+ * @param maxSolutions Limits the amount of results of each problem
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                                      size_t nProblems,
+                                                      const miopenProblem_t* problems,
+                                                      miopenFindOptions_t options,
+                                                      miopenSolution_t* solutions,
+                                                      size_t* numSolutions,
+                                                      size_t maxSolutions);
+
 /*! @brief Values of a tensor argument for the miopenRunSolution function.
  */
 struct miopenTensorArgument_t
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/conv/heuristics/dense_net.hpp>
+#include <miopen/db_path.hpp>
+
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+#include <fdeep/fdeep.hpp>
+#endif
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace ai_heuristics {
+
+/// Latency per prediction of TunaNet evaluated by DenseNet, one problem at a time and in
+/// batches as for the layers of a network, and by fdeep when it is available.
+struct AiHeuristicsSpeedTestDriver : public test_driver
+{
+    AiHeuristicsSpeedTestDriver()
+    {
+        add(model, "model");
+        add(batch, "batch");
+        add(predictions, "predictions");
+    }
+
+    void run()
+    {
+        std::cout << "Model: " << model << std::endl;
+        const auto net = ai::DenseNet::Load(model);
+        if(!net)
+        {
+            std::cout << "The model is not supported by DenseNet" << std::endl;
+            return;
+        }
+
+        std::mt19937 gen{0};
+        std::normal_distribution<float> dist;
+        std::vector<float> inputs(predictions * net->InputSize());
+        for(auto& input : inputs)
+            input = dist(gen);
+
+        Measure("DenseNet", 1, [&](std::size_t first, std::size_t count) {
+            net->Forward(Slice(inputs, *net, first, count), count);
+        });
+        Measure("DenseNet", batch, [&](std::size_t first, std::size_t count) {
+            net->Forward(Slice(inputs, *net, first, count), count);
+        });
+
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+        const auto fdeep_model = fdeep::load_model(model, false, fdeep::dev_null_logger);
+        const auto shape       = fdeep::tensor_shape(net->InputSize());
+        Measure("fdeep", 1, [&](std::size_t first, std::size_t count) {
+            fdeep_model.predict({fdeep::tensor(shape, Slice(inputs, *net, first, count))});
+        });
+#endif
+    }
+
+    static std::vector<float> Slice(const std::vector<float>& inputs,
+                                    const ai::DenseNet& net,
+                                    std::size_t first,
+                                    std::size_t count)
+    {
+        const auto begin = inputs.begin() + first * net.InputSize();
+        return {begin, begin + count * net.InputSize()};
+    }
+
+    template <class F>
+    void Measure(const std::string& name, std::size_t batch_size, F forward) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(std::size_t first = 0; first < predictions; first += batch_size)
+            forward(first, std::min(batch_size, predictions - first));
+        const auto end = std::chrono::steady_clock::now();
+
+        std::cout << std::setw(8) << name << ", batch " << std::setw(4) << batch_size << ": "
+                  << std::chrono::duration<double, std::micro>{end - start}.count() / predictions
+                  << " us per prediction" << std::endl;
+    }
+
+    std::string model       = GetSystemDbPath() + "/gfx908.tn.model";
+    std::size_t batch       = 64;
+    std::size_t predictions = 10000;
+};
+
+} // namespace ai_heuristics
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::ai_heuristics::AiHeuristicsSpeedTestDriver>(argc, argv);
+    return 0;
+}
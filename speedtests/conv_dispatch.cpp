@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/invoker_cache.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace conv_dispatch {
+
+/// Host side of the immediate mode dispatch, as in LoadOrPrepareInvoker(): the problem is built
+/// from the descriptors, its network config is computed and the invoker is looked up.
+struct ConvDispatchSpeedTestDriver : public test_driver
+{
+    ConvDispatchSpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(problems, "problems");
+    }
+
+    void run()
+    {
+        const auto conv_desc = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+        const auto w         = TensorDescriptor{miopenFloat, {64, 64, 3, 3}};
+        auto xs              = std::vector<TensorDescriptor>{};
+        auto ys              = std::vector<TensorDescriptor>{};
+        InvokerCache cache;
+
+        for(auto i = 0; i < problems; ++i)
+        {
+            const auto size = 7 + i;
+            xs.push_back(TensorDescriptor{miopenFloat, {1, 64, size, size}});
+            ys.push_back(TensorDescriptor{miopenFloat, {1, 64, size, size}});
+            const auto problem = MakeProblem(xs.back(), w, ys.back(), conv_desc);
+            cache.Register({problem.BuildConfKey(), "ConvBinWinograd3x3U"},
+                           [](const Handle&, const AnyInvokeParams&) {});
+        }
+
+        Test("string key", [&](std::size_t i) {
+            const auto problem = MakeProblem(xs[i], w, ys[i], conv_desc);
+            std::string config;
+            problem.BuildConfKey(config);
+            return cache[{NetworkConfig{config}, "ConvBinWinograd3x3U"}].has_value();
+        });
+
+        Test("interned key", [&](std::size_t i) {
+            const auto problem = MakeProblem(xs[i], w, ys[i], conv_desc);
+            return cache[{problem.BuildConfKey(), "ConvBinWinograd3x3U"}].has_value();
+        });
+    }
+
+private:
+    int iterations = 100000;
+    int problems   = 16;
+
+    static conv::ProblemDescription MakeProblem(const TensorDescriptor& x,
+                                          const TensorDescriptor& w,
+                                          const TensorDescriptor& y,
+                                          const ConvolutionDescriptor& conv_desc)
+    {
+        return conv::ProblemDescription{x, w, y, conv_desc, conv::Direction::Forward};
+    }
+
+    template <class TDispatch>
+    void Test(const std::string& name, TDispatch&& dispatch) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+            if(!dispatch(static_cast<std::size_t>(i % problems)))
+                std::abort();
+        const auto time = std::chrono::steady_clock::now() - start;
+        const auto ns   = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+        std::cout << name << ": " << ns / iterations << " ns per call" << std::endl;
+    }
+};
+
+} // namespace conv_dispatch
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::conv_dispatch::ConvDispatchSpeedTestDriver>(argc, argv);
+    return 0;
+}
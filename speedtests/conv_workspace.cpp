@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/miopen.h>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace conv_workspace {
+
+/// Measures the repeated workspace size queries of the convolutions of a network, as
+/// frameworks issue them once per layer per iteration. The layers are read from the MIOpenDriver
+/// command lines of test/perf_models/*.txt.
+struct ConvWorkspaceSpeedTestDriver : public test_driver
+{
+    ConvWorkspaceSpeedTestDriver()
+    {
+        add(model, "model");
+        add(iterations, "iterations");
+    }
+
+    void run()
+    {
+        const auto layers = ReadModel();
+        std::cout << "Model: " << model << ", layers: " << layers.size() << std::endl;
+        if(layers.empty())
+            return;
+
+        miopenHandle_t handle;
+        miopenCreate(&handle);
+
+        for(auto i = 0; i < iterations; ++i)
+        {
+            std::size_t total = 0;
+            const auto start  = std::chrono::steady_clock::now();
+            for(const auto& layer : layers)
+                total += Query(handle, layer);
+            const auto time = std::chrono::steady_clock::now() - start;
+            const auto us   = std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+            std::cout << "Iteration " << i << ": " << us << " us, " << us / layers.size()
+                      << " us per layer, workspace: " << total << std::endl;
+        }
+
+        miopenDestroy(handle);
+    }
+
+private:
+    std::string model;
+    int iterations = 5;
+
+    using Layer = std::map<std::string, std::string>;
+
+    std::vector<Layer> ReadModel() const
+    {
+        auto layers = std::vector<Layer>{};
+        auto file   = std::ifstream{model};
+        auto line   = std::string{};
+
+        while(std::getline(file, line))
+        {
+            auto stream = std::istringstream{line};
+            auto token  = std::string{};
+            auto layer  = Layer{};
+            while(stream >> token)
+            {
+                if(token.rfind("--", 0) != 0)
+                {
+                    if(token.rfind("conv", 0) == 0)
+                        layer["command"] = token;
+                    continue;
+                }
+                auto value = std::string{};
+                stream >> value;
+                layer[token.substr(2)] = value;
+            }
+            if(layer.count("command") != 0 && layer.count("in_channels") != 0 &&
+               layer["spatial_dim"] == "2")
+                layers.push_back(std::move(layer));
+        }
+
+        return layers;
+    }
+
+    static int Get(const Layer& layer, const std::string& name, int fallback)
+    {
+        const auto it = layer.find(name);
+        return it == layer.end() ? fallback : std::stoi(it->second);
+    }
+
+    static std::size_t Query(miopenHandle_t handle, const Layer& layer)
+    {
+        const auto& command = layer.at("command");
+        const auto type     = command == "convfp16"    ? miopenHalf
+                              : command == "convbfp16" ? miopenBFloat16
+                                                       : miopenFloat;
+        miopenTensorDescriptor_t x;
+        miopenTensorDescriptor_t w;
+        miopenTensorDescriptor_t y;
+        miopenConvolutionDescriptor_t conv;
+        miopenCreateTensorDescriptor(&x);
+        miopenCreateTensorDescriptor(&w);
+        miopenCreateTensorDescriptor(&y);
+        miopenCreateConvolutionDescriptor(&conv);
+
+        miopenSet4dTensorDescriptor(x,
+                                    type,
+                                    Get(layer, "batchsize", 1),
+                                    Get(layer, "in_channels", 1),
+                                    Get(layer, "in_h", 1),
+                                    Get(layer, "in_w", 1));
+        miopenSet4dTensorDescriptor(w,
+                                    type,
+                                    Get(layer, "out_channels", 1),
+                                    Get(layer, "in_channels", 1) / Get(layer, "group_count", 1),
+                                    Get(layer, "fil_h", 1),
+                                    Get(layer, "fil_w", 1));
+        miopenInitConvolutionDescriptor(conv,
+                                        miopenConvolution,
+                                        Get(layer, "pad_h", 0),
+                                        Get(layer, "pad_w", 0),
+                                        Get(layer, "conv_stride_h", 1),
+                                        Get(layer, "conv_stride_w", 1),
+                                        Get(layer, "dilation_h", 1),
+                                        Get(layer, "dilation_w", 1));
+        miopenSetConvolutionGroupCount(conv, Get(layer, "group_count", 1));
+
+        int n, c, h, wd;
+        miopenGetConvolutionForwardOutputDim(conv, x, w, &n, &c, &h, &wd);
+        miopenSet4dTensorDescriptor(y, type, n, c, h, wd);
+
+        // Same bits as the --forw option of MIOpenDriver, 0 runs all the directions
+        const auto forw = Get(layer, "forw", 0);
+        std::size_t size;
+        std::size_t total = 0;
+        if(forw == 0 || (forw & 1) != 0)
+        {
+            miopenConvolutionForwardGetWorkSpaceSize(handle, w, x, conv, y, &size);
+            total += size;
+        }
+        if(forw == 0 || (forw & 2) != 0)
+        {
+            miopenConvolutionBackwardDataGetWorkSpaceSize(handle, y, w, conv, x, &size);
+            total += size;
+        }
+        if(forw == 0 || (forw & 4) != 0)
+        {
+            miopenConvolutionBackwardWeightsGetWorkSpaceSize(handle, y, x, conv, w, &size);
+            total += size;
+        }
+
+        miopenDestroyConvolutionDescriptor(conv);
+        miopenDestroyTensorDescriptor(y);
+        miopenDestroyTensorDescriptor(w);
+        miopenDestroyTensorDescriptor(x);
+        return total;
+    }
+};
+
+} // namespace conv_workspace
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::conv_workspace::ConvWorkspaceSpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/errors.hpp>
+
+#include <cpu_conv.hpp>
+#include <driver.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace cpu_conv {
+
+/// Run time of the CPU references used by MIOpenDriver -V 1 and the convolution tests, for the
+/// fp32 convolutions of a list of MIOpenDriver command lines such as test/perf_models/*.txt.
+/// The batch size is overridden, the direct loops are only timed for the first layers.
+struct CpuConvSpeedTestDriver : public test_driver
+{
+    CpuConvSpeedTestDriver()
+    {
+        add(models, "models");
+        add(batchsize, "batchsize");
+        add(layers, "layers");
+        add(direct_layers, "direct-layers");
+    }
+
+    void run()
+    {
+        auto file = std::ifstream{models};
+        if(!file)
+            MIOPEN_THROW("Unable to open " + models);
+
+        std::string line;
+        std::size_t layer = 0;
+        while(layer < layers && std::getline(file, line))
+        {
+            auto options = std::map<std::string, int>{};
+            if(!Parse(line, options))
+                continue;
+            std::cout << "Layer " << layer << ": " << Describe(options) << std::endl;
+            Measure(options, layer < direct_layers);
+            ++layer;
+        }
+    }
+
+private:
+    std::string models        = "test/perf_models/Resnet50_v1_FP32_BS256.txt";
+    int batchsize             = 4;
+    std::size_t layers        = 10;
+    std::size_t direct_layers = 1;
+
+    /// The numeric options of a 2D convolution command line
+    static bool Parse(const std::string& line, std::map<std::string, int>& options)
+    {
+        auto stream = std::istringstream{line};
+        auto token  = std::string{};
+        while(stream >> token && token != "conv") {}
+        if(!stream)
+            return false;
+
+        while(stream >> token)
+        {
+            auto value = std::string{};
+            if(token.compare(0, 2, "--") == 0 && stream >> value &&
+               value.find_first_not_of("0123456789") == std::string::npos)
+                options[token.substr(2)] = std::stoi(value);
+        }
+        return options["spatial_dim"] == 2 && options["group_count"] >= 1;
+    }
+
+    static std::string Describe(const std::map<std::string, int>& options)
+    {
+        std::ostringstream ss;
+        for(const auto* name : {"in_channels", "in_h", "in_w", "out_channels", "fil_h", "fil_w"})
+            ss << name << ' ' << options.at(name) << ' ';
+        ss << "stride " << options.at("conv_stride_h") << ' ' << options.at("conv_stride_w");
+        return ss.str();
+    }
+
+    void Measure(std::map<std::string, int>& o, bool with_direct) const
+    {
+        const auto groups    = o["group_count"];
+        const auto pads      = std::vector<int>{o["pad_h"], o["pad_w"]};
+        const auto strides   = std::vector<int>{o["conv_stride_h"], o["conv_stride_w"]};
+        const auto dilations = std::vector<int>{o["dilation_h"], o["dilation_w"]};
+
+        auto in =
+            tensor<float>{std::vector<int>{batchsize, o["in_channels"], o["in_h"], o["in_w"]}};
+        auto wei = tensor<float>{
+            std::vector<int>{o["out_channels"], o["in_channels"] / groups, o["fil_h"], o["fil_w"]}};
+        auto out_lens = std::vector<int>{batchsize, o["out_channels"]};
+        for(auto i : {0, 1})
+        {
+            const auto filter = dilations[i] * (wei.desc.GetLengths()[i + 2] - 1) + 1;
+            out_lens.push_back(
+                (in.desc.GetLengths()[i + 2] + 2 * pads[i] - filter) / strides[i] + 1);
+        }
+        auto out = tensor<float>{out_lens};
+        in.generate(tensor_elem_gen_integer{17});
+        wei.generate(tensor_elem_gen_integer{17});
+        out.generate(tensor_elem_gen_integer{17});
+
+        const auto time = [&](const std::string& name, auto f) {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const auto end = std::chrono::steady_clock::now();
+            std::cout << "    " << std::setw(16) << std::left << name << std::right
+                      << std::chrono::duration<double, std::milli>{end - start}.count() << " ms"
+                      << std::endl;
+        };
+
+        using Tacc = double;
+        time("fwd gemm", [&] {
+            cpu_convolution_forward_gemm<2, Tacc>(in, wei, out, pads, strides, dilations, groups);
+        });
+        time("bwd gemm", [&] {
+            cpu_convolution_backward_data_gemm<2, Tacc>(
+                in, wei, out, pads, strides, dilations, groups);
+        });
+        time("wrw gemm", [&] {
+            cpu_convolution_backward_weight_gemm<2, Tacc>(
+                in, wei, out, pads, strides, dilations, groups);
+        });
+        if(!with_direct)
+            return;
+        time("fwd direct", [&] {
+            cpu_convolution_forward_direct<2, Tacc>(in, wei, out, pads, strides, dilations, groups);
+        });
+        time("bwd direct", [&] {
+            cpu_convolution_backward_data_direct<2, Tacc>(
+                in, wei, out, pads, strides, dilations, groups);
+        });
+        time("wrw direct", [&] {
+            cpu_convolution_backward_weight_direct<2, Tacc>(
+                in, wei, out, pads, strides, dilations, groups);
+        });
+    }
+};
+
+} // namespace cpu_conv
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::cpu_conv::CpuConvSpeedTestDriver>(argc, argv);
+    return 0;
+}
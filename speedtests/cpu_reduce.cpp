@@ -0,0 +1,154 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <cpu_reduce.hpp>
+#include <driver.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace cpu_reduce {
+
+/// Run time of the host reduction used by MIOpenDriver -V 1 and the reduction tests, on a packed
+/// N, C, ... fp32 tensor reduced over the spatial dimensions, C, N, all but C and all of them.
+/// The element by element reference is only timed with --direct.
+struct CpuReduceSpeedTestDriver : public test_driver
+{
+    CpuReduceSpeedTestDriver()
+    {
+        add(lengths, "lengths");
+        add(direct, "direct", flag());
+    }
+
+    void run()
+    {
+        const auto lens = std::vector<std::size_t>(lengths.begin(), lengths.end());
+
+        std::vector<std::size_t> spatial(lens.size() - 2);
+        std::iota(spatial.begin(), spatial.end(), 2);
+        std::vector<std::size_t> all(lens.size());
+        std::iota(all.begin(), all.end(), 0);
+        auto all_but_c = all;
+        all_but_c.erase(all_but_c.begin() + 1);
+
+        auto in = std::vector<float>(Size(lens));
+        for(std::size_t i = 0; i < in.size(); ++i)
+            in[i] = static_cast<float>(i % 17) - 8.f;
+
+        for(const auto& dims : {spatial, {1}, {0}, all_but_c, all})
+            Measure(lens, dims, in);
+    }
+
+private:
+    std::vector<int> lengths = {4, 64, 28, 28};
+    bool direct              = false;
+
+    static std::size_t Size(const std::vector<std::size_t>& lens)
+    {
+        return std::accumulate(lens.begin(), lens.end(), std::size_t{1}, std::multiplies<>{});
+    }
+
+    static std::vector<std::size_t> Packed(const std::vector<std::size_t>& lens)
+    {
+        std::vector<std::size_t> strides(lens.size());
+        std::size_t stride = 1;
+        for(auto d = lens.size(); d-- > 0;)
+        {
+            strides[d] = stride;
+            stride *= lens[d];
+        }
+        return strides;
+    }
+
+    void Measure(const std::vector<std::size_t>& lens,
+                 const std::vector<std::size_t>& dims,
+                 const std::vector<float>& in) const
+    {
+        auto out_lens = lens;
+        for(auto d : dims)
+            out_lens[d] = 1;
+        const auto in_strides  = Packed(lens);
+        const auto out_strides = Packed(out_lens);
+
+        std::ostringstream ss;
+        for(auto d : dims)
+            ss << d << ' ';
+        std::cout << "Reduce dims " << ss.str() << std::endl;
+
+        auto out     = std::vector<float>(Size(out_lens));
+        auto indices = std::vector<int>(out.size());
+
+        const auto time = [&](const std::string& name, auto f) {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const auto end = std::chrono::steady_clock::now();
+            std::cout << "    " << std::setw(16) << std::left << name << std::right
+                      << std::chrono::duration<double, std::milli>{end - start}.count() << " ms"
+                      << std::endl;
+        };
+
+        const auto run = [&](auto reduce, miopenReduceTensorOp_t op, int* idx) {
+            reduce(lens,
+                   in_strides,
+                   out_lens,
+                   out_strides,
+                   op,
+                   MIOPEN_NOT_PROPAGATE_NAN,
+                   1.0f,
+                   in.data(),
+                   0.0f,
+                   out.data(),
+                   idx);
+        };
+
+        const auto engine = [](auto&&... xs) { reduce::cpu_reduce<float>(xs...); };
+        const auto naive  = [](auto&&... xs) { reduce::cpu_reduce_direct<float>(xs...); };
+
+        time("add", [&] { run(engine, MIOPEN_REDUCE_TENSOR_ADD, nullptr); });
+        time("norm2", [&] { run(engine, MIOPEN_REDUCE_TENSOR_NORM2, nullptr); });
+        time("max indices", [&] { run(engine, MIOPEN_REDUCE_TENSOR_MAX, indices.data()); });
+        if(!direct)
+            return;
+        time("add direct", [&] { run(naive, MIOPEN_REDUCE_TENSOR_ADD, nullptr); });
+        time("norm2 direct", [&] { run(naive, MIOPEN_REDUCE_TENSOR_NORM2, nullptr); });
+        time("max direct", [&] { run(naive, MIOPEN_REDUCE_TENSOR_MAX, indices.data()); });
+    }
+};
+
+} // namespace cpu_reduce
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::cpu_reduce::CpuReduceSpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/search_options.hpp>
+#include <miopen/solution.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace find_batch {
+
+using Layer = std::map<std::string, std::string>;
+
+/// Reads the long options of a MIOpenDriver conv command, returns false for other lines
+bool ParseLayer(const std::string& line, Layer& layer)
+{
+    auto stream = std::istringstream{line};
+    auto token  = std::string{};
+
+    while(stream >> token)
+    {
+        if(token == "conv" || token == "convfp16" || token == "convbfp16")
+            break;
+    }
+    if(!stream)
+        return false;
+    layer["command"] = token;
+
+    auto value = std::string{};
+    while(stream >> token >> value)
+    {
+        if(token.size() > 2 && token.compare(0, 2, "--") == 0)
+            layer[token.substr(2)] = value;
+    }
+    return true;
+}
+
+int Get(const Layer& layer, const std::string& name, int fallback)
+{
+    const auto it = layer.find(name);
+    return it == layer.end() ? fallback : std::stoi(it->second);
+}
+
+/// Appends the 2D NCHW problems of the layer in the directions requested by --forw, other
+/// layers are skipped
+void MakeProblems(const Layer& layer, std::vector<Problem>& problems)
+{
+    const auto is_default = [&](const std::string& name, const std::string& value) {
+        const auto it = layer.find(name);
+        return it == layer.end() || it->second == value;
+    };
+    if(Get(layer, "spatial_dim", 2) != 2 || !is_default("mode", "conv") ||
+       !is_default("in_layout", "NCHW") || !is_default("fil_layout", "NCHW") ||
+       !is_default("out_layout", "NCHW"))
+        return;
+
+    const auto& command  = layer.at("command");
+    const auto type      = command == "convfp16"    ? miopenHalf
+                           : command == "convbfp16" ? miopenBFloat16
+                                                    : miopenFloat;
+    const auto groups    = Get(layer, "group_count", 1);
+    const auto n         = Get(layer, "batchsize", 100);
+    const auto c         = Get(layer, "in_channels", 3);
+    const auto k         = Get(layer, "out_channels", 32);
+    const auto x = TensorDescriptor{type, {n, c, Get(layer, "in_h", 32), Get(layer, "in_w", 32)}};
+    const auto w =
+        TensorDescriptor{type, {k, c / groups, Get(layer, "fil_h", 3), Get(layer, "fil_w", 3)}};
+    const auto conv_desc = ConvolutionDescriptor{
+        {Get(layer, "pad_h", 0), Get(layer, "pad_w", 0)},
+        {Get(layer, "conv_stride_h", 1), Get(layer, "conv_stride_w", 1)},
+        {Get(layer, "dilation_h", 1), Get(layer, "dilation_w", 1)},
+        {0, 0},
+        groups};
+    const auto y = conv_desc.GetForwardOutputTensor(x, w, type);
+
+    const auto forw = Get(layer, "forw", 0);
+    const auto add  = [&](int bit, miopenProblemDirection_t direction) {
+        if(forw != 0 && (forw & bit) == 0)
+            return;
+        auto problem = Problem{};
+        problem.SetOperatorDescriptor(conv_desc);
+        problem.SetDirection(direction);
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionX, x);
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionW, w);
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionY, y);
+        problems.push_back(std::move(problem));
+    };
+    add(1, miopenProblemDirectionForward);
+    add(2, miopenProblemDirectionBackward);
+    add(4, miopenProblemDirectionBackwardWeights);
+}
+
+/// Find of all the layers of a network one problem at a time and as a single batch. The
+/// kernel cache and the find-db are disabled in main(), and each mode uses its own handle, so
+/// neither mode reuses what the other one has compiled.
+struct FindBatchSpeedTestDriver : public test_driver
+{
+    FindBatchSpeedTestDriver()
+    {
+        add(models, "models");
+        add(mode, "mode");
+    }
+
+    void run()
+    {
+        if(models.empty())
+        {
+            show_help();
+            return;
+        }
+
+        auto problems = std::vector<Problem>{};
+        auto file     = std::ifstream{models};
+        auto line     = std::string{};
+        auto layer    = Layer{};
+        while(std::getline(file, line))
+        {
+            layer.clear();
+            if(ParseLayer(line, layer))
+                MakeProblems(layer, problems);
+        }
+        std::cout << models << ": " << problems.size() << " problems" << std::endl;
+
+        auto pointers = std::vector<const Problem*>{};
+        pointers.reserve(problems.size());
+        for(const auto& problem : problems)
+            pointers.push_back(&problem);
+
+        const auto options = FindOptions{};
+
+        if(mode == "all" || mode == "per-problem")
+        {
+            Test("per-problem", [&](Handle& handle) {
+                for(const auto& problem : problems)
+                    problem.FindSolutions(handle, options, 1);
+            });
+        }
+
+        if(mode == "all" || mode == "batch")
+        {
+            Test("batch", [&](Handle& handle) {
+                Problem::FindSolutions(handle, pointers, options, 1);
+            });
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Models is a list of MIOpenDriver conv commands, e.g. one of "
+                     "test/perf_models. Mode is all, per-problem or batch."
+                  << std::endl;
+    }
+
+private:
+    std::string models;
+    std::string mode = "all";
+
+    template <class TFind>
+    static void Test(const std::string& name, TFind&& find)
+    {
+        auto handle      = Handle{};
+        const auto start = std::chrono::steady_clock::now();
+        find(handle);
+        const auto time = std::chrono::steady_clock::now() - start;
+        const auto ms   = std::chrono::duration_cast<std::chrono::milliseconds>(time).count();
+        std::cout << name << ": " << ms << " ms" << std::endl;
+    }
+};
+
+} // namespace find_batch
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    // Every Find compiles its kernels, see FindBatchSpeedTestDriver
+    setenv("MIOPEN_DISABLE_CACHE", "1", 1);         // NOLINT (concurrency-mt-unsafe)
+    setenv("MIOPEN_DEBUG_DISABLE_FIND_DB", "1", 1); // NOLINT (concurrency-mt-unsafe)
+    test_drive<miopen::find_batch::FindBatchSpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/kernel.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/write_file.hpp>
+
+#if MIOPEN_BACKEND_HIP
+#include <miopen/hip_build_utils.hpp>
+#endif
+
+#include <driver.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace hip_build {
+
+// Stands in for the compiler: creates the file given after -o
+constexpr auto fake_compiler = R"(#!/bin/sh
+while [ $# -gt 0 ]; do
+    if [ "$1" = "-o" ]; then : > "$2"; fi
+    shift
+done
+)";
+
+struct HipBuildSpeedTestDriver : public test_driver
+{
+    HipBuildSpeedTestDriver()
+    {
+        add(builds, "builds");
+        add(threads, "threads");
+    }
+
+    void run()
+    {
+#if MIOPEN_BACKEND_HIP
+        const auto compiler_dir = TmpDir{"fake_compiler"};
+        const auto compiler     = (compiler_dir.path / "hipcc").string();
+        {
+            std::ofstream file{compiler};
+            file << fake_compiler;
+        }
+        boost::filesystem::permissions(compiler,
+                                       boost::filesystem::owner_all |
+                                           boost::filesystem::group_read |
+                                           boost::filesystem::group_exe);
+
+        const auto inc_list = GetHipKernelIncList();
+        std::cout << "Builds: " << builds << ", threads: " << threads
+                  << ", include files: " << inc_list.size() << std::endl;
+
+        Test("Per-build includes, shell", [&](const TmpDir& tmp_dir) {
+            for(const auto& inc_file : inc_list)
+                WriteFile(GetKernelInc(inc_file), tmp_dir.path / inc_file);
+            SystemCmd("cd " + tmp_dir.path.string() + "; " + compiler +
+                      " -I. kernel.cpp -o kernel.cpp.o 1>/dev/null 2>&1");
+        });
+
+        Test("Shared includes, spawn   ", [&](const TmpDir& tmp_dir) {
+            tmp_dir.Execute(compiler,
+                            "-I. -I" + GetHipKernelIncDir().string() +
+                                " kernel.cpp -o kernel.cpp.o",
+                            true);
+        });
+#else
+        std::cout << "HIP backend is required" << std::endl;
+#endif
+    }
+
+private:
+    int builds  = 256;
+    int threads = 16;
+
+    template <class F>
+    void Test(const std::string& name, F build) const
+    {
+        std::atomic<int> next{0};
+        std::vector<std::thread> workers;
+
+        const auto begin = std::chrono::steady_clock::now();
+        for(auto t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&]() {
+                while(next++ < builds)
+                {
+                    const auto tmp_dir = TmpDir{"hip_build"};
+                    WriteFile(std::string{"int main() {}\n"}, tmp_dir.path / "kernel.cpp");
+                    build(tmp_dir);
+                    if(!boost::filesystem::exists(tmp_dir.path / "kernel.cpp.o"))
+                        std::abort();
+                }
+            });
+        }
+        for(auto& worker : workers)
+            worker.join();
+        const auto time = std::chrono::steady_clock::now() - begin;
+
+        const auto ms = std::chrono::duration_cast<std::chrono::microseconds>(time).count() * .001;
+        std::cout << name << ": " << std::setw(10) << ms << " ms, " << ms / builds
+                  << " ms per build" << std::endl;
+    }
+};
+
+} // namespace hip_build
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::hip_build::HipBuildSpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/invoker_cache.hpp>
+
+#include <driver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace invoker_cache {
+
+struct InvokerCacheSpeedTestDriver : public test_driver
+{
+    InvokerCacheSpeedTestDriver()
+    {
+        add(configs, "configs");
+        add(solvers, "solvers");
+        add(lookups, "lookups");
+        add(max_threads, "max-threads");
+    }
+
+    void run()
+    {
+        InvokerCache cache;
+        std::vector<InvokerCache::Key> keys;
+        keys.reserve(configs * solvers);
+
+        // Network configs are long strings with a common prefix, like the ones of convolutions
+        for(auto i = 0; i < configs; ++i)
+        {
+            const auto config = "64-56-56-3x3-64-56-56-1-1x1-1x1-1x1-0-NCHW-FP32-F-" +
+                                std::to_string(i) + "-" + std::to_string(i * 7919);
+            for(auto j = 0; j < solvers; ++j)
+            {
+                keys.emplace_back(NetworkConfig{config}, "ConvSolver" + std::to_string(j));
+                cache.Register(keys.back(), [](const Handle&, const AnyInvokeParams&) {});
+            }
+        }
+
+        std::cout << "Keys: " << keys.size() << ", lookups per thread: " << lookups << std::endl;
+
+        for(auto threads = 1; threads <= max_threads; threads *= 2)
+            Test(cache, keys, threads);
+    }
+
+private:
+    int configs     = 64;
+    int solvers     = 8;
+    int lookups     = 1000000;
+    int max_threads = 16;
+
+    void Test(const InvokerCache& cache,
+              const std::vector<InvokerCache::Key>& keys,
+              int threads) const
+    {
+        std::atomic<bool> start{false};
+        std::atomic<std::size_t> misses{0};
+        std::vector<std::thread> workers;
+
+        for(auto t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                while(!start)
+                    std::this_thread::yield();
+                auto index = static_cast<std::size_t>(t) * 7;
+                for(auto i = 0; i < lookups; ++i)
+                {
+                    if(!cache[keys[index]])
+                        ++misses;
+                    index = (index + 13) % keys.size();
+                }
+            });
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        start            = true;
+        for(auto& worker : workers)
+            worker.join();
+        const auto time = std::chrono::steady_clock::now() - begin;
+
+        if(misses != 0)
+            std::abort();
+
+        const auto ms = std::chrono::duration_cast<std::chrono::microseconds>(time).count() * .001;
+        std::cout << "Threads: " << std::setw(3) << threads << ", time: " << ms
+                  << " ms, lookups: " << threads * static_cast<double>(lookups) / (ms * 1000.)
+                  << " M/s" << std::endl;
+    }
+};
+
+} // namespace invoker_cache
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::invoker_cache::InvokerCacheSpeedTestDriver>(argc, argv);
+    return 0;
+}
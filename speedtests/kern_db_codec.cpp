@@ -0,0 +1,226 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/binary_cache.hpp>
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+#include <miopen/bz2.hpp>
+#include <miopen/kern_db.hpp>
+#include <miopen/lz.hpp>
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <driver.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace kern_db_codec {
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+struct Codec
+{
+    std::string name;
+    std::function<std::string(std::string, bool*)> compress;
+    std::function<std::string(std::string, unsigned int)> decompress;
+};
+
+struct KernDbCodecSpeedTestDriver : public test_driver
+{
+    KernDbCodecSpeedTestDriver()
+    {
+        add(corpus, "corpus");
+        add(iterations, "iterations");
+    }
+
+    void run()
+    {
+        const auto path = corpus.empty() ? GetCachePath(false) : boost::filesystem::path{corpus};
+        std::vector<std::string> blobs;
+        Collect(path, blobs);
+
+        std::size_t total = 0;
+        for(const auto& blob : blobs)
+            total += blob.size();
+        std::cout << "Corpus: " << path << ", blobs: " << blobs.size() << ", size: " << total
+                  << " bytes, iterations: " << iterations << std::endl;
+        if(blobs.empty())
+            return;
+
+        Test(blobs, {"bz2", miopen::compress, miopen::decompress});
+        Test(blobs, {"lz", lz::compress, lz::decompress});
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Corpus is a directory of code objects (*.o, *.co, *.hsaco) and kernel "
+                     "cache databases (*.kdb, *.ukdb) or one such file. The user kernel cache "
+                     "directory is used by default."
+                  << std::endl;
+    }
+
+private:
+    std::string corpus;
+    int iterations = 3;
+
+    static std::string ReadFile(const boost::filesystem::path& path)
+    {
+        auto file = std::ifstream{path.string(), std::ios::binary};
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    static void ReadKernDb(const boost::filesystem::path& path, std::vector<std::string>& blobs)
+    {
+        const auto sql    = SQLite{path.string(), true};
+        const auto fields = sql.Exec("PRAGMA table_info(" + KernelConfig::table_name() + ");");
+        const auto has_codec = std::any_of(
+            fields.begin(), fields.end(), [](auto row) { return row["name"] == "codec"; });
+
+        auto stmt = SQLite::Statement{
+            sql,
+            std::string{"SELECT kernel_blob, uncompressed_size, "} + (has_codec ? "codec" : "0") +
+                " FROM " + KernelConfig::table_name() + ";"};
+        while(stmt.Step(sql) == SQLITE_ROW)
+        {
+            auto blob        = stmt.ColumnBlob(0);
+            const auto size  = static_cast<unsigned int>(stmt.ColumnInt64(1));
+            const auto codec = static_cast<KernelCodec>(stmt.ColumnInt64(2));
+            if(size == 0)
+                blobs.push_back(std::move(blob));
+            else if(codec == KernelCodec::Bzip2)
+                blobs.push_back(miopen::decompress(blob, size));
+            else if(codec == KernelCodec::Lz)
+                blobs.push_back(lz::decompress(blob, size));
+        }
+    }
+
+    static void Collect(const boost::filesystem::path& path, std::vector<std::string>& blobs)
+    {
+        if(boost::filesystem::is_directory(path))
+        {
+            for(const auto& entry : boost::filesystem::recursive_directory_iterator{path})
+                if(boost::filesystem::is_regular_file(entry.path()))
+                    Collect(entry.path(), blobs);
+            return;
+        }
+
+        const auto ext = path.extension().string();
+        if(ext == ".o" || ext == ".co" || ext == ".hsaco")
+        {
+            auto blob = ReadFile(path);
+            if(!blob.empty())
+                blobs.push_back(std::move(blob));
+        }
+        else if(ext == ".kdb" || ext == ".ukdb")
+        {
+            ReadKernDb(path, blobs);
+        }
+    }
+
+    template <class TFunc>
+    static double Measure(TFunc&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto time = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration_cast<std::chrono::microseconds>(time).count() * .001;
+    }
+
+    void Test(const std::vector<std::string>& blobs, const Codec& codec) const
+    {
+        std::size_t original_size   = 0;
+        std::size_t compressed_size = 0;
+        std::vector<std::string> compressed(blobs.size());
+        std::vector<bool> is_compressed(blobs.size());
+
+        auto compress_time = 0.;
+        for(auto i = 0; i < iterations; ++i)
+        {
+            compress_time += Measure([&]() {
+                for(auto j = std::size_t{0}; j < blobs.size(); ++j)
+                {
+                    bool success     = false;
+                    compressed[j]    = codec.compress(blobs[j], &success);
+                    is_compressed[j] = success;
+                }
+            });
+        }
+
+        for(auto j = std::size_t{0}; j < blobs.size(); ++j)
+        {
+            original_size += blobs[j].size();
+            compressed_size += compressed[j].size();
+        }
+
+        auto decompress_time = 0.;
+        for(auto i = 0; i < iterations; ++i)
+        {
+            decompress_time += Measure([&]() {
+                for(auto j = std::size_t{0}; j < blobs.size(); ++j)
+                {
+                    if(!is_compressed[j])
+                        continue;
+                    if(codec.decompress(compressed[j], blobs[j].size()) != blobs[j])
+                        std::abort();
+                }
+            });
+        }
+
+        const auto mbytes = original_size * iterations / (1024. * 1024.);
+        std::cout << std::setw(6) << codec.name << ": ratio: " << std::setprecision(3)
+                  << static_cast<double>(original_size) / compressed_size
+                  << ", compress: " << mbytes / (compress_time * .001)
+                  << " MB/s, decompress: " << mbytes / (decompress_time * .001) << " MB/s"
+                  << std::endl;
+    }
+};
+#else
+struct KernDbCodecSpeedTestDriver : public test_driver
+{
+    void run() { std::cout << "SQLite kernel cache is disabled in this build" << std::endl; }
+};
+#endif
+
+} // namespace kern_db_codec
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kern_db_codec::KernDbCodecSpeedTestDriver>(argc, argv);
+    return 0;
+}
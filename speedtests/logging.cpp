@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/logger.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace logging {
+
+/// Time per message of the logging calls. The mode is selected by the environment as usual,
+/// e.g. MIOPEN_LOG_LEVEL=5 with and without MIOPEN_LOG_ASYNC, the log is best redirected
+/// to /dev/null.
+struct LoggingSpeedTestDriver : public test_driver
+{
+    LoggingSpeedTestDriver()
+    {
+        add(messages, "messages");
+        add(threads, "threads");
+    }
+
+    void run()
+    {
+        std::cout << "Messages: " << messages << ", threads: " << threads
+                  << ", async: " << IsLoggingAsync() << std::endl;
+        Measure("Info", [](std::size_t i) { MIOPEN_LOG_I("Message " << i << " of the test"); });
+        Measure("Trace", [](std::size_t i) { MIOPEN_LOG_T("Message " << i << " of the test"); });
+    }
+
+    template <class F>
+    void Measure(const std::string& name, F f) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for(std::size_t t = 0; t < threads; ++t)
+            workers.emplace_back([&]() {
+                for(std::size_t i = 0; i < messages; ++i)
+                    f(i);
+            });
+        for(auto& worker : workers)
+            worker.join();
+        const auto logged = std::chrono::steady_clock::now();
+        FlushLog();
+        const auto flushed = std::chrono::steady_clock::now();
+
+        using ns = std::chrono::duration<double, std::nano>;
+        std::cout << std::setw(6) << name << ": " << std::setw(10)
+                  << ns{logged - start}.count() / messages << " ns per message, written in "
+                  << std::chrono::duration<double, std::milli>{flushed - start}.count() << " ms"
+                  << std::endl;
+    }
+
+    std::size_t messages = 100000;
+    std::size_t threads  = 4;
+};
+
+} // namespace logging
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::logging::LoggingSpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/db_record.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+namespace system_db {
+
+struct Key
+{
+    int id;
+
+    void Serialize(std::ostream& stream) const
+    {
+        stream << "3-224-224-3x3-64-224-224-" << id << "-1x1-1x1-1x1-0-NCHW-FP32-F";
+    }
+};
+
+/// Loads the file the way ReadonlyRamDb did before it started to map it: by copying every line
+/// into a map of strings.
+class CopyingRamDb
+{
+public:
+    CopyingRamDb(const std::string& path)
+    {
+        auto file = std::ifstream{path};
+        auto line = std::string{};
+
+        while(std::getline(file, line))
+        {
+            const auto key_size = line.find('=');
+            if(key_size == std::string::npos || key_size == 0)
+                continue;
+            cache.emplace(line.substr(0, key_size), line.substr(key_size + 1));
+        }
+    }
+
+    bool Has(const std::string& key) const { return cache.find(key) != cache.end(); }
+
+private:
+    std::unordered_map<std::string, std::string> cache;
+};
+
+struct SystemDbSpeedTestDriver : public test_driver
+{
+    SystemDbSpeedTestDriver()
+    {
+        add(records, "records", generate_data({10000, 100000, 1000000}));
+        add(db_class, "db");
+    }
+
+    void run()
+    {
+        const auto temp_file = TempFile{"miopen.speedtests.system_db"};
+        Fill(temp_file);
+
+        std::cout << "Records: " << records << std::endl;
+
+        // Memory freed by one implementation may be reused by the other one. Run them one by one
+        // with --db for precise memory usage figures.
+        if(db_class == "all" || db_class == "copying")
+            Test("copying", [&]() {
+                const auto db = std::make_shared<CopyingRamDb>(temp_file);
+                return [db](const std::string& key) { return db->Has(key); };
+            });
+
+        if(db_class == "all" || db_class == "mapped")
+            Test("mapped", [&]() {
+                const auto& db = ReadonlyRamDb::GetCached(temp_file, true);
+                return [&db](const std::string& key) { return db.FindRecord(key).has_value(); };
+            });
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Permitted dbs: all, copying, mapped" << std::endl;
+    }
+
+private:
+    int records          = 10000;
+    std::string db_class = "all";
+
+    void Fill(const std::string& path) const
+    {
+        auto file = std::ofstream{path};
+        for(auto i = 0; i < records; ++i)
+        {
+            Key{i}.Serialize(file);
+            file << "=ConvOclDirectFwd:" << i << ",16,1,64,2,2,1,4;ConvBinWinograd3x3U:" << i
+                 << ",0,1,1" << std::endl;
+        }
+    }
+
+    /// Returns the private (non-shared) resident memory of the process in KiB.
+    static long PrivateMemory()
+    {
+        auto statm = std::ifstream{"/proc/self/statm"};
+        long size     = 0;
+        long resident = 0;
+        long shared   = 0;
+        if(!(statm >> size >> resident >> shared))
+            return -1;
+        return (resident - shared) * 4;
+    }
+
+    template <class TLoader>
+    void Test(const std::string& name, TLoader&& loader) const
+    {
+        const auto memory_before = PrivateMemory();
+        const auto start         = std::chrono::steady_clock::now();
+        const auto has           = loader();
+        const auto loaded        = std::chrono::steady_clock::now();
+        const auto memory_after  = PrivateMemory();
+
+        // Check that the data is really there.
+        if(!has(DbRecord{Key{records - 1}}.GetKey()))
+            std::abort();
+
+        const auto time =
+            std::chrono::duration_cast<std::chrono::microseconds>(loaded - start).count() * .001;
+
+        std::cout << std::setw(8) << name << ": load: " << time
+                  << " ms, private memory: " << (memory_after - memory_before) << " KiB"
+                  << std::endl;
+    }
+};
+
+} // namespace system_db
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::system_db::SystemDbSpeedTestDriver>(argc, argv);
+    return 0;
+}
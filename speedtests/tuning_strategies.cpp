@@ -0,0 +1,219 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_strategy.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tuning_strategies {
+
+/// Stands in for the GPU: a smooth bowl around a random optimum with some noise and failures.
+/// An evaluation costs the runs requested, and a compilation unless the config has been
+/// evaluated before, as the binaries are in the kernel cache then.
+class MockTimings
+{
+public:
+    MockTimings(std::size_t params_, std::size_t values_, std::uint32_t seed_)
+        : params(params_), values(values_), seed(seed_)
+    {
+        for(std::size_t i = 0; i < params; ++i)
+            optimum.push_back(Hash(i) % values);
+    }
+
+    solver::SearchSpace MakeSpace() const
+    {
+        auto configs = std::vector<std::string>{};
+        for(std::size_t index = 0; index < Size(); ++index)
+        {
+            auto config = std::string{};
+            for(const auto value : Values(index))
+                config += (config.empty() ? "" : ",") + std::to_string(value);
+            configs.push_back(config);
+        }
+        return {std::move(configs), std::size_t{0}};
+    }
+
+    std::size_t Size() const { return static_cast<std::size_t>(std::pow(values, params)); }
+
+    float Time(std::size_t index, std::size_t run) const
+    {
+        if(Hash(index) % 17 == 0)
+            return std::numeric_limits<float>::max();
+        const auto config = Values(index);
+        auto time         = 1.0f;
+        for(std::size_t i = 0; i < params; ++i)
+        {
+            const auto distance = static_cast<float>(config[i]) - optimum[i];
+            time += 0.05f * distance * distance;
+        }
+        // Steady per-config deviation plus the jitter of a single run
+        time *= 1.0f + 0.02f * (Hash(index) % 100) / 100.0f;
+        time *= 1.0f + 0.05f * (Hash(index * 31 + run + 1) % 100) / 100.0f;
+        return time;
+    }
+
+    /// Mean time of a config, what the search should minimize
+    float TrueTime(std::size_t index) const
+    {
+        auto sum = 0.0f;
+        for(std::size_t run = 0; run < 100; ++run)
+            sum += Time(index, run);
+        return sum / 100;
+    }
+
+private:
+    std::size_t params;
+    std::size_t values;
+    std::uint32_t seed;
+    std::vector<std::size_t> optimum;
+
+    std::uint64_t Hash(std::uint64_t value) const
+    {
+        value = (value ^ seed) * 0x9E3779B97F4A7C15ull;
+        value ^= value >> 29;
+        value *= 0xBF58476D1CE4E5B9ull;
+        return value ^ (value >> 32);
+    }
+
+    std::vector<std::size_t> Values(std::size_t index) const
+    {
+        auto config = std::vector<std::size_t>{};
+        for(std::size_t i = 0; i < params; ++i, index /= values)
+            config.push_back(index % values);
+        return config;
+    }
+};
+
+struct TuningStrategiesSpeedTestDriver : public test_driver
+{
+    TuningStrategiesSpeedTestDriver()
+    {
+        add(params, "params");
+        add(values, "values");
+        add(max_configs, "max-configs");
+        add(compile_cost, "compile-cost");
+        add(seeds, "seeds");
+    }
+
+    void run()
+    {
+        std::cout << "Params: " << params << ", values: " << values
+                  << ", max configs: " << max_configs << ", compile cost: " << compile_cost
+                  << " runs" << std::endl;
+
+        Run("exhaustive", solver::SearchStrategyKind::Exhaustive);
+        Run("halving", solver::SearchStrategyKind::SuccessiveHalving);
+        Run("random", solver::SearchStrategyKind::Random);
+        Run("local", solver::SearchStrategyKind::Local);
+    }
+
+    void Run(const std::string& name, solver::SearchStrategyKind kind) const
+    {
+        auto evaluations = 0.0;
+        auto cost        = 0.0;
+        auto ratio       = 0.0;
+        auto ms          = 0.0;
+
+        for(std::size_t seed = 0; seed < seeds; ++seed)
+        {
+            const auto timings = MockTimings{params, values, static_cast<std::uint32_t>(seed)};
+            const auto space   = timings.MakeSpace();
+
+            auto optimum = std::numeric_limits<float>::max();
+            for(std::size_t index = 0; index < space.Size(); ++index)
+                optimum = std::min(optimum, timings.TrueTime(index));
+
+            const auto start = std::chrono::steady_clock::now();
+            const auto strategy = solver::MakeSearchStrategy(
+                kind, space, max_configs, static_cast<std::uint32_t>(seed));
+            auto compiled  = std::vector<bool>(space.Size(), false);
+            auto best      = std::numeric_limits<float>::max();
+            auto best_true = std::numeric_limits<float>::max();
+            auto batch     = strategy->NextBatch();
+            while(!batch.empty())
+            {
+                for(const auto& request : batch)
+                {
+                    // The precise measurement of GenericSearch takes up to 5 runs
+                    const auto runs = request.runs == 0 ? 5 : request.runs;
+                    auto time       = timings.Time(request.index, 0);
+                    if(time != std::numeric_limits<float>::max())
+                    {
+                        for(std::size_t run = 1; run < runs; ++run)
+                            time += timings.Time(request.index, run);
+                        time /= runs;
+                    }
+
+                    evaluations += 1;
+                    cost += runs + (compiled[request.index] ? 0 : compile_cost);
+                    compiled[request.index] = true;
+                    if(request.runs == 0 && time < best)
+                    {
+                        best      = time;
+                        best_true = timings.TrueTime(request.index);
+                    }
+                    strategy->Report(request, time);
+                }
+                batch = strategy->NextBatch();
+            }
+            ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                            start)
+                      .count();
+            ratio += best_true / optimum;
+        }
+
+        std::cout << std::setw(10) << name << ": evaluations: " << std::setw(8)
+                  << evaluations / seeds << ", cost: " << std::setw(10) << cost / seeds
+                  << ", best/optimum: " << std::setw(8) << ratio / seeds
+                  << ", overhead: " << ms / seeds << " ms" << std::endl;
+    }
+
+    std::size_t params       = 4;
+    std::size_t values       = 8;
+    std::size_t max_configs  = 10000;
+    std::size_t compile_cost = 20;
+    std::size_t seeds        = 10;
+};
+
+} // namespace tuning_strategies
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::tuning_strategies::TuningStrategiesSpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,181 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/db.hpp>
+#include <miopen/indexedtextdb.hpp>
+#include <miopen/ramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace user_db {
+
+// Sizes of keys and values resemble the ones of the convolution perf-db records.
+struct Key
+{
+    int id;
+
+    void Serialize(std::ostream& stream) const
+    {
+        stream << "3-224-224-3x3-64-224-224-" << id << "-1x1-1x1-1x1-0-NCHW-FP32-F";
+    }
+};
+
+struct Value
+{
+    int x = 0;
+    int y = 0;
+
+    void Serialize(std::ostream& stream) const { stream << x << ',' << y; }
+
+    bool Deserialize(const std::string& str)
+    {
+        auto ss = std::istringstream{str};
+        char comma;
+        return static_cast<bool>(ss >> x >> comma >> y);
+    }
+};
+
+struct UserDbSpeedTestDriver : public test_driver
+{
+    UserDbSpeedTestDriver()
+    {
+        add(records, "records", generate_data({1000, 10000, 100000}));
+        add(operations, "operations");
+        add(db_class, "db");
+    }
+
+    void run()
+    {
+        std::cout << "Records: " << records << ", operations: " << operations << std::endl;
+
+        if(db_class == "all" || db_class == "db")
+            Test<PlainTextDb>("PlainTextDb");
+        if(db_class == "all" || db_class == "ramdb")
+            Test<RamDb>("RamDb");
+        if(db_class == "all" || db_class == "indexeddb")
+            Test<IndexedTextDb>("IndexedTextDb");
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Permitted dbs: all, db, ramdb, indexeddb" << std::endl;
+    }
+
+private:
+    int records          = 1000;
+    int operations       = 100;
+    std::string db_class = "all";
+
+    void Fill(const std::string& path) const
+    {
+        auto file = std::ofstream{path};
+        for(auto i = 0; i < records; ++i)
+        {
+            Key{i}.Serialize(file);
+            file << "=ConvOclDirectFwd:";
+            Value{i, i}.Serialize(file);
+            file << ";ConvBinWinograd3x3U:";
+            Value{i, 0}.Serialize(file);
+            file << std::endl;
+        }
+    }
+
+    template <class TFunc>
+    static double Measure(TFunc&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto time = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration_cast<std::chrono::microseconds>(time).count() * .001;
+    }
+
+    template <class TDb>
+    void Test(const std::string& name) const
+    {
+        const auto temp_file = TempFile{"miopen.speedtests.user_db"};
+        Fill(temp_file);
+
+        auto rng  = std::mt19937{};
+        auto dist = std::uniform_int_distribution<int>{0, records - 1};
+        auto db   = TDb{temp_file};
+
+        // Includes building of the cache or index for the classes which have it.
+        const auto first = Measure([&]() {
+            auto value = Value{};
+            if(!db.Load(Key{0}, "ConvOclDirectFwd", value))
+                std::abort();
+        });
+
+        const auto finds = Measure([&]() {
+            for(auto i = 0; i < operations; ++i)
+            {
+                const auto id = dist(rng);
+                auto value    = Value{};
+                if(!db.Load(Key{id}, "ConvOclDirectFwd", value) || value.x != id)
+                    std::abort();
+            }
+        });
+
+        // Values grow in size, so records can't be simply rewritten in place.
+        const auto updates = Measure([&]() {
+            for(auto i = 0; i < operations; ++i)
+            {
+                const auto id = dist(rng);
+                if(!db.Update(Key{id}, "ConvOclDirectFwd", Value{id, 1000000 + i}))
+                    std::abort();
+            }
+        });
+
+        std::cout << std::setw(16) << name << ": first find: " << first
+                  << " ms, find: " << finds / operations
+                  << " ms, update: " << updates / operations << " ms, file size: "
+                  << boost::filesystem::file_size(temp_file.Path()) << std::endl;
+    }
+};
+
+} // namespace user_db
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::user_db::UserDbSpeedTestDriver>(argc, argv);
+    return 0;
+}
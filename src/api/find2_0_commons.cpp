@@ -165,6 +165,49 @@ miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
     });
 }
 
+miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                        size_t nProblems,
+                                        const miopenProblem_t* problems,
+                                        miopenFindOptions_t options,
+                                        miopenSolution_t* solutions,
+                                        size_t* numSolutions,
+                                        size_t maxSolutions)
+{
+    MIOPEN_LOG_FUNCTION(handle, nProblems, problems, options, solutions, numSolutions, maxSolutions);
+
+    return miopen::try_([&] {
+        auto& handle_deref = miopen::deref(handle);
+
+        if(nProblems != 0 && problems == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Problems parameter should not be a nullptr.");
+
+        auto problems_deref = std::vector<const miopen::Problem*>{};
+        problems_deref.reserve(nProblems);
+        for(std::size_t i = 0; i < nProblems; ++i)
+        {
+            const auto& problem_deref = miopen::deref(problems[i]);
+            problem_deref.LogDriverCommand();
+            problems_deref.push_back(&problem_deref);
+        }
+
+        const auto& options_deref =
+            options == nullptr ? miopen::FindOptions{} : miopen::deref(options);
+
+        auto solutions_deref = miopen::Problem::FindSolutions(
+            handle_deref, problems_deref, options_deref, maxSolutions);
+
+        for(std::size_t i = 0; i < solutions_deref.size(); ++i)
+        {
+            for(std::size_t j = 0; j < solutions_deref[i].size(); ++j)
+                miopen::deref(solutions + i * maxSolutions + j) =
+                    new miopen::Solution{std::move(solutions_deref[i][j])};
+
+            if(numSolutions != nullptr)
+                numSolutions[i] = solutions_deref[i].size();
+        }
+    });
+}
+
 inline std::ostream& operator<<(std::ostream& stream, const miopenTensorArgument_t& tensor)
 {
     switch(tensor.id)
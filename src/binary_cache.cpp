@@ -40,14 +40,152 @@
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
+#include <miopen/trace.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <ctime>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CUSTOM_CACHE_DIR)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CACHE_SIZE_LIMIT)
+
+namespace {
+struct CacheCounters
+{
+    std::atomic<std::size_t> hits{0};
+    std::atomic<std::size_t> misses{0};
+    std::atomic<std::size_t> evictions{0};
+    /// Bytes saved since the size of the cache has been checked
+    std::atomic<std::uint64_t> unchecked{0};
+    std::atomic<bool> checked{false};
+};
+
+CacheCounters& Counters()
+{
+    static CacheCounters counters;
+    return counters;
+}
+
+/// The size of the cache is checked at the first save of the process, and then after about
+/// a tenth of the limit has been saved, so the cache may exceed the limit only by that much.
+bool IsSizeCheckDue(std::uint64_t saved)
+{
+    const auto limit = GetCacheSizeLimit();
+    if(limit == 0)
+        return false;
+    auto& counters = Counters();
+    if(counters.checked.exchange(true) && counters.unchecked.fetch_add(saved) + saved < limit / 10)
+        return false;
+    counters.unchecked = 0;
+    return true;
+}
+
+/// The cache is shrunk below the limit, so the eviction does not run at every save.
+std::uint64_t ShrinkTarget(std::uint64_t limit) { return limit - limit / 10; }
+
+struct CacheFile
+{
+    boost::filesystem::path path;
+    std::uint64_t size;
+    std::time_t last_access;
+};
+
+bool IsMd5(const std::string& name)
+{
+    return name.size() == 32 && std::all_of(name.begin(), name.end(), [](unsigned char c) {
+               return std::isxdigit(c) != 0;
+           });
+}
+
+/// The kernel files of the directory cache, see GetCacheFile(). Other files, like the
+/// include directories of the HIP compiler, are not touched.
+std::vector<CacheFile> ListCacheFiles(const boost::filesystem::path& dir)
+{
+    namespace fs = boost::filesystem;
+    std::vector<CacheFile> files;
+    boost::system::error_code ec;
+    if(dir.empty() || !fs::is_directory(dir, ec))
+        return files;
+    for(const auto& subdir : fs::directory_iterator{dir, ec})
+    {
+        if(!fs::is_directory(subdir.path(), ec) || !IsMd5(subdir.path().filename().string()))
+            continue;
+        for(const auto& file : fs::directory_iterator{subdir.path(), ec})
+        {
+            if(file.path().extension() != ".o" || !fs::is_regular_file(file.path(), ec))
+                continue;
+            const auto size = fs::file_size(file.path(), ec);
+            if(ec)
+                continue;
+            files.push_back({file.path(), size, fs::last_write_time(file.path(), ec)});
+        }
+    }
+    return files;
+}
+
+void EnforceDirectorySizeLimit(const boost::filesystem::path& dir)
+{
+    const auto limit = GetCacheSizeLimit();
+    try
+    {
+        const auto files   = ListCacheFiles(dir);
+        std::uint64_t size = 0;
+        for(const auto& file : files)
+            size += file.size;
+        if(size > limit)
+            Counters().evictions += ShrinkCacheDirectory(dir, ShrinkTarget(limit));
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to shrink the kernel cache: " << ex.what());
+    }
+}
+} // namespace
+
+std::uint64_t GetCacheSizeLimit()
+{
+    return static_cast<std::uint64_t>(Value(MIOPEN_CACHE_SIZE_LIMIT{})) * 1024 * 1024;
+}
+
+std::size_t ShrinkCacheDirectory(const boost::filesystem::path& dir, std::uint64_t size)
+{
+    auto files = ListCacheFiles(dir);
+    std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) {
+        return a.last_access > b.last_access;
+    });
+
+    // The most recent kernels are kept while they fit
+    std::uint64_t kept  = 0;
+    std::size_t removed = 0;
+    auto evicting       = false;
+    for(const auto& file : files)
+    {
+        evicting = evicting || kept + file.size > size;
+        if(!evicting)
+        {
+            kept += file.size;
+            continue;
+        }
+        boost::system::error_code ec;
+        if(boost::filesystem::remove(file.path, ec))
+        {
+            ++removed;
+            // Removed only when empty, the directory may be used by another process
+            boost::filesystem::remove(file.path.parent_path(), ec);
+        }
+    }
+
+    if(removed != 0)
+        MIOPEN_LOG_I("Evicted " << removed << " kernels from " << dir);
+    return removed;
+}
 
 static boost::filesystem::path ComputeSysCachePath()
 {
@@ -126,22 +264,50 @@ bool IsCacheDisabled()
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
-KDb GetDb(const TargetProperties& target, size_t num_cu)
+
+static boost::filesystem::path GetUserDbPath(const TargetProperties& target, size_t num_cu)
 {
     static const auto user_dir = ComputeUserCachePath();
-    static const auto sys_dir  = ComputeSysCachePath();
-    boost::filesystem::path user_path =
-        user_dir / (Handle::GetDbBasename(target, num_cu) + ".ukdb");
-    boost::filesystem::path sys_path = sys_dir / (Handle::GetDbBasename(target, num_cu) + ".kdb");
     if(user_dir.empty())
-        user_path = user_dir;
+        return user_dir;
+    return user_dir / (Handle::GetDbBasename(target, num_cu) + ".ukdb");
+}
+
+static KernDb& GetUserDb(const TargetProperties& target, size_t num_cu)
+{
+    return KernDb::GetCached(GetUserDbPath(target, num_cu).string(), false);
+}
+
+static void EnforceSizeLimit(KernDb& db)
+{
+    const auto limit = GetCacheSizeLimit();
+    try
+    {
+        if(db.GetSize() > limit)
+            Counters().evictions += db.Shrink(ShrinkTarget(limit));
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to shrink the kernel cache: " << ex.what());
+    }
+}
+
+static boost::filesystem::path GetSysDbPath(const TargetProperties& target, size_t num_cu)
+{
+    static const auto sys_dir        = ComputeSysCachePath();
+    boost::filesystem::path sys_path = sys_dir / (Handle::GetDbBasename(target, num_cu) + ".kdb");
     if(!boost::filesystem::exists(sys_path))
         sys_path = sys_dir / (target.DbId() + ".kdb");
 #if !MIOPEN_EMBED_DB
     if(!boost::filesystem::exists(sys_path))
         sys_path = boost::filesystem::path{};
 #endif
-    return {sys_path.string(), user_path.string()};
+    return sys_path;
+}
+
+KDb GetDb(const TargetProperties& target, size_t num_cu)
+{
+    return {GetSysDbPath(target, num_cu).string(), GetUserDbPath(target, num_cu).string()};
 }
 #endif
 
@@ -186,15 +352,36 @@ std::string LoadBinary(const TargetProperties& target,
     if(record)
     {
         MIOPEN_LOG_I2("Successfully loaded binary for: " << verbose_name << "; args: " << args);
+        MIOPEN_TRACE_EVENT("kernel_cache", "Hit", verbose_name << ' ' << args);
+        ++Counters().hits;
         return record.get();
     }
     else
     {
         MIOPEN_LOG_I2("Unable to load binary for: " << verbose_name << "; args: " << args);
+        MIOPEN_TRACE_EVENT("kernel_cache", "Miss", verbose_name << ' ' << args);
+        ++Counters().misses;
         return {};
     }
 }
 
+bool HasBinary(const TargetProperties& target,
+               const size_t num_cu,
+               const std::string& name,
+               const std::string& args,
+               bool is_kernel_str)
+{
+    if(miopen::IsCacheDisabled())
+        return false;
+
+    const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
+    const KernelConfig cfg{filename, args, ""};
+    if(GetUserDb(target, num_cu).HasRecord(cfg))
+        return true;
+    const auto sys_path = GetSysDbPath(target, num_cu);
+    return !sys_path.empty() && KernDb::GetCached(sys_path.string(), true).HasRecord(cfg);
+}
+
 void SaveBinary(const std::string& hsaco,
                 const TargetProperties& target,
                 const std::size_t num_cu,
@@ -213,8 +400,68 @@ void SaveBinary(const std::string& hsaco,
     const auto verbose_name = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
     MIOPEN_LOG_I2("Saving binary for: " << verbose_name << "; args: " << args);
     db.StoreRecord(cfg);
+
+    if(IsSizeCheckDue(hsaco.size()) && !MIOPEN_DISABLE_USERDB)
+        EnforceSizeLimit(GetUserDb(target, num_cu));
+}
+
+KernelCacheStats GetKernelCacheStats(const TargetProperties& target, std::size_t num_cu)
+{
+    const auto& counters = Counters();
+    KernelCacheStats stats{counters.hits, counters.misses, 0, counters.evictions};
+    if(!miopen::IsCacheDisabled() && !MIOPEN_DISABLE_USERDB)
+        stats.bytes = GetUserDb(target, num_cu).GetSize();
+    return stats;
+}
+
+void CompactKernelCache(const TargetProperties& target, std::size_t num_cu)
+{
+    if(miopen::IsCacheDisabled() || MIOPEN_DISABLE_USERDB)
+        return;
+    auto& db = GetUserDb(target, num_cu);
+    if(GetCacheSizeLimit() != 0)
+        EnforceSizeLimit(db);
+    db.Vacuum();
+}
+
+KernelCacheBatch::KernelCacheBatch(const TargetProperties& target, std::size_t num_cu)
+{
+    if(miopen::IsCacheDisabled() || MIOPEN_DISABLE_USERDB)
+        return;
+
+    db = &GetUserDb(target, num_cu);
+    db->BeginBatch();
+}
+
+KernelCacheBatch::~KernelCacheBatch()
+{
+    if(db == nullptr)
+        return;
+
+    try
+    {
+        db->EndBatch();
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to save binaries to the cache: " << ex.what());
+    }
 }
 #else
+bool HasBinary(const TargetProperties& target,
+               const size_t num_cu,
+               const std::string& name,
+               const std::string& args,
+               bool is_kernel_str)
+{
+    if(miopen::IsCacheDisabled())
+        return false;
+
+    (void)num_cu;
+    boost::system::error_code ec;
+    return boost::filesystem::exists(GetCacheFile(target.DbId(), name, args, is_kernel_str), ec);
+}
+
 boost::filesystem::path LoadBinary(const TargetProperties& target,
                                    const size_t num_cu,
                                    const std::string& name,
@@ -226,12 +473,23 @@ boost::filesystem::path LoadBinary(const TargetProperties& target,
 
     (void)num_cu;
     auto f = GetCacheFile(target.DbId(), name, args, is_kernel_str);
-    if(boost::filesystem::exists(f))
+    boost::system::error_code ec;
+    const auto last_access = boost::filesystem::last_write_time(f, ec);
+    if(!ec)
     {
+        MIOPEN_TRACE_EVENT("kernel_cache", "Hit", name << ' ' << args);
+        ++Counters().hits;
+        // The modification time is the access time for the LRU eviction. It is updated at most
+        // once an hour, so the cache hits rarely write to the filesystem.
+        const auto now = std::time(nullptr);
+        if(now - last_access >= 60 * 60)
+            boost::filesystem::last_write_time(f, now, ec);
         return f.string();
     }
     else
     {
+        MIOPEN_TRACE_EVENT("kernel_cache", "Miss", name << ' ' << args);
+        ++Counters().misses;
         return {};
     }
 }
@@ -251,7 +509,35 @@ void SaveBinary(const boost::filesystem::path& binary_path,
         auto p = GetCacheFile(target.DbId(), name, args, is_kernel_str);
         boost::filesystem::create_directories(p.parent_path());
         boost::filesystem::rename(binary_path, p);
+
+        boost::system::error_code ec;
+        const auto size = boost::filesystem::file_size(p, ec);
+        if(IsSizeCheckDue(ec ? 0 : size))
+            EnforceDirectorySizeLimit(GetCachePath(false));
     }
 }
+
+KernelCacheStats GetKernelCacheStats(const TargetProperties&, std::size_t)
+{
+    const auto& counters = Counters();
+    KernelCacheStats stats{counters.hits, counters.misses, 0, counters.evictions};
+    if(!miopen::IsCacheDisabled())
+    {
+        for(const auto& file : ListCacheFiles(GetCachePath(false)))
+            stats.bytes += file.size;
+    }
+    return stats;
+}
+
+void CompactKernelCache(const TargetProperties&, std::size_t)
+{
+    // The freed space is returned by the filesystem, only the eviction is left
+    if(!miopen::IsCacheDisabled() && GetCacheSizeLimit() != 0)
+        EnforceDirectorySizeLimit(GetCachePath(false));
+}
+
+KernelCacheBatch::KernelCacheBatch(const TargetProperties&, std::size_t) {}
+
+KernelCacheBatch::~KernelCacheBatch() = default;
 #endif
 } // namespace miopen
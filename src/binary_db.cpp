@@ -0,0 +1,582 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/binary_db.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/stringutils.hpp>
+
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/problem_description.hpp>
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#if MIOPEN_EMBED_DB
+#include <miopen_data.hpp>
+#endif
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <type_traits>
+
+namespace miopen {
+
+namespace {
+
+constexpr char magic[8] = {'M', 'I', 'O', 'P', 'E', 'N', 'D', 'B'};
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint64_t source_size;
+    int64_t source_mtime;
+    char source_md5[32];
+    uint64_t file_size;
+    uint64_t record_count;
+    uint64_t index_offset;
+    uint64_t value_count;
+    uint64_t value_offset;
+    uint64_t schema_offset;
+    uint64_t schema_size;
+};
+
+struct IndexItem
+{
+    uint64_t hash;
+    uint64_t key_offset;
+    uint64_t first_value;
+    uint32_t key_size;
+    uint32_t value_count;
+};
+
+struct ValueItem
+{
+    /// Value of the solver::Id, or solver::Id::invalid_value if ID is stored as a string.
+    uint64_t solver;
+    uint64_t id_offset;
+    uint64_t values_offset;
+    uint32_t id_size;
+    uint32_t values_size;
+};
+
+static_assert(std::is_trivially_copyable<Header>{} && sizeof(Header) == 120, "");
+static_assert(std::is_trivially_copyable<IndexItem>{} && sizeof(IndexItem) == 32, "");
+static_assert(std::is_trivially_copyable<ValueItem>{} && sizeof(ValueItem) == 32, "");
+
+/// FNV-1a. Unlike std::hash, it is stable across platforms and library versions.
+uint64_t HashKey(std::string_view key)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(const auto c : key)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/// Embedded data is not guaranteed to be aligned, so the structures are copied out.
+template <class T>
+T ReadAt(std::string_view data, uint64_t offset)
+{
+    auto ret = T{};
+    std::memcpy(&ret, data.data() + offset, sizeof(T));
+    return ret;
+}
+
+template <class T>
+void WriteAt(std::vector<char>& data, uint64_t offset, const T& value)
+{
+    std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+bool IsRangeValid(uint64_t offset, uint64_t size, uint64_t total)
+{
+    return offset <= total && size <= total - offset;
+}
+
+int64_t GetMTime(const std::string& path)
+{
+    return static_cast<int64_t>(boost::filesystem::last_write_time(path));
+}
+
+/// The file is mapped instead of being read, the source databases may be large.
+std::string HashFile(const std::string& path)
+{
+    namespace bip = boost::interprocess;
+
+    // Empty files can't be mapped
+    if(boost::filesystem::file_size(path) == 0)
+        return md5(std::string_view{});
+    const auto file    = bip::file_mapping{path.c_str(), bip::read_only};
+    const auto mapping = bip::mapped_region{file, bip::read_only};
+    return md5(
+        std::string_view{static_cast<const char*>(mapping.get_address()), mapping.get_size()});
+}
+
+} // namespace
+
+BinaryDb::BinaryDb(std::string path_, std::string_view data_)
+    : path(std::move(path_)), data(data_)
+{
+}
+
+BinaryDb::~BinaryDb() = default;
+
+BinaryDb::Source BinaryDb::Source::FromFile(const std::string& path)
+{
+    auto source  = Source{};
+    source.size  = boost::filesystem::file_size(path);
+    source.mtime = GetMTime(path);
+    source.md5   = HashFile(path);
+    return source;
+}
+
+std::unique_ptr<BinaryDb> BinaryDb::TryLoad(const std::string& db_path, KeyKind kind)
+{
+    if(db_path.empty())
+        return nullptr;
+
+    const auto bin_path = GetPath(db_path);
+    auto source_size    = uint64_t{0};
+    auto source_mtime   = boost::optional<int64_t>{};
+    auto source_md5     = std::function<std::string()>{};
+    auto db             = std::unique_ptr<BinaryDb>{};
+
+    constexpr bool isEmbedded = MIOPEN_EMBED_DB;
+    // cppcheck-suppress knownConditionTrueFalse
+    if(!debug::rordb_embed_fs_override() && isEmbedded)
+    {
+#if MIOPEN_EMBED_DB
+        const auto filename = boost::filesystem::path(db_path).filename().string();
+        const auto it_bin   = miopen_data().find(filename + ".bin.o");
+        if(it_bin == miopen_data().end())
+            return nullptr;
+        const auto it_src = miopen_data().find(filename + ".o");
+        if(it_src == miopen_data().end())
+        {
+            MIOPEN_LOG_W("Source of the binary database is missing, ignored: " << bin_path);
+            return nullptr;
+        }
+        const auto source = std::string_view{
+            it_src->second.first,
+            static_cast<std::size_t>(it_src->second.second - it_src->second.first)};
+        source_size = source.size();
+        source_md5  = [source]() { return md5(source); };
+
+        const auto& p = it_bin->second;
+        db.reset(new BinaryDb{
+            bin_path, std::string_view{p.first, static_cast<std::size_t>(p.second - p.first)}});
+#endif
+    }
+    else
+    {
+        namespace bip = boost::interprocess;
+
+        try
+        {
+            if(!boost::filesystem::exists(bin_path))
+                return nullptr;
+            if(!boost::filesystem::exists(db_path))
+            {
+                MIOPEN_LOG_W("Source of the binary database is missing, ignored: " << bin_path);
+                return nullptr;
+            }
+            source_size  = boost::filesystem::file_size(db_path);
+            source_mtime = GetMTime(db_path);
+            source_md5   = [db_path]() {
+                try
+                {
+                    return HashFile(db_path);
+                }
+                catch(const std::exception& ex)
+                {
+                    // An unreadable source matches nothing
+                    MIOPEN_LOG_I2(ex.what());
+                    return std::string{};
+                }
+            };
+
+            const auto file = bip::file_mapping{bin_path.c_str(), bip::read_only};
+            auto mapping    = std::make_unique<bip::mapped_region>(file, bip::read_only);
+            const auto view = std::string_view{static_cast<const char*>(mapping->get_address()),
+                                               mapping->get_size()};
+            db.reset(new BinaryDb{bin_path, view});
+            db->mapping = std::move(mapping);
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("File is unreadable: " << bin_path);
+            MIOPEN_LOG_I2(ex.what());
+            return nullptr;
+        }
+    }
+
+    if(!db->Validate(kind, source_size, source_mtime, source_md5))
+        return nullptr;
+
+    MIOPEN_LOG_I("Using binary database " << bin_path << ", " << db->GetSize() << " records");
+    return db;
+}
+
+bool BinaryDb::Validate(KeyKind kind,
+                        uint64_t source_size,
+                        boost::optional<int64_t> source_mtime,
+                        const std::function<std::string()>& source_md5)
+{
+    if(data.size() < sizeof(Header))
+    {
+        MIOPEN_LOG_W("Binary database is truncated, ignored: " << path);
+        return false;
+    }
+
+    const auto header = ReadAt<Header>(data, 0);
+
+    if(std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != format_version)
+    {
+        MIOPEN_LOG_W("Binary database has unsupported format, ignored: " << path);
+        return false;
+    }
+
+    if(header.kind != static_cast<uint32_t>(kind))
+    {
+        MIOPEN_LOG_W("Binary database has unexpected kind of keys, ignored: " << path);
+        return false;
+    }
+
+    if(header.file_size != data.size() ||
+       !IsRangeValid(header.index_offset, header.record_count * sizeof(IndexItem), data.size()) ||
+       !IsRangeValid(header.value_offset, header.value_count * sizeof(ValueItem), data.size()) ||
+       !IsRangeValid(header.schema_offset, header.schema_size, data.size()))
+    {
+        MIOPEN_LOG_W("Binary database is corrupt, ignored: " << path);
+        return false;
+    }
+
+    // Otherwise the binary database is outdated
+    if(header.source_size != source_size ||
+       (source_mtime && header.source_mtime != *source_mtime) ||
+       std::string_view{header.source_md5, sizeof(header.source_md5)} != source_md5())
+    {
+        MIOPEN_LOG_W("Binary database does not match the source database, ignored: " << path);
+        return false;
+    }
+
+    record_count = header.record_count;
+    index_offset = header.index_offset;
+    value_count  = header.value_count;
+    value_offset = header.value_offset;
+    schema       = data.substr(header.schema_offset, header.schema_size);
+    return true;
+}
+
+boost::optional<std::string_view> BinaryDb::GetString(uint64_t offset, uint64_t size) const
+{
+    if(!IsRangeValid(offset, size, data.size()))
+    {
+        MIOPEN_LOG_E("Binary database is corrupt: " << path);
+        return boost::none;
+    }
+    return data.substr(offset, size);
+}
+
+boost::optional<DbRecord> BinaryDb::FindRecord(const std::string& key) const
+{
+    MIOPEN_LOG_I2("Looking for key " << key << " in file " << path);
+
+    const auto hash = HashKey(key);
+    const auto item = [&](uint64_t i) {
+        return ReadAt<IndexItem>(data, index_offset + i * sizeof(IndexItem));
+    };
+
+    auto first = uint64_t{0};
+    auto count = record_count;
+
+    while(count > 0)
+    {
+        const auto step = count / 2;
+        if(item(first + step).hash < hash)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    for(; first < record_count; ++first)
+    {
+        const auto index = item(first);
+        if(index.hash != hash)
+            break;
+
+        const auto stored_key = GetString(index.key_offset, index.key_size);
+        if(!stored_key)
+            return boost::none;
+        if(*stored_key != key)
+            continue;
+
+        if(!IsRangeValid(index.first_value, index.value_count, value_count))
+        {
+            MIOPEN_LOG_E("Binary database is corrupt: " << path);
+            return boost::none;
+        }
+
+        auto record = DbRecord{key};
+
+        for(auto i = index.first_value; i < index.first_value + index.value_count; ++i)
+        {
+            const auto value  = ReadAt<ValueItem>(data, value_offset + i * sizeof(ValueItem));
+            const auto values = GetString(value.values_offset, value.values_size);
+            if(!values)
+                return boost::none;
+
+            auto id = std::string{};
+            if(value.solver != solver::Id::invalid_value)
+            {
+                id = solver::Id{value.solver}.ToString();
+            }
+            else
+            {
+                const auto stored_id = GetString(value.id_offset, value.id_size);
+                if(!stored_id)
+                    return boost::none;
+                id = *stored_id;
+            }
+
+            record.map.emplace(std::move(id), *values);
+        }
+
+        MIOPEN_LOG_I2("Key match: " << key);
+        return record;
+    }
+
+    return boost::none;
+}
+
+void BinaryDb::Write(const std::string& path,
+                     KeyKind kind,
+                     const std::string& schema,
+                     const Source& source,
+                     const std::vector<DbRecord>& records)
+{
+    auto header = Header{};
+    if(source.md5.size() != sizeof(header.source_md5))
+        MIOPEN_THROW(miopenStatusInternalError, "Invalid md5 of the source database: " + path);
+
+    auto sorted = std::vector<std::pair<uint64_t, const DbRecord*>>{};
+    sorted.reserve(records.size());
+    auto total_values = uint64_t{0};
+
+    for(const auto& record : records)
+    {
+        sorted.emplace_back(HashKey(record.GetKey()), &record);
+        total_values += record.GetSize();
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [](const auto& l, const auto& r) {
+        return l.first != r.first ? l.first < r.first : l.second->GetKey() < r.second->GetKey();
+    });
+
+    std::memcpy(header.magic, magic, sizeof(magic));
+    std::memcpy(header.source_md5, source.md5.data(), sizeof(header.source_md5));
+    header.version       = format_version;
+    header.kind          = static_cast<uint32_t>(kind);
+    header.source_size   = source.size;
+    header.source_mtime  = source.mtime;
+    header.record_count  = sorted.size();
+    header.index_offset  = sizeof(Header);
+    header.value_count   = total_values;
+    header.value_offset  = header.index_offset + header.record_count * sizeof(IndexItem);
+    header.schema_offset = header.value_offset + header.value_count * sizeof(ValueItem);
+    header.schema_size   = schema.size();
+
+    auto out = std::vector<char>(header.schema_offset);
+    out.insert(out.end(), schema.begin(), schema.end());
+
+    const auto append_string = [&](const std::string& str) {
+        const auto offset = static_cast<uint64_t>(out.size());
+        out.insert(out.end(), str.begin(), str.end());
+        return offset;
+    };
+
+    auto value_idx = uint64_t{0};
+
+    for(auto i = 0ULL; i < sorted.size(); ++i)
+    {
+        const auto& record = *sorted[i].second;
+
+        auto index        = IndexItem{};
+        index.hash        = sorted[i].first;
+        index.key_size    = record.GetKey().size();
+        index.key_offset  = append_string(record.GetKey());
+        index.first_value = value_idx;
+        index.value_count = record.GetSize();
+
+        // Sort IDs to make the output reproducible.
+        auto ids = std::map<std::string, std::string>{record.map.begin(), record.map.end()};
+
+        for(const auto& id_values : ids)
+        {
+            const auto solver = solver::Id{id_values.first};
+
+            auto value          = ValueItem{};
+            value.solver        = solver.IsValid() ? solver.Value() : solver::Id::invalid_value;
+            value.id_size       = solver.IsValid() ? 0 : id_values.first.size();
+            value.id_offset     = solver.IsValid() ? 0 : append_string(id_values.first);
+            value.values_size   = id_values.second.size();
+            value.values_offset = append_string(id_values.second);
+
+            WriteAt(out, header.value_offset + value_idx * sizeof(ValueItem), value);
+            ++value_idx;
+        }
+
+        WriteAt(out, header.index_offset + i * sizeof(IndexItem), index);
+    }
+
+    header.file_size = out.size();
+    WriteAt(out, 0, header);
+
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    if(!file.write(out.data(), out.size()))
+        MIOPEN_THROW(miopenStatusInternalError, "Unable to write binary database: " + path);
+}
+
+std::vector<DbRecord> BinaryDb::ReadTextDb(const std::string& path)
+{
+    auto file = std::ifstream{path};
+    if(!file)
+        MIOPEN_THROW(miopenStatusInternalError, "Unable to read database: " + path);
+
+    auto records = std::vector<DbRecord>{};
+    auto keys    = std::unordered_map<std::string, std::size_t>{};
+    auto line    = std::string{};
+    auto n_line  = 0;
+
+    while(std::getline(file, line))
+    {
+        ++n_line;
+
+        if(!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#" << n_line);
+            continue;
+        }
+
+        auto record = DbRecord{line.substr(0, key_size)};
+
+        if(!record.ParseContents(line.substr(key_size + 1)))
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: " << record.GetKey() << " form file "
+                                                                 << path << "#" << n_line);
+            continue;
+        }
+
+        // The first record wins, the same as in ReadonlyRamDb.
+        if(!keys.emplace(record.GetKey(), records.size()).second)
+        {
+            MIOPEN_LOG_W("Duplicate key (ignored): " << record.GetKey() << ": " << path << "#"
+                                                     << n_line);
+            continue;
+        }
+
+        records.emplace_back(std::move(record));
+    }
+
+    return records;
+}
+
+#if MIOPEN_ENABLE_SQLITE
+std::string BinaryDb::SQLiteSchema()
+{
+    return JoinStrings(ProblemDescriptionCompatTemporary{}.FieldNames(), ",");
+}
+
+std::string BinaryDb::SQLiteKey(const std::vector<std::string>& values)
+{
+    return JoinStrings(values, ",");
+}
+
+std::vector<DbRecord> BinaryDb::ReadSQLitePerfDb(const std::string& path)
+{
+    const auto sql = SQLite{path, true};
+    if(!sql.Valid())
+        MIOPEN_THROW(miopenStatusInternalError, "Unable to read database: " + path);
+
+    const auto fields = ProblemDescriptionCompatTemporary{}.FieldNames();
+    auto columns      = std::vector<std::string>{};
+    for(const auto& field : fields)
+        columns.push_back("config." + field + " AS " + field);
+
+    // clang-format off
+    const auto query =
+        "SELECT " + JoinStrings(columns, ", ") + ", perf_db.solver, perf_db.params "
+        "FROM perf_db "
+        "INNER JOIN config "
+        "ON perf_db.config = config.id;";
+    // clang-format on
+
+    auto records = std::vector<DbRecord>{};
+    auto keys    = std::unordered_map<std::string, std::size_t>{};
+
+    for(auto& row : sql.Exec(query))
+    {
+        auto values = std::vector<std::string>{};
+        for(const auto& field : fields)
+            values.push_back(row[field]);
+
+        auto key      = SQLiteKey(values);
+        const auto it = keys.emplace(key, records.size());
+        if(it.second)
+            records.push_back(DbRecord{key});
+
+        records[it.first->second].SetValues(row["solver"], row["params"]);
+    }
+
+    return records;
+}
+#endif
+
+} // namespace miopen
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compile_queue.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mt_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+struct CompileQueue::impl
+{
+    std::size_t workers_count;
+    std::vector<std::thread> workers;
+    ThreadSafeQueue<std::function<void()>> jobs;
+    std::atomic<bool> stopping{false};
+
+    mutable std::mutex mutex;
+    mutable std::condition_variable done;
+    std::unordered_map<std::string, State> states;
+    std::size_t pending = 0;
+
+    explicit impl(std::size_t workers_) : workers_count(workers_) {}
+
+    ~impl()
+    {
+        stopping = true;
+        // An empty job stops a worker
+        for(std::size_t i = 0; i < workers.size(); ++i)
+            jobs.push({});
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    void Work()
+    {
+        for(;;)
+        {
+            const auto job = jobs.pop();
+            if(!job)
+                return;
+            job();
+        }
+    }
+
+    void Run(const std::string& key, const std::function<void()>& job)
+    {
+        auto succeeded = false;
+        if(!stopping)
+        {
+            try
+            {
+                job();
+                succeeded = true;
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_W("Background compilation of " << key << " has failed: " << ex.what());
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(succeeded)
+                states.erase(key);
+            else
+                states[key] = State::Failed;
+            --pending;
+        }
+        done.notify_all();
+    }
+};
+
+CompileQueue::CompileQueue(std::size_t workers)
+{
+    if(workers == 0)
+        workers = std::max<std::size_t>(1, std::thread::hardware_concurrency() / 2);
+    pImpl = std::make_unique<impl>(workers);
+}
+
+CompileQueue::~CompileQueue()                                  = default;
+CompileQueue::CompileQueue(CompileQueue&&) noexcept            = default;
+CompileQueue& CompileQueue::operator=(CompileQueue&&) noexcept = default;
+
+CompileQueue::State CompileQueue::GetState(const std::string& key) const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    const auto it = pImpl->states.find(key);
+    return it == pImpl->states.end() ? State::None : it->second;
+}
+
+bool CompileQueue::Push(const std::string& key, std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        if(!pImpl->states.emplace(key, State::Pending).second)
+            return false;
+        ++pImpl->pending;
+
+        if(pImpl->workers.empty())
+        {
+            for(std::size_t i = 0; i < pImpl->workers_count; ++i)
+                pImpl->workers.emplace_back([impl = pImpl.get()]() { impl->Work(); });
+        }
+    }
+
+    MIOPEN_LOG_I2("Queued background compilation of " << key);
+    pImpl->jobs.push([impl = pImpl.get(), key, job = std::move(job)]() { impl->Run(key, job); });
+    return true;
+}
+
+void CompileQueue::Wait() const
+{
+    std::unique_lock<std::mutex> lock(pImpl->mutex);
+    pImpl->done.wait(lock, [&]() { return pImpl->pending == 0; });
+}
+
+CompileQueue::State CompileQueue::Wait(const std::string& key) const
+{
+    std::unique_lock<std::mutex> lock(pImpl->mutex);
+    const auto state = [&]() {
+        const auto it = pImpl->states.find(key);
+        return it == pImpl->states.end() ? State::None : it->second;
+    };
+    pImpl->done.wait(lock, [&]() { return state() != State::Pending; });
+    return state();
+}
+
+} // namespace miopen
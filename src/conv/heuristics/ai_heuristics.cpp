@@ -26,8 +26,12 @@
 
 #include <miopen/conv/heuristics/ai_heuristics.hpp>
 #if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK || MIOPEN_ENABLE_AI_KERNEL_TUNING
+#include <miopen/conv/heuristics/dense_net.hpp>
 #include <fdeep/fdeep.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <map>
+#include <mutex>
 
 namespace miopen {
 namespace ai {
@@ -114,7 +118,10 @@ public:
     Metadata metadata;
     Model(const std::string& arch)
         : metadata(Metadata(arch)),
-          model(fdeep::load_model(ModelPath(arch), true, fdeep::dev_null_logger)),
+          dense_net(DenseNet::Load(ModelPath(arch))),
+          model(dense_net ? nullptr
+                          : std::make_unique<const fdeep::model>(fdeep::load_model(
+                                ModelPath(arch), true, fdeep::dev_null_logger))),
           input_shape(fdeep::tensor_shape(metadata.num_inputs)),
           offset(metadata.num_outputs - metadata.num_solvers)
     {
@@ -122,17 +129,49 @@ public:
     virtual ~Model()                                                     = default;
     virtual bool IsProblemSupported(const ProblemDescription& problem,
                                     const ConvolutionContext& ctx) const = 0;
-    std::vector<float> Forward(const ProblemDescription& problem) const
+    /// Evaluates the whole batch in one pass, returns the solver scores per problem.
+    std::vector<std::vector<float>>
+    Forward(const std::vector<const ProblemDescription*>& problems) const
     {
-        std::vector<float> features       = ToFeatures(problem);
-        std::vector<fdeep::tensor> output = model.predict({fdeep::tensor(input_shape, features)});
-        std::vector<float> output_vector  = output.front().to_vector();
-        std::vector<float> res(output_vector.begin() + offset, output_vector.end());
-        return res;
+        std::vector<float> features;
+        features.reserve(problems.size() * metadata.num_inputs);
+        for(const auto problem : problems)
+        {
+            const auto problem_features = ToFeatures(*problem);
+            features.insert(features.end(), problem_features.begin(), problem_features.end());
+        }
+
+        std::vector<float> output;
+        if(dense_net)
+        {
+            output = dense_net->Forward(features, problems.size());
+        }
+        else
+        {
+            for(std::size_t i = 0; i < problems.size(); ++i)
+            {
+                const auto first = features.begin() + i * metadata.num_inputs;
+                std::vector<fdeep::tensor> res = model->predict({fdeep::tensor(
+                    input_shape, std::vector<float>(first, first + metadata.num_inputs))});
+                const auto output_vector = res.front().to_vector();
+                output.insert(output.end(), output_vector.begin(), output_vector.end());
+            }
+        }
+
+        std::vector<std::vector<float>> scores;
+        scores.reserve(problems.size());
+        for(std::size_t i = 0; i < problems.size(); ++i)
+        {
+            const auto first = output.begin() + i * metadata.num_outputs;
+            scores.emplace_back(first + offset, first + metadata.num_outputs);
+        }
+        return scores;
     }
 
 protected:
-    const fdeep::model model;
+    // TunaNet is a graph of dense layers, fdeep is kept for the models DenseNet can't run
+    const std::unique_ptr<const DenseNet> dense_net;
+    const std::unique_ptr<const fdeep::model> model;
     const fdeep::tensor_shape input_shape;
     const size_t offset;
     static std::string ModelPath(const std::string& arch)
@@ -261,74 +300,116 @@ protected:
 
 std::unique_ptr<Model> GetModel(const std::string&) { return std::make_unique<Gfx908Model>(); }
 
-std::vector<uint64_t> PredictSolver(const ProblemDescription& problem,
-                                    const ConvolutionContext& ctx,
-                                    const std::string& device)
+static std::vector<uint64_t> ToSolverIds(const std::vector<boost::any>& record)
 {
-    const static std::unique_ptr<Model> model = GetModel(device);
-    if(!model || !model->IsProblemSupported(problem, ctx))
-        return {};
+    std::vector<uint64_t> ids(record.size());
+    std::transform(record.begin(), record.end(), ids.begin(), [](const boost::any& id) {
+        return boost::any_cast<uint64_t>(id);
+    });
+    return ids;
+}
 
-    std::string est_name = ":memory:" + device;
-    auto& db             = AnyRamDb::GetCached(est_name);
-    auto db_res          = db.FindRecord(problem.conv_problem);
-    if(db_res)
-    {
-        MIOPEN_LOG_I2("Cached heuristic result found");
-        std::vector<uint64_t> db_sol(db_res->size());
-        // cast returned record to solver ids
-        std::transform(db_res->begin(), db_res->end(), db_sol.begin(), [](boost::any id) {
-            return boost::any_cast<uint64_t>(id);
-        });
-        if(miopen::IsLogging(LoggingLevel::Info2))
-        {
-            std::stringstream ss;
-            for(auto& id : db_sol)
-                ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
-            MIOPEN_LOG_I2("Cached solvers: " << ss.str());
-        }
-        return db_sol;
-    }
+static void LogSolvers(const char* title, const std::vector<uint64_t>& ids)
+{
+    if(!miopen::IsLogging(LoggingLevel::Info2))
+        return;
+    std::stringstream ss;
+    for(auto& id : ids)
+        ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
+    MIOPEN_LOG_I2(title << ": " << ss.str());
+}
 
-    MIOPEN_LOG_I2("Evaluating Heuristic");
-
-    std::vector<float> res = model->Forward(problem);
-    std::vector<std::pair<int, float>> sort_res(res.size());
-    // sorts result based upon magnitude of result in vector, returned from Model,
-    // paired with original index (idx). Sort magnitudes in descending order.
-    // Greater magnitude = better solver. Indexes (idx), which will be used to map to solvers,
-    // with greater corresponding magnitude are at front of the vector so they get priority.
-    for(auto idx = 0; idx < res.size(); idx++)
-        sort_res[idx] = {idx, res[idx]};
-    const auto cmp = [](const std::pair<int, float>& a, const std::pair<int, float>& b) -> bool {
+/// Sorts the solvers by their scores, greater score = better solver.
+static std::vector<uint64_t> RankSolvers(const Model& model, const std::vector<float>& scores)
+{
+    std::vector<std::pair<std::size_t, float>> sort_res(scores.size());
+    for(std::size_t idx = 0; idx < scores.size(); idx++)
+        sort_res[idx] = {idx, scores[idx]};
+    std::stable_sort(sort_res.begin(), sort_res.end(), [](const auto& a, const auto& b) {
         return a.second > b.second;
-    };
-    std::sort(sort_res.begin(), sort_res.end(), cmp);
+    });
 
-    // map idx to solver id and then anysolver
+    // map idx to solver id
     std::vector<uint64_t> sol;
-    std::vector<boost::any> any_sol;
     for(const auto& kinder : sort_res)
     {
-        const auto id     = kinder.first;
-        const auto sol_id = solver::Id{model->metadata.solver_map.at(id)};
+        const auto& name  = model.metadata.solver_map.at(kinder.first);
+        const auto sol_id = solver::Id{name};
         if(!sol_id.IsValid())
         {
-            MIOPEN_LOG_I2("Invalid solver " << model->metadata.solver_map.at(id) << " removed");
+            MIOPEN_LOG_I2("Invalid solver " << name << " removed");
             continue;
         }
         sol.push_back(sol_id.Value());
-        any_sol.push_back(sol_id.Value());
     }
-    db.StoreRecord(problem.conv_problem, any_sol);
-    if(miopen::IsLogging(LoggingLevel::Info2))
+    return sol;
+}
+
+static std::vector<std::vector<uint64_t>>
+PredictSolversImpl(const std::vector<const ProblemDescription*>& problems,
+                   const ConvolutionContext& ctx,
+                   const std::string& device)
+{
+    const static std::unique_ptr<Model> model = GetModel(device);
+    std::vector<std::vector<uint64_t>> results(problems.size());
+    if(!model)
+        return results;
+
+    // The predictions are cached by the problem, so repeated queries skip the model. Whether
+    // TunaNet applies also depends on the context, through the applicability of the solvers it
+    // may predict, so it is checked on every query and the negatives are not cached.
+    auto& db = AnyRamDb::GetCached(":memory:" + device);
+    std::vector<std::size_t> pending;
+    std::vector<const ProblemDescription*> pending_problems;
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        const auto& problem = *problems[i];
+        if(!model->IsProblemSupported(problem, ctx))
+            continue;
+        const auto db_res = db.FindRecord(problem.conv_problem);
+        if(db_res)
+        {
+            MIOPEN_LOG_I2("Cached heuristic result found");
+            results[i] = ToSolverIds(*db_res);
+            LogSolvers("Cached solvers", results[i]);
+            continue;
+        }
+        pending.push_back(i);
+        pending_problems.push_back(&problem);
+    }
+
+    if(pending.empty())
+        return results;
+
+    MIOPEN_LOG_I2("Evaluating Heuristic for " << pending.size() << " problem(s)");
+    const auto scores = model->Forward(pending_problems);
+    for(std::size_t k = 0; k < pending.size(); ++k)
     {
-        std::stringstream ss;
-        for(auto& id : sol)
-            ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
-        MIOPEN_LOG_I2("Heuristic Result: " << ss.str());
+        auto& sol    = results[pending[k]];
+        sol          = RankSolvers(*model, scores[k]);
+        auto any_sol = std::vector<boost::any>(sol.begin(), sol.end());
+        db.StoreRecord(problems[pending[k]]->conv_problem, any_sol);
+        LogSolvers("Heuristic Result", sol);
     }
-    return sol;
+    return results;
+}
+
+std::vector<std::vector<uint64_t>> PredictSolvers(const std::vector<ProblemDescription>& problems,
+                                                  const ConvolutionContext& ctx,
+                                                  const std::string& device)
+{
+    std::vector<const ProblemDescription*> pointers;
+    pointers.reserve(problems.size());
+    for(const auto& problem : problems)
+        pointers.push_back(&problem);
+    return PredictSolversImpl(pointers, ctx, device);
+}
+
+std::vector<uint64_t> PredictSolver(const ProblemDescription& problem,
+                                    const ConvolutionContext& ctx,
+                                    const std::string& device)
+{
+    return PredictSolversImpl({&problem}, ctx, device).front();
 }
 } // namespace immed_mode
 #endif // MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
@@ -397,6 +478,8 @@ std::shared_ptr<Model> GetModel(const std::string& arch, const std::string& solv
 
     if(prevArch != arch)
         MIOPEN_THROW("Cannot use AI tuning models for multiple gpu architectures");
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
     static std::map<std::string, std::shared_ptr<Model>> models;
     auto it = models.find(solver);
     if(it == models.end())
@@ -411,10 +494,10 @@ std::shared_ptr<Model> GetModel(const std::string& arch, const std::string& solv
     }
 }
 
-bool ModelSetParams(const std::string& arch,
-                    const std::string& solver,
-                    const std::vector<float>& features,
-                    std::function<bool(int, int)> validator)
+static bool ModelSetParamsImpl(const std::string& arch,
+                               const std::string& solver,
+                               const std::vector<float>& features,
+                               const std::function<bool(int, int)>& validator)
 {
     auto model             = GetModel(arch, solver);
     int dim                = std::sqrt(features.size());
@@ -434,7 +517,8 @@ bool ModelSetParams(const std::string& arch,
         {
             int token = pq.top().second;
             // convert index to token value
-            int value = model->metadata.tuning_decodings[std::to_string(token)];
+            const auto decoding = model->metadata.tuning_decodings.find(std::to_string(token));
+            int value = decoding != model->metadata.tuning_decodings.end() ? decoding->second : 0;
             pq.pop();
             if(value < 0)
                 return false;
@@ -451,6 +535,62 @@ bool ModelSetParams(const std::string& arch,
     return true;
 }
 
+namespace {
+/// The calls of the validator made by the model for some features.
+struct Prediction
+{
+    struct Call
+    {
+        int index;
+        int value;
+        bool valid;
+    };
+    std::vector<Call> calls;
+    bool result;
+};
+} // namespace
+
+bool ModelSetParams(const std::string& arch,
+                    const std::string& solver,
+                    const std::vector<float>& features,
+                    std::function<bool(int, int)> validator)
+{
+    // The decoder runs once per tuning parameter, so the predictions are cached by the features.
+    // The validator may depend on more than the features, so a cached prediction is replayed
+    // and used only when the validator agrees with all of its calls.
+    static std::mutex mutex;
+    static std::map<std::string, Prediction> predictions;
+
+    const auto key = solver + std::string(reinterpret_cast<const char*>(features.data()),
+                                          features.size() * sizeof(float));
+    boost::optional<Prediction> cached;
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto found = predictions.find(key);
+        if(found != predictions.end())
+            cached = found->second;
+    }
+    if(cached && std::all_of(cached->calls.begin(), cached->calls.end(), [&](const auto& call) {
+           return validator(call.index, call.value) == call.valid;
+       }))
+    {
+        MIOPEN_LOG_I2("Cached AI tuning prediction found");
+        return cached->result;
+    }
+
+    Prediction prediction;
+    prediction.result =
+        ModelSetParamsImpl(arch, solver, features, [&](int index, int value) {
+            const auto valid = validator(index, value);
+            prediction.calls.push_back({index, value, valid});
+            return valid;
+        });
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    predictions[key] = prediction;
+    return prediction.result;
+}
+
 } // namespace tuning
 #endif // MIOPEN_ENABLE_AI_KERNEL_TUNING
 } // namespace ai
@@ -0,0 +1,310 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/heuristics/dense_net.hpp>
+#include <miopen/errors.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace miopen {
+namespace ai {
+
+namespace {
+
+/// fdeep stores the parameters as base64 encoded little-endian floats split into chunks.
+std::vector<float> DecodeFloats(const nlohmann::json& chunks)
+{
+    static const auto table = []() {
+        std::array<int, 256> decoded{};
+        decoded.fill(-1);
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for(auto i = 0; i < 64; ++i)
+            decoded[static_cast<unsigned char>(alphabet[i])] = i;
+        return decoded;
+    }();
+
+    std::vector<std::uint8_t> bytes;
+    std::uint32_t accumulator = 0;
+    auto bits                 = 0;
+    for(const auto& chunk : chunks)
+    {
+        for(const auto c : chunk.get<std::string>())
+        {
+            const auto value = table[static_cast<unsigned char>(c)];
+            if(value < 0)
+                continue; // Padding
+            accumulator = (accumulator << 6) | static_cast<std::uint32_t>(value);
+            bits += 6;
+            if(bits >= 8)
+            {
+                bits -= 8;
+                bytes.push_back(static_cast<std::uint8_t>(accumulator >> bits));
+            }
+        }
+    }
+
+    if(bytes.size() % sizeof(float) != 0)
+        MIOPEN_THROW("Malformed model parameters");
+    std::vector<float> floats(bytes.size() / sizeof(float));
+    std::memcpy(floats.data(), bytes.data(), bytes.size());
+    return floats;
+}
+
+bool ParseActivation(const nlohmann::json& name, DenseNet::Activation& activation)
+{
+    if(name == "linear")
+        activation = DenseNet::Activation::Linear;
+    else if(name == "relu")
+        activation = DenseNet::Activation::Relu;
+    else if(name == "sigmoid")
+        activation = DenseNet::Activation::Sigmoid;
+    else if(name == "tanh")
+        activation = DenseNet::Activation::Tanh;
+    else
+        return false;
+    return true;
+}
+
+void Activate(DenseNet::Activation activation, float* values, std::size_t count)
+{
+    switch(activation)
+    {
+    case DenseNet::Activation::Linear: break;
+    case DenseNet::Activation::Relu:
+        for(std::size_t i = 0; i < count; ++i)
+            values[i] = std::max(values[i], 0.0f);
+        break;
+    case DenseNet::Activation::Sigmoid:
+        for(std::size_t i = 0; i < count; ++i)
+            values[i] = 1.0f / (1.0f + std::exp(-values[i]));
+        break;
+    case DenseNet::Activation::Tanh:
+        for(std::size_t i = 0; i < count; ++i)
+            values[i] = std::tanh(values[i]);
+        break;
+    }
+}
+
+/// out = in * weights + bias for a batch of rows. The rows are processed in tiles, so a row of
+/// the weights is reused from the cache by the whole tile, and the innermost loop is a
+/// contiguous multiply-add, which is vectorized by the compiler.
+void Dense(const float* in,
+           std::size_t in_size,
+           const DenseNet::Layer& layer,
+           float* out,
+           std::size_t batch)
+{
+    constexpr std::size_t tile = 8;
+    const auto out_size        = layer.size;
+
+    for(std::size_t b = 0; b < batch; ++b)
+    {
+        auto* row = out + b * out_size;
+        if(layer.bias.empty())
+            std::fill(row, row + out_size, 0.0f);
+        else
+            std::copy(layer.bias.begin(), layer.bias.end(), row);
+    }
+
+    for(std::size_t first = 0; first < batch; first += tile)
+    {
+        const auto last = std::min(first + tile, batch);
+        for(std::size_t i = 0; i < in_size; ++i)
+        {
+            const auto* weights = layer.weights.data() + i * out_size;
+            for(auto b = first; b < last; ++b)
+            {
+                const auto x = in[b * in_size + i];
+                if(x == 0.0f)
+                    continue; // Frequent after ReLU
+                auto* row = out + b * out_size;
+                for(std::size_t o = 0; o < out_size; ++o)
+                    row[o] += x * weights[o];
+            }
+        }
+    }
+}
+
+} // namespace
+
+std::unique_ptr<DenseNet> DenseNet::Load(const std::string& path)
+{
+    std::ifstream file{path};
+    if(!file)
+        MIOPEN_THROW(miopenStatusInternalError, "Unable to load AI model file:" + path);
+    const auto model   = nlohmann::json::parse(file);
+    const auto& config = model.at("architecture").at("config");
+    const auto& params = model.at("trainable_params");
+
+    auto net = std::make_unique<DenseNet>();
+    std::unordered_map<std::string, std::size_t> indices;
+
+    for(const auto& json : config.at("layers"))
+    {
+        const auto& name       = json.at("name").get_ref<const std::string&>();
+        const auto& class_name = json.at("class_name").get_ref<const std::string&>();
+        const auto& layer_cfg  = json.at("config");
+        Layer layer;
+
+        const auto& nodes = json.at("inbound_nodes");
+        if(nodes.size() > 1)
+            return nullptr; // Shared layers
+        if(!nodes.empty())
+        {
+            for(const auto& inbound : nodes.front())
+            {
+                const auto found = indices.find(inbound.at(0).get<std::string>());
+                if(found == indices.end() || inbound.at(2) != 0)
+                    return nullptr;
+                layer.inputs.push_back(found->second);
+            }
+        }
+
+        const auto input_size = [&]() {
+            return layer.inputs.size() == 1 ? net->layers[layer.inputs.front()].size : 0;
+        };
+
+        if(class_name == "InputLayer")
+        {
+            const auto& shape = layer_cfg.at("batch_input_shape");
+            if(!net->layers.empty() || shape.size() != 2)
+                return nullptr;
+            layer.kind = Layer::Kind::Input;
+            layer.size = shape.at(1).get<std::size_t>();
+        }
+        else if(class_name == "Dense")
+        {
+            if(input_size() == 0 || !ParseActivation(layer_cfg.at("activation"), layer.activation))
+                return nullptr;
+            layer.kind         = Layer::Kind::Dense;
+            layer.size         = layer_cfg.at("units").get<std::size_t>();
+            const auto& weight = params.at(name);
+            layer.weights      = DecodeFloats(weight.at("weights"));
+            if(layer_cfg.at("use_bias").get<bool>())
+                layer.bias = DecodeFloats(weight.at("bias"));
+            if(layer.weights.size() != input_size() * layer.size ||
+               (!layer.bias.empty() && layer.bias.size() != layer.size))
+                MIOPEN_THROW("Malformed dense layer in AI model file: " + path);
+        }
+        else if(class_name == "ReLU")
+        {
+            const auto is_default = [&](const char* key, bool zero) {
+                const auto found = layer_cfg.find(key);
+                return found == layer_cfg.end() || found->is_null() ||
+                       (zero && found->is_number() && found->get<float>() == 0.0f);
+            };
+            if(input_size() == 0 || !is_default("max_value", false) ||
+               !is_default("negative_slope", true) || !is_default("threshold", true))
+                return nullptr;
+            layer.kind       = Layer::Kind::Activation;
+            layer.size       = input_size();
+            layer.activation = Activation::Relu;
+        }
+        else if(class_name == "Activation")
+        {
+            if(input_size() == 0 || !ParseActivation(layer_cfg.at("activation"), layer.activation))
+                return nullptr;
+            layer.kind = Layer::Kind::Activation;
+            layer.size = input_size();
+        }
+        else if(class_name == "Add")
+        {
+            if(layer.inputs.size() < 2)
+                return nullptr;
+            layer.kind = Layer::Kind::Add;
+            layer.size = net->layers[layer.inputs.front()].size;
+            for(const auto input : layer.inputs)
+                if(net->layers[input].size != layer.size)
+                    return nullptr;
+        }
+        else
+        {
+            return nullptr;
+        }
+
+        indices.emplace(name, net->layers.size());
+        net->layers.push_back(std::move(layer));
+    }
+
+    // A single input, which is the first layer, and a single output, which is the last one.
+    const auto& inputs  = config.at("input_layers");
+    const auto& outputs = config.at("output_layers");
+    if(net->layers.empty() || inputs.size() != 1 || outputs.size() != 1 ||
+       indices.at(inputs.front().at(0).get<std::string>()) != 0 ||
+       indices.at(outputs.front().at(0).get<std::string>()) != net->layers.size() - 1)
+        return nullptr;
+    return net;
+}
+
+std::vector<float> DenseNet::Forward(const std::vector<float>& inputs, std::size_t batch) const
+{
+    if(inputs.size() != batch * InputSize())
+        MIOPEN_THROW("Wrong size of the AI model inputs");
+
+    std::vector<std::vector<float>> values(layers.size());
+    values.front() = inputs;
+
+    for(std::size_t l = 1; l < layers.size(); ++l)
+    {
+        const auto& layer = layers[l];
+        auto& out         = values[l];
+        const auto& in    = values[layer.inputs.front()];
+
+        switch(layer.kind)
+        {
+        case Layer::Kind::Input: break;
+        case Layer::Kind::Dense:
+            out.resize(batch * layer.size);
+            Dense(in.data(), layers[layer.inputs.front()].size, layer, out.data(), batch);
+            break;
+        case Layer::Kind::Activation: out = in; break;
+        case Layer::Kind::Add:
+            out = in;
+            for(auto i = std::next(layer.inputs.begin()); i != layer.inputs.end(); ++i)
+            {
+                const auto& addend = values[*i];
+                for(std::size_t j = 0; j < out.size(); ++j)
+                    out[j] += addend[j];
+            }
+            break;
+        }
+
+        Activate(layer.activation, out.data(), out.size());
+    }
+
+    return std::move(values.back());
+}
+
+} // namespace ai
+} // namespace miopen
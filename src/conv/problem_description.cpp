@@ -30,8 +30,11 @@
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/execution_context.hpp>
+#include <miopen/sharded_map.hpp>
 #include <miopen/tensor_layout.hpp>
 
+#include <array>
+#include <cstdint>
 #include <sstream>
 
 namespace miopen {
@@ -63,6 +66,38 @@ std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)
     return stream;
 }
 
+/// Everything BuildConfKey() depends on in a form which is cheap to build, compare and hash.
+struct ConfKey
+{
+    std::array<std::int64_t, 27> values;
+    // Short enough for the small string optimization
+    std::array<std::string, 3> layouts;
+
+    bool operator==(const ConfKey& other) const
+    {
+        return values == other.values && layouts == other.layouts;
+    }
+};
+
+struct ConfKeyHash
+{
+    std::size_t operator()(const ConfKey& key) const
+    {
+        // FNV-1a over the values
+        std::uint64_t hash = 14695981039346656037ULL;
+        const auto add     = [&](std::uint64_t value) {
+            hash ^= value;
+            hash *= 1099511628211ULL;
+        };
+        for(const auto value : key.values)
+            add(static_cast<std::uint64_t>(value));
+        for(const auto& layout : key.layouts)
+            for(const auto c : layout)
+                add(static_cast<unsigned char>(c));
+        return static_cast<std::size_t>(hash ^ (hash >> 32));
+    }
+};
+
 } // namespace
 
 std::string ProblemDescription::GetDirectionStr() const
@@ -137,6 +172,45 @@ void ProblemDescription::BuildConfKey(std::string& conf_key) const
     conf_key = ss.str();
 }
 
+NetworkConfig ProblemDescription::BuildConfKey() const
+{
+    using Map = ShardedMap<ConfKey, NetworkConfig, ConfKeyHash>;
+    // Leaked to be usable from the destructors of other static objects
+    static auto& known = *new Map{};
+
+    // clang-format off
+    const auto key = ConfKey{
+        {{static_cast<std::int64_t>(GetSpatialDims()),
+          static_cast<std::int64_t>(GetInChannels()),
+          static_cast<std::int64_t>(GetInDepth()),
+          static_cast<std::int64_t>(GetInHeight()),
+          static_cast<std::int64_t>(GetInWidth()),
+          static_cast<std::int64_t>(GetWeightsDepth()),
+          static_cast<std::int64_t>(GetWeightsHeight()),
+          static_cast<std::int64_t>(GetWeightsWidth()),
+          static_cast<std::int64_t>(GetOutChannels()),
+          static_cast<std::int64_t>(GetOutDepth()),
+          static_cast<std::int64_t>(GetOutHeight()),
+          static_cast<std::int64_t>(GetOutWidth()),
+          static_cast<std::int64_t>(GetInBatchSize()),
+          GetInDataType(), GetWeightsDataType(), GetOutDataType(),
+          GetPadD(), GetPadH(), GetPadW(),
+          GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW(),
+          GetDilationD(), GetDilationH(), GetDilationW(),
+          GetGroupCount(),
+          static_cast<std::int64_t>(GetDirection())}},
+        {{in_layout, weights_layout, out_layout}}};
+    // clang-format on
+
+    const auto hash = Map::HashOf(key);
+    if(const auto found = known.Find(key, hash))
+        return *found;
+
+    std::string conf_key;
+    BuildConfKey(conf_key);
+    return *known.Emplace(key, hash, NetworkConfig{conf_key}).first;
+}
+
 void ProblemDescription::Serialize(std::ostream& stream) const
 {
     const auto sep = '-';
@@ -28,8 +28,10 @@
 
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/config.h>
+#include <miopen/find_pipeline.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/perf_field.hpp>
+#include <miopen/thread_pool.hpp>
 
 namespace miopen {
 
@@ -282,18 +284,40 @@ void ConvFindCore(const AnyInvokeParams& invoke_ctx,
                   bool use_winograd_only,
                   const std::vector<std::unique_ptr<SolversFinder>>& finders)
 {
-    auto& handle = ctx.GetStream();
+    auto& handle               = ctx.GetStream();
+    auto pipeline              = FindPipeline{handle, FindPipeline::IsParallelEnabled(ctx)};
+    auto pipeline_ctx          = ctx;
+    pipeline_ctx.find_pipeline = &pipeline;
 
     // Find
+    auto found = std::vector<std::vector<solver::ConvSolution>>(finders.size());
+    {
+        const auto find = [&](std::size_t i) {
+            found[i] = finders[i]->Find(pipeline_ctx, problem, invoke_ctx, use_winograd_only);
+        };
+        if(pipeline.IsParallel())
+        {
+            TaskGroup tasks;
+            for(std::size_t i = 0; i < finders.size(); ++i)
+                tasks.Run([&, i]() { find(i); });
+            tasks.Wait();
+        }
+        else
+        {
+            for(std::size_t i = 0; i < finders.size(); ++i)
+                find(i);
+        }
+    }
+
     auto solutions = std::map<AlgorithmName, std::vector<solver::ConvSolution>>{};
-    std::transform(
-        finders.begin(), finders.end(), std::inserter(solutions, solutions.end()), [&](auto&& f) {
-            return std::make_pair(f->GetAlgorithmName(problem.conv_problem),
-                                  f->Find(ctx, problem, invoke_ctx, use_winograd_only));
-        });
+    for(std::size_t i = 0; i < finders.size(); ++i)
+        solutions.emplace(finders[i]->GetAlgorithmName(problem.conv_problem), std::move(found[i]));
 
     // Precompile
     {
+        // Most of the kernels are already compiled when solvers are evaluated in parallel
+        pipeline.Finish();
+        const FindPipeline::PhaseTimer timer{&pipeline, FindPipeline::Phase::Compile};
         auto all = std::vector<const miopen::solver::ConvSolution*>{};
         all.reserve(
             std::accumulate(solutions.begin(), solutions.end(), 0, [](auto&& before, auto&& ss) {
@@ -305,12 +329,57 @@ void ConvFindCore(const AnyInvokeParams& invoke_ctx,
     }
 
     // Evaluate Invokers
-    AutoEnableProfiling enableProfiling{handle};
-    const auto network_config = problem.BuildConfKey();
+    {
+        const FindPipeline::PhaseTimer timer{&pipeline, FindPipeline::Phase::Benchmark};
+        AutoEnableProfiling enableProfiling{handle};
+        const auto network_config = problem.BuildConfKey();
+
+        for(const auto& ss : solutions)
+            if(!ss.second.empty())
+                EvaluateInvokers(handle, ss.second, ss.first, network_config, invoke_ctx, record);
+    }
+
+    pipeline.LogTimings();
+}
+
+void ConvPrecompileCore(const Handle& handle,
+                        const std::vector<ConvPrecompileItem>& items,
+                        const std::vector<std::unique_ptr<SolversFinder>>& finders)
+{
+    auto pipeline = FindPipeline{handle, true};
+    auto contexts = std::vector<ConvolutionContext>{};
+    contexts.reserve(items.size());
+    for(const auto& item : items)
+    {
+        contexts.push_back(item.ctx);
+        contexts.back().find_pipeline = &pipeline;
+    }
+
+    // Find
+    auto found = std::vector<std::vector<solver::ConvSolution>>(items.size() * finders.size());
+    {
+        TaskGroup tasks;
+        for(std::size_t i = 0; i < items.size(); ++i)
+        {
+            for(std::size_t j = 0; j < finders.size(); ++j)
+            {
+                tasks.Run([&, i, j]() {
+                    found[i * finders.size() + j] = finders[j]->Find(
+                        contexts[i], items[i].problem, {}, items[i].use_winograd_only);
+                });
+            }
+        }
+        tasks.Wait();
+    }
+
+    // Precompile the kernels of the finders which do not precompile their solutions on their own
+    for(const auto& solutions : found)
+        for(const auto& solution : solutions)
+            pipeline.Precompile(solution);
+    pipeline.Finish();
 
-    for(const auto& ss : solutions)
-        if(!ss.second.empty())
-            EvaluateInvokers(handle, ss.second, ss.first, network_config, invoke_ctx, record);
+    MIOPEN_LOG_I("Precompiled solutions of " << items.size() << " problems");
+    pipeline.LogTimings();
 }
 
 bool IsAlgorithmDisabled(miopenConvAlgorithm_t algo)
@@ -43,6 +43,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
 #include <cmath>
 #include <ostream>
@@ -148,6 +149,38 @@ std::size_t GetWorkSpaceSizeImplicitGemmWrW(const miopen::ConvolutionContext& ct
     return GetMaxWorkSpaceSize(FindImplicitGemmWrWWorkspaceSizes(ctx, problem));
 }
 
+/// Everything besides the network config of the problem and the device which affects the set of
+/// the solvers GetWorkSpaceSize() queries: the attributes of the convolution and the bias the
+/// solvers check in IsApplicable(), the algorithm switches of the environment and the context
+/// flags. The environment controls are read once per process, but are still a part of the key
+/// so it does not depend on that.
+std::uint64_t GetWorkSpaceSizeControls(const ExecutionContext& ctx,
+                                       const conv::ProblemDescription& problem)
+{
+    auto controls  = std::uint64_t{0};
+    const auto add = [&](bool value) { controls = (controls << 1) | (value ? 1 : 0); };
+
+    const auto& attribute = problem.GetConv().attribute;
+    add(attribute.deterministic);
+    add(attribute.gfx90aFp16alt.GetFwd());
+    add(attribute.gfx90aFp16alt.GetBwd());
+    add(problem.GetBias() != 0);
+
+    add(miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{}));
+    add(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM{}));
+    add(miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{}));
+    add(miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}));
+    add(miopen::IsDisabled(MIOPEN_DEBUG_CONV_FFT{}));
+    add(GetEnvFindOnlySolver().has_value());
+    add(ctx.use_dynamic_solutions_only);
+    add(ctx.use_asm_kernels);
+    add(ctx.use_hip_kernels);
+    add(ctx.use_opencl_convolutions);
+    add(ctx.use_binaries);
+
+    return (controls << 8) | static_cast<std::uint64_t>(ctx.rmv.getValue());
+}
+
 } // namespace
 
 ConvolutionDescriptor::ConvolutionDescriptor(std::size_t spatial_dim,
@@ -434,6 +467,16 @@ std::size_t ConvolutionDescriptor::GetWorkSpaceSize(ExecutionContext ctx,
         return solutions.front().workspace_size;
     }
 
+    // Each query below evaluates the applicability and the workspace of all the solvers of the
+    // family, so the result is cached in the handle.
+    const auto network_config = problem.BuildConfKey();
+    const auto controls       = GetWorkSpaceSizeControls(ctx, problem);
+    if(const auto cached = ctx.GetStream().GetWorkspaceSize(network_config, controls))
+    {
+        MIOPEN_LOG_I(*cached << " (cached)");
+        return *cached;
+    }
+
     auto conv_ctx = ConvolutionContext{ctx};
     size_t workspace_size;
 
@@ -461,6 +504,7 @@ std::size_t ConvolutionDescriptor::GetWorkSpaceSize(ExecutionContext ctx,
                                    GetWorkSpaceSizeWinogradWrW(conv_ctx, problem)});
     }
 
+    ctx.GetStream().RegisterWorkspaceSize(network_config, controls, workspace_size);
     MIOPEN_LOG_I(workspace_size);
     return workspace_size;
 }
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/find_pipeline.hpp>
+#include <miopen/env.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/find_controls.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/logger.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_PARALLEL_FIND)
+
+namespace miopen {
+
+FindPipeline::PhaseTimer::PhaseTimer(FindPipeline* pipeline_, Phase phase_)
+    : pipeline(pipeline_), phase(phase_), start(std::chrono::steady_clock::now())
+{
+}
+
+FindPipeline::PhaseTimer::~PhaseTimer()
+{
+    if(pipeline != nullptr)
+        pipeline->AddTime(phase, std::chrono::steady_clock::now() - start);
+}
+
+FindPipeline::FindPipeline(const Handle& handle_, bool parallel_)
+    : handle(handle_),
+      parallel(parallel_),
+      kernel_cache_batch(handle_.GetTargetProperties(), handle_.GetMaxComputeUnits()),
+      max_agents(std::max<std::size_t>(solver::GetTuningThreadsMax(), 1))
+{
+}
+
+FindPipeline::~FindPipeline() = default;
+
+bool FindPipeline::IsParallelEnabled(const ExecutionContext& ctx)
+{
+    if(IsDisabled(MIOPEN_DEBUG_CONV_PARALLEL_FIND{}))
+        return false;
+    return !ctx.do_search && !FindEnforce{}.IsSearch(ctx);
+}
+
+void FindPipeline::Precompile(const solver::ConvSolution& solution)
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    for(const auto& kernel : solution.construction_params)
+    {
+        if(!requested.emplace(kernel.kernel_file, kernel.comp_options).second)
+            continue;
+        // The handle is only read until Finish()
+        if(handle.HasProgram(kernel.kernel_file, kernel.comp_options))
+            continue;
+        kernels.push_back(kernel);
+    }
+    // Same limit of parallel compilations as in PrecompileKernels()
+    while(agents < max_agents && agents < kernels.size())
+    {
+        ++agents;
+        compile_tasks.Run([this]() { CompileAgent(); });
+    }
+}
+
+void FindPipeline::CompileAgent()
+{
+    while(true)
+    {
+        solver::KernelInfo kernel;
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            if(kernels.empty())
+            {
+                --agents;
+                return;
+            }
+            kernel = std::move(kernels.front());
+            kernels.pop_front();
+        }
+
+        const PhaseTimer timer{this, Phase::Compile};
+        auto program = handle.LoadProgram(kernel.kernel_file, kernel.comp_options, false, "");
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        programs.emplace_back(std::move(kernel), std::move(program));
+    }
+}
+
+void FindPipeline::Finish()
+{
+    compile_tasks.Wait();
+    for(auto& program : programs)
+    {
+        const auto& kernel = program.first;
+        if(!handle.HasProgram(kernel.kernel_file, kernel.comp_options))
+            handle.AddProgram(std::move(program.second), kernel.kernel_file, kernel.comp_options);
+    }
+    programs.clear();
+}
+
+void FindPipeline::AddTime(Phase phase, std::chrono::steady_clock::duration time)
+{
+    times[static_cast<std::size_t>(phase)] +=
+        std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+}
+
+void FindPipeline::LogTimings() const
+{
+    const auto ms = [&](Phase phase) { return times[static_cast<std::size_t>(phase)] * .001; };
+    MIOPEN_LOG_I("Find time, ms (summed over threads): applicability: "
+                 << ms(Phase::Applicability) << ", perf-db: " << ms(Phase::PerfDb)
+                 << ", solutions: " << ms(Phase::Solution) << ", compile: "
+                 << ms(Phase::Compile) << ", benchmark: " << ms(Phase::Benchmark)
+                 << (parallel ? "" : " (serial)"));
+}
+
+} // namespace miopen
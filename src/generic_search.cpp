@@ -26,7 +26,9 @@
 
 #include <miopen/generic_search.hpp>
 #include <miopen/generic_search_controls.hpp>
+#include <miopen/logger.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 #include <chrono>
@@ -58,5 +60,62 @@ std::size_t GetTuningThreadsMax()
     return Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, def_max);
 }
 
+std::size_t GetTuningLookahead(std::size_t threads)
+{
+    // Enough to keep the agents busy while the benchmark takes the oldest results
+    return std::max<std::size_t>(Value(MIOPEN_TUNING_LOOKAHEAD{}, 2 * threads), 1);
+}
+
+TuningPipeline::TuningPipeline(std::size_t lookahead_, std::size_t threads_)
+    : lookahead(lookahead_), threads(std::max<std::size_t>(threads_, 1))
+{
+}
+
+bool TuningPipeline::TryAcquire(std::function<void()> resume)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    if(in_flight < lookahead)
+    {
+        ++in_flight;
+        return true;
+    }
+    parked.push_back(std::move(resume));
+    ++n_parked;
+    return false;
+}
+
+void TuningPipeline::Release()
+{
+    std::function<void()> resume;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        --in_flight;
+        if(parked.empty())
+            return;
+        resume = std::move(parked.back());
+        parked.pop_back();
+    }
+    resume();
+}
+
+void TuningPipeline::LogUtilization() const
+{
+    using ms           = std::chrono::duration<float, std::milli>;
+    const auto total   = ms{std::chrono::steady_clock::now() - start}.count();
+    const auto compile = ms{Duration{compile_time.load()}}.count();
+    const auto bench   = ms{benchmark_time}.count();
+    const auto wait    = ms{wait_time}.count();
+    if(total <= 0.0f)
+        return;
+
+    MIOPEN_LOG_I("Compilation: " << compile << " ms, " << 100 * compile / (total * threads)
+                                 << "% of " << threads << " threads, stopped by the lookahead of "
+                                 << lookahead << ": " << n_parked << " times");
+    MIOPEN_LOG_I("Benchmark: " << bench << " ms, " << 100 * bench / total << "%, waited for "
+                               << "compilation: " << wait << " ms, " << 100 * wait / total
+                               << "%");
+    MIOPEN_LOG_I("The search has been " << (wait > bench ? "compile" : "benchmark") << "-bound");
+}
+
 } // namespace solver
 } // namespace miopen
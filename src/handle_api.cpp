@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <cstdio>
 #include <miopen/version.h>
+#include <miopen/binary_cache.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 
@@ -114,3 +115,52 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t miopenGetKernelCacheStats(miopenHandle_t handle,
+                                                    miopenKernelCacheStats_t* stats)
+{
+    return miopen::try_([&] {
+        const auto& h = miopen::deref(handle);
+        const auto cache =
+            miopen::GetKernelCacheStats(h.GetTargetProperties(), h.GetMaxComputeUnits());
+        auto& out     = miopen::deref(stats);
+        out.hits      = cache.hits;
+        out.misses    = cache.misses;
+        out.bytes     = cache.bytes;
+        out.evictions = cache.evictions;
+    });
+}
+
+extern "C" miopenStatus_t miopenCompactKernelCache(miopenHandle_t handle)
+{
+    return miopen::try_([&] {
+        const auto& h = miopen::deref(handle);
+        miopen::CompactKernelCache(h.GetTargetProperties(), h.GetMaxComputeUnits());
+    });
+}
+
+extern "C" miopenStatus_t miopenSetMemoryPoolLimit(miopenHandle_t handle, size_t limit)
+{
+    return miopen::try_([&] { miopen::deref(handle).GetMemoryPool().SetLimit(limit); });
+}
+
+extern "C" miopenStatus_t miopenGetMemoryPoolStats(miopenHandle_t handle,
+                                                   miopenMemoryPoolStats_t* stats)
+{
+    return miopen::try_([&] {
+        const auto pool  = miopen::deref(handle).GetMemoryPool().GetStats();
+        auto& out        = miopen::deref(stats);
+        out.limit        = pool.limit;
+        out.bytes_in_use = pool.bytes_in_use;
+        out.bytes_cached = pool.bytes_cached;
+        out.peak_bytes   = pool.peak_bytes;
+        out.hits         = pool.hits;
+        out.misses       = pool.misses;
+        out.releases     = pool.releases;
+    });
+}
+
+extern "C" miopenStatus_t miopenReleaseMemoryPool(miopenHandle_t handle)
+{
+    return miopen::try_([&] { miopen::deref(handle).GetMemoryPool().Release(); });
+}
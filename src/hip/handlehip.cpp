@@ -39,6 +39,7 @@
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
 
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 #include <miopen/write_file.hpp>
@@ -253,6 +254,7 @@ struct HandleImpl
     float profiling_result = 0.0;
     int device             = -1;
     Allocator allocator{};
+    MemoryPool memory_pool;
     KernelCache cache;
     TargetProperties target_properties;
 };
@@ -358,12 +360,16 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
                           void* allocatorContext) const
 {
+    // The cached blocks belong to the previous allocator.
+    this->impl->memory_pool.Release();
     this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
     this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
 
     this->impl->allocator.context = allocatorContext;
 }
 
+MemoryPool& Handle::GetMemoryPool() const { return this->impl->memory_pool; }
+
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
 
 float Handle::GetKernelTime() const { return this->impl->profiling_result; }
@@ -371,8 +377,11 @@ float Handle::GetKernelTime() const { return this->impl->profiling_result; }
 Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
 {
     MIOPEN_HANDLE_LOCK
+    auto reused = this->impl->memory_pool.TryReuse(sz, this->GetStream());
+    if(reused)
+        return reused;
     this->Finish();
-    return this->impl->allocator(sz);
+    return this->impl->memory_pool.Allocate(this->impl->allocator, sz, this->GetStream());
 }
 
 Allocator::ManageDataPtr&
@@ -461,8 +470,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::shared_ptr<const std::vector<Kernel>>
+Handle::GetKernelsImpl(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -495,6 +504,7 @@ Program Handle::LoadProgram(const std::string& program_name,
                                     is_kernel_str);
     if(hsaco.empty())
     {
+        MIOPEN_TRACE_SCOPE_ARGS("compile", "Compile", program_name << ' ' << params);
         CompileTimer ct;
         auto p = HIPOCProgram{
             program_name, params, is_kernel_str, this->GetTargetProperties(), kernel_src};
@@ -532,6 +542,17 @@ bool Handle::HasProgram(const std::string& program_name, const std::string& para
     return this->impl->cache.HasProgram(program_name, params);
 }
 
+bool Handle::IsProgramReady(const std::string& program_name, const std::string& params) const
+{
+    if(this->HasProgram(program_name, params))
+        return true;
+    auto binary_params = params;
+    if(!miopen::EndsWith(program_name, ".mlir"))
+        binary_params += " -mcpu=" + this->GetTargetProperties().Name();
+    return miopen::HasBinary(
+        this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, binary_params);
+}
+
 void Handle::AddProgram(Program prog,
                         const std::string& program_name,
                         const std::string& params) const
@@ -25,11 +25,13 @@
  *******************************************************************************/
 
 #include <miopen/config.h>
+#include <miopen/binary_cache.hpp>
 #include <miopen/hip_build_utils.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/exec_utils.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/env.hpp>
+#include <miopen/md5.hpp>
 #include <miopen/rocm_features.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
 #include <miopen/target_properties.hpp>
@@ -42,6 +44,63 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_DUMP)
 
 namespace miopen {
 
+static void WriteHipKernelIncs(const boost::filesystem::path& dir)
+{
+    boost::filesystem::create_directories(dir);
+    for(const auto& inc_file : GetHipKernelIncList())
+        WriteFile(GetKernelInc(inc_file), dir / inc_file);
+}
+
+static boost::filesystem::path GetHipKernelIncDirImpl()
+{
+    auto contents = std::string{};
+    for(const auto& inc_file : GetHipKernelIncList())
+        contents += inc_file + '\0' + GetKernelInc(inc_file) + '\0';
+
+    const auto cache = GetCachePath(false);
+    if(!cache.empty())
+    {
+        try
+        {
+            // Named after the contents, so the directory is never modified once it exists
+            const auto dir = cache / ("include-" + md5(contents));
+            if(boost::filesystem::exists(dir))
+                return dir;
+
+            // Written aside and renamed, so a directory with this name is always complete
+            const auto tmp = cache / boost::filesystem::unique_path("include-%%%%-%%%%-%%%%-%%%%");
+            WriteHipKernelIncs(tmp);
+
+            auto ec = boost::system::error_code{};
+            boost::filesystem::rename(tmp, dir, ec);
+            if(ec)
+            {
+                // Another process has won the race
+                boost::filesystem::remove_all(tmp, ec);
+                if(!boost::filesystem::exists(dir))
+                    MIOPEN_THROW("Can't create " + dir.string());
+            }
+            MIOPEN_LOG_I2(dir.string());
+            return dir;
+        }
+        catch(const boost::filesystem::filesystem_error& ex)
+        {
+            MIOPEN_LOG_W(ex.what());
+        }
+    }
+
+    // Without the user cache the includes are shared by the builds of this process only
+    static const auto process_dir = TmpDir{"include"};
+    WriteHipKernelIncs(process_dir.path);
+    return process_dir.path;
+}
+
+const boost::filesystem::path& GetHipKernelIncDir()
+{
+    static const auto dir = GetHipKernelIncDirImpl();
+    return dir;
+}
+
 static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                                             const std::string& filename,
                                             std::string src,
@@ -50,28 +109,12 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                                             const bool testing_mode)
 {
 #ifdef __linux__
-    // Write out the include files
-    // Let's assume includes are overkill for feature tests & optimize'em out.
-    if(!testing_mode)
-    {
-        auto inc_list = GetHipKernelIncList();
-        auto inc_path = tmp_dir->path;
-        boost::filesystem::create_directories(inc_path);
-        for(const auto& inc_file : inc_list)
-        {
-            auto inc_src = GetKernelInc(inc_file);
-            WriteFile(inc_src, inc_path / inc_file);
-        }
-    }
-
     src += "\nint main() {}\n";
     WriteFile(src, tmp_dir->path / filename);
 
     // cppcheck-suppress unreadVariable
     const LcOptionTargetStrings lots(target);
 
-    auto env = std::string("");
-
     if(params.find("-std=") == std::string::npos)
         params += " --std=c++11";
 
@@ -84,6 +127,9 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
     params += " -c";
     params += " -O3 ";
     params += " -Wno-unused-command-line-argument -I. ";
+    // Let's assume includes are overkill for feature tests & optimize'em out.
+    if(!testing_mode)
+        params += "-I" + GetHipKernelIncDir().string() + " ";
     params += MIOPEN_STRINGIZE(HIP_COMPILER_FLAGS);
 
 #if HIP_PACKAGE_VERSION_FLAT < 4004000000ULL
@@ -110,9 +156,9 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
     auto bin_file = tmp_dir->path / (filename + ".o");
 
     // compile
-    const std::string redirector = testing_mode ? " 1>/dev/null 2>&1" : "";
-    tmp_dir->Execute(env + std::string(" ") + MIOPEN_HIP_COMPILER,
-                     params + filename + " -o " + bin_file.string() + redirector);
+    tmp_dir->Execute(MIOPEN_HIP_COMPILER,
+                     params + filename + " -o " + bin_file.string(),
+                     testing_mode);
     if(!boost::filesystem::exists(bin_file))
         MIOPEN_THROW(filename + " failed to compile");
 
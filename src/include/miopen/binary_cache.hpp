@@ -30,6 +30,7 @@
 #include <miopen/config.h>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem/path.hpp>
+#include <cstdint>
 #include <string>
 
 namespace miopen {
@@ -43,6 +44,36 @@ boost::filesystem::path GetCacheFile(const std::string& device,
 
 boost::filesystem::path GetCachePath(bool is_system);
 
+/// Size limit of the user kernel cache in bytes, set by MIOPEN_CACHE_SIZE_LIMIT in MiB.
+/// Zero if the cache is unlimited.
+std::uint64_t GetCacheSizeLimit();
+
+struct KernelCacheStats
+{
+    std::size_t hits;
+    std::size_t misses;
+    std::uint64_t bytes;
+    std::size_t evictions;
+};
+
+/// The hits, the misses and the evictions are counted for this process, the size is of the
+/// current user cache of the target.
+KernelCacheStats GetKernelCacheStats(const TargetProperties& target, std::size_t num_cu);
+/// Evicts the kernels beyond the size limit from the user cache and returns the space freed
+/// by the evicted kernels to the filesystem.
+void CompactKernelCache(const TargetProperties& target, std::size_t num_cu);
+/// Removes the least recently used kernel files of the directory cache, see GetCacheFile(),
+/// until they take no more than the size. Returns the number of removed files.
+std::size_t ShrinkCacheDirectory(const boost::filesystem::path& dir, std::uint64_t size);
+
+/// True when the binary is in the cache. Unlike LoadBinary(), the binary is not read, and the
+/// statistics and the access times of the cache are left as they are.
+bool HasBinary(const TargetProperties& target,
+               std::size_t num_cu,
+               const std::string& name,
+               const std::string& args,
+               bool is_kernel_str = false);
+
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 boost::filesystem::path LoadBinary(const TargetProperties& target,
                                    std::size_t num_cu,
@@ -69,6 +100,26 @@ void SaveBinary(const std::string& hsaco,
                 bool is_kernel_str = false);
 #endif
 
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+class KernDb;
+#endif
+
+/// Binaries saved to the user cache during the lifetime of the object are written to it
+/// at once when the last of such objects existing at the same time is destroyed.
+class KernelCacheBatch
+{
+public:
+    KernelCacheBatch(const TargetProperties& target, std::size_t num_cu);
+    ~KernelCacheBatch();
+    KernelCacheBatch(const KernelCacheBatch&) = delete;
+    KernelCacheBatch& operator=(const KernelCacheBatch&) = delete;
+
+private:
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    KernDb* db = nullptr;
+#endif
+};
+
 } // namespace miopen
 
 #endif
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef MIOPEN_GUARD_MLOPEN_BINARY_DB_HPP
+#define MIOPEN_GUARD_MLOPEN_BINARY_DB_HPP
+
+#include <miopen/config.h>
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace boost {
+namespace interprocess {
+class mapped_region;
+} // namespace interprocess
+} // namespace boost
+
+namespace miopen {
+
+/// Read-only database stored in the pre-indexed binary format.
+///
+/// Such files are produced offline by the MIOpenDbConvert tool from the text and SQLite
+/// system databases and are installed next to them with the ".bin" suffix appended to the
+/// name (e.g. gfx90a68.db.bin). Loading is a memory mapping and a header validation, records
+/// are looked up by a binary search over the hashes of the keys. Solver IDs are stored as
+/// the values of the solver::Id registry, IDs unknown to the registry are stored as strings.
+///
+/// Layout (native byte order):
+///   Header
+///   IndexItem[record_count]   sorted by key hash, then by key
+///   ValueItem[value_count]    values of each record are stored contiguously
+///   string data               keys, schema, unregistered IDs and VALUES
+class BinaryDb
+{
+public:
+    static constexpr uint32_t format_version = 2;
+
+    enum class KeyKind : uint32_t
+    {
+        /// Keys are the serialized problem descriptions used by the text databases.
+        Text = 1,
+        /// Keys are the values of the SQLite config table joined in the schema order.
+        SQLiteConfig = 2,
+    };
+
+    /// Database a binary one is built from. The binary database is used only if its source
+    /// is present and matches all of these, otherwise the binary one is outdated.
+    struct Source
+    {
+        uint64_t size = 0;
+        /// Seconds since the epoch. The embedded databases have none, only their size and
+        /// contents are checked.
+        int64_t mtime = 0;
+        /// md5 of the contents
+        std::string md5;
+
+        /// Throws if the file is unreadable
+        static Source FromFile(const std::string& path);
+    };
+
+    ~BinaryDb();
+
+    static std::string GetPath(const std::string& db_path) { return db_path + ".bin"; }
+
+    /// Loads the binary counterpart of the database at db_path if it is present (on disk
+    /// or in the embedded data), valid, of the requested kind and built from the database
+    /// at db_path as it is now, see Source. Returns nullptr otherwise.
+    static std::unique_ptr<BinaryDb> TryLoad(const std::string& db_path, KeyKind kind);
+
+    static void Write(const std::string& path,
+                      KeyKind kind,
+                      const std::string& schema,
+                      const Source& source,
+                      const std::vector<DbRecord>& records);
+
+    static std::vector<DbRecord> ReadTextDb(const std::string& path);
+#if MIOPEN_ENABLE_SQLITE
+    static std::vector<DbRecord> ReadSQLitePerfDb(const std::string& path);
+    static std::string SQLiteSchema();
+    static std::string SQLiteKey(const std::vector<std::string>& values);
+#endif
+
+    boost::optional<DbRecord> FindRecord(const std::string& key) const;
+
+    template <class TProblem>
+    boost::optional<DbRecord> FindRecord(const TProblem& problem) const
+    {
+        const auto key = DbRecord::Serialize(problem);
+        return FindRecord(key);
+    }
+
+    const std::string& GetPath() const { return path; }
+    std::string_view GetSchema() const { return schema; }
+    std::size_t GetSize() const { return record_count; }
+
+private:
+    std::string path;
+    std::unique_ptr<boost::interprocess::mapped_region> mapping;
+    std::string_view data;
+    std::string_view schema;
+    uint64_t record_count = 0;
+    uint64_t index_offset = 0;
+    uint64_t value_count  = 0;
+    uint64_t value_offset = 0;
+
+    BinaryDb(std::string path_, std::string_view data_);
+
+    BinaryDb(const BinaryDb&) = delete;
+    BinaryDb(BinaryDb&&)      = delete;
+    BinaryDb& operator=(const BinaryDb&) = delete;
+    BinaryDb& operator=(BinaryDb&&) = delete;
+
+    /// The hash of the source is computed last, only if all the other checks pass
+    bool Validate(KeyKind kind,
+                  uint64_t source_size,
+                  boost::optional<int64_t> source_mtime,
+                  const std::function<std::string()>& source_md5);
+    boost::optional<std::string_view> GetString(uint64_t offset, uint64_t size) const;
+};
+
+} // namespace miopen
+
+#endif
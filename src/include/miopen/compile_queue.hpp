@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_QUEUE_HPP_
+#define GUARD_MIOPEN_COMPILE_QUEUE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace miopen {
+
+/// Runs compilation jobs on background threads. Jobs are identified by keys: a job is not
+/// queued again while it is pending, and a failed job is not retried. The threads are started
+/// on the first job. Queued jobs which are not started yet are dropped on destruction.
+class CompileQueue
+{
+public:
+    enum class State
+    {
+        None,
+        Pending,
+        Failed,
+    };
+
+    /// By default uses half of the hardware threads leaving the rest to the callers.
+    explicit CompileQueue(std::size_t workers = 0);
+    ~CompileQueue();
+    CompileQueue(CompileQueue&&) noexcept;
+    CompileQueue& operator=(CompileQueue&&) noexcept;
+
+    State GetState(const std::string& key) const;
+    /// Returns false if the job with this key is pending or has failed already.
+    bool Push(const std::string& key, std::function<void()> job);
+    /// Waits until there are no pending jobs.
+    void Wait() const;
+    /// Waits until the job with this key is not pending, returns its state then.
+    State Wait(const std::string& key) const;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> pImpl;
+};
+
+/// Gets the result of the keyed build, compiling it in background when there is a fallback:
+/// - the result registered by a previous build, if any,
+/// - while the build is pending, the fallback, or if there is none the result of the build in
+///   flight, which is waited for rather than repeated,
+/// - when the build would compile, the fallback after queuing the build,
+/// - otherwise the result of a synchronous build, which also reports the error of a failed one.
+/// The build registers its result, so ready() returns it afterwards. It is copied to the queue.
+template <class Ready, class Fallback, class IsCached, class Build>
+auto GetOrBuildInBackground(CompileQueue& queue,
+                            const std::string& key,
+                            Ready ready,
+                            Fallback fallback,
+                            IsCached is_cached,
+                            Build build) -> decltype(build())
+{
+    if(const auto result = ready())
+        return *result;
+
+    auto state = queue.GetState(key);
+    if(state == CompileQueue::State::Pending)
+    {
+        if(const auto result = fallback())
+            return *result;
+        state = queue.Wait(key);
+        if(const auto result = ready())
+            return *result;
+    }
+
+    if(state != CompileQueue::State::Failed && !is_cached())
+    {
+        if(const auto result = fallback())
+        {
+            queue.Push(key, [build]() { build(); });
+            return *result;
+        }
+    }
+
+    return build();
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_QUEUE_HPP_
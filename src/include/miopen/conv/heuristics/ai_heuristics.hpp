@@ -71,9 +71,15 @@ public:
     size_t EncodeLayout(const std::string& layout) const;
 };
 class Model;
+/// The solvers ranked by TunaNet, empty when the problem is not supported by it. The results
+/// are cached by the problem.
 std::vector<uint64_t> PredictSolver(const ProblemDescription& problem,
                                     const ConvolutionContext& ctx,
                                     const std::string& device);
+/// Same for many problems, e.g. the layers of a network, evaluated by the model in one pass.
+std::vector<std::vector<uint64_t>> PredictSolvers(const std::vector<ProblemDescription>& problems,
+                                                  const ConvolutionContext& ctx,
+                                                  const std::string& device);
 } // namespace immed_mode
 
 #endif // MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_DENSE_NET_HPP_
+#define GUARD_MIOPEN_DENSE_NET_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace ai {
+
+/// Evaluates the frugally-deep models which are graphs of the dense layers, like TunaNet.
+/// For such small models it is much lighter than fdeep, and it evaluates a batch of inputs
+/// in one pass.
+class DenseNet
+{
+public:
+    /// Returns nullptr when the model has layers which are not supported here.
+    static std::unique_ptr<DenseNet> Load(const std::string& path);
+
+    std::size_t InputSize() const { return layers.front().size; }
+    std::size_t OutputSize() const { return layers.back().size; }
+
+    /// The inputs and the outputs are row-major matrices with a row per item of the batch.
+    std::vector<float> Forward(const std::vector<float>& inputs, std::size_t batch) const;
+
+    enum class Activation
+    {
+        Linear,
+        Relu,
+        Sigmoid,
+        Tanh,
+    };
+
+    struct Layer
+    {
+        enum class Kind
+        {
+            Input,
+            Dense,
+            Activation,
+            Add,
+        };
+
+        Kind kind;
+        std::size_t size;
+        std::vector<std::size_t> inputs; // Indices of the preceding layers
+        Activation activation = Activation::Linear;
+        std::vector<float> weights; // Input-major
+        std::vector<float> bias;
+    };
+
+private:
+    std::vector<Layer> layers; // Topologically sorted, the output is the last one
+};
+
+} // namespace ai
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DENSE_NET_HPP_
@@ -372,12 +372,9 @@ struct ProblemDescription : ProblemDescriptionBase
 
     void BuildConfKey(std::string& conf_key) const;
 
-    NetworkConfig BuildConfKey() const
-    {
-        std::string ret;
-        BuildConfKey(ret);
-        return NetworkConfig{ret};
-    }
+    /// The string is only built for the first of the equal problems. The following ones find
+    /// the interned config by a binary key of the values it depends on.
+    NetworkConfig BuildConfKey() const;
 
     void Serialize(std::ostream& stream) const;
 
@@ -36,6 +36,7 @@
 namespace miopen {
 
 class DbRecord;
+struct Handle;
 
 class SolversFinder
 {
@@ -87,5 +88,21 @@ void ConvFindCore(const AnyInvokeParams& invoke_ctx,
                   bool use_winograd_only,
                   const std::vector<std::unique_ptr<SolversFinder>>& finders);
 
+/// A problem to precompile by ConvPrecompileCore(), the arguments of ConvFindCore() which do not
+/// depend on the buffers.
+struct ConvPrecompileItem
+{
+    ConvolutionContext ctx;
+    ProblemDescription problem;
+    bool use_winograd_only;
+};
+
+/// Evaluates the solvers of all the problems in parallel and compiles the union of the kernels
+/// of their solutions in a single pass, so the following ConvFindCore() calls only benchmark
+/// them. Used by the Find of several problems at once, e.g. all the layers of a network.
+void ConvPrecompileCore(const Handle& handle,
+                        const std::vector<ConvPrecompileItem>& items,
+                        const std::vector<std::unique_ptr<SolversFinder>>& finders);
+
 bool IsAlgorithmDisabled(miopenConvAlgorithm_t algo);
 } // namespace miopen
@@ -250,6 +250,8 @@ public:
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
     friend class RamDb;
+    friend class IndexedTextDb;
+    friend class BinaryDb;
 };
 
 } // namespace miopen
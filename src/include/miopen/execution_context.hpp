@@ -69,6 +69,8 @@ namespace conv {
 struct ProblemDescription;
 } // namespace conv
 
+class FindPipeline;
+
 struct ExecutionContext
 {
     // Solution-specific
@@ -90,6 +92,8 @@ struct ExecutionContext
     // performance config.
     bool disable_perfdb_access      = false;
     bool use_dynamic_solutions_only = false;
+    // Set during Find to evaluate the solvers in parallel, see ConvFindCore().
+    FindPipeline* find_pipeline = nullptr;
 
     inline Handle& GetStream() const { return *stream; }
     inline void SetStream(Handle* stream_) { stream = stream_; }
@@ -32,6 +32,7 @@
 #include <miopen/db_path.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
+#include <miopen/indexedtextdb.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/ramdb.hpp>
 #include <miopen/readonlyramdb.hpp>
@@ -53,10 +54,16 @@ class FindDbRecord_t;
 
 #if MIOPEN_DEBUG_FIND_DB_CACHING
 using SystemFindDb = ReadonlyRamDb;
-using UserFindDb   = RamDb;
 #else
 using SystemFindDb = PlainTextDb;
-using UserFindDb   = PlainTextDb;
+#endif
+
+#if MIOPEN_ENABLE_INDEXED_USER_DB
+using UserFindDb = IndexedTextDb;
+#elif MIOPEN_DEBUG_FIND_DB_CACHING
+using UserFindDb = RamDb;
+#else
+using UserFindDb = PlainTextDb;
 #endif
 
 using FindDb           = MultiFileDb<SystemFindDb, UserFindDb, false>;
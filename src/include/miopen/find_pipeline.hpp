@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FIND_PIPELINE_HPP_
+#define GUARD_MIOPEN_FIND_PIPELINE_HPP_
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct ExecutionContext;
+
+/// State of a Find shared by the solvers through ExecutionContext::find_pipeline, see
+/// ConvFindCore(). When the solvers are evaluated in parallel, the kernels of each solution
+/// are compiled as soon as it is found, while the other solvers are still being evaluated.
+/// Also accumulates the time spent in the phases of the Find.
+class FindPipeline
+{
+public:
+    enum class Phase
+    {
+        Applicability,
+        PerfDb,
+        Solution, // Includes the perf-db accesses
+        Compile,
+        Benchmark,
+        Count_,
+    };
+
+    /// Adds the lifetime of the object to the time of the phase. Does nothing for nullptr.
+    class PhaseTimer
+    {
+    public:
+        PhaseTimer(FindPipeline* pipeline_, Phase phase_);
+        ~PhaseTimer();
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    private:
+        FindPipeline* pipeline;
+        Phase phase;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    FindPipeline(const Handle& handle_, bool parallel_);
+    ~FindPipeline();
+    FindPipeline(const FindPipeline&) = delete;
+    FindPipeline& operator=(const FindPipeline&) = delete;
+
+    /// Solvers are evaluated in parallel unless MIOPEN_DEBUG_CONV_PARALLEL_FIND is disabled or
+    /// tuning is requested, as it benchmarks kernels. So IsApplicable(), GetSolution() and the
+    /// default performance configs of the solvers must not modify unsynchronized static state.
+    static bool IsParallelEnabled(const ExecutionContext& ctx);
+
+    bool IsParallel() const { return parallel; }
+    /// Perf-db accesses of the solvers evaluated in parallel are serialized with it.
+    std::mutex& DbMutex() { return db_mutex; }
+
+    /// Thread-safe. Starts compilation of the kernels which are not in the handle yet.
+    void Precompile(const solver::ConvSolution& solution);
+    /// Waits for the compilation and adds the programs to the handle.
+    void Finish();
+
+    void AddTime(Phase phase, std::chrono::steady_clock::duration time);
+    void LogTimings() const;
+
+private:
+    const Handle& handle;
+    const bool parallel;
+    const KernelCacheBatch kernel_cache_batch;
+    std::mutex db_mutex;
+
+    std::mutex mutex;
+    std::set<std::pair<std::string, std::string>> requested;
+    std::deque<solver::KernelInfo> kernels;
+    std::vector<std::pair<solver::KernelInfo, Program>> programs;
+    std::size_t agents = 0;
+    std::size_t max_agents;
+
+    std::array<std::atomic<int64_t>, static_cast<std::size_t>(Phase::Count_)> times{};
+    // The last one to finish the tasks before the other members are destroyed
+    TaskGroup compile_tasks;
+
+    void CompileAgent();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_PIPELINE_HPP_
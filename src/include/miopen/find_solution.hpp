@@ -31,11 +31,14 @@
 #include <miopen/conv_solution.hpp>
 #include <miopen/execution_context.hpp>
 #include <miopen/find_controls.hpp>
+#include <miopen/find_pipeline.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/trace.hpp>
 
 #include <limits>
+#include <mutex>
 #include <vector>
 
 namespace miopen {
@@ -168,6 +171,68 @@ ConvSolution FindSolution(Solver s,
     return solution;
 }
 
+/// Perf-db of the solvers evaluated by a Find. Serializes the accesses of the solvers running
+/// in parallel and measures their time.
+template <class Db>
+class FindPipelineDb
+{
+public:
+    FindPipelineDb(Db& db_, FindPipeline* pipeline_) : db(db_), pipeline(pipeline_) {}
+
+    template <class... Ts>
+    auto Load(Ts&&... xs)
+    {
+        return Access([&]() { return db.Load(std::forward<Ts>(xs)...); });
+    }
+
+    template <class... Ts>
+    auto Remove(Ts&&... xs)
+    {
+        return Access([&]() { return db.Remove(std::forward<Ts>(xs)...); });
+    }
+
+    template <class... Ts>
+    auto Update(Ts&&... xs)
+    {
+        return Access([&]() { return db.Update(std::forward<Ts>(xs)...); });
+    }
+
+private:
+    Db& db;
+    FindPipeline* pipeline;
+
+    template <class F>
+    auto Access(F f)
+    {
+        std::unique_lock<std::mutex> lock;
+        if(pipeline != nullptr)
+            lock = std::unique_lock<std::mutex>{pipeline->DbMutex()};
+        const FindPipeline::PhaseTimer timer{pipeline, FindPipeline::Phase::PerfDb};
+        return f();
+    }
+};
+
+template <class Solver, class Context, class Problem>
+bool IsApplicableTimed(const Solver& s, const Context& ctx, const Problem& problem)
+{
+    const FindPipeline::PhaseTimer timer{ctx.find_pipeline, FindPipeline::Phase::Applicability};
+    MIOPEN_TRACE_SCOPE_ARGS("find", "IsApplicable", s.SolverDbId());
+    return s.IsApplicable(ctx, problem);
+}
+
+template <class Solver, class Context, class Problem, class Db>
+ConvSolution FindSolutionTimed(Solver s,
+                               const Context& ctx,
+                               const Problem& problem,
+                               Db& db,
+                               const AnyInvokeParams& invoke_ctx)
+{
+    const FindPipeline::PhaseTimer timer{ctx.find_pipeline, FindPipeline::Phase::Solution};
+    MIOPEN_TRACE_SCOPE_ARGS("find", "FindSolution", s.SolverDbId());
+    auto pipeline_db = FindPipelineDb<Db>{db, ctx.find_pipeline};
+    return FindSolution(s, ctx, problem, pipeline_db, invoke_ctx);
+}
+
 template <class... Solvers>
 struct SolverContainer
 {
@@ -180,6 +245,11 @@ struct SolverContainer
                           const AnyInvokeParams& invoke_ctx,
                           std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
+        // The limit implies the order of evaluation
+        if(ctx.find_pipeline != nullptr && ctx.find_pipeline->IsParallel() &&
+           limit == std::numeric_limits<std::size_t>::max())
+            return SearchForAllSolutionsParallel<Solution>(ctx, problem, db, invoke_ctx);
+
         std::vector<Solution> ss;
         std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
@@ -198,13 +268,13 @@ struct SolverContainer
                 {
                     MIOPEN_LOG_I2(solver.SolverDbId() << ": Skipped (non-dynamic)");
                 }
-                else if(!solver.IsApplicable(ctx, problem))
+                else if(!IsApplicableTimed(solver, ctx, problem))
                 {
                     MIOPEN_LOG_I2(solver.SolverDbId() << ": Not applicable");
                 }
                 else
                 {
-                    const Solution s = FindSolution(solver, ctx, problem, db, invoke_ctx);
+                    const Solution s = FindSolutionTimed(solver, ctx, problem, db, invoke_ctx);
                     if(s.Succeeded())
                     {
                         ++count;
@@ -227,6 +297,62 @@ struct SolverContainer
         return ss;
     }
 
+    /// Evaluates the solvers on the thread pool of the Find, the order of the result is the same
+    /// as the one of the serial search. Kernels of each solution are precompiled right away.
+    template <class Solution, class Context, class Problem, class Db>
+    std::vector<Solution> SearchForAllSolutionsParallel(const Context& ctx,
+                                                        const Problem& problem,
+                                                        Db& db,
+                                                        const AnyInvokeParams& invoke_ctx) const
+    {
+        auto& pipeline       = *ctx.find_pipeline;
+        const auto find_only = GetEnvFindOnlySolver();
+        // Each solver finds either one or no solution
+        std::vector<std::vector<Solution>> found(sizeof...(Solvers));
+        auto next = found.begin();
+        TaskGroup tasks;
+        miopen::each_args(
+            [&](auto solver) {
+                auto* const result = &*next++;
+                if(find_only &&
+                   (std::find(find_only->begin(), find_only->end(), Id{solver.SolverDbId()}) ==
+                    find_only->end()))
+                { // Do nothing (and keep silence for the sake of Tuna), just skip.
+                }
+                else if(ctx.use_dynamic_solutions_only && !solver.IsDynamic())
+                {
+                    MIOPEN_LOG_I2(solver.SolverDbId() << ": Skipped (non-dynamic)");
+                }
+                else
+                {
+                    tasks.Run([&, solver, result]() {
+                        if(!IsApplicableTimed(solver, ctx, problem))
+                        {
+                            MIOPEN_LOG_I2(solver.SolverDbId() << ": Not applicable");
+                            return;
+                        }
+                        Solution s = FindSolutionTimed(solver, ctx, problem, db, invoke_ctx);
+                        if(!s.Succeeded())
+                        {
+                            MIOPEN_LOG_I(solver.SolverDbId()
+                                         << ": [Warning] Applicable Solver not succeeded.");
+                            return;
+                        }
+                        pipeline.Precompile(s);
+                        result->push_back(std::move(s));
+                        MIOPEN_LOG_I2(solver.SolverDbId() << ": Success.");
+                    });
+                }
+            },
+            Solvers{}...);
+        tasks.Wait();
+
+        std::vector<Solution> ss;
+        for(auto& solutions : found)
+            std::move(solutions.begin(), solutions.end(), std::back_inserter(ss));
+        return ss;
+    }
+
     // Search for all applicable solutions among many solvers
     template <class Problem, class Solution = miopen::solver::ConvSolution>
     std::vector<Solution>
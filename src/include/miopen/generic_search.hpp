@@ -39,15 +39,23 @@
 #include <miopen/type_traits.hpp>
 #include <miopen/mt_queue.hpp>
 #include <miopen/generic_search_controls.hpp>
+#include <miopen/search_strategy.hpp>
+#include <miopen/thread_pool.hpp>
+#include <miopen/trace.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <cstdlib>
 #include <limits>
 #include <iterator>
 #include <chrono>
 #include <cassert>
+#include <functional>
+#include <mutex>
 #include <random>
+#include <sstream>
+#include <string>
 
 namespace miopen {
 namespace solver {
@@ -302,47 +310,128 @@ GetAllSolutions(const Solver s, const Context& context_, const Problem& problem)
 std::size_t GetTuningIterationsMax();
 std::chrono::milliseconds GetTuningTimeMax(); // returns the max allowed time in milliseconds
 std::size_t GetTuningThreadsMax();
+/// Max number of configs compiled ahead of the benchmark, see TuningPipeline.
+std::size_t GetTuningLookahead(std::size_t threads);
+
+/// Connects the compile agents of GenericSearch with the benchmark. A config takes a slot
+/// before it is compiled and frees it when its programs are cleared after the benchmark, so
+/// the compiled programs do not pile up in memory when compilation is faster than the GPU.
+/// Also measures how busy both stages are.
+class TuningPipeline
+{
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    TuningPipeline(std::size_t lookahead_, std::size_t threads_);
+
+    /// Takes a slot. If there is none, keeps resume to be run by a Release() and returns false.
+    bool TryAcquire(std::function<void()> resume);
+    void Release();
+
+    void AddCompileTime(Duration time) { compile_time += time.count(); }
+    void AddBenchmarkTime(Duration time) { benchmark_time += time; }
+    void AddWaitTime(Duration time) { wait_time += time; }
+    /// Tells if the search has been compile-bound or benchmark-bound.
+    void LogUtilization() const;
+
+private:
+    std::size_t lookahead;
+    std::size_t threads;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::mutex mutex;
+    std::size_t in_flight = 0;
+    std::vector<std::function<void()>> parked;
+    std::size_t n_parked = 0;
+
+    std::atomic<Duration::rep> compile_time{0}; // Sum over the agents
+    Duration benchmark_time{0};
+    Duration wait_time{0}; // Benchmark waiting for compilation
+};
 
+/// Compiles the next config and continues with the one after it as a new task of the agents
+/// group. Hence the number of agents limits the number of compilations in flight, while a
+/// thread which helps the pool runs only one compilation at a time. An agent without a free
+/// slot in the pipeline stops until the benchmark frees one.
 template <typename PerformanceConfig, typename Solver, typename Context, typename Problem>
-void CompileAgent(size_t thread_index,
-                  size_t total_threads,
+void CompileAgent(std::atomic<std::size_t>& next_index,
+                  std::chrono::steady_clock::time_point start_time,
+                  TaskGroup& agents,
+                  TuningPipeline& pipeline,
                   const Solver& s,
                   const Context& context,
                   const Problem& problem,
-                  std::vector<PerformanceConfig>& data,
-                  ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>>& comp_queue)
+                  const std::vector<PerformanceConfig>& data,
+                  ThreadSafeQueue<std::tuple<std::size_t, ConvSolution, bool>>& comp_queue)
 {
-    const auto start_time =
-        std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now());
-    const auto data_size   = data.size();
-    const auto time_budget = GetTuningTimeMax();
-    const auto& profile_h  = context.GetStream();
-    // start the counter
-    for(auto idx = thread_index; idx < data_size; idx += total_threads)
+    const auto next = [&, start_time]() {
+        agents.Run([&, start_time]() {
+            CompileAgent<PerformanceConfig, Solver, Context, Problem>(
+                next_index, start_time, agents, pipeline, s, context, problem, data, comp_queue);
+        });
+    };
+
+    if(!pipeline.TryAcquire(next))
+        return;
+
+    const auto idx = next_index++;
+    if(idx >= data.size())
+    {
+        pipeline.Release();
+        return;
+    }
+
+    // Check if we are out of time
+    if(std::chrono::steady_clock::now() - start_time > GetTuningTimeMax())
     {
-        // Check if we are out of time
-        const auto current_time = std::chrono::time_point_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now());
-        if(current_time - start_time > time_budget)
+        MIOPEN_LOG_I2("Config: " << idx << " Skipped, exhausted time budget");
+        comp_queue.push(std::make_tuple(idx, ConvSolution{}, true));
+    }
+    else
+    {
+        const auto& profile_h      = context.GetStream();
+        const auto& current_config = data.at(idx);
+        const auto compile_start   = std::chrono::steady_clock::now();
+        try
         {
-            MIOPEN_LOG_I2("Thread: " << thread_index << " Done, exhausted time budget");
-            auto tmp = std::make_tuple<PerformanceConfig, ConvSolution, bool>({}, {}, true);
-            comp_queue.push(std::move(tmp));
-            break;
+            ConvSolution current_solution = s.GetSolution(context, problem, current_config);
+            for(const auto& kernel : current_solution.construction_params)
+            {
+                if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
+                    continue;
+                std::ignore =
+                    profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, false, "");
+            }
+            comp_queue.push(std::make_tuple(idx, std::move(current_solution), false));
         }
-        auto& current_config          = data.at(idx);
-        ConvSolution current_solution = s.GetSolution(context, problem, current_config);
-        for(const auto& kernel : current_solution.construction_params)
+        catch(const std::exception& ex)
         {
-            if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
-                continue;
-            std::ignore = profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, false, "");
+            MIOPEN_LOG_E("Config: " << idx << " Skipped, compilation failed: " << ex.what());
+            comp_queue.push(std::make_tuple(idx, ConvSolution{}, true));
         }
-        auto tup = std::make_tuple<PerformanceConfig, ConvSolution, bool>(
-            std::move(current_config), std::move(current_solution), false);
-        comp_queue.push(std::move(tup));
+        pipeline.AddCompileTime(std::chrono::steady_clock::now() - compile_start);
+    }
+
+    next();
+}
+
+template <class PerformanceConfig>
+SearchSpace MakeSearchSpace(const std::vector<PerformanceConfig>& configs,
+                            const PerformanceConfig& default_config)
+{
+    auto serialized = std::vector<std::string>{};
+    serialized.reserve(configs.size());
+    for(const auto& config : configs)
+    {
+        std::ostringstream ss;
+        config.Serialize(ss);
+        serialized.push_back(ss.str());
     }
-    MIOPEN_LOG_I2("Thread: " << thread_index << " Done, completed tuning");
+
+    const auto found = std::find(configs.begin(), configs.end(), default_config);
+    return {std::move(serialized),
+            found == configs.end() ? boost::none
+                                   : boost::make_optional<std::size_t>(found - configs.begin())};
 }
 
 template <class Solver, class Context, class Problem>
@@ -357,13 +446,14 @@ auto GenericSearch(const Solver s,
           HasMember<RunAndMeasure_t, Solver, Data_t, ConstData_t>{}),
         "RunAndMeasure is obsolete. Solvers should implement auto-tune evaluation in invoker");
 
+    MIOPEN_TRACE_SCOPE_ARGS("tuning", "GenericSearch", s.SolverDbId());
     auto context                  = context_;
     context.is_for_generic_search = true;
 
     using PerformanceConfig = decltype(s.GetDefaultPerformanceConfig(context, problem));
     PerformanceConfig best_config;
-    const auto default_solution =
-        s.GetSolution(context, problem, s.GetDefaultPerformanceConfig(context, problem));
+    const auto default_config   = s.GetDefaultPerformanceConfig(context, problem);
+    const auto default_solution = s.GetSolution(context, problem, default_config);
     const auto invoke_ctx = [invoke_ctx_]() {
         auto copy = invoke_ctx_;
         copy.SetInvokeType(InvokeType::AutoTune);
@@ -377,59 +467,98 @@ auto GenericSearch(const Solver s,
     // For random access
     std::vector<PerformanceConfig> all_configs;
     std::copy(tmp_all_configs.begin(), tmp_all_configs.end(), std::back_inserter(all_configs));
-    // shuffle the configs
+
+    // The strategy selects the configs to evaluate, see MIOPEN_TUNING_STRATEGY
+    const auto space = MakeSearchSpace(all_configs, default_config);
     std::random_device rd{};
-    auto rng = std::default_random_engine{rd()};
-    std::shuffle(all_configs.begin(), all_configs.end(), rng);
-    const std::size_t n_runs_total = std::min(all_configs.size(), GetTuningIterationsMax());
-    all_configs.resize(n_runs_total);
-
-    bool is_passed  = false; // left false only if all iterations failed.
-    float best_time = std::numeric_limits<float>::max();
-    size_t n_failed = 0;
-    size_t n_best   = 0;
+    const auto strategy =
+        MakeSearchStrategy(GetTuningStrategy(), space, GetTuningIterationsMax(), rd());
+    const std::size_t n_runs_total = strategy->GetMaxEvaluations();
+
+    bool is_passed   = false; // left false only if all iterations failed.
+    float best_time  = std::numeric_limits<float>::max();
+    size_t n_failed  = 0;
+    size_t n_best    = 0;
+    size_t n_current = 0;
+    // Best of the rough measurements, used only if the search stops before any precise one.
+    boost::optional<PerformanceConfig> rough_best_config;
+    float rough_best_time = std::numeric_limits<float>::max();
     HeartBeat<PerformanceConfig> heartbeat;
     heartbeat.Start();
 
     const auto total_threads = GetTuningThreadsMax();
-
-    ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>> solution_queue;
-    std::vector<std::thread> compile_agents;
-    compile_agents.reserve(total_threads);
-    for(auto idx = 0; idx < total_threads; ++idx)
+    // Binaries of the compiled kernels are saved at once when the search is done.
+    const KernelCacheBatch kernel_cache_batch{profile_h.GetTargetProperties(),
+                                              profile_h.GetMaxComputeUnits()};
+
+    ThreadSafeQueue<std::tuple<std::size_t, ConvSolution, bool>> solution_queue;
+    const auto start_time = std::chrono::steady_clock::now();
+    // Nothing is benchmarked in the compile only mode, all the configs of a batch are compiled.
+    TuningPipeline pipeline{IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{})
+                                ? std::numeric_limits<std::size_t>::max()
+                                : GetTuningLookahead(total_threads),
+                            total_threads};
+
+    while(true)
     {
-        compile_agents.emplace_back(CompileAgent<PerformanceConfig, Solver, Context, Problem>,
-                                    idx,
-                                    total_threads,
-                                    std::cref(s),
-                                    std::cref(context),
-                                    std::cref(problem),
-                                    std::ref(all_configs),
-                                    std::ref(solution_queue));
-    }
+        const auto batch = strategy->NextBatch();
+        if(batch.empty())
+            break;
+        if(std::chrono::steady_clock::now() - start_time > GetTuningTimeMax())
+        {
+            MIOPEN_LOG_I("Exhausted time budget");
+            break;
+        }
 
-    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
-    {
-        size_t n_current       = 0;
-        auto threads_remaining = total_threads;
-        while(true)
+        std::vector<PerformanceConfig> batch_configs;
+        batch_configs.reserve(batch.size());
+        for(const auto& request : batch)
+            batch_configs.push_back(all_configs[request.index]);
+
+        std::atomic<std::size_t> next_config{0};
+        // Compile agents run on the global thread pool, see CompileAgent().
+        TaskGroup compile_agents;
+        for(std::size_t idx = 0; idx < total_threads; ++idx)
+        {
+            compile_agents.Run([&]() {
+                CompileAgent<PerformanceConfig, Solver, Context, Problem>(next_config,
+                                                                          start_time,
+                                                                          compile_agents,
+                                                                          pipeline,
+                                                                          s,
+                                                                          context,
+                                                                          problem,
+                                                                          batch_configs,
+                                                                          solution_queue);
+            });
+        }
+
+        if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+        {
+            compile_agents.Wait();
+            MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
+                         "Running kernels on GPU is disabled. Search skipped");
+        }
+
+        for(std::size_t n_done = 0; n_done < batch.size(); ++n_done)
         {
-            if(n_current >= n_runs_total)
-                break;
             MIOPEN_LOG_I2("Waiting for item in queue");
-            const auto kinder     = solution_queue.pop();
-            auto current_config   = std::get<0>(kinder);
-            auto current_solution = std::get<1>(kinder);
+            std::tuple<std::size_t, ConvSolution, bool> kinder;
+            // Runs the pending agents meanwhile, that also keeps them going when the search
+            // itself runs on the pool. Each agent task pushes at most one item and ends.
+            const auto wait_start = std::chrono::steady_clock::now();
+            compile_agents.RunPendingUntil([&]() { return solution_queue.try_pop(kinder); });
+            const auto benchmark_start = std::chrono::steady_clock::now();
+            pipeline.AddWaitTime(benchmark_start - wait_start);
+            const auto& request          = batch[std::get<0>(kinder)];
+            const auto& current_config   = batch_configs[std::get<0>(kinder)];
+            const auto& current_solution = std::get<1>(kinder);
 
             if(std::get<2>(kinder))
             {
-                threads_remaining--;
-                if(threads_remaining == 0)
-                    break;
-                else
-                {
-                    continue;
-                }
+                pipeline.Release();
+                strategy->Report(request, std::numeric_limits<float>::max());
+                continue;
             }
 
             float elapsed_time = 0.0f;
@@ -441,6 +570,7 @@ auto GenericSearch(const Solver s,
 
             try
             {
+                MIOPEN_TRACE_SCOPE_ARGS("tuning", "Benchmark", current_config);
                 if(default_solution.workspace_sz != current_solution.workspace_sz)
                 {
                     ret = -2;
@@ -471,7 +601,31 @@ auto GenericSearch(const Solver s,
                          << '/' << n_runs_total << " elapsed_time: " << elapsed_time
                          << ", best_time: " << best_time << ", " << current_config);
 
-            if(ret == 0)
+            if(ret == 0 && request.runs > 0)
+            {
+                // A rough measurement requested by the strategy, the config is not
+                // a candidate for the result yet.
+                try
+                {
+                    for(std::size_t i = 1; i < request.runs; ++i)
+                    {
+                        invoker(profile_h, invoke_ctx);
+                        elapsed_time += profile_h.GetKernelTime();
+                    }
+                    elapsed_time /= request.runs;
+                }
+                catch(...)
+                {
+                    ret = 1;
+                }
+
+                if(ret == 0 && elapsed_time < rough_best_time)
+                {
+                    rough_best_config = current_config;
+                    rough_best_time   = elapsed_time;
+                }
+            }
+            else if(ret == 0)
             {
                 // Smooth the jitter of measurements:
                 // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
@@ -522,6 +676,10 @@ auto GenericSearch(const Solver s,
             // runtime and free the associated resources (memory, file handles...)
             for(const auto& kernelInfo : current_solution.construction_params)
                 profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
+            // The kernels hold the programs as well
+            invoker = {};
+            pipeline.Release();
+            pipeline.AddBenchmarkTime(std::chrono::steady_clock::now() - benchmark_start);
 
             if(ret != 0)
             {
@@ -529,6 +687,7 @@ auto GenericSearch(const Solver s,
                                  << " Failed rc=" << ret);
                 ++n_failed;
             }
+            strategy->Report(request, ret == 0 ? elapsed_time : std::numeric_limits<float>::max());
             heartbeat.Monitor(ret != 0,
                               elapsed_time,
                               n_current,
@@ -538,17 +697,20 @@ auto GenericSearch(const Solver s,
                               current_config);
             ++n_current;
         }
+
+        compile_agents.Wait();
     }
-    else
+
+    if(!is_passed && rough_best_config)
     {
-        MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
-                     "Running kernels on GPU is disabled. Search skipped");
+        MIOPEN_LOG_W("Search stopped before the final round, using the best rough measurement");
+        is_passed   = true;
+        best_config = *rough_best_config;
+        best_time   = rough_best_time;
     }
 
-    for(auto& agent : compile_agents)
-        agent.join();
-
-    MIOPEN_LOG_I("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
+    pipeline.LogUtilization();
+    MIOPEN_LOG_I("Done: " << n_current << '/' << n_failed << '/' << n_runs_total << ", best #"
                           << n_best << ' ' << best_time << ' ' << best_config);
 
     if(!is_passed && n_runs_total)
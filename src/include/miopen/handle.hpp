@@ -29,16 +29,19 @@
 #include <miopen/config.h>
 #include <miopen/kernel_info.hpp>
 #include <miopen/common.hpp>
+#include <miopen/compile_queue.hpp>
 #include <miopen/invoker_cache.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
 #include <miopen/object.hpp>
 #include <miopen/allocator.hpp>
+#include <miopen/memory_pool.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
+#include <miopen/workspace_size_cache.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
 
@@ -88,6 +91,7 @@ struct Handle : miopenHandle
     void SetAllocator(miopenAllocatorFunction allocator,
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
+    MemoryPool& GetMemoryPool() const;
 
     void EnableProfiling(bool enable = true) const;
 
@@ -110,25 +114,31 @@ struct Handle : miopenHandle
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config) const;
 
-    auto GetKernels(const std::string& algorithm, const std::string& network_config) const
+    std::vector<KernelInvoke> GetKernels(const std::string& algorithm,
+                                         const std::string& network_config) const
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
-               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+        const auto ks = this->GetKernelsImpl(algorithm, network_config);
+        std::vector<KernelInvoke> invokes;
+        invokes.reserve(ks->size());
+        for(const auto& k : *ks)
+            invokes.push_back(this->Run(k));
+        return invokes;
     }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config) const
     {
-        auto ks = this->GetKernelsImpl(algorithm, network_config);
-        if(ks.empty())
+        const auto ks = this->GetKernelsImpl(algorithm, network_config);
+        if(ks->empty())
         {
             MIOPEN_THROW("looking for default kernel (does not exist): " + algorithm + ", " +
                          network_config);
         }
-        return this->Run(ks.front());
+        return this->Run(ks->front());
     }
 
     KernelInvoke Run(Kernel k) const;
-    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config) const;
+    /// A snapshot of the kernels, which is not affected by the kernels added or cleared later
+    std::shared_ptr<const std::vector<Kernel>>
+    GetKernelsImpl(const std::string& algorithm, const std::string& network_config) const;
 
     Program LoadProgram(const std::string& program_name,
                         std::string params,
@@ -136,6 +146,9 @@ struct Handle : miopenHandle
                         const std::string& kernel_src) const;
 
     bool HasProgram(const std::string& program_name, const std::string& params) const;
+    /// True if loading the program would not compile it, i.e. it's loaded already or
+    /// its binary is in the kernel cache.
+    bool IsProgramReady(const std::string& program_name, const std::string& params) const;
     void ClearProgram(const std::string& program_name, const std::string& params) const;
     void AddProgram(Program prog, const std::string& program_name, const std::string& params) const;
 
@@ -249,19 +262,32 @@ public:
         {
             MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            return invokers[std::make_pair(config, solver->ToString())];
         }
         MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and algorithm "
                                                           << algo->ToString());
         return invokers.GetFound1_0(config, *algo);
     }
 
-    boost::optional<const std::string&> GetFound1_0SolverId(const NetworkConfig& config,
-                                                            const AlgorithmName& algo) const
+    boost::optional<std::string> GetFound1_0SolverId(const NetworkConfig& config,
+                                                     const AlgorithmName& algo) const
     {
         return invokers.GetFound1_0SolverId(config, algo);
     }
 
+    boost::optional<std::size_t> GetWorkspaceSize(const NetworkConfig& config,
+                                                  std::uint64_t controls) const
+    {
+        return workspace_sizes.Get(config, controls);
+    }
+
+    void RegisterWorkspaceSize(const NetworkConfig& config, std::uint64_t controls, std::size_t size)
+    {
+        workspace_sizes.Register(config, controls, size);
+    }
+
+    CompileQueue& GetCompileQueue() { return compile_queue; }
+
 #if MIOPEN_USE_ROCBLAS
     const rocblas_handle_ptr& rhandle() const;
 
@@ -271,6 +297,9 @@ private:
 private:
 #endif
     InvokerCache invokers;
+    WorkspaceSizeCache workspace_sizes;
+    // Its jobs use the handle, so it's destroyed first
+    CompileQueue compile_queue;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Handle& handle) { return handle.Print(os); }
@@ -42,6 +42,10 @@ boost::filesystem::path HipBuild(boost::optional<miopen::TmpDir>& tmp_dir,
                                  std::string params,
                                  const TargetProperties& target);
 
+/// Directory with the include files of the HIP kernels. Written once per their contents to the
+/// user cache and shared by all the builds of all the processes.
+const boost::filesystem::path& GetHipKernelIncDir();
+
 void bin_file_to_str(const boost::filesystem::path& file, std::string& buf);
 
 class LcOptionTargetStrings
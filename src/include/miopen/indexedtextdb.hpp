@@ -0,0 +1,244 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+class LockFile;
+
+/// Drop-in replacement for PlainTextDb/RamDb as the user perf/find-db.
+///
+/// The file format is identical to PlainTextDb, so the very same file may be used by both
+/// classes. The difference is how the file is accessed:
+///  - The file is memory-mapped and scanned once to build a key -> (offset, size) index.
+///    Lookups are O(1) in the number of records, only the matched line is read and parsed.
+///  - Updates never rewrite the file. The new line is written in place if it has the same
+///    size as the old one. Otherwise the old line is overwritten by line feeds (which every
+///    reader skips as empty lines) and the new one is appended. Thus updates are O(record).
+///  - When the "holes" make up more than a half of the file, it is compacted by rewriting.
+///
+/// All operations are done under the same LockFile protocol as the one of PlainTextDb. The
+/// index is rebuilt when the file is changed by some other instance or process.
+class IndexedTextDb : protected PlainTextDb
+{
+public:
+    IndexedTextDb(std::string path,
+                  bool is_system,
+                  const std::string& /*arch*/,
+                  std::size_t /*num_cu*/)
+        : IndexedTextDb(path, is_system)
+    {
+    }
+
+    IndexedTextDb(std::string path, bool is_system = false);
+
+    IndexedTextDb(const IndexedTextDb&) = delete;
+    IndexedTextDb(IndexedTextDb&&)      = delete;
+    IndexedTextDb& operator=(const IndexedTextDb&) = delete;
+    IndexedTextDb& operator=(IndexedTextDb&&) = delete;
+
+    static IndexedTextDb& GetCached(const std::string& path, bool is_system);
+
+    static IndexedTextDb& GetCached(const std::string& path,
+                                    bool is_system,
+                                    const std::string& /*arch*/,
+                                    std::size_t /*num_cu*/)
+    {
+        return GetCached(path, is_system);
+    }
+
+    boost::optional<DbRecord> FindRecord(const std::string& problem);
+
+    template <class TProblem>
+    boost::optional<DbRecord> FindRecord(const TProblem& problem)
+    {
+        const auto key = DbRecord::Serialize(problem);
+        return FindRecord(key);
+    }
+
+    template <class TProblem, class TValue>
+    bool Load(const TProblem& problem, const std::string& id, TValue& value)
+    {
+        const auto record = FindRecord(problem);
+        if(!record)
+            return false;
+        return record->GetValues(id, value);
+    }
+
+    bool StoreRecord(const DbRecord& record);
+    bool UpdateRecord(DbRecord& record);
+    bool RemoveRecord(const std::string& key);
+    bool Remove(const std::string& key, const std::string& id);
+
+    template <class T>
+    inline bool Remove(const T& problem_config, const std::string& id)
+    {
+        const auto key = DbRecord::Serialize(problem_config);
+        return Remove(key, id);
+    }
+
+    template <class T>
+    inline bool RemoveRecord(const T& problem_config)
+    {
+        const auto key = DbRecord::Serialize(problem_config);
+        return RemoveRecord(key);
+    }
+
+    template <class T, class V>
+    inline boost::optional<DbRecord>
+    Update(const T& problem_config, const std::string& id, const V& values)
+    {
+        DbRecord record(problem_config);
+        record.SetValues(id, values);
+        const auto ok = UpdateRecord(record);
+        if(ok)
+            return record;
+        else
+            return boost::none;
+    }
+
+    /// Rewrites the file dropping all the unused space.
+    ///
+    /// Returns true if compaction was successful, false otherwise.
+    bool Compact();
+
+private:
+    struct IndexItem
+    {
+        std::uint64_t begin; // Offset of the first character of the line
+        std::uint64_t size;  // Line size, without the line feed
+    };
+
+    struct FileState
+    {
+        std::uintmax_t size    = 0;
+        std::time_t write_time = 0;
+
+        bool operator==(const FileState& other) const
+        {
+            return size == other.size && write_time == other.write_time;
+        }
+    };
+
+    std::unordered_map<std::string, IndexItem> index;
+    bool is_indexed = false;
+    FileState indexed_state;
+    std::uint64_t file_size   = 0;
+    std::uint64_t unused_size = 0;
+    bool ends_with_lf         = true;
+
+    FileState GetFileState() const;
+    void InvalidateIndex();
+    bool ValidateUnsafe();
+    void BuildIndexUnsafe();
+    boost::optional<std::string> ReadLineUnsafe(const IndexItem& item) const;
+    /// Looks the key up in the index and checks that the file still has it at the indexed
+    /// position, rebuilding the index otherwise. Optionally returns the line read.
+    boost::optional<IndexItem> LocateUnsafe(const std::string& key, std::string* line);
+    boost::optional<DbRecord> FindRecordUnsafe(const std::string& key);
+    bool StoreRecordUnsafe(const DbRecord& record);
+    bool CompactUnsafe();
+};
+
+/// \todo This is modified copy of code from db.hpp. Make a proper fix.
+template <>
+// cppcheck-suppress noConstructor
+class DbTimer<IndexedTextDb>
+{
+    IndexedTextDb& inner;
+
+    template <class TFunc>
+    static auto Measure(const std::string& funcName, TFunc&& func)
+    {
+        if(!miopen::IsLogging(LoggingLevel::Info2))
+            return func();
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        auto ret         = func();
+        const auto end   = std::chrono::high_resolution_clock::now();
+        MIOPEN_LOG_I2("Db::" << funcName << " time: " << (end - start).count() * .000001f << " ms");
+        return ret;
+    }
+
+public:
+    template <class... TArgs>
+    DbTimer(TArgs&&... args) : inner(IndexedTextDb::GetCached(args...))
+    {
+    }
+
+    template <class TProblem>
+    auto FindRecord(const TProblem& problem)
+    {
+        return Measure("FindRecord", [&]() { return inner.FindRecord(problem); });
+    }
+
+    bool StoreRecord(const DbRecord& record)
+    {
+        return Measure("StoreRecord", [&]() { return inner.StoreRecord(record); });
+    }
+
+    bool UpdateRecord(DbRecord& record)
+    {
+        return Measure("UpdateRecord", [&]() { return inner.UpdateRecord(record); });
+    }
+
+    template <class TProblem>
+    bool RemoveRecord(const TProblem& problem)
+    {
+        return Measure("RemoveRecord", [&]() { return inner.RemoveRecord(problem); });
+    }
+
+    template <class TProblem, class TValue>
+    auto Update(const TProblem& problem, const std::string& id, const TValue& value)
+    {
+        return Measure("Update", [&]() { return inner.Update(problem, id, value); });
+    }
+
+    template <class TProblem, class TValue>
+    bool Load(const TProblem& problem, const std::string& id, TValue& value)
+    {
+        return Measure("Load", [&]() { return inner.Load(problem, id, value); });
+    }
+
+    template <class TProblem>
+    bool Remove(const TProblem& problem, const std::string& id)
+    {
+        return Measure("Remove", [&]() { return inner.Remove(problem, id); });
+    }
+};
+
+} // namespace miopen
@@ -28,47 +28,54 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/names.hpp>
+#include <miopen/sharded_map.hpp>
 
 #include <boost/optional.hpp>
 
-#include <map>
-#include <memory>
 #include <string>
 #include <utility>
 
 namespace miopen {
 
+/// Thread-safe. Lookups only lock one shard for reading, so threads sharing a handle can
+/// dispatch concurrently. Invokers are never removed, the returned references stay valid.
 class InvokerCache
 {
 public:
     // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    using Key = std::pair<NetworkConfig, std::string>;
 
     boost::optional<const Invoker&> operator[](const Key& key) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
+    boost::optional<const Invoker&> GetFound1_0(const NetworkConfig& network_config,
                                                 const std::string& algorithm) const;
-    boost::optional<const std::string&> GetFound1_0SolverId(const std::string& network_config,
-                                                            const std::string& algorithm) const;
+    boost::optional<std::string> GetFound1_0SolverId(const NetworkConfig& network_config,
+                                                     const std::string& algorithm) const;
 
     void Register(const Key& key, const Invoker& invoker);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
+    void SetAsFound1_0(const NetworkConfig& network_config,
                        const std::string& algorithm,
                        const std::string& solver_id);
 
 private:
-    struct Item
+    // Reuses the hash of the network config, only the short second string is hashed
+    struct KeyHash
     {
-        // algorithm -> solver_id
-        // for find 1.0
-        std::map<std::string, std::string> found_1_0;
-        // solver_id -> invoker
-        std::map<std::string, Invoker> invokers;
+        std::size_t operator()(const Key& key) const
+        {
+            const auto h = std::hash<std::string>{}(key.second);
+            return key.first.Hash() ^ (h + 0x9e3779b97f4a7c15ULL + (key.first.Hash() << 6) +
+                                       (key.first.Hash() >> 2));
+        }
     };
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    // network_config, solver_id -> invoker
+    ShardedMap<Key, Invoker, KeyHash> invokers;
+    // network_config, algorithm -> solver_id
+    // for find 1.0
+    ShardedMap<Key, std::string, KeyHash> found_1_0;
 };
 
 } // namespace miopen
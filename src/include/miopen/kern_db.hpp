@@ -32,6 +32,7 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
+#include <miopen/lz.hpp>
 #include <miopen/md5.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
@@ -40,7 +41,13 @@
 
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <tuple>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -49,6 +56,14 @@ class path;
 } // namespace boost
 
 namespace miopen {
+/// Compression of the kernel blobs, stored in the codec column of each kern_db row.
+/// Rows written before the column existed are bzip2. Values are persistent, never reuse them.
+enum class KernelCodec : int64_t
+{
+    Bzip2 = 0,
+    Lz    = 1,
+};
+
 struct KernelConfig
 {
     static std::string table_name() { return "kern_db"; }
@@ -69,42 +84,103 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`codec` INT NOT NULL DEFAULT 0"
+           << ",`last_access` INT NOT NULL DEFAULT 0"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
            << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);";
         return ss.str();
     }
-    std::string Where() const
+    std::tuple<std::string, std::vector<std::string>> WhereClause() const
     {
-        std::ostringstream ss;
-        ss << "(kernel_name = '" << kernel_name << "')"
-           << " AND (kernel_args = '" << kernel_args << "')";
-        return ss.str();
+        return std::make_tuple("(kernel_name = ?) AND (kernel_args = ?)",
+                               std::vector<std::string>{kernel_name, kernel_args});
     }
 };
 
 class KernDb : public SQLiteBase<KernDb>
 {
+    /// Contents of a kern_db row, except for the key
+    struct Blob
+    {
+        std::string data;
+        std::string md5_hash;
+        int64_t uncompressed_size;
+        KernelCodec codec;
+    };
+
+    using Records = std::map<std::pair<std::string, std::string>, Blob>;
+
+    /// Records stored during a batch, see BeginBatch()
+    struct Batch
+    {
+        std::mutex mutex;
+        int depth        = 0;
+        std::size_t size = 0;
+        Records records;
+        /// Serializes the flushes, see FlushBatch()
+        std::mutex flush_mutex;
+        /// Records being written by FlushBatch(), the lookups still find them here
+        Records flushing;
+    };
+
+    /// Codec of the stored records, records of other codecs are still readable
+    KernelCodec codec;
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
+    /// Old system databases have no codec column
+    bool has_codec_column = true;
+    /// Seconds since the epoch when the kernel was stored or loaded, for the LRU eviction.
+    /// Only the user databases have it.
+    bool has_access_column = false;
+    // Kept by pointer to keep the class movable
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>();
 
 public:
+    /// Uses the codec selected by MIOPEN_KERN_DB_CODEC (bz2 or lz), lz by default
     KernDb(const std::string& filename_, bool is_system);
-    // This constructor is only intended for testing
+    KernDb(const std::string& filename_, bool is_system_, KernelCodec codec_);
+    // This constructor is only intended for testing, the functions are used as bzip2 codec
     KernDb(const std::string& filename_,
            bool is_system_,
            std::function<std::string(std::string, bool*)> compress_fn_,
            std::function<std::string(std::string, unsigned int)> decompress_fn_);
+
+    /// Starts a batch or joins the one already started by another caller. Until the matching
+    /// number of EndBatch() calls, stored records are kept in memory (and are visible to
+    /// FindRecord) and then are written to the database in a single transaction. That
+    /// replaces a lot of single row commits during compilation of many kernels, e.g. when
+    /// solutions are precompiled or tuned.
+    void BeginBatch();
+    void EndBatch();
+
+    /// Total size of the stored kernel blobs
+    std::uint64_t GetSize();
+    /// Removes the least recently used kernels until the blobs take no more than the size.
+    /// Returns the number of removed kernels.
+    std::size_t Shrink(std::uint64_t size);
+    /// Rebuilds the file, which returns the space freed by the removed kernels to the
+    /// filesystem.
+    void Vacuum();
+
     template <typename T>
     bool RemoveRecordUnsafe(const T& problem_config)
     {
         if(filename.empty())
             return true;
-        auto del_query =
-            "DELETE FROM " + T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, del_query};
-        auto rc   = stmt.Step(sql);
+        {
+            // Waits for the flush in progress, which could otherwise write the record back
+            const std::lock_guard<std::mutex> flush_lock{batch->flush_mutex};
+            const std::lock_guard<std::mutex> lock{batch->mutex};
+            batch->records.erase({problem_config.kernel_name, problem_config.kernel_args});
+        }
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        auto del_query           = "DELETE FROM " + T::table_name() + " WHERE " + clause + ";";
+        auto stmt                = SQLite::Statement{sql, del_query, values};
+        auto rc                  = stmt.Step(sql);
         if(rc == SQLITE_DONE)
             return true;
         else
@@ -119,27 +195,31 @@ public:
     {
         if(filename.empty())
             return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
+        {
+            const std::lock_guard<std::mutex> lock{batch->mutex};
+            const auto blob = FindBatchRecordUnsafe(problem_config);
+            if(blob != nullptr)
+                return Unpack(*blob);
+        }
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        auto select_query = std::string{"SELECT kernel_blob, kernel_hash, uncompressed_size, "} +
+                            (has_codec_column ? "codec" : "0") +
+                            (has_access_column ? ", id, last_access" : "") + " FROM " +
+                            T::table_name() + " WHERE " + clause + ";";
+        auto stmt = SQLite::Statement{sql, select_query, values};
         // only one result field
         // assert one row
         auto rc = stmt.Step(sql);
         if(rc == SQLITE_ROW)
         {
-            auto compressed_blob           = stmt.ColumnBlob(0);
-            auto md5_hash                  = stmt.ColumnText(1);
-            auto uncompressed_size         = stmt.ColumnInt64(2);
-            std::string& decompressed_blob = compressed_blob;
-            if(uncompressed_size != 0)
-            {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
-            }
-            auto new_md5 = md5(decompressed_blob);
-            if(new_md5 != md5_hash)
-                MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
-            return decompressed_blob;
+            if(has_access_column)
+                Touch(stmt.ColumnInt64(4), stmt.ColumnInt64(5));
+            return Unpack({stmt.ColumnBlob(0),
+                           stmt.ColumnText(1),
+                           stmt.ColumnInt64(2),
+                           static_cast<KernelCodec>(stmt.ColumnInt64(3))});
         }
         else if(rc == SQLITE_DONE)
             return boost::none;
@@ -148,38 +228,80 @@ public:
         return boost::none;
     }
 
+    /// Checks for the record without reading the blob, so the access time is not updated
     template <typename T>
-    bool StoreRecordUnsafe(const T& problem_config)
+    bool HasRecord(const T& problem_config)
     {
-        if(filename.empty())
+        if(filename.empty() || (!is_system && DisableUserDbFileIO))
             return false;
-        auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
-                            "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
-        auto md5_sum           = md5(problem_config.kernel_blob);
-        auto uncompressed_size = problem_config.kernel_blob.size();
-        bool success           = false;
-        auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
-        auto stmt              = SQLite::Statement{sql, insert_query};
-        stmt.BindText(1, problem_config.kernel_name);
-        stmt.BindText(2, problem_config.kernel_args);
-        if(!success)
         {
-            stmt.BindBlob(3, problem_config.kernel_blob);
-            stmt.BindInt64(5, 0);
+            const std::lock_guard<std::mutex> lock{batch->mutex};
+            if(FindBatchRecordUnsafe(problem_config) != nullptr)
+                return true;
         }
-        else
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        const auto query = "SELECT 1 FROM " + T::table_name() + " WHERE " + clause + ";";
+        auto stmt        = SQLite::Statement{sql, query, values};
+        const auto rc = stmt.Step(sql);
+        if(rc == SQLITE_ROW)
+            return true;
+        else if(rc == SQLITE_DONE)
+            return false;
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+
+    template <typename T>
+    bool StoreRecordUnsafe(const T& problem_config)
+    {
+        if(filename.empty())
+            return false;
+        auto blob = Pack(problem_config.kernel_blob);
         {
-            stmt.BindBlob(3, compressed_blob);
-            stmt.BindInt64(5, uncompressed_size);
+            std::unique_lock<std::mutex> lock{batch->mutex};
+            if(batch->depth > 0)
+            {
+                batch->size += blob.data.size();
+                batch->records[{problem_config.kernel_name, problem_config.kernel_args}] =
+                    std::move(blob);
+                if(batch->size > MaxBatchSize())
+                {
+                    lock.unlock();
+                    FlushBatch();
+                }
+                return true;
+            }
         }
-        stmt.BindText(4, md5_sum);
-
-        auto rc = stmt.Step(sql);
-        if(rc != SQLITE_DONE)
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        Write(problem_config.kernel_name, problem_config.kernel_args, blob);
         return true;
     }
+
+private:
+    static std::size_t MaxBatchSize();
+    static KernelCodec DefaultCodec();
+
+    Blob Pack(const std::string& data) const;
+    /// Returns none for the codecs unknown to this version, so the kernel gets rebuilt
+    boost::optional<std::string> Unpack(Blob blob) const;
+    void Write(const std::string& name, const std::string& args, const Blob& blob);
+    /// Updates the access time of a loaded kernel, but not more often than once an hour,
+    /// so the cache hits rarely write to the database.
+    void Touch(int64_t id, int64_t last_access);
+    /// Shall be called with the batch mutex locked
+    template <typename T>
+    const Blob* FindBatchRecordUnsafe(const T& problem_config) const
+    {
+        const auto key = std::make_pair(problem_config.kernel_name, problem_config.kernel_args);
+        auto it        = batch->records.find(key);
+        if(it != batch->records.end())
+            return &it->second;
+        it = batch->flushing.find(key);
+        return it != batch->flushing.end() ? &it->second : nullptr;
+    }
+    /// Writes the records stored so far in a single transaction. The batch mutex is only held
+    /// to take the records, so the lookups and stores are not blocked by the write.
+    void FlushBatch();
 };
 } // namespace miopen
 #endif
@@ -44,10 +44,11 @@
 
 #include <miopen/handle.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/sharded_map.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace miopen {
@@ -55,14 +56,19 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * Thread-safe, lookups only lock one shard of the maps for reading. A program which is
+ * requested by several threads at once may be built more than once, the first one is kept.
+ * The kernels of a key are replaced as a whole on change, so GetKernels() returns a snapshot
+ * which stays valid while other threads add or clear the kernels.
  */
 class KernelCache
 {
 
 public:
     using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using Kernels    = std::shared_ptr<const std::vector<Kernel>>;
+    using KernelMap  = ShardedMap<Key, Kernels, SimpleHash>;
+    using ProgramMap = ShardedMap<Key, Program, SimpleHash>;
 
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
@@ -80,8 +86,8 @@ public:
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
-    const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+    /// Never null, the vector is empty if there are no kernels for the key
+    Kernels GetKernels(const std::string& algorithm, const std::string& network_config);
 
     bool HasProgram(const std::string& name, const std::string& params) const;
     void ClearProgram(const std::string& name, const std::string& params);
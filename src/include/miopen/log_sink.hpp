@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LOG_SINK_HPP_
+#define GUARD_MIOPEN_LOG_SINK_HPP_
+
+#include <miopen/logger.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace miopen {
+namespace logger {
+
+/// A log message together with the data of its prefix. The prefix is formatted when the
+/// message is written, see LogMessage().
+struct Record
+{
+    std::int64_t time_ns = 0; // Since the epoch of the system clock
+    int thread_id        = 0;
+    LoggingLevel level   = LoggingLevel::Default;
+    bool raw             = false; // Only the prefix is added to the message
+    std::string category;
+    std::string function;
+    std::string message;
+};
+
+/// "MIOpen", followed by the backend.
+const char* LibraryName();
+/// See MIOPEN_ENABLE_LOGGING_MPMT and MIOPEN_ENABLE_LOGGING_ELAPSED_TIME.
+bool IsLoggingThreadId();
+bool IsLoggingElapsedTime();
+/// See MIOPEN_LOG_BINARY_FILE.
+bool IsLoggingBinary();
+std::string MakePrefix(const std::string& library,
+                       boost::optional<int> thread_id,
+                       boost::optional<float> elapsed_ms);
+/// Formats the line as the synchronous logging does.
+std::string FormatRecord(const Record& record, const std::string& prefix);
+
+/// Binary log, the output of MIOPEN_LOG_BINARY_FILE. The header holds the library name.
+void WriteBinaryHeader(std::ostream& stream);
+void WriteBinaryRecord(std::ostream& stream, const Record& record);
+/// Returns the library name, or nothing if the stream is not a binary log.
+boost::optional<std::string> ReadBinaryHeader(std::istream& stream);
+/// Returns false at the end of the stream.
+bool ReadBinaryRecord(std::istream& stream, Record& record);
+
+/// Puts the record to the ring buffer of the calling thread. The background thread writes
+/// the records of all the threads ordered by time.
+void PushAsync(Record&& record);
+/// Waits until the records pushed so far are written.
+void FlushAsync();
+
+} // namespace logger
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LOG_SINK_HPP_
@@ -30,6 +30,7 @@
 #include <array>
 #include <vector>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <type_traits>
 #include <chrono>
@@ -37,6 +38,7 @@
 #include <miopen/each_args.hpp>
 #include <miopen/object.hpp>
 #include <miopen/config.h>
+#include <miopen/trace.hpp>
 
 // See https://github.com/pfultz2/Cloak/wiki/C-Preprocessor-tricks,-tips,-and-idioms
 #define MIOPEN_PP_CAT(x, y) MIOPEN_PP_PRIMITIVE_CAT(x, y)
@@ -220,6 +222,49 @@ std::string LoggingPrefix();
 bool IsLogging(LoggingLevel level, bool disableQuieting = false);
 bool IsLoggingCmd();
 bool IsLoggingFunctionCalls();
+/// See MIOPEN_LOG_ASYNC.
+bool IsLoggingAsync();
+/// The most detailed level enabled, the quiet mode is not taken into account.
+LoggingLevel GetLoggingLevelMax();
+
+/// Writes the message with the prefix, the category and the function name.
+void LogMessage(LoggingLevel level,
+                const std::string& category,
+                const std::string& function,
+                std::string message);
+/// Writes the line with the prefix only.
+void LogLine(std::string line);
+/// Waits until the messages logged so far are written, if the logging is asynchronous.
+void FlushLog();
+
+namespace logger {
+
+/// Cheap check that disabled levels pass before IsLogging() and the formatting of the message.
+inline bool MayLog(LoggingLevel level)
+{
+    static const auto max = static_cast<int>(GetLoggingLevelMax());
+    return static_cast<int>(level) <= max;
+}
+
+/// Formats a message. Reuses the stream of the thread unless it is busy formatting another
+/// message, as constructing a stream takes longer than formatting a typical message.
+class MessageStream
+{
+public:
+    MessageStream();
+    ~MessageStream();
+    MessageStream(const MessageStream&) = delete;
+    MessageStream& operator=(const MessageStream&) = delete;
+
+    std::ostream& Get() { return *stream; }
+    std::string Str() const { return stream->str(); }
+
+private:
+    std::ostringstream* stream;
+    std::unique_ptr<std::ostringstream> owned;
+};
+
+} // namespace logger
 
 namespace logger {
 
@@ -282,27 +327,24 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
         std::ostringstream().swap(miopen_log_func_ss);                          \
         /* Use stringstram as ostream to engage existing template functions: */ \
         std::ostream& miopen_log_func_ostream = miopen_log_func_ss;             \
-        miopen_log_func_ostream << miopen::LoggingPrefix();                     \
-        miopen::LogParam(miopen_log_func_ostream, #param, param) << std::endl;  \
-        std::cerr << miopen_log_func_ss.str();                                  \
+        miopen::LogParam(miopen_log_func_ostream, #param, param);               \
+        miopen::LogLine(miopen_log_func_ss.str());                              \
     } while(false);
 
-#define MIOPEN_LOG_FUNCTION(...)                                                        \
-    do                                                                                  \
-        if(miopen::IsLoggingFunctionCalls())                                            \
-        {                                                                               \
-            std::ostringstream miopen_log_func_ss;                                      \
-            miopen_log_func_ss << miopen::LoggingPrefix() << __PRETTY_FUNCTION__ << "{" \
-                               << std::endl;                                            \
-            std::cerr << miopen_log_func_ss.str();                                      \
-            MIOPEN_PP_EACH_ARGS(MIOPEN_LOG_FUNCTION_EACH, __VA_ARGS__)                  \
-            std::ostringstream().swap(miopen_log_func_ss);                              \
-            miopen_log_func_ss << miopen::LoggingPrefix() << "}" << std::endl;          \
-            std::cerr << miopen_log_func_ss.str();                                      \
-        }                                                                               \
+/// Also traces the API call, see MIOPEN_TRACE_FILE.
+#define MIOPEN_LOG_FUNCTION(...)                                       \
+    MIOPEN_TRACE_SCOPE("api", __func__);                               \
+    do                                                                 \
+        if(miopen::IsLoggingFunctionCalls())                           \
+        {                                                              \
+            std::ostringstream miopen_log_func_ss;                     \
+            miopen::LogLine(std::string{__PRETTY_FUNCTION__} + "{");   \
+            MIOPEN_PP_EACH_ARGS(MIOPEN_LOG_FUNCTION_EACH, __VA_ARGS__) \
+            miopen::LogLine("}");                                      \
+        }                                                              \
     while(false)
 #else
-#define MIOPEN_LOG_FUNCTION(...)
+#define MIOPEN_LOG_FUNCTION(...) MIOPEN_TRACE_SCOPE("api", __func__)
 #endif
 
 std::string LoggingParseFunction(const char* func, const char* pretty_func);
@@ -310,16 +352,15 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 #define MIOPEN_GET_FN_NAME() \
     (miopen::LoggingParseFunction(__func__, __PRETTY_FUNCTION__)) /* NOLINT */
 
-#define MIOPEN_LOG_XQ_CUSTOM(level, disableQuieting, category, fn_name, ...)                \
-    do                                                                                      \
-    {                                                                                       \
-        if(miopen::IsLogging(level, disableQuieting))                                       \
-        {                                                                                   \
-            std::ostringstream miopen_log_ss;                                               \
-            miopen_log_ss << miopen::LoggingPrefix() << category << " [" << fn_name << "] " \
-                          << __VA_ARGS__ << std::endl;                                      \
-            std::cerr << miopen_log_ss.str();                                               \
-        }                                                                                   \
+#define MIOPEN_LOG_XQ_CUSTOM(level, disableQuieting, category, fn_name, ...)           \
+    do                                                                                 \
+    {                                                                                  \
+        if(miopen::logger::MayLog(level) && miopen::IsLogging(level, disableQuieting)) \
+        {                                                                              \
+            miopen::logger::MessageStream miopen_log_ss;                               \
+            miopen_log_ss.Get() << __VA_ARGS__;                                        \
+            miopen::LogMessage(level, category, fn_name, miopen_log_ss.Str());         \
+        }                                                                              \
     } while(false)
 
 #define MIOPEN_LOG_XQ_(level, disableQuieting, fn_name, ...) \
@@ -346,16 +387,16 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 // Warnings in installable builds, errors otherwise.
 #define MIOPEN_LOG_WE(...) MIOPEN_LOG(LogWELevel, __VA_ARGS__)
 
-#define MIOPEN_LOG_DRIVER_CMD(...)                                                             \
-    do                                                                                         \
-    {                                                                                          \
-        std::ostringstream miopen_driver_cmd_ss;                                               \
-        miopen_driver_cmd_ss << miopen::LoggingPrefix() << "Command"                           \
-                             << " ["                                                           \
-                             << miopen::LoggingParseFunction(__func__,                         \
-                                                             __PRETTY_FUNCTION__) /* NOLINT */ \
-                             << "] ./bin/MIOpenDriver " << __VA_ARGS__ << std::endl;           \
-        std::cerr << miopen_driver_cmd_ss.str();                                               \
+#define MIOPEN_LOG_DRIVER_CMD(...)                                                         \
+    do                                                                                     \
+    {                                                                                      \
+        std::ostringstream miopen_driver_cmd_ss;                                           \
+        miopen_driver_cmd_ss << "./bin/MIOpenDriver " << __VA_ARGS__;                      \
+        miopen::LogMessage(miopen::LoggingLevel::Default,                                  \
+                           "Command",                                                      \
+                           miopen::LoggingParseFunction(__func__,                          \
+                                                        __PRETTY_FUNCTION__), /* NOLINT */ \
+                           miopen_driver_cmd_ss.str());                                    \
     } while(false)
 
 #if MIOPEN_LOG_FUNC_TIME_ENABLE
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LZ_HPP_
+#define GUARD_MIOPEN_LZ_HPP_
+
+#include <string>
+#include <stdexcept>
+
+namespace miopen {
+namespace lz {
+/// Fast LZ77-class codec, the data layout follows the LZ4 block format. Compresses code
+/// objects several times faster than bzip2 and decompresses them an order of magnitude
+/// faster, at the cost of a somewhat lower ratio. Interface mirrors the one of bz2.hpp:
+/// when the data does not shrink, the input is returned and *compressed is set to false.
+std::string compress(std::string s, bool* compressed = nullptr);
+/// size is the upper bound of the decompressed size. Throws on malformed input.
+std::string decompress(std::string s, unsigned int size);
+} // namespace lz
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LZ_HPP_
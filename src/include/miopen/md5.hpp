@@ -2,10 +2,11 @@
 #define GUARD_MLOPEN_MD5_HPP
 
 #include <string>
+#include <string_view>
 
 namespace miopen {
 
-std::string md5(std::string s);
+std::string md5(std::string_view s);
 
 } // namespace miopen
 
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MEMORY_POOL_HPP_
+#define GUARD_MIOPEN_MEMORY_POOL_HPP_
+
+#include <miopen/allocator.hpp>
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace miopen {
+
+struct MemoryPoolStats
+{
+    std::size_t limit        = 0;
+    std::size_t bytes_in_use = 0;
+    std::size_t bytes_cached = 0;
+    std::size_t peak_bytes   = 0;
+    std::size_t hits         = 0;
+    std::size_t misses       = 0;
+    std::size_t releases     = 0;
+};
+
+/// Caching suballocator over the Allocator of a handle. Freed buffers are kept in bins of size
+/// classes and handed out again for requests of the same class on the same stream, where the
+/// stream order makes the reuse safe without synchronization. The bytes held from the allocator
+/// (in use and cached) are kept within the limit by releasing the least recently freed blocks;
+/// buffers in use are never held back, so the pool does not fail where the allocator would not.
+/// The pool is disabled while the limit is 0.
+class MemoryPool
+{
+public:
+    /// The limit is taken from MIOPEN_MEMORY_POOL_LIMIT in MiB.
+    MemoryPool();
+    explicit MemoryPool(std::size_t limit_);
+    /// Releases the cached blocks. The buffers in use go back to the allocator once freed.
+    ~MemoryPool();
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    /// Sizes are rounded up to one of four classes per power of two, at least 256 bytes, so
+    /// a block is at most a quarter larger than the request.
+    static std::size_t GetSizeClass(std::size_t size);
+
+    /// Returns a cached block freed on the stream, or an empty pointer.
+    Allocator::ManageDataPtr TryReuse(std::size_t size, miopenAcceleratorQueue_t stream);
+    /// Reuses a cached block or allocates a new one from the allocator. Cached blocks are
+    /// released and the allocation retried when the allocator fails.
+    Allocator::ManageDataPtr
+    Allocate(const Allocator& allocator, std::size_t size, miopenAcceleratorQueue_t stream);
+
+    void SetLimit(std::size_t limit_);
+    /// Returns all the cached blocks to the allocator.
+    void Release();
+    MemoryPoolStats GetStats() const;
+
+private:
+    struct Block;
+    struct Impl;
+    std::shared_ptr<Impl> impl;
+
+    static void Deallocate(void* block, void* memory);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MEMORY_POOL_HPP_
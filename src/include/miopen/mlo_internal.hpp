@@ -70,6 +70,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #endif
 #include <miopen/conv/context.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/indexedtextdb.hpp>
 #include <miopen/problem_description.hpp>
 #include <miopen/ramdb.hpp>
 
@@ -141,6 +142,8 @@ struct AnyInvokeParams;
 
 #if MIOPEN_ENABLE_SQLITE
 using PerformanceDb = DbTimer<MultiFileDb<SQLitePerfDb, SQLitePerfDb, true>>;
+#elif MIOPEN_ENABLE_INDEXED_USER_DB
+using PerformanceDb = DbTimer<MultiFileDb<ReadonlyRamDb, IndexedTextDb, true>>;
 #else
 using PerformanceDb = DbTimer<MultiFileDb<ReadonlyRamDb, RamDb, true>>;
 #endif
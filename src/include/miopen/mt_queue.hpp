@@ -56,4 +56,13 @@ public:
         queue.pop();
         return ret;
     }
+    bool try_pop(T& item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(queue.empty())
+            return false;
+        item = std::move(queue.front());
+        queue.pop();
+        return true;
+    }
 };
@@ -26,19 +26,34 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace miopen {
 
+/// Key of the problem in the invoker and kernel caches. The values are interned: each distinct
+/// string is stored once for the lifetime of the process together with its hash, so copies,
+/// comparisons and hashing do not touch the string.
 struct NetworkConfig
 {
-    NetworkConfig() = default;
-    explicit NetworkConfig(const std::string& value_) : value(value_) {}
-    operator std::string() const { return value; }
-    std::string ToString() const { return value; }
+    NetworkConfig();
+    explicit NetworkConfig(const std::string& value_);
+    operator std::string() const { return value->str; }
+    std::string ToString() const { return value->str; }
+    const std::string& Str() const { return value->str; }
+    std::size_t Hash() const { return value->hash; }
+
+    bool operator==(const NetworkConfig& r) const { return value == r.value; }
+    bool operator!=(const NetworkConfig& r) const { return value != r.value; }
 
 private:
-    std::string value;
+    struct Interned
+    {
+        std::string str;
+        std::size_t hash;
+    };
+
+    const Interned* value;
 };
 
 struct AlgorithmName
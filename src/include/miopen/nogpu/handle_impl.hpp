@@ -52,12 +52,14 @@ struct HandleImpl
     int device             = -1;
     std::string device_name;
     std::size_t num_cu             = 0;
-    std::size_t local_mem_size     = 0;
+    // All the supported targets have this amount of LDS
+    std::size_t local_mem_size     = TargetProperties::GetMaxLocalMemorySize();
     std::size_t global_mem_size    = 0;
     std::size_t img3d_max_width    = 0;
     std::size_t warp_size          = 64;
     std::size_t max_mem_alloc_size = 0;
     Allocator allocator{};
+    MemoryPool memory_pool;
     KernelCache cache;
     std::int64_t ctx;
     TargetProperties target_properties;
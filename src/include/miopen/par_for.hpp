@@ -27,6 +27,8 @@
 #ifndef MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
+#include <miopen/thread_pool.hpp>
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
@@ -38,41 +40,8 @@
 
 namespace miopen {
 
-struct joinable_thread : std::thread
-{
-    template <class... Xs>
-    joinable_thread(Xs&&... xs) : std::thread(std::forward<Xs>(xs)...) // NOLINT
-    {
-    }
-
-    joinable_thread& operator=(joinable_thread&& other) = default;
-    joinable_thread(joinable_thread&& other)            = default;
-
-    ~joinable_thread()
-    {
-        if(this->joinable())
-            this->join();
-    }
-};
-
-struct thread_factory
-{
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
-    {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
-            {
-                f(i);
-            }
-        });
-        work += grainsize;
-        return result;
-    }
-};
-
+/// Splits the range into threadsize chunks run on the global ThreadPool. The calling thread
+/// runs the first chunk and helps with the rest, so nested loops don't oversubscribe the CPU.
 template <class F>
 void par_for_impl(std::size_t n, std::size_t threadsize, F f)
 {
@@ -83,14 +52,22 @@ void par_for_impl(std::size_t n, std::size_t threadsize, F f)
     }
     else
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threadsize);
+
+        TaskGroup tasks;
+        for(std::size_t work = grainsize; work < n; work += grainsize)
+        {
+            tasks.Run([=] {
+                std::size_t last = std::min(n, work + grainsize);
+                for(std::size_t i = work; i < last; i++)
+                {
+                    f(i);
+                }
+            });
+        }
+        for(std::size_t i = 0; i < std::min(n, grainsize); i++)
+            f(i);
+        tasks.Wait();
     }
 }
 
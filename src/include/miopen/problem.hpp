@@ -81,6 +81,15 @@ struct Problem : miopenProblem
     std::vector<Solution>
     FindSolutions(Handle& handle, const FindOptions& options, std::size_t max_solutions) const;
 
+    /// Finds solutions to several problems, e.g. all the layers of a network. Problems with the
+    /// same network config are solved once and the kernels of all the problems are compiled in a
+    /// single parallel pass before the benchmarks. Returns the solutions in the order of problems.
+    static std::vector<std::vector<Solution>>
+    FindSolutions(Handle& handle,
+                  const std::vector<const Problem*>& problems,
+                  const FindOptions& options,
+                  std::size_t max_solutions);
+
     conv::ProblemDescription AsConvolution() const;
 
     const TensorDescriptor& GetTensorDescriptorChecked(miopenTensorArgumentId_t name,
@@ -110,6 +119,8 @@ private:
                                             const AllocatedBuffers& buffers,
                                             const ConvolutionDescriptor& conv_desc) const;
 
+    static void PrecompileSolutions(Handle& handle, const std::vector<const Problem*>& problems);
+
     void TransposeImpl(const ConvolutionDescriptor& conv_desc);
     void LogDriverCommand(const ConvolutionDescriptor& conv_desc) const;
 };
@@ -26,29 +26,48 @@
 #ifndef MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 #define MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 
+#include <miopen/binary_db.hpp>
 #include <miopen/db_record.hpp>
 
 #include <boost/optional.hpp>
 
+#include <memory>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <sstream>
 
+namespace boost {
+namespace interprocess {
+class mapped_region;
+} // namespace interprocess
+} // namespace boost
+
 namespace miopen {
 
 namespace debug {
 extern bool& rordb_embed_fs_override();
 } // namespace debug
 
+/// Read-only database which is loaded into memory as a whole.
+///
+/// The file is memory-mapped (or the embedded data is used as is) and only an index of the
+/// records is built on load. Both keys and contents of the index refer to the mapped data,
+/// nothing is copied or parsed until the record is actually requested. If the binary
+/// counterpart of the file is present (see BinaryDb), it is used instead and no index is built.
 class ReadonlyRamDb
 {
 public:
-    ReadonlyRamDb(std::string path) : db_path(path) {}
+    ReadonlyRamDb(std::string path);
+    ~ReadonlyRamDb();
 
     static ReadonlyRamDb& GetCached(const std::string& path, bool warn_if_unreadable);
 
     boost::optional<DbRecord> FindRecord(const std::string& problem) const
     {
+        if(binary)
+            return binary->FindRecord(problem);
+
         MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
         const auto it = cache.find(problem);
 
@@ -60,7 +79,7 @@ public:
         MIOPEN_LOG_I2("Key match: " << problem);
         MIOPEN_LOG_I2("Contents found: " << it->second.content);
 
-        if(!record.ParseContents(it->second.content))
+        if(!record.ParseContents(std::string{it->second.content}))
         {
             MIOPEN_LOG_E("Error parsing payload under the key: "
                          << problem << " form file " << db_path << "#" << it->second.line);
@@ -91,19 +110,21 @@ private:
     struct CacheItem
     {
         int line;
-        std::string content;
+        std::string_view content;
     };
 
     std::string db_path;
-    std::unordered_map<std::string, CacheItem> cache;
+    std::unique_ptr<boost::interprocess::mapped_region> mapping;
+    std::unordered_map<std::string_view, CacheItem> cache;
+    std::unique_ptr<BinaryDb> binary;
 
-    ReadonlyRamDb(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb(ReadonlyRamDb&&)      = default;
-    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
+    ReadonlyRamDb(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb(ReadonlyRamDb&&)      = delete;
+    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = delete;
 
     void Prefetch(bool warn_if_unreadable);
-    void ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable);
+    void ParseAndLoadDb(std::string_view data);
 };
 
 } // namespace miopen
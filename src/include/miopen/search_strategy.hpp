@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+#define GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+enum class SearchStrategyKind
+{
+    Exhaustive,
+    SuccessiveHalving,
+    Random,
+    Local,
+};
+
+/// Selected by MIOPEN_TUNING_STRATEGY: exhaustive (default), halving, random or local.
+SearchStrategyKind GetTuningStrategy();
+
+/// Performance configs of a problem as seen by the search strategies. They are referred to by
+/// their indices and compared by their serialized parameters.
+class SearchSpace
+{
+public:
+    /// Configs are given as comma-separated lists of their parameters, i.e. as serialized.
+    SearchSpace(std::vector<std::string> configs, boost::optional<std::size_t> default_index_);
+
+    std::size_t Size() const { return fields.size(); }
+    boost::optional<std::size_t> GetDefault() const { return default_index; }
+    /// Configs which differ from the given one in a single parameter.
+    std::vector<std::size_t> GetNeighbours(std::size_t index) const;
+
+private:
+    std::vector<std::vector<std::string>> fields;
+    boost::optional<std::size_t> default_index;
+    /// Configs by the hash of all their fields except one, built on the first use
+    mutable std::unordered_multimap<std::uint64_t, std::size_t> neighbourhoods;
+
+    std::uint64_t HashWithout(std::size_t index, std::size_t skipped) const;
+};
+
+struct SearchRequest
+{
+    std::size_t index;
+    /// Number of runs averaged. Zero requests the precise measurement of GenericSearch; the best
+    /// of the configs measured that way is the result of the search.
+    std::size_t runs;
+};
+
+/// Decides which configs GenericSearch evaluates and how precisely.
+class SearchStrategy
+{
+public:
+    virtual ~SearchStrategy() = default;
+
+    /// Returns the configs to evaluate next, or nothing when the search is done. The results of
+    /// the whole batch are reported before the next call.
+    virtual std::vector<SearchRequest> NextBatch() = 0;
+    /// Failed configs are reported with the max float time.
+    virtual void Report(const SearchRequest& request, float time) = 0;
+    /// Upper limit of the number of evaluations, used for progress reports.
+    virtual std::size_t GetMaxEvaluations() const = 0;
+};
+
+/// Neither of the strategies evaluates more than max_configs distinct configs.
+std::unique_ptr<SearchStrategy> MakeSearchStrategy(SearchStrategyKind kind,
+                                                   const SearchSpace& space,
+                                                   std::size_t max_configs,
+                                                   std::uint32_t seed);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
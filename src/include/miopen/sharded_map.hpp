@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SHARDED_MAP_HPP_
+#define GUARD_MIOPEN_SHARDED_MAP_HPP_
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace miopen {
+
+/// Hash map for read-mostly caches shared between threads. The elements are split into
+/// independently locked shards by the hash of the key. Readers take a shared lock of a single
+/// shard, so they do not contend with each other and only wait for writers of the same shard.
+/// The hash of a key is computed once per access and is used both to pick the shard and to find
+/// the element within it; callers which already know the hash may pass it.
+/// Elements are never moved, pointers to them stay valid until they are erased.
+template <class Key, class Value, class Hash = std::hash<Key>, std::size_t ShardCount = 16>
+class ShardedMap
+{
+public:
+    static std::size_t HashOf(const Key& key) { return Hash{}(key); }
+
+    /// Calls f with a pointer to the value or nullptr while the shard is locked for reading.
+    template <class F>
+    decltype(auto) Read(const Key& key, std::size_t hash, F&& f) const
+    {
+        const auto& shard = GetShard(hash);
+        const std::shared_lock<std::shared_timed_mutex> lock{shard.mutex};
+        return f(Lookup(shard, key, hash));
+    }
+
+    template <class F>
+    decltype(auto) Read(const Key& key, F&& f) const
+    {
+        return Read(key, HashOf(key), std::forward<F>(f));
+    }
+
+    /// Returns a pointer to the value or nullptr.
+    const Value* Find(const Key& key, std::size_t hash) const
+    {
+        return Read(key, hash, [](const Value* value) { return value; });
+    }
+
+    const Value* Find(const Key& key) const { return Find(key, HashOf(key)); }
+
+    /// Inserts the value unless the key is present. Returns the element and whether it was
+    /// inserted.
+    std::pair<const Value*, bool> Emplace(const Key& key, std::size_t hash, Value value)
+    {
+        return Update(key, hash, [&](Value& item, bool inserted) {
+            if(inserted)
+                item = std::move(value);
+            return std::make_pair(static_cast<const Value*>(&item), inserted);
+        });
+    }
+
+    std::pair<const Value*, bool> Emplace(const Key& key, Value value)
+    {
+        return Emplace(key, HashOf(key), std::move(value));
+    }
+
+    /// Calls f with the value, which is default constructed if the key is absent, and whether it
+    /// was just inserted while the shard is locked for writing.
+    template <class F>
+    decltype(auto) Update(const Key& key, std::size_t hash, F&& f)
+    {
+        auto& shard = GetShard(hash);
+        const std::unique_lock<std::shared_timed_mutex> lock{shard.mutex};
+        if(auto* const found = const_cast<Value*>(Lookup(shard, key, hash)))
+            return f(*found, false);
+        auto& item = shard.items.emplace(hash, std::make_pair(key, Value{}))->second.second;
+        return f(item, true);
+    }
+
+    template <class F>
+    decltype(auto) Update(const Key& key, F&& f)
+    {
+        return Update(key, HashOf(key), std::forward<F>(f));
+    }
+
+    bool Erase(const Key& key)
+    {
+        const auto hash = HashOf(key);
+        auto& shard     = GetShard(hash);
+        const std::unique_lock<std::shared_timed_mutex> lock{shard.mutex};
+        const auto range = shard.items.equal_range(hash);
+        for(auto it = range.first; it != range.second; ++it)
+        {
+            if(it->second.first == key)
+            {
+                shard.items.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct IdentityHash
+    {
+        std::size_t operator()(std::size_t hash) const { return hash; }
+    };
+
+    // Aligned to keep the locks of different shards in different cache lines
+    struct alignas(64) Shard
+    {
+        mutable std::shared_timed_mutex mutex;
+        std::unordered_multimap<std::size_t, std::pair<const Key, Value>, IdentityHash> items;
+    };
+
+    std::array<Shard, ShardCount> shards;
+
+    static const Value* Lookup(const Shard& shard, const Key& key, std::size_t hash)
+    {
+        const auto range = shard.items.equal_range(hash);
+        for(auto it = range.first; it != range.second; ++it)
+            if(it->second.first == key)
+                return &it->second.second;
+        return nullptr;
+    }
+
+    // The low bits select the bucket within the shard, so the shard is picked by the high ones
+    const Shard& GetShard(std::size_t hash) const
+    {
+        return shards[(hash >> (sizeof(std::size_t) * 4)) % ShardCount];
+    }
+    Shard& GetShard(std::size_t hash)
+    {
+        return shards[(hash >> (sizeof(std::size_t) * 4)) % ShardCount];
+    }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SHARDED_MAP_HPP_
@@ -35,7 +35,10 @@ struct SimpleHash
     size_t operator()(const std::pair<std::string, std::string>& p) const
     {
         using std::hash;
-        return (hash<std::string>()(p.first) ^ hash<std::string>()(p.second));
+        // Unlike a plain xor, does not map pairs of equal strings to 0 or swapped pairs together
+        const auto h1 = hash<std::string>()(p.first);
+        const auto h2 = hash<std::string>()(p.second);
+        return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6) + (h1 >> 2));
     }
 };
 
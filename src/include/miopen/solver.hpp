@@ -1035,10 +1035,14 @@ struct PerformanceConvMlirIgemm : PerfConfigBase<PerformanceConvMlirIgemm>
     bool use_spare_set;
 
     /// \ref https://github.com/ROCmSoftwarePlatform/MIOpen/issues/1154
-    static PerformanceConvMlirIgemm& MlirHeuristicInitRequest()
-    {
-        static PerformanceConvMlirIgemm heur;
-        heur.SetMlirHeuristicInitRequest();
+    /// Initialized once, so the solvers may compare against it from several threads
+    static const PerformanceConvMlirIgemm& MlirHeuristicInitRequest()
+    {
+        static const PerformanceConvMlirIgemm heur = [] {
+            PerformanceConvMlirIgemm init;
+            init.SetMlirHeuristicInitRequest();
+            return init;
+        }();
         return heur;
     }
 
@@ -1107,10 +1111,14 @@ struct PerformanceConvMlirIgemmXdlops : PerfConfigBase<PerformanceConvMlirIgemmX
     bool use_spare_set;
 
     /// \ref https://github.com/ROCmSoftwarePlatform/MIOpen/issues/1154
-    static PerformanceConvMlirIgemmXdlops& MlirHeuristicInitRequest()
-    {
-        static PerformanceConvMlirIgemmXdlops heur;
-        heur.SetMlirHeuristicInitRequest();
+    /// Initialized once, so the solvers may compare against it from several threads
+    static const PerformanceConvMlirIgemmXdlops& MlirHeuristicInitRequest()
+    {
+        static const PerformanceConvMlirIgemmXdlops heur = [] {
+            PerformanceConvMlirIgemmXdlops init;
+            init.SetMlirHeuristicInitRequest();
+            return init;
+        }();
         return heur;
     }
 
@@ -31,6 +31,7 @@
 #error "MIOPEN_ENABLE_SQLITE = Off"
 #endif
 
+#include <miopen/binary_db.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/db.hpp>
 #include <miopen/manage_ptr.hpp>
@@ -87,6 +88,22 @@ struct SQLiteSerializable
 
         return names;
     }
+    std::vector<std::string> FieldValues() const
+    {
+        std::vector<std::string> values;
+        Derived::Visit(static_cast<const Derived&>(*this),
+                       [&](const std::string& value, const std::string& name) {
+                           std::ignore = name;
+                           values.push_back(value);
+                       });
+        Derived::Visit(static_cast<const Derived&>(*this),
+                       [&](const int value, const std::string name) {
+                           std::ignore = name;
+                           values.push_back(std::to_string(value));
+                       });
+
+        return values;
+    }
     std::tuple<std::string, std::vector<std::string>> WhereClause() const
     {
         std::vector<std::string> values;
@@ -171,6 +188,10 @@ class SQLite
     std::unique_ptr<impl> pImpl;
 
 public:
+    /// Prepared statements are cached per connection: when a Statement is destroyed, the
+    /// underlying statement is reset and kept for reuse by the next Statement with the same query
+    /// text. So queries should pass values as bound parameters instead of inlining them.
+    /// A Statement holds the connection for its lifetime, see Transaction.
     class Statement
     {
         class impl;
@@ -195,6 +216,25 @@ public:
         int BindInt64(int idx, int64_t);
     };
 
+    /// Executes all the statements issued on the connection during the lifetime of the object
+    /// in a single write transaction. It is committed by Commit() and rolled back if the object
+    /// is destroyed before that. The connection is held by the transaction, so other threads
+    /// wait for it to finish before they start their transactions or statements.
+    class Transaction
+    {
+    public:
+        Transaction(const SQLite& sql_);
+        ~Transaction();
+        Transaction(const Transaction&) = delete;
+        Transaction& operator=(const Transaction&) = delete;
+        void Commit();
+
+    private:
+        const SQLite& sql;
+        std::unique_lock<std::recursive_mutex> lock;
+        bool finished = false;
+    };
+
     using result_type = std::vector<std::unordered_map<std::string, std::string>>;
     SQLite();
     SQLite(const std::string& filename_, bool is_system);
@@ -439,7 +479,7 @@ public:
     template <typename T>
     inline boost::optional<DbRecord> FindRecordUnsafe(const T& problem_config)
     {
-        if(dbInvalid)
+        if(dbInvalid && !binary)
             return boost::none;
 
         const auto pdb_ovr = miopen::GetStringEnv(MIOPEN_DEBUG_PERFDB_OVERRIDE{});
@@ -465,6 +505,9 @@ public:
             if(success)
                 return {ovr_rec};
         }
+        if(binary)
+            return binary->FindRecord(BinaryDb::SQLiteKey(problem_config.FieldValues()));
+
         std::string clause;
         std::vector<std::string> values;
         std::tie(clause, values) = problem_config.WhereClause();
@@ -513,8 +556,9 @@ public:
             "WHERE config IN ("
             "SELECT id FROM config WHERE ( "
             + clause + " ) )"
-            "AND solver == '" +  id + "' ;";
+            "AND solver == ? ;";
         // clang-format on
+        values.push_back(id);
         auto stmt = SQLite::Statement{sql, query, values};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
@@ -535,6 +579,8 @@ public:
     {
         if(dbInvalid)
             return boost::none;
+        // Both the config and the perf values are committed at once
+        auto transaction = SQLite::Transaction{sql};
         // UPSERT the value
         {
             std::string clause;
@@ -576,6 +622,7 @@ public:
                 return boost::none;
             }
         }
+        transaction.Commit();
         DbRecord record;
         record.SetValues(id, values);
         return record;
@@ -627,7 +674,7 @@ public:
     template <class T, class V>
     inline bool LoadUnsafe(const T& problem_config, const std::string& id, V& values)
     {
-        if(dbInvalid)
+        if(dbInvalid && !binary)
             return false;
         const auto record = FindRecordUnsafe(problem_config);
 
@@ -635,5 +682,9 @@ public:
             return false;
         return record->GetValues(id, values);
     }
+
+private:
+    /// Pre-indexed binary counterpart of the system database, used instead of it if present.
+    std::shared_ptr<const BinaryDb> binary;
 };
 } // namespace miopen
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_THREAD_POOL_HPP_
+#define GUARD_MIOPEN_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace miopen {
+
+/// Fixed set of worker threads with a deque of tasks per worker. Workers take their own
+/// tasks in LIFO order and steal the oldest tasks of the others when idle. Tasks submitted
+/// from a worker go to its own deque, so nested parallel loops stay on the same threads
+/// instead of creating new ones.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(std::size_t workers);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Pool shared by the whole library. The threads that wait for tasks help to run them,
+    /// so the pool has one worker less than the number of hardware threads.
+    static ThreadPool& Global();
+
+    std::size_t Size() const;
+
+private:
+    friend class TaskGroup;
+    struct impl;
+    std::unique_ptr<impl> pImpl;
+
+    /// The task shall not throw
+    void Submit(std::function<void()> task);
+};
+
+/// Set of tasks run on a ThreadPool which can be waited for together. The waiting threads
+/// run the tasks of the group which have not started yet and only them, so waiting from
+/// inside of a task can't starve the pool, nor run an unrelated task in the middle of the
+/// waiting one.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool& pool_ = ThreadPool::Global());
+    /// Waits for the remaining tasks, exceptions are dropped.
+    ~TaskGroup();
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /// Can be called from the tasks of the group as well.
+    void Run(std::function<void()> task);
+    /// Waits for all the tasks of the group. Rethrows the first exception thrown by the tasks.
+    void Wait();
+    /// Runs the pending tasks of the group on the calling thread until done() returns true,
+    /// and sleeps while there are none. done() is checked again when a task of the group ends,
+    /// so it shall only be changed by the tasks of the group. It is called under a lock of the
+    /// group, one call per check, so it may take the result, e.g. pop a queue.
+    void RunPendingUntil(const std::function<bool()>& done);
+
+private:
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable task_done;
+        std::size_t pending = 0;
+        // Tasks which have not started yet
+        std::deque<std::function<void()>> tasks;
+        std::exception_ptr error;
+    };
+
+    /// Runs one of the tasks which have not started yet, the lock is released meanwhile.
+    /// Returns false if there are none.
+    static bool RunOne(State& state, std::unique_lock<std::mutex>& lock);
+
+    ThreadPool& pool;
+    std::shared_ptr<State> state = std::make_shared<State>();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_THREAD_POOL_HPP_
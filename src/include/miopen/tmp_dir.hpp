@@ -2,12 +2,17 @@
 #define MIOPEN_GUARD_MLOPEN_TMP_DIR_HPP
 
 #include <string>
+#include <vector>
 #include <boost/filesystem/path.hpp>
 
 namespace miopen {
 
 void SystemCmd(std::string cmd);
 
+/// Splits arguments at whitespace like the shell does, honouring quotes and backslashes.
+/// Expansions and redirections are not supported.
+std::vector<std::string> SplitCommandLine(const std::string& args);
+
 struct TmpDir
 {
     boost::filesystem::path path;
@@ -19,7 +24,8 @@ struct TmpDir
     TmpDir(TmpDir&& other) noexcept { (*this) = std::move(other); }
     TmpDir& operator=(TmpDir&& other) noexcept;
 
-    void Execute(std::string exe, std::string args) const;
+    /// Runs the program in the directory without a shell. Output is discarded when quiet.
+    void Execute(std::string exe, std::string args, bool quiet = false) const;
 
     ~TmpDir();
 };
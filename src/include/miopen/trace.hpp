@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRACE_HPP_
+#define GUARD_MIOPEN_TRACE_HPP_
+
+#include <chrono>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace miopen {
+namespace trace {
+
+/// Tracing is enabled by MIOPEN_TRACE_FILE, the path of the Chrome trace JSON written at exit.
+/// It can be opened by chrome://tracing or https://ui.perfetto.dev.
+bool IsEnabledImpl();
+
+/// Cached, so the disabled tracing costs a check of a flag.
+inline bool IsEnabled()
+{
+    static const bool enabled = IsEnabledImpl();
+    return enabled;
+}
+
+using Clock = std::chrono::steady_clock;
+
+/// Records an event on the timeline of the calling thread. The names and the categories shall
+/// be string literals. Instant events have no duration.
+void AddSpan(const char* category, const char* name, Clock::time_point start, std::string args);
+void AddInstant(const char* category, const char* name, std::string args);
+/// Writes the events recorded so far, which is also done at exit.
+void Flush();
+
+/// Records the time from its construction to its destruction as a span. The arguments are
+/// formatted only when tracing is enabled.
+class Span
+{
+public:
+    Span(const char* category_, const char* name_)
+        : category(category_), name(name_), enabled(IsEnabled())
+    {
+        if(enabled)
+            start = Clock::now();
+    }
+
+    template <class F>
+    Span(const char* category_, const char* name_, F format_args)
+        : category(category_), name(name_), enabled(IsEnabled())
+    {
+        if(enabled)
+        {
+            args  = FormatArgs(format_args);
+            start = Clock::now();
+        }
+    }
+
+    ~Span()
+    {
+        if(enabled)
+            AddSpan(category, name, start, std::move(args));
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    static std::string FormatArgs(const std::function<void(std::ostream&)>& format_args);
+
+private:
+    const char* category;
+    const char* name;
+    bool enabled;
+    Clock::time_point start;
+    std::string args;
+};
+
+} // namespace trace
+} // namespace miopen
+
+#define MIOPEN_TRACE_CAT(x, y) MIOPEN_TRACE_PRIMITIVE_CAT(x, y)
+#define MIOPEN_TRACE_PRIMITIVE_CAT(x, y) x##y
+
+/// Traces the rest of the scope.
+#define MIOPEN_TRACE_SCOPE(category, name) \
+    const miopen::trace::Span MIOPEN_TRACE_CAT(miopen_trace_span_, __LINE__){category, name}
+
+/// Traces the rest of the scope with the arguments given as a stream expression, like in
+/// MIOPEN_LOG: MIOPEN_TRACE_SCOPE_ARGS("db", "FindRecord", "key: " << key).
+#define MIOPEN_TRACE_SCOPE_ARGS(category, name, ...)                                           \
+    const miopen::trace::Span MIOPEN_TRACE_CAT(miopen_trace_span_, __LINE__)                   \
+    {                                                                                          \
+        category, name, [&](std::ostream& miopen_trace_os) { miopen_trace_os << __VA_ARGS__; } \
+    }
+
+/// Records an instant event with the arguments given as a stream expression.
+#define MIOPEN_TRACE_EVENT(category, name, ...)                                               \
+    do                                                                                        \
+    {                                                                                         \
+        if(miopen::trace::IsEnabled())                                                        \
+            miopen::trace::AddInstant(                                                        \
+                category,                                                                     \
+                name,                                                                         \
+                miopen::trace::Span::FormatArgs(                                              \
+                    [&](std::ostream& miopen_trace_os) { miopen_trace_os << __VA_ARGS__; })); \
+    } while(false)
+
+#endif // GUARD_MIOPEN_TRACE_HPP_
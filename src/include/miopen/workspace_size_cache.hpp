@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_WORKSPACE_SIZE_CACHE_HPP_
+#define GUARD_MIOPEN_WORKSPACE_SIZE_CACHE_HPP_
+
+#include <miopen/names.hpp>
+#include <miopen/sharded_map.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace miopen {
+
+/// Workspace sizes of the problems of a handle, see ConvolutionDescriptor::GetWorkSpaceSize().
+/// The network config does not hold the attributes of the convolution nor the bias, so the
+/// controls are a mask of them and of everything else besides the problem which affects the set
+/// of the applicable solvers. Thread-safe.
+class WorkspaceSizeCache
+{
+public:
+    boost::optional<std::size_t> Get(const NetworkConfig& config, std::uint64_t controls) const
+    {
+        const auto size = sizes.Find({config, controls});
+        if(size == nullptr)
+            return boost::none;
+        return *size;
+    }
+
+    void Register(const NetworkConfig& config, std::uint64_t controls, std::size_t size)
+    {
+        sizes.Update({config, controls}, [&](std::size_t& item, bool) { item = size; });
+    }
+
+private:
+    using Key = std::pair<NetworkConfig, std::uint64_t>;
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            return key.first.Hash() ^ (key.second * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    ShardedMap<Key, std::size_t, KeyHash> sizes;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WORKSPACE_SIZE_CACHE_HPP_
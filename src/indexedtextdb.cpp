@@ -0,0 +1,525 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/indexedtextdb.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+
+/// Read-only view of the first size bytes of a file.
+class MappedFile
+{
+public:
+    MappedFile(const std::string& path, std::uint64_t size)
+    {
+        if(size == 0)
+            return;
+
+        namespace bip = boost::interprocess;
+        mapping       = bip::file_mapping{path.c_str(), bip::read_only};
+        region        = bip::mapped_region{mapping, bip::read_only, 0, size};
+    }
+
+    const char* Data() const { return static_cast<const char*>(region.get_address()); }
+    std::uint64_t Size() const { return region.get_size(); }
+
+private:
+    boost::interprocess::file_mapping mapping;
+    boost::interprocess::mapped_region region;
+};
+
+bool WriteAt(const std::string& path, std::uint64_t offset, const std::string& data)
+{
+    auto file = std::fstream{path, std::ios::in | std::ios::out | std::ios::binary};
+    if(!file)
+        return false;
+    file.seekp(offset);
+    file.write(data.data(), data.size());
+    return file.good();
+}
+
+// Files smaller than that are never compacted automatically.
+constexpr std::uint64_t CompactionThreshold() { return 64 * 1024; }
+
+} // namespace
+
+#define MIOPEN_VALIDATE_LOCK(lock)                       \
+    do                                                   \
+    {                                                    \
+        if(!(lock))                                      \
+            MIOPEN_THROW("Db lock has failed to lock."); \
+    } while(false)
+
+static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+
+using exclusive_lock = std::unique_lock<LockFile>;
+
+IndexedTextDb::IndexedTextDb(std::string path, bool is_system) : PlainTextDb(path, is_system) {}
+
+IndexedTextDb& IndexedTextDb::GetCached(const std::string& path, bool is_system)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::map<std::string, IndexedTextDb*>{};
+    const auto it         = instances.find(path);
+
+    if(it != instances.end())
+        return *it->second;
+
+    // The same reasoning as for RamDb::GetCached applies here: the objects are small, there are
+    // only a few of them, and they are intentionally never deleted.
+    auto instance = new IndexedTextDb{path, is_system};
+    instances.emplace(path, instance);
+    return *instance;
+}
+
+boost::optional<DbRecord> IndexedTextDb::FindRecord(const std::string& problem)
+{
+    if(DisableUserDbFileIO)
+        return {};
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return FindRecordUnsafe(problem);
+}
+
+bool IndexedTextDb::StoreRecord(const DbRecord& record)
+{
+    if(DisableUserDbFileIO)
+        return true;
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    MIOPEN_LOG_I2("Storing record: " << record.GetKey());
+    return StoreRecordUnsafe(record);
+}
+
+bool IndexedTextDb::UpdateRecord(DbRecord& record)
+{
+    if(DisableUserDbFileIO)
+        return true;
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    const auto old_record = FindRecordUnsafe(record.GetKey());
+    DbRecord new_record(record);
+    if(old_record)
+    {
+        new_record.Merge(*old_record);
+        MIOPEN_LOG_I2("Updating record: " << record.GetKey());
+    }
+    else
+    {
+        MIOPEN_LOG_I2("Storing record: " << record.GetKey());
+    }
+
+    const auto result = StoreRecordUnsafe(new_record);
+    if(result)
+        record = std::move(new_record);
+    return result;
+}
+
+bool IndexedTextDb::RemoveRecord(const std::string& key)
+{
+    if(DisableUserDbFileIO)
+        return true;
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    MIOPEN_LOG_I("Removing record: " << key);
+    // Storing of an empty record removes it.
+    return StoreRecordUnsafe(DbRecord(key));
+}
+
+bool IndexedTextDb::Remove(const std::string& key, const std::string& id)
+{
+    if(DisableUserDbFileIO)
+        return true;
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    auto record = FindRecordUnsafe(key);
+    if(!record)
+        return false;
+    if(!record->EraseValues(id))
+        return false;
+    return StoreRecordUnsafe(*record);
+}
+
+bool IndexedTextDb::Compact()
+{
+    if(DisableUserDbFileIO)
+        return true;
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    if(!ValidateUnsafe())
+        BuildIndexUnsafe();
+    return CompactUnsafe();
+}
+
+IndexedTextDb::FileState IndexedTextDb::GetFileState() const
+{
+    auto state = FileState{};
+    auto error = boost::system::error_code{};
+
+    state.size = boost::filesystem::file_size(GetFileName(), error);
+    if(error)
+        return {};
+    state.write_time = boost::filesystem::last_write_time(GetFileName(), error);
+    if(error)
+        return {};
+    return state;
+}
+
+void IndexedTextDb::InvalidateIndex() { is_indexed = false; }
+
+bool IndexedTextDb::ValidateUnsafe()
+{
+    // Foreign changes which keep both size and modification time intact (like removals done by
+    // other instances of this class within the same second) are caught later, by verification
+    // of the key stored at the indexed position. See LocateUnsafe().
+    return is_indexed && GetFileState() == indexed_state;
+}
+
+void IndexedTextDb::BuildIndexUnsafe()
+{
+    index.clear();
+    file_size    = 0;
+    unused_size  = 0;
+    ends_with_lf = true;
+    is_indexed   = true;
+
+    const auto state = GetFileState();
+    indexed_state    = state;
+
+    if(state.size == 0)
+        return;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    try
+    {
+        const auto file  = MappedFile{GetFileName(), state.size};
+        const auto* data = file.Data();
+        const auto size  = file.Size();
+        auto pos         = std::uint64_t{0};
+        auto n_line      = 0;
+
+        while(pos < size)
+        {
+            const auto* lf = static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+            const auto line_end  = lf != nullptr ? static_cast<std::uint64_t>(lf - data) : size;
+            const auto line_size = line_end - pos;
+            ++n_line;
+
+            const auto* eq = static_cast<const char*>(std::memchr(data + pos, '=', line_size));
+
+            if(line_size == 0)
+            {
+                unused_size += 1;
+            }
+            else if(eq == nullptr || eq == data + pos)
+            {
+                MIOPEN_LOG_E("Ill-formed record: key not found: " << GetFileName() << "#"
+                                                                  << n_line);
+                unused_size += line_size + 1;
+            }
+            else
+            {
+                // The first record wins, as in PlainTextDb. Duplicates are dropped on compaction.
+                auto key = std::string{data + pos, eq};
+                if(!index.emplace(std::move(key), IndexItem{pos, line_size}).second)
+                    unused_size += line_size + 1;
+            }
+
+            pos = line_end + 1;
+        }
+
+        file_size    = size;
+        ends_with_lf = data[size - 1] == '\n';
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        const auto log_level =
+            IsWarningIfUnreadable() ? LoggingLevel::Warning : LoggingLevel::Info2;
+        MIOPEN_LOG(log_level, "File is unreadable: " << GetFileName() << ": " << ex.what());
+        index.clear();
+        InvalidateIndex();
+        return;
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    MIOPEN_LOG_I2("Indexed " << index.size() << " records of " << GetFileName() << " in "
+                             << (end - start).count() * .000001f << " ms");
+}
+
+boost::optional<std::string> IndexedTextDb::ReadLineUnsafe(const IndexItem& item) const
+{
+    try
+    {
+        const auto file = MappedFile{GetFileName(), item.begin + item.size};
+        if(file.Size() < item.begin + item.size)
+            return boost::none;
+        return std::string{file.Data() + item.begin, file.Data() + item.begin + item.size};
+    }
+    catch(const boost::interprocess::interprocess_exception&)
+    {
+        return boost::none;
+    }
+}
+
+boost::optional<IndexedTextDb::IndexItem> IndexedTextDb::LocateUnsafe(const std::string& key,
+                                                                      std::string* line)
+{
+    if(!ValidateUnsafe())
+        BuildIndexUnsafe();
+
+    const auto matches = [&](const IndexItem& item) {
+        auto read = ReadLineUnsafe(item);
+        if(!read || read->size() <= key.size() || read->compare(0, key.size(), key) != 0 ||
+           (*read)[key.size()] != '=')
+            return false;
+        if(line != nullptr)
+            *line = std::move(*read);
+        return true;
+    };
+
+    auto it = index.find(key);
+    if(it == index.end())
+        return boost::none;
+    if(matches(it->second))
+        return it->second;
+
+    MIOPEN_LOG_I2("Index of " << GetFileName() << " is out of date, rebuilding");
+    BuildIndexUnsafe();
+
+    it = index.find(key);
+    if(it == index.end() || !matches(it->second))
+        return boost::none;
+    return it->second;
+}
+
+boost::optional<DbRecord> IndexedTextDb::FindRecordUnsafe(const std::string& key)
+{
+    MIOPEN_LOG_I2("Looking for key " << key << " in file " << GetFileName());
+
+    auto line = std::string{};
+    if(!LocateUnsafe(key, &line))
+        return boost::none;
+
+    MIOPEN_LOG_I2("Key match: " << key);
+    auto contents = line.substr(key.size() + 1);
+    if(!contents.empty() && contents.back() == '\r')
+        contents.pop_back();
+
+    if(contents.empty())
+    {
+        MIOPEN_LOG_E("None contents under the key: " << key << " form file " << GetFileName());
+        return boost::none;
+    }
+    MIOPEN_LOG_I2("Contents found: " << contents);
+
+    DbRecord record(key);
+    if(!record.ParseContents(contents))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file "
+                                                             << GetFileName());
+        MIOPEN_LOG_E("Contents: " << contents);
+        return boost::none;
+    }
+    return record;
+}
+
+bool IndexedTextDb::StoreRecordUnsafe(const DbRecord& record)
+{
+    const auto& key = record.GetKey();
+    auto ss         = std::ostringstream{};
+    record.WriteContents(ss);
+    const auto line = ss.str();
+
+    if(const auto old = LocateUnsafe(key, nullptr))
+    {
+        if(!line.empty() && line.size() == old->size + 1)
+        {
+            if(!WriteAt(GetFileName(), old->begin, line))
+            {
+                MIOPEN_LOG_E("File is unwritable: " << GetFileName());
+                InvalidateIndex();
+                return false;
+            }
+            // The last line may lack the line feed, which is written now
+            const auto end = old->begin + line.size();
+            if(end >= file_size)
+            {
+                file_size    = end;
+                ends_with_lf = true;
+            }
+            indexed_state = GetFileState();
+            return true;
+        }
+
+        // Line feeds are skipped as empty lines by all the readers of the format.
+        if(!WriteAt(GetFileName(), old->begin, std::string(old->size, '\n')))
+        {
+            MIOPEN_LOG_E("File is unwritable: " << GetFileName());
+            InvalidateIndex();
+            return false;
+        }
+        index.erase(key);
+        unused_size += old->size + 1;
+        indexed_state = GetFileState();
+    }
+
+    if(!line.empty())
+    {
+        const auto is_new = file_size == 0;
+        const auto prefix = std::string{ends_with_lf ? "" : "\n"};
+
+        {
+            auto file = std::ofstream{GetFileName(), std::ios::app | std::ios::binary};
+            if(!file)
+            {
+                MIOPEN_LOG_E("File is unwritable: " << GetFileName());
+                InvalidateIndex();
+                return false;
+            }
+            file << prefix << line;
+            if(!file.flush())
+            {
+                MIOPEN_LOG_E("File is unwritable: " << GetFileName());
+                InvalidateIndex();
+                return false;
+            }
+        }
+
+        if(is_new)
+            boost::filesystem::permissions(GetFileName(), boost::filesystem::all_all);
+
+        const auto begin = file_size + prefix.size();
+        index[key]       = IndexItem{begin, line.size() - 1};
+        file_size        = begin + line.size();
+        ends_with_lf     = true;
+        indexed_state    = GetFileState();
+    }
+
+    if(unused_size * 2 > file_size && file_size > CompactionThreshold())
+        CompactUnsafe();
+    return true;
+}
+
+bool IndexedTextDb::CompactUnsafe()
+{
+    if(unused_size == 0)
+        return true;
+
+    MIOPEN_LOG_I2("Compacting " << GetFileName() << ": " << unused_size << " of " << file_size
+                                << " bytes are unused");
+
+    // Records are written in the order of appearance to keep the file diffable.
+    auto items = std::vector<std::pair<std::uint64_t, IndexItem*>>{};
+    items.reserve(index.size());
+    for(auto& pair : index)
+        items.emplace_back(pair.second.begin, &pair.second);
+    std::sort(items.begin(), items.end(), [](const auto& left, const auto& right) {
+        return left.first < right.first;
+    });
+
+    const auto temp_name = GetFileName() + ".temp";
+    auto new_begins      = std::vector<std::uint64_t>{};
+    new_begins.reserve(items.size());
+    auto new_size = std::uint64_t{0};
+
+    try
+    {
+        const auto from = MappedFile{GetFileName(), file_size};
+        auto to         = std::ofstream{temp_name, std::ios::binary};
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+
+        for(const auto& item : items)
+        {
+            if(item.second->begin + item.second->size > from.Size())
+            {
+                MIOPEN_LOG_E("Index of " << GetFileName() << " is out of date, compaction failed");
+                InvalidateIndex();
+                return false;
+            }
+            new_begins.push_back(new_size);
+            to.write(from.Data() + item.second->begin, item.second->size);
+            to.put('\n');
+            new_size += item.second->size + 1;
+        }
+
+        if(!to.flush())
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_E("File is unreadable: " << GetFileName() << ": " << ex.what());
+        InvalidateIndex();
+        return false;
+    }
+
+    std::remove(GetFileName().c_str());
+    std::rename(temp_name.c_str(), GetFileName().c_str());
+    boost::filesystem::permissions(GetFileName(), boost::filesystem::all_all);
+
+    for(auto i = 0u; i < items.size(); ++i)
+        items[i].second->begin = new_begins[i];
+
+    file_size     = new_size;
+    unused_size   = 0;
+    ends_with_lf  = true;
+    indexed_state = GetFileState();
+    return true;
+}
+
+} // namespace miopen
@@ -31,104 +31,58 @@ namespace miopen {
 
 boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
+    const auto invoker = invokers.Find(key);
+    if(invoker == nullptr)
         return boost::none;
-    const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
-    if(invoker == item_invokers.end())
-        return boost::none;
-    return invoker->second;
+    return *invoker;
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const NetworkConfig& network_config,
                                                           const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-    {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
-        return boost::none;
-    }
-    if(item->second.found_1_0.empty())
-    {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
+    const auto solver_id = GetFound1_0SolverId(network_config, algorithm);
+    if(!solver_id)
         return boost::none;
-    }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
-    {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
-        return boost::none;
-    }
-    const auto invoker = item_invokers.find(found_1_0_id->second);
-    if(invoker == item_invokers.end())
-        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
-    return invoker->second;
+    const auto invoker = invokers.Find({network_config, *solver_id});
+    if(invoker == nullptr)
+        MIOPEN_THROW("No invoker with solver_id of " + *solver_id + " was registered for " +
+                     network_config.ToString());
+    return *invoker;
 }
 
-boost::optional<const std::string&>
-InvokerCache::GetFound1_0SolverId(const std::string& network_config,
-                                  const std::string& algorithm) const
+boost::optional<std::string> InvokerCache::GetFound1_0SolverId(const NetworkConfig& network_config,
+                                                               const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-    {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
-        return boost::none;
-    }
-    if(item->second.found_1_0.empty())
-    {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
-        return boost::none;
-    }
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
-    {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
-        return boost::none;
-    }
-    return found_1_0_id->second;
+    // Copied under the lock as SetAsFound1_0() may replace it
+    auto solver_id = found_1_0.Read({network_config, algorithm}, [](const std::string* id) {
+        return id == nullptr ? boost::optional<std::string>{} : boost::make_optional(*id);
+    });
+    if(!solver_id)
+        MIOPEN_LOG_I2("There is no find 1.0 result for " << network_config.ToString()
+                                                          << " with an algorithm " << algorithm);
+    return solver_id;
 }
 
 void InvokerCache::Register(const Key& key, const Invoker& invoker)
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
-    auto& item = invokers.insert({key.first, Item{}}).first->second;
-    item.invokers.insert({key.second, invoker});
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    invokers.Emplace(key, invoker);
+    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first.ToString() << " and solver "
+                                                      << key.second);
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
+void InvokerCache::SetAsFound1_0(const NetworkConfig& network_config,
                                  const std::string& algorithm,
                                  const std::string& solver_id)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
-
-    {
-        // Validating at find time
-        const auto& item_invokers = item->second.invokers;
-        const auto invoker        = item_invokers.find(solver_id);
-        if(invoker == item_invokers.end())
-            MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
-    }
+    // Validating at find time
+    if(invokers.Find({network_config, solver_id}) == nullptr)
+        MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
+                     network_config.ToString());
 
-    item->second.found_1_0[algorithm] = solver_id;
+    found_1_0.Update({network_config, algorithm},
+                     [&](std::string& id, bool) { id = solver_id; });
     MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
-                            << " in " << network_config);
+                            << " in " << network_config.ToString());
 }
 
 } // namespace miopen
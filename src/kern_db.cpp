@@ -24,18 +24,63 @@
  *
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
+#include <miopen/env.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERN_DB_CODEC)
 
 namespace miopen {
+namespace {
+std::function<std::string(std::string, bool*)> GetCompressFn(KernelCodec codec)
+{
+    switch(codec)
+    {
+    case KernelCodec::Bzip2: return [](std::string s, bool* c) { return compress(s, c); };
+    case KernelCodec::Lz: return [](std::string s, bool* c) { return lz::compress(s, c); };
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown kernel codec");
+}
+
+int64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+std::function<std::string(std::string, unsigned int)> GetDecompressFn(KernelCodec codec)
+{
+    switch(codec)
+    {
+    case KernelCodec::Bzip2: return [](std::string s, unsigned n) { return decompress(s, n); };
+    case KernelCodec::Lz: return [](std::string s, unsigned n) { return lz::decompress(s, n); };
+    }
+    return {};
+}
+} // namespace
+
 KernDb::KernDb(const std::string& filename_, bool is_system_)
-    : KernDb(filename_, is_system_, compress, decompress)
+    : KernDb(filename_, is_system_, DefaultCodec())
+{
+}
+
+KernDb::KernDb(const std::string& filename_, bool is_system_, KernelCodec codec_)
+    : KernDb(filename_, is_system_, GetCompressFn(codec_), GetDecompressFn(codec_))
 {
+    codec = codec_;
 }
 
 KernDb::KernDb(const std::string& filename_,
                bool is_system_,
                std::function<std::string(std::string, bool*)> compress_fn_,
                std::function<std::string(std::string, unsigned int)> decompress_fn_)
-    : SQLiteBase(filename_, is_system_), compress_fn(compress_fn_), decompress_fn(decompress_fn_)
+    : SQLiteBase(filename_, is_system_),
+      codec(KernelCodec::Bzip2),
+      compress_fn(compress_fn_),
+      decompress_fn(decompress_fn_)
 {
     if(!is_system && DisableUserDbFileIO)
         return;
@@ -61,7 +106,277 @@ KernDb::KernDb(const std::string& filename_,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
+    }
+    has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    if(!has_codec_column && !is_system)
+    {
+        // Created by an older version, all the existing rows are bzip2
+        try
+        {
+            sql.Exec("ALTER TABLE " + KernelConfig::table_name() +
+                     " ADD COLUMN `codec` INT NOT NULL DEFAULT 0;");
+        }
+        catch(const Exception& ex)
+        {
+            // Another process may have added the column in the meantime
+            MIOPEN_LOG_I2(ex.what());
+        }
+        has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    }
+    if(!is_system)
+    {
+        has_access_column = CheckTableColumns(KernelConfig::table_name(), {"last_access"});
+        if(!has_access_column)
+        {
+            // Created by an older version, the existing rows are evicted first
+            try
+            {
+                sql.Exec("ALTER TABLE " + KernelConfig::table_name() +
+                         " ADD COLUMN `last_access` INT NOT NULL DEFAULT 0;");
+            }
+            catch(const Exception& ex)
+            {
+                MIOPEN_LOG_I2(ex.what());
+            }
+            has_access_column = CheckTableColumns(KernelConfig::table_name(), {"last_access"});
+        }
+    }
+}
+
+KernelCodec KernDb::DefaultCodec()
+{
+    const auto name = GetStringEnv(MIOPEN_KERN_DB_CODEC{});
+    if(name == nullptr || std::strcmp(name, "lz") == 0)
+        return KernelCodec::Lz;
+    if(std::strcmp(name, "bz2") == 0)
+        return KernelCodec::Bzip2;
+    MIOPEN_LOG_W("Unknown MIOPEN_KERN_DB_CODEC value: " << name << ", using lz");
+    return KernelCodec::Lz;
+}
+
+void KernDb::BeginBatch()
+{
+    const std::lock_guard<std::mutex> lock{batch->mutex};
+    ++batch->depth;
+}
+
+void KernDb::EndBatch()
+{
+    {
+        const std::lock_guard<std::mutex> lock{batch->mutex};
+        assert(batch->depth > 0);
+        if(--batch->depth != 0)
+            return;
+    }
+    FlushBatch();
+}
+
+std::size_t KernDb::MaxBatchSize()
+{
+    // Limits the memory held by a batch, kernels are rarely larger than a few hundreds of KiB.
+    return 64 * 1024 * 1024;
+}
+
+KernDb::Blob KernDb::Pack(const std::string& data) const
+{
+    auto md5_sum         = md5(data);
+    bool success         = false;
+    auto compressed_blob = compress_fn(data, &success);
+    if(!success)
+        return {data, std::move(md5_sum), 0, codec};
+    return {std::move(compressed_blob),
+            std::move(md5_sum),
+            static_cast<int64_t>(data.size()),
+            codec};
+}
+
+boost::optional<std::string> KernDb::Unpack(Blob blob) const
+{
+    std::string& decompressed_blob = blob.data;
+    if(blob.uncompressed_size != 0)
+    {
+        if(blob.codec == codec)
+        {
+            decompressed_blob = decompress_fn(blob.data, blob.uncompressed_size);
+        }
+        else
+        {
+            const auto decompress_other = GetDecompressFn(blob.codec);
+            if(!decompress_other)
+            {
+                MIOPEN_LOG_W("Unknown kernel codec " << static_cast<int64_t>(blob.codec)
+                                                     << " in " << filename);
+                return boost::none;
+            }
+            decompressed_blob = decompress_other(blob.data, blob.uncompressed_size);
+        }
     }
+    auto new_md5 = md5(decompressed_blob);
+    if(new_md5 != blob.md5_hash)
+        MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+    return std::move(decompressed_blob);
+}
+
+void KernDb::Write(const std::string& name, const std::string& args, const Blob& blob)
+{
+    if(!has_codec_column && blob.codec != KernelCodec::Bzip2 && blob.uncompressed_size != 0)
+        MIOPEN_THROW(miopenStatusInternalError, "No codec column in " + filename);
+
+    std::string columns = "kernel_name, kernel_args, kernel_blob, kernel_hash, uncompressed_size";
+    std::string values  = "?, ?, ?, ?, ?";
+    if(has_codec_column)
+    {
+        columns += ", codec";
+        values += ", ?";
+    }
+    if(has_access_column)
+    {
+        columns += ", last_access";
+        values += ", ?";
+    }
+    const auto insert_query = "INSERT OR REPLACE INTO " + KernelConfig::table_name() + "(" +
+                              columns + ") VALUES(" + values + ");";
+    auto stmt = SQLite::Statement{sql, insert_query};
+    stmt.BindText(1, name);
+    stmt.BindText(2, args);
+    stmt.BindBlob(3, blob.data);
+    stmt.BindText(4, blob.md5_hash);
+    stmt.BindInt64(5, blob.uncompressed_size);
+    auto idx = 6;
+    if(has_codec_column)
+        stmt.BindInt64(idx++, static_cast<int64_t>(blob.codec));
+    if(has_access_column)
+        stmt.BindInt64(idx++, Now());
+
+    auto rc = stmt.Step(sql);
+    if(rc != SQLITE_DONE)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+}
+
+void KernDb::Touch(int64_t id, int64_t last_access)
+{
+    constexpr int64_t resolution = 60 * 60;
+    const auto now               = Now();
+    if(now - last_access < resolution)
+        return;
+
+    try
+    {
+        auto stmt = SQLite::Statement{
+            sql, "UPDATE " + KernelConfig::table_name() + " SET last_access = ? WHERE id = ?;"};
+        stmt.BindInt64(1, now);
+        stmt.BindInt64(2, id);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_LOG_I2("Unable to update the kernel access time: " << sql.ErrorMessage());
+    }
+    catch(const Exception& ex)
+    {
+        // Losing an update only makes the kernel a bit more likely to be evicted
+        MIOPEN_LOG_I2(ex.what());
+    }
+}
+
+std::uint64_t KernDb::GetSize()
+{
+    if(filename.empty() || dbInvalid)
+        return 0;
+    auto stmt = SQLite::Statement{
+        sql, "SELECT SUM(LENGTH(kernel_blob)) FROM " + KernelConfig::table_name() + ";"};
+    if(stmt.Step(sql) != SQLITE_ROW)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    return static_cast<std::uint64_t>(stmt.ColumnInt64(0));
+}
+
+std::size_t KernDb::Shrink(std::uint64_t size)
+{
+    if(filename.empty() || dbInvalid || !has_access_column)
+        return 0;
+
+    auto transaction = SQLite::Transaction{sql};
+    std::vector<int64_t> evicted;
+    {
+        auto stmt = SQLite::Statement{sql,
+                                      "SELECT id, LENGTH(kernel_blob) FROM " +
+                                          KernelConfig::table_name() +
+                                          " ORDER BY last_access DESC, id DESC;"};
+        // The most recent kernels are kept while they fit
+        std::uint64_t kept = 0;
+        for(auto rc = stmt.Step(sql); rc != SQLITE_DONE; rc = stmt.Step(sql))
+        {
+            if(rc != SQLITE_ROW)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            const auto blob_size = static_cast<std::uint64_t>(stmt.ColumnInt64(1));
+            if(kept + blob_size <= size && evicted.empty())
+                kept += blob_size;
+            else
+                evicted.push_back(stmt.ColumnInt64(0));
+        }
+    }
+
+    for(const auto id : evicted)
+    {
+        auto stmt =
+            SQLite::Statement{sql, "DELETE FROM " + KernelConfig::table_name() + " WHERE id = ?;"};
+        stmt.BindInt64(1, id);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+    transaction.Commit();
+
+    if(!evicted.empty())
+        MIOPEN_LOG_I("Evicted " << evicted.size() << " kernels from " << filename);
+    return evicted.size();
+}
+
+void KernDb::Vacuum()
+{
+    if(filename.empty() || dbInvalid)
+        return;
+    MIOPEN_LOG_I("Compacting " << filename);
+    sql.Exec("PRAGMA wal_checkpoint(TRUNCATE);");
+    sql.Exec("VACUUM;");
+}
+
+void KernDb::FlushBatch()
+{
+    // The flushed records are only read by this thread and the lookups, which don't modify them
+    const std::lock_guard<std::mutex> flush_lock{batch->flush_mutex};
+    {
+        const std::lock_guard<std::mutex> lock{batch->mutex};
+        if(batch->records.empty())
+            return;
+        batch->flushing = std::move(batch->records);
+        batch->records.clear();
+        batch->size = 0;
+    }
+
+    MIOPEN_LOG_I2("Writing " << batch->flushing.size() << " kernels to " << filename);
+
+    try
+    {
+        auto transaction = SQLite::Transaction{sql};
+        for(const auto& record : batch->flushing)
+            Write(record.first.first, record.first.second, record.second);
+        transaction.Commit();
+    }
+    catch(...)
+    {
+        // Keeps the records for the next flush, the ones stored since then are newer
+        const std::lock_guard<std::mutex> lock{batch->mutex};
+        for(auto& record : batch->flushing)
+        {
+            if(batch->records.count(record.first) != 0)
+                continue;
+            batch->size += record.second.data.size();
+            batch->records.emplace(record.first, std::move(record.second));
+        }
+        batch->flushing.clear();
+        throw;
+    }
+
+    const std::lock_guard<std::mutex> lock{batch->mutex};
+    batch->flushing.clear();
 }
 
 } // namespace miopen
@@ -45,6 +45,8 @@
 #include <miopen/logger.hpp>
 #include <miopen/stringutils.hpp>
 
+#include <boost/optional.hpp>
+
 #include <iostream>
 #include <iterator>
 
@@ -52,21 +54,23 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
 
 namespace miopen {
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+KernelCache::Kernels KernelCache::GetKernels(const std::string& algorithm,
+                                             const std::string& network_config)
 {
 
     std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
 
-    const auto it = kernel_map.find(key);
-    if(it != kernel_map.end())
+    auto kernels = kernel_map.Read(key, [](const Kernels* item) {
+        return item == nullptr ? Kernels{} : *item;
+    });
+    if(kernels != nullptr)
     {
-        MIOPEN_LOG_I2(it->second.size()
+        MIOPEN_LOG_I2(kernels->size()
                       << " kernels for key: " << key.first << " \"" << key.second << '\"');
-        return it->second;
+        return kernels;
     }
 
-    static const std::vector<Kernel> empty{};
+    static const auto empty = std::make_shared<const std::vector<Kernel>>();
     MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
     return empty;
 }
@@ -74,21 +78,19 @@ const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
 bool KernelCache::HasProgram(const std::string& name, const std::string& params) const
 {
     const auto key = std::make_pair(name, params);
-    return program_map.count(key) > 0;
+    return program_map.Find(key) != nullptr;
 }
 
 void KernelCache::ClearProgram(const std::string& name, const std::string& params)
 {
-    if(HasProgram(name, params))
-    {
-        const auto key = std::make_pair(name, params);
-        program_map.erase(key);
-    }
+    const auto key = std::make_pair(name, params);
+    program_map.Erase(key);
 }
 
 void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
 {
-    program_map[std::make_pair(program_name, params)] = prog;
+    program_map.Update(std::make_pair(program_name, params),
+                       [&](Program& item, bool) { item = std::move(prog); });
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -107,31 +109,30 @@ Kernel KernelCache::AddKernel(const Handle& h,
     if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
         MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
 
-    Program program;
+    const auto program_key = std::make_pair(program_name, params);
+    auto program           = program_map.Read(program_key, [](const Program* p) {
+        return p == nullptr ? boost::optional<Program>{} : boost::make_optional(*p);
+    });
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
-    {
-        program = program_it->second;
-    }
-    else
+    if(!program)
     {
         if(!is_kernel_miopengemm_str) // default value
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
                                        algorithm.find("GEMM") != std::string::npos;
-        program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+        auto built = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
+        // Built without holding the lock, another thread may have added the program meanwhile
+        program = *program_map.Emplace(program_key, std::move(built)).first;
     }
 
     Kernel kernel{};
     const char* const arch = miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{});
     if(arch != nullptr && strlen(arch) > 0)
     {
-        kernel = Kernel{program, kernel_name};
+        kernel = Kernel{*program, kernel_name};
     }
     else
     {
-        kernel = Kernel{program, kernel_name, vld, vgd};
+        kernel = Kernel{*program, kernel_name, vld, vgd};
     }
 
     if(!network_config.empty() && !algorithm.empty())
@@ -143,12 +144,16 @@ Kernel KernelCache::AddKernel(const Handle& h,
 
 void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
 {
-    auto&& v = kernel_map[key];
-    if(cache_index >= v.size())
-    {
-        v.resize(cache_index + 1);
-    }
-    v[cache_index] = k;
+    // Copy on write, the snapshots returned by GetKernels() are never modified
+    kernel_map.Update(key, [&](Kernels& item, bool) {
+        auto v = item == nullptr ? std::vector<Kernel>{} : *item;
+        if(cache_index >= v.size())
+        {
+            v.resize(cache_index + 1);
+        }
+        v[cache_index] = std::move(k);
+        item           = std::make_shared<const std::vector<Kernel>>(std::move(v));
+    });
 }
 
 void KernelCache::ClearKernels(const std::string& algorithm, const std::string& network_config)
@@ -158,12 +163,14 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
         MIOPEN_THROW("Network config or algorithm empty.");
     }
     const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v                                      = this->kernel_map[key];
-    if(!v.empty())
-    {
-        MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
-    }
-    v.clear();
+    kernel_map.Update(key, [&](Kernels& item, bool) {
+        if(item != nullptr && !item->empty())
+        {
+            MIOPEN_LOG_I2(item->size()
+                          << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        }
+        item = nullptr;
+    });
 }
 
 KernelCache::KernelCache() {}
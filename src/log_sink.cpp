@@ -0,0 +1,368 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/log_sink.hpp>
+#include <miopen/env.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace logger {
+
+/// Writes the binary log to the file instead of the text to std::cerr. Enables the
+/// asynchronous logging, see MIOPEN_LOG_ASYNC.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_LOG_BINARY_FILE)
+
+namespace {
+
+constexpr char binary_magic[]          = {'M', 'I', 'O', 'P', 'E', 'N', 'L', 'G'};
+constexpr std::uint32_t binary_version = 1;
+
+template <class T>
+void WriteBinary(std::ostream& stream, T value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void WriteBinary(std::ostream& stream, const std::string& value)
+{
+    WriteBinary(stream, static_cast<std::uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+}
+
+template <class T>
+bool ReadBinary(std::istream& stream, T& value)
+{
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+bool ReadBinary(std::istream& stream, std::string& value)
+{
+    std::uint32_t size = 0;
+    if(!ReadBinary(stream, size))
+        return false;
+    value.resize(size);
+    return static_cast<bool>(stream.read(&value[0], size));
+}
+
+/// Single producer, single consumer queue of the records of a thread.
+class RecordRing
+{
+public:
+    bool TryPush(Record& record)
+    {
+        const auto tail = write.load(std::memory_order_relaxed);
+        if(tail - read.load(std::memory_order_acquire) == capacity)
+            return false;
+        slots[tail % capacity] = std::move(record);
+        write.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <class F>
+    void Drain(F f)
+    {
+        const auto head = read.load(std::memory_order_relaxed);
+        const auto tail = write.load(std::memory_order_acquire);
+        for(auto i = head; i != tail; ++i)
+            f(std::move(slots[i % capacity]));
+        read.store(tail, std::memory_order_release);
+    }
+
+    bool Empty() const
+    {
+        return read.load(std::memory_order_acquire) == write.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr std::size_t capacity = 1024;
+
+    std::array<Record, capacity> slots;
+    std::atomic<std::size_t> read{0};
+    std::atomic<std::size_t> write{0};
+};
+
+class AsyncLog
+{
+public:
+    static AsyncLog& Instance()
+    {
+        // Leaked, so the threads which log during the static destruction do not outlive it.
+        // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+        static auto* const instance = new AsyncLog{};
+        return *instance;
+    }
+
+    void Push(Record&& record)
+    {
+        if(stopped)
+        {
+            Write({std::move(record)});
+            return;
+        }
+
+        auto& ring = ThreadRing();
+        while(!ring.TryPush(record))
+        {
+            Wake();
+            std::this_thread::yield();
+        }
+    }
+
+    void Flush()
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        const auto requested = ++flush_requested;
+        cv.notify_all();
+        flushed_cv.wait(lock, [&]() { return flushed >= requested || stopped; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::condition_variable flushed_cv;
+    std::vector<std::shared_ptr<RecordRing>> rings;
+    std::size_t flush_requested = 0;
+    std::size_t flushed         = 0;
+    std::atomic<bool> stopped{false};
+    bool stop = false;
+
+    std::mutex output_mutex;
+    std::ofstream binary;
+    std::int64_t last_time_ns = 0;
+    std::thread flusher;
+
+    AsyncLog()
+    {
+        const auto binary_path = GetStringEnv(MIOPEN_LOG_BINARY_FILE{});
+        if(binary_path != nullptr)
+        {
+            binary.open(binary_path, std::ios::binary | std::ios::trunc);
+            if(binary)
+                WriteBinaryHeader(binary);
+            else
+                std::cerr << "Unable to open the binary log: " << binary_path << std::endl;
+        }
+        flusher = std::thread{[this]() { Run(); }};
+        std::atexit([]() { Instance().Stop(); });
+    }
+
+    RecordRing& ThreadRing()
+    {
+        thread_local const auto ring = [this]() {
+            auto created = std::make_shared<RecordRing>();
+            const std::lock_guard<std::mutex> lock{mutex};
+            rings.push_back(created);
+            return created;
+        }();
+        return *ring;
+    }
+
+    void Wake()
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        ++flush_requested;
+        cv.notify_all();
+    }
+
+    void Stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+            cv.notify_all();
+        }
+        flusher.join();
+        stopped = true;
+        flushed_cv.notify_all();
+        // The records pushed meanwhile
+        Drain();
+    }
+
+    void Run()
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+        while(true)
+        {
+            cv.wait_for(lock, std::chrono::milliseconds{50}, [&]() {
+                return stop || flush_requested > flushed;
+            });
+            const auto requested = flush_requested;
+            const auto stopping  = stop;
+            lock.unlock();
+            Drain();
+            lock.lock();
+            flushed = std::max(flushed, requested);
+            flushed_cv.notify_all();
+            if(stopping)
+                break;
+        }
+    }
+
+    void Drain()
+    {
+        auto snapshot = std::vector<std::shared_ptr<RecordRing>>{};
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            // Rings of the exited threads are dropped once empty
+            rings.erase(std::remove_if(rings.begin(),
+                                       rings.end(),
+                                       [](auto&& ring) {
+                                           return ring.use_count() == 1 && ring->Empty();
+                                       }),
+                        rings.end());
+            snapshot = rings;
+        }
+
+        auto records = std::vector<Record>{};
+        for(const auto& ring : snapshot)
+            ring->Drain([&](Record&& record) { records.push_back(std::move(record)); });
+        std::stable_sort(records.begin(), records.end(), [](auto&& left, auto&& right) {
+            return left.time_ns < right.time_ns;
+        });
+        Write(std::move(records));
+    }
+
+    void Write(std::vector<Record>&& records)
+    {
+        if(records.empty())
+            return;
+        const std::lock_guard<std::mutex> lock{output_mutex};
+
+        if(binary.is_open())
+        {
+            for(const auto& record : records)
+                WriteBinaryRecord(binary, record);
+            binary.flush();
+            return;
+        }
+
+        std::string text;
+        for(const auto& record : records)
+        {
+            auto elapsed = boost::optional<float>{};
+            if(IsLoggingElapsedTime())
+            {
+                elapsed = last_time_ns == 0 ? 0.0f : (record.time_ns - last_time_ns) / 1.0e6f;
+                last_time_ns = record.time_ns;
+            }
+            const auto thread_id =
+                IsLoggingThreadId() ? boost::make_optional(record.thread_id) : boost::none;
+            text += FormatRecord(record, MakePrefix(LibraryName(), thread_id, elapsed));
+        }
+        std::cerr << text;
+    }
+};
+
+} // namespace
+
+std::string MakePrefix(const std::string& library,
+                       boost::optional<int> thread_id,
+                       boost::optional<float> elapsed_ms)
+{
+    auto prefix = thread_id ? std::to_string(*thread_id) + ' ' + library : library;
+    if(elapsed_ms)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%8.3f", *elapsed_ms);
+        prefix += buffer;
+    }
+    return prefix + ": ";
+}
+
+std::string FormatRecord(const Record& record, const std::string& prefix)
+{
+    if(record.raw)
+        return prefix + record.message + '\n';
+    return prefix + record.category + " [" + record.function + "] " + record.message + '\n';
+}
+
+void WriteBinaryHeader(std::ostream& stream)
+{
+    stream.write(binary_magic, sizeof(binary_magic));
+    WriteBinary(stream, binary_version);
+    WriteBinary(stream, std::string{LibraryName()});
+}
+
+void WriteBinaryRecord(std::ostream& stream, const Record& record)
+{
+    WriteBinary(stream, record.time_ns);
+    WriteBinary(stream, static_cast<std::int32_t>(record.thread_id));
+    WriteBinary(stream, static_cast<std::int32_t>(record.level));
+    WriteBinary(stream, static_cast<std::uint8_t>(record.raw));
+    WriteBinary(stream, record.category);
+    WriteBinary(stream, record.function);
+    WriteBinary(stream, record.message);
+}
+
+boost::optional<std::string> ReadBinaryHeader(std::istream& stream)
+{
+    char magic[sizeof(binary_magic)] = {};
+    std::uint32_t version            = 0;
+    std::string library;
+    if(!stream.read(magic, sizeof(magic)) ||
+       !std::equal(std::begin(magic), std::end(magic), std::begin(binary_magic)) ||
+       !ReadBinary(stream, version) || version != binary_version || !ReadBinary(stream, library))
+        return boost::none;
+    return library;
+}
+
+bool ReadBinaryRecord(std::istream& stream, Record& record)
+{
+    std::int32_t thread_id = 0;
+    std::int32_t level     = 0;
+    std::uint8_t raw       = 0;
+    if(!ReadBinary(stream, record.time_ns) || !ReadBinary(stream, thread_id) ||
+       !ReadBinary(stream, level) || !ReadBinary(stream, raw) ||
+       !ReadBinary(stream, record.category) || !ReadBinary(stream, record.function) ||
+       !ReadBinary(stream, record.message))
+        return false;
+    record.thread_id = thread_id;
+    record.level     = static_cast<LoggingLevel>(level);
+    record.raw       = raw != 0;
+    return true;
+}
+
+bool IsLoggingBinary() { return GetStringEnv(MIOPEN_LOG_BINARY_FILE{}) != nullptr; }
+
+void PushAsync(Record&& record) { AsyncLog::Instance().Push(std::move(record)); }
+
+void FlushAsync() { AsyncLog::Instance().Flush(); }
+
+} // namespace logger
+} // namespace miopen
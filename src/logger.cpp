@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <miopen/env.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/log_sink.hpp>
 #include <miopen/config.h>
 
 #include <cstdlib>
@@ -60,6 +61,10 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME)
 /// See LoggingLevel in the header.
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_LOG_LEVEL)
 
+/// The logging threads only put the messages to their queues, a background thread formats
+/// and writes them. Messages may be lost if the process crashes.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_LOG_ASYNC)
+
 namespace debug {
 
 bool LoggingQuiet = false; // NOLINT (cppcoreguidelines-avoid-non-const-global-variables)
@@ -94,7 +99,8 @@ inline int GetProcessAndThreadId()
 {
 #ifdef __linux__
     // LWP is fine for identifying both processes and threads.
-    return syscall(SYS_gettid); // NOLINT
+    thread_local const int id = syscall(SYS_gettid); // NOLINT
+    return id;
 #else
     return 0; // Not implemented.
 #endif
@@ -123,6 +129,23 @@ bool IsLoggingFunctionCalls()
     return miopen::IsEnabled(MIOPEN_ENABLE_LOGGING{}) && !IsLoggingDebugQuiet();
 }
 
+bool IsLoggingAsync()
+{
+    return miopen::IsEnabled(MIOPEN_LOG_ASYNC{}) || logger::IsLoggingBinary();
+}
+
+LoggingLevel GetLoggingLevelMax()
+{
+    const auto enabled_level = miopen::Value(MIOPEN_LOG_LEVEL{});
+    if(enabled_level != LoggingLevel::Default)
+        return static_cast<LoggingLevel>(enabled_level);
+#ifdef NDEBUG
+    return LoggingLevel::Warning;
+#else
+    return LoggingLevel::Info;
+#endif
+}
+
 bool IsLogging(const LoggingLevel level, const bool disableQuieting)
 {
     auto enabled_level = miopen::Value(MIOPEN_LOG_LEVEL{});
@@ -171,23 +194,109 @@ bool IsLoggingCmd()
 
 std::string LoggingPrefix()
 {
-    std::stringstream ss;
-    if(miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_MPMT{}))
-    {
-        ss << GetProcessAndThreadId() << ' ';
-    }
-    ss << "MIOpen";
+    return logger::MakePrefix(
+        logger::LibraryName(),
+        logger::IsLoggingThreadId() ? boost::make_optional(GetProcessAndThreadId()) : boost::none,
+        logger::IsLoggingElapsedTime() ? boost::make_optional(GetTimeDiff()) : boost::none);
+}
+
+namespace logger {
+
+const char* LibraryName()
+{
 #if MIOPEN_BACKEND_OPENCL
-    ss << "(OpenCL)";
+    return "MIOpen(OpenCL)";
 #elif MIOPEN_BACKEND_HIP
-    ss << "(HIP)";
+    return "MIOpen(HIP)";
+#else
+    return "MIOpen";
 #endif
-    if(miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME{}))
+}
+
+bool IsLoggingThreadId() { return miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_MPMT{}); }
+
+bool IsLoggingElapsedTime() { return miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME{}); }
+
+namespace {
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+thread_local std::ostringstream thread_stream;
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+thread_local bool thread_stream_busy = false;
+
+void Log(Record&& record)
+{
+    if(!IsLoggingAsync())
+    {
+        std::cerr << FormatRecord(record, LoggingPrefix());
+        return;
+    }
+
+    record.time_ns   = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+    record.thread_id = GetProcessAndThreadId();
+    const auto level = record.level;
+    PushAsync(std::move(record));
+    // Errors are written right away, they may precede a crash
+    if(level == LoggingLevel::Error || level == LoggingLevel::Fatal)
+        FlushAsync();
+}
+
+} // namespace
+
+MessageStream::MessageStream()
+{
+    if(thread_stream_busy)
     {
-        ss << std::fixed << std::setprecision(3) << std::setw(8) << GetTimeDiff();
+        // Formatting of a message logs another one
+        owned  = std::make_unique<std::ostringstream>();
+        stream = owned.get();
+        return;
     }
-    ss << ": ";
-    return ss.str();
+    thread_stream_busy = true;
+    stream             = &thread_stream;
+    stream->str({});
+    stream->clear();
+    stream->flags(std::ios_base::skipws | std::ios_base::dec);
+    stream->precision(6);
+    stream->width(0);
+    stream->fill(' ');
+}
+
+MessageStream::~MessageStream()
+{
+    if(!owned)
+        thread_stream_busy = false;
+}
+
+} // namespace logger
+
+void LogMessage(const LoggingLevel level,
+                const std::string& category,
+                const std::string& function,
+                std::string message)
+{
+    logger::Record record;
+    record.level    = level;
+    record.category = category;
+    record.function = function;
+    record.message  = std::move(message);
+    logger::Log(std::move(record));
+}
+
+void LogLine(std::string line)
+{
+    logger::Record record;
+    record.raw     = true;
+    record.message = std::move(line);
+    logger::Log(std::move(record));
+}
+
+void FlushLog()
+{
+    if(IsLoggingAsync())
+        logger::FlushAsync();
 }
 
 /// Expected to be invoked with __func__ and __PRETTY_FUNCTION__.
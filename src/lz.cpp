@@ -0,0 +1,218 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/lz.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace miopen {
+namespace lz {
+namespace {
+constexpr std::size_t min_match     = 4;
+constexpr std::size_t last_literals = 5;  // the last bytes of a block are always literals
+constexpr std::size_t match_limit   = 12; // no match may start in the last bytes of a block
+constexpr std::size_t max_offset    = 65535;
+constexpr int hash_log              = 16;
+
+uint32_t Read32(const char* p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t Hash(uint32_t v) { return (v * 2654435761U) >> (32 - hash_log); }
+
+void WriteLength(std::string& out, std::size_t len)
+{
+    for(; len >= 255; len -= 255)
+        out.push_back(static_cast<char>(255));
+    out.push_back(static_cast<char>(len));
+}
+
+void WriteSequence(std::string& out,
+                   const char* literals,
+                   std::size_t literal_len,
+                   std::size_t offset,
+                   std::size_t match_len)
+{
+    const auto match_code = match_len - min_match;
+    const auto token      = ((literal_len < 15 ? literal_len : 15) << 4) |
+                       (match_code < 15 ? match_code : 15);
+    out.push_back(static_cast<char>(token));
+    if(literal_len >= 15)
+        WriteLength(out, literal_len - 15);
+    out.append(literals, literal_len);
+    if(match_len == 0)
+        return;
+    out.push_back(static_cast<char>(offset & 0xFF));
+    out.push_back(static_cast<char>(offset >> 8));
+    if(match_code >= 15)
+        WriteLength(out, match_code - 15);
+}
+
+[[noreturn]] void Fail(const std::string& what)
+{
+    throw std::runtime_error("LZ decompress failed: " + what);
+}
+
+std::size_t ReadLength(const unsigned char*& ip, const unsigned char* end)
+{
+    std::size_t len = 0;
+    unsigned char b;
+    do
+    {
+        if(ip == end)
+            Fail("the compressed data ends unexpectedly");
+        b = *ip++;
+        len += b;
+    } while(b == 255);
+    return len;
+}
+} // namespace
+
+std::string compress(std::string s, bool* compressed)
+{
+    if(s.empty())
+        throw std::runtime_error("LZ compress failed: empty input");
+
+    const auto n   = s.size();
+    const auto src = s.data();
+    std::string result;
+    result.reserve(n + n / 255 + 16);
+
+    std::size_t anchor = 0;
+    if(n > match_limit)
+    {
+        // Positions are stored +1, zero means empty
+        std::vector<uint32_t> table(std::size_t{1} << hash_log, 0);
+        const auto limit = n - match_limit;
+        std::size_t pos  = 0;
+        while(pos < limit)
+        {
+            const auto seq = Read32(src + pos);
+            auto& slot     = table[Hash(seq)];
+            const auto ref = static_cast<std::size_t>(slot);
+            slot           = static_cast<uint32_t>(pos + 1);
+
+            if(ref == 0 || pos + 1 - ref > max_offset || Read32(src + ref - 1) != seq)
+            {
+                // Skip faster over incompressible data
+                pos += 1 + ((pos - anchor) >> 6);
+                continue;
+            }
+
+            const auto match_pos = ref - 1;
+            auto match_len       = min_match;
+            while(pos + match_len < n - last_literals &&
+                  src[match_pos + match_len] == src[pos + match_len])
+                ++match_len;
+
+            WriteSequence(result, src + anchor, pos - anchor, pos - match_pos, match_len);
+            pos += match_len;
+            anchor = pos;
+            if(result.size() >= n)
+                break;
+        }
+    }
+    if(result.size() < n)
+        WriteSequence(result, src + anchor, n - anchor, 0, 0);
+
+    if(result.size() >= n)
+    {
+        if(compressed == nullptr)
+            throw std::runtime_error(
+                "LZ compress failed: the size of the compressed data exceeds the input size");
+        *compressed = false;
+        return s;
+    }
+    if(compressed != nullptr)
+        *compressed = true;
+    return result;
+}
+
+std::string decompress(std::string s, unsigned int size)
+{
+    std::string result(size, 0);
+    auto ip              = reinterpret_cast<const unsigned char*>(s.data());
+    const auto end       = ip + s.size();
+    auto op              = &result[0];
+    const auto out_begin = op;
+    const auto out_end   = op + result.size();
+
+    while(ip != end)
+    {
+        const unsigned token    = *ip++;
+        std::size_t literal_len = token >> 4;
+        if(literal_len == 15)
+            literal_len += ReadLength(ip, end);
+        if(literal_len > static_cast<std::size_t>(end - ip))
+            Fail("the compressed data ends unexpectedly");
+        if(literal_len > static_cast<std::size_t>(out_end - op))
+            Fail("the size of the decompressed data exceeds the expected size");
+        std::memcpy(op, ip, literal_len);
+        ip += literal_len;
+        op += literal_len;
+
+        if(ip == end)
+            break; // the last sequence has no match
+
+        if(end - ip < 2)
+            Fail("the compressed data ends unexpectedly");
+        const std::size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if(offset == 0 || offset > static_cast<std::size_t>(op - out_begin))
+            Fail("a data integrity error was detected in the compressed data");
+
+        std::size_t match_len = token & 15;
+        if(match_len == 15)
+            match_len += ReadLength(ip, end);
+        match_len += min_match;
+        if(match_len > static_cast<std::size_t>(out_end - op))
+            Fail("the size of the decompressed data exceeds the expected size");
+
+        const char* match = op - offset;
+        if(offset >= match_len)
+        {
+            std::memcpy(op, match, match_len);
+            op += match_len;
+        }
+        else
+        {
+            // Overlapping copy repeats the last offset bytes
+            for(auto i = std::size_t{0}; i < match_len; ++i)
+                *op++ = *match++;
+        }
+    }
+
+    result.resize(op - out_begin);
+    return result;
+}
+
+} // namespace lz
+} // namespace miopen
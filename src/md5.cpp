@@ -303,7 +303,7 @@ static void MD5_Final(unsigned char* result, MD5_CTX* ctx)
 
 namespace miopen {
 
-std::string md5(std::string s)
+std::string md5(std::string_view s)
 {
     std::array<unsigned char, MD5_DIGEST_LENGTH> result{};
 
@@ -0,0 +1,215 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/memory_pool.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MEMORY_POOL_LIMIT)
+
+struct MemoryPool::Block
+{
+    Allocator::ManageDataPtr data;
+    std::size_t size;
+    miopenAcceleratorQueue_t stream;
+    std::weak_ptr<Impl> pool;
+};
+
+struct MemoryPool::Impl
+{
+    using BlockPtr = std::unique_ptr<Block>;
+    using Cached   = std::list<BlockPtr>;
+    using Bin      = std::vector<Cached::iterator>;
+
+    mutable std::mutex mutex;
+    std::size_t limit;
+    /// In the order the blocks have been freed, the oldest first.
+    Cached cached;
+    std::map<std::pair<miopenAcceleratorQueue_t, std::size_t>, Bin> bins;
+    MemoryPoolStats stats;
+
+    explicit Impl(std::size_t limit_) : limit(limit_) {}
+
+    std::size_t Held() const { return stats.bytes_in_use + stats.bytes_cached; }
+
+    void Cache(BlockPtr block)
+    {
+        const auto key = std::make_pair(block->stream, block->size);
+        stats.bytes_cached += block->size;
+        cached.push_back(std::move(block));
+        bins[key].push_back(std::prev(cached.end()));
+    }
+
+    BlockPtr Take(Cached::iterator it)
+    {
+        auto& bin = bins[std::make_pair((*it)->stream, (*it)->size)];
+        bin.erase(std::find(bin.begin(), bin.end(), it));
+        auto block = std::move(*it);
+        cached.erase(it);
+        stats.bytes_cached -= block->size;
+        return block;
+    }
+
+    /// Removes the least recently freed blocks until the held bytes are within the target.
+    /// The blocks are returned, so that the caller can free them outside of the lock.
+    std::vector<BlockPtr> Trim(std::size_t target)
+    {
+        std::vector<BlockPtr> evicted;
+        while(!cached.empty() && Held() > target)
+            evicted.push_back(Take(cached.begin()));
+        stats.releases += evicted.size();
+        return evicted;
+    }
+};
+
+MemoryPool::MemoryPool() : MemoryPool(Value(MIOPEN_MEMORY_POOL_LIMIT{}) * 1024 * 1024) {}
+
+MemoryPool::MemoryPool(std::size_t limit_) : impl(std::make_shared<Impl>(limit_)) {}
+
+MemoryPool::~MemoryPool() { Release(); }
+
+std::size_t MemoryPool::GetSizeClass(std::size_t size)
+{
+    constexpr std::size_t min_size = 256;
+    if(size <= min_size)
+        return min_size;
+
+    auto step = min_size / 4;
+    while(step * 8 < size)
+        step *= 2;
+    return (size + step - 1) / step * step;
+}
+
+Allocator::ManageDataPtr MemoryPool::TryReuse(std::size_t size, miopenAcceleratorQueue_t stream)
+{
+    if(size == 0)
+        return {};
+
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    if(impl->limit == 0)
+        return {};
+
+    const auto bin = impl->bins.find(std::make_pair(stream, GetSizeClass(size)));
+    if(bin == impl->bins.end() || bin->second.empty())
+        return {};
+
+    auto block = impl->Take(bin->second.back());
+    impl->stats.bytes_in_use += block->size;
+    impl->stats.hits++;
+
+    const auto data = block->data.get();
+    return {data, AllocatorDeleter{&MemoryPool::Deallocate, block.release()}};
+}
+
+Allocator::ManageDataPtr
+MemoryPool::Allocate(const Allocator& allocator, std::size_t size, miopenAcceleratorQueue_t stream)
+{
+    auto reused = TryReuse(size, stream);
+    if(reused)
+        return reused;
+
+    const auto size_class = GetSizeClass(size);
+    std::vector<Impl::BlockPtr> evicted;
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        if(impl->limit == 0 || size == 0)
+            return allocator(size);
+        impl->stats.misses++;
+        evicted = impl->Trim(impl->limit - std::min(impl->limit, size_class));
+    }
+    evicted.clear();
+
+    auto block = std::make_unique<Block>(Block{{}, size_class, stream, impl});
+    try
+    {
+        block->data = allocator(size_class);
+    }
+    catch(const Exception& ex)
+    {
+        if(GetStats().bytes_cached == 0)
+            throw;
+        MIOPEN_LOG_I("Releasing the memory pool after an allocation failure: " << ex.what());
+        Release();
+        block->data = allocator(size_class);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->stats.bytes_in_use += size_class;
+        impl->stats.peak_bytes = std::max(impl->stats.peak_bytes, impl->Held());
+    }
+
+    const auto data = block->data.get();
+    return {data, AllocatorDeleter{&MemoryPool::Deallocate, block.release()}};
+}
+
+void MemoryPool::Deallocate(void* block_ptr, void*)
+{
+    auto block      = std::unique_ptr<Block>{static_cast<Block*>(block_ptr)};
+    const auto pool = block->pool.lock();
+    if(pool == nullptr)
+        return;
+
+    std::vector<Impl::BlockPtr> evicted;
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    pool->stats.bytes_in_use -= block->size;
+    pool->Cache(std::move(block));
+    evicted = pool->Trim(pool->limit);
+}
+
+void MemoryPool::SetLimit(std::size_t limit_)
+{
+    std::vector<Impl::BlockPtr> evicted;
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->limit = limit_;
+    evicted     = impl->Trim(limit_);
+}
+
+void MemoryPool::Release()
+{
+    std::vector<Impl::BlockPtr> evicted;
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    evicted = impl->Trim(0);
+}
+
+MemoryPoolStats MemoryPool::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    auto stats  = impl->stats;
+    stats.limit = impl->limit;
+    return stats;
+}
+
+} // namespace miopen
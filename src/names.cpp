@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/names.hpp>
+#include <miopen/sharded_map.hpp>
+
+#include <memory>
+
+namespace miopen {
+
+NetworkConfig::NetworkConfig() : NetworkConfig(std::string{}) {}
+
+NetworkConfig::NetworkConfig(const std::string& value_)
+{
+    using Map = ShardedMap<std::string, std::unique_ptr<const Interned>>;
+    // Entries are never removed, the amount of distinct configs is small. Leaked to be usable
+    // from the destructors of other static objects.
+    static auto& interned = *new Map{};
+
+    const auto hash = Map::HashOf(value_);
+
+    value = interned.Read(value_, hash, [](const auto* item) {
+        return item == nullptr ? nullptr : item->get();
+    });
+    if(value != nullptr)
+        return;
+
+    value = interned.Update(value_, hash, [&](auto& item, bool inserted) {
+        if(inserted)
+            item.reset(new Interned{value_, hash});
+        return item.get();
+    });
+}
+
+} // namespace miopen
@@ -28,6 +28,7 @@
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
 #include <miopen/binary_cache.hpp>
+#include <miopen/env.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -56,6 +57,9 @@
 #include <chrono>
 #include <thread>
 #include <miopen/nogpu/handle_impl.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_CU)
+
 namespace miopen {
 
 Handle::Handle(miopenAcceleratorQueue_t /* stream */) : Handle::Handle() {}
@@ -75,17 +79,27 @@ void Handle::ReserveExtraStreamsInPool(int) const {}
 
 miopenAcceleratorQueue_t Handle::GetStream() const { return {}; }
 
-void Handle::SetAllocator(miopenAllocatorFunction /* allocator */,
-                          miopenDeallocatorFunction /* deallocator */,
-                          void* /* allocatorContext */) const
+void Handle::SetAllocator(miopenAllocatorFunction allocator,
+                          miopenDeallocatorFunction deallocator,
+                          void* allocatorContext) const
 {
+    // The cached blocks belong to the previous allocator.
+    this->impl->memory_pool.Release();
+    this->impl->allocator.allocator   = allocator;
+    this->impl->allocator.deallocator = deallocator;
+    this->impl->allocator.context     = allocatorContext;
 }
 
+MemoryPool& Handle::GetMemoryPool() const { return this->impl->memory_pool; }
+
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
 
 float Handle::GetKernelTime() const { return this->impl->profiling_result; }
 
-Allocator::ManageDataPtr Handle::Create(std::size_t sz) const { return this->impl->allocator(sz); }
+Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
+{
+    return this->impl->memory_pool.Allocate(this->impl->allocator, sz, this->GetStream());
+}
 
 Allocator::ManageDataPtr&
 Handle::WriteTo(const void* /* data */, Allocator::ManageDataPtr& ddata, std::size_t /* sz */) const
@@ -158,8 +172,8 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::shared_ptr<const std::vector<Kernel>>
+Handle::GetKernelsImpl(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -225,6 +239,17 @@ bool Handle::HasProgram(const std::string& program_name, const std::string& para
     return this->impl->cache.HasProgram(program_name, params);
 }
 
+bool Handle::IsProgramReady(const std::string& program_name, const std::string& params) const
+{
+    if(this->HasProgram(program_name, params))
+        return true;
+    auto binary_params = params;
+    if(!miopen::EndsWith(program_name, ".mlir"))
+        binary_params += " -mcpu=" + this->GetTargetProperties().Name();
+    return miopen::HasBinary(
+        this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, binary_params);
+}
+
 void Handle::AddProgram(Program prog,
                         const std::string& program_name,
                         const std::string& params) const
@@ -244,7 +269,14 @@ std::size_t Handle::GetLocalMemorySize() const { return this->impl->local_mem_si
 
 std::size_t Handle::GetGlobalMemorySize() const { return this->impl->global_mem_size; }
 
-std::size_t Handle::GetMaxComputeUnits() const { return this->impl->num_cu; }
+std::size_t Handle::GetMaxComputeUnits() const
+{
+    // There is no device to query, the CU count of the target can only be set by the variable
+    const std::size_t num_cu = Value(MIOPEN_DEVICE_CU{});
+    if(num_cu > 0)
+        return num_cu;
+    return this->impl->num_cu;
+}
 
 std::size_t Handle::GetImage3dMaxWidth() const { return this->impl->img3d_max_width; }
 
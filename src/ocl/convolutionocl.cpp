@@ -40,6 +40,7 @@
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/util.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/datatype.hpp>
@@ -50,8 +51,10 @@
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include <miopen/conv/heuristics/ai_heuristics.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
+#include <memory>
 #include <type_traits>
 
 #include <boost/range/adaptors.hpp>
@@ -59,6 +62,7 @@
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_ASYNC_COMPILE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DUMP_TENSOR_PATH)
@@ -105,10 +109,9 @@ static inline void ValidateGroupCount(const TensorDescriptor& xDesc,
     }
 }
 
-static Invoker PrepareInvoker(ExecutionContext ctx,
-                              const conv::ProblemDescription& problem,
-                              const NetworkConfig& config,
-                              solver::Id solver_id)
+static solver::ConvSolution FindInvokerSolution(ExecutionContext& ctx,
+                                                const conv::ProblemDescription& problem,
+                                                solver::Id solver_id)
 {
     ctx.DetectRocm();
     problem.SetupFloats(ctx);
@@ -118,8 +121,16 @@ static Invoker PrepareInvoker(ExecutionContext ctx,
     const auto legacy_problem = ProblemDescription{problem};
     const auto solver         = solver_id.GetSolver();
     auto db                   = GetDb(ctx);
-    auto solution =
-        solver.FindSolution(legacy_ctx, legacy_problem, db, {}); // auto tune is not expected here
+    // auto tune is not expected here
+    return solver.FindSolution(legacy_ctx, legacy_problem, db, {});
+}
+
+static Invoker PrepareInvoker(const ExecutionContext& ctx,
+                              const conv::ProblemDescription& problem,
+                              const NetworkConfig& config,
+                              solver::Id solver_id,
+                              const solver::ConvSolution& solution)
+{
     auto& handle = ctx.GetStream();
     auto invoker = handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
     const auto algo = AlgorithmName{solver_id.GetAlgo(problem.GetDirection())};
@@ -128,6 +139,15 @@ static Invoker PrepareInvoker(ExecutionContext ctx,
     return invoker;
 }
 
+static Invoker PrepareInvoker(ExecutionContext ctx,
+                              const conv::ProblemDescription& problem,
+                              const NetworkConfig& config,
+                              solver::Id solver_id)
+{
+    const auto solution = FindInvokerSolution(ctx, problem, solver_id);
+    return PrepareInvoker(ctx, problem, config, solver_id, solution);
+}
+
 Invoker LoadOrPrepareInvoker(const ExecutionContext& ctx,
                              const conv::ProblemDescription& problem,
                              solver::Id solver_id)
@@ -140,6 +160,97 @@ Invoker LoadOrPrepareInvoker(const ExecutionContext& ctx,
     return PrepareInvoker(ctx, problem, config, solver_id);
 }
 
+static solver::Id GetNaiveSolverId(conv::Direction direction)
+{
+    switch(direction)
+    {
+    case conv::Direction::Forward: return solver::Id{"ConvDirectNaiveConvFwd"};
+    case conv::Direction::BackwardData: return solver::Id{"ConvDirectNaiveConvBwd"};
+    case conv::Direction::BackwardWeights: return solver::Id{"ConvDirectNaiveConvWrw"};
+    }
+    MIOPEN_THROW(miopenStatusInternalError);
+}
+
+/// Returns an invoker which serves the problem without waiting for a compilation: the one
+/// prepared for another solver already, or the naive one which program is shared by all
+/// the problems and thus is built once.
+static boost::optional<Invoker> GetImmediateFallback(const ExecutionContext& ctx,
+                                                     const conv::ProblemDescription& problem,
+                                                     const NetworkConfig& config,
+                                                     solver::Id solver_id,
+                                                     std::size_t workspace_size)
+{
+    auto solver_ctx = ctx;
+    solver_ctx.DetectRocm();
+    problem.SetupFloats(solver_ctx);
+
+    const auto& handle        = ctx.GetStream();
+    const auto legacy_ctx     = ConvolutionContext{solver_ctx};
+    const auto legacy_problem = ProblemDescription{problem};
+
+    for(const auto& id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
+    {
+        if(id == solver_id)
+            continue;
+        const auto invoker = handle.GetInvoker(config, id);
+        if(invoker && id.GetSolver().GetWorkspaceSize(legacy_ctx, legacy_problem) <= workspace_size)
+        {
+            MIOPEN_LOG_I("Falling back to " << id.ToString());
+            return *invoker;
+        }
+    }
+
+    const auto naive = GetNaiveSolverId(problem.GetDirection());
+    if(naive == solver_id || !naive.GetSolver().IsApplicable(legacy_ctx, legacy_problem))
+        return boost::none;
+    MIOPEN_LOG_I("Falling back to " << naive.ToString());
+    return LoadOrPrepareInvoker(ctx, problem, naive);
+}
+
+/// With MIOPEN_CONV_ASYNC_COMPILE the programs missing from the kernel cache are built in
+/// background, and the calls are served by a fallback meanwhile. When the build is done, the
+/// invoker of the requested solver is registered and used by the next calls.
+static Invoker LoadOrPrepareImmediateInvoker(const ExecutionContext& ctx,
+                                             const conv::ProblemDescription& problem,
+                                             solver::Id solver_id,
+                                             std::size_t workspace_size)
+{
+    if(!miopen::IsEnabled(MIOPEN_CONV_ASYNC_COMPILE{}))
+        return LoadOrPrepareInvoker(ctx, problem, solver_id);
+
+    auto& handle      = ctx.GetStream();
+    const auto config = problem.BuildConfKey();
+    const auto key    = config.ToString() + ' ' + solver_id.ToString();
+
+    // The solution is only searched for when the invoker is not ready. The background build
+    // shares it, it is queued after the solution has been found.
+    struct Build
+    {
+        ExecutionContext ctx;
+        boost::optional<solver::ConvSolution> solution;
+    };
+    const auto build    = std::make_shared<Build>(Build{ctx, boost::none});
+    const auto solution = [=]() -> const solver::ConvSolution& {
+        if(!build->solution)
+            build->solution = FindInvokerSolution(build->ctx, problem, solver_id);
+        return *build->solution;
+    };
+
+    return GetOrBuildInBackground(
+        handle.GetCompileQueue(),
+        key,
+        [&]() { return handle.GetInvoker(config, solver_id); },
+        [&]() { return GetImmediateFallback(ctx, problem, config, solver_id, workspace_size); },
+        [&]() {
+            const auto& kernels = solution().construction_params;
+            return std::all_of(
+                kernels.begin(), kernels.end(), [&](const solver::KernelInfo& kernel) {
+                    return handle.IsProgramReady(kernel.kernel_file, kernel.comp_options);
+                });
+        },
+        [=]() { return PrepareInvoker(build->ctx, problem, config, solver_id, solution()); });
+}
+
 static void
 CompileSolution(solver::Id solver_id, ExecutionContext ctx, const conv::ProblemDescription& problem)
 {
@@ -449,6 +560,7 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
         {
             const auto& invoke_ctx = conv::DataInvokeParams{
                 tensors, workSpace, workSpaceSize, this->attribute.gfx90aFp16alt.GetFwd()};
+            MIOPEN_TRACE_SCOPE("invoker", "ConvolutionForward");
             (*invoker)(handle, invoke_ctx);
             return;
         }
@@ -762,9 +874,11 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
         const auto problem =
             conv::ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
         const auto ctx        = ExecutionContext{&handle};
-        const auto invoker    = LoadOrPrepareInvoker(ctx, problem, solver_id);
+        const auto invoker =
+            LoadOrPrepareImmediateInvoker(ctx, problem, solver_id, workSpaceSize);
         const auto invoke_ctx = conv::DataInvokeParams{
             tensors, workSpace, workSpaceSize, this->attribute.gfx90aFp16alt.GetFwd()};
+        MIOPEN_TRACE_SCOPE("invoker", "ConvolutionForwardImmediate");
         invoker(handle, invoke_ctx);
     });
 }
@@ -914,6 +1028,7 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
 
         const auto& invoke_ctx = conv::DataInvokeParams{
             tensors, workSpace, workSpaceSize, this->attribute.gfx90aFp16alt.GetBwd()};
+        MIOPEN_TRACE_SCOPE("invoker", "ConvolutionBackwardData");
         (*invoker)(handle, invoke_ctx);
     });
 }
@@ -971,9 +1086,11 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
         const auto problem =
             conv::ProblemDescription{dyDesc, wDesc, dxDesc, *this, conv::Direction::BackwardData};
         const auto ctx        = ExecutionContext{&handle};
-        const auto invoker    = LoadOrPrepareInvoker(ctx, problem, solver_id);
+        const auto invoker =
+            LoadOrPrepareImmediateInvoker(ctx, problem, solver_id, workSpaceSize);
         const auto invoke_ctx = conv::DataInvokeParams{
             tensors, workSpace, workSpaceSize, this->attribute.gfx90aFp16alt.GetBwd()};
+        MIOPEN_TRACE_SCOPE("invoker", "ConvolutionBackwardImmediate");
         invoker(handle, invoke_ctx);
     });
 }
@@ -1114,6 +1231,7 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(const Handle& handle,
 
         const auto invoke_ctx = conv::WrWInvokeParams{
             tensors, workSpace, workSpaceSize, this->attribute.gfx90aFp16alt.GetWrW()};
+        MIOPEN_TRACE_SCOPE("invoker", "ConvolutionBackwardWeights");
         (*invoker)(handle, invoke_ctx);
     });
 }
@@ -1169,9 +1287,11 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
         const auto problem = conv::ProblemDescription{
             dyDesc, dwDesc, xDesc, *this, conv::Direction::BackwardWeights};
         const auto ctx        = ExecutionContext{&handle};
-        const auto invoker    = LoadOrPrepareInvoker(ctx, problem, solver_id);
+        const auto invoker =
+            LoadOrPrepareImmediateInvoker(ctx, problem, solver_id, workSpaceSize);
         const auto invoke_ctx = conv::WrWInvokeParams{
             tensors, workSpace, workSpaceSize, this->attribute.gfx90aFp16alt.GetWrW()};
+        MIOPEN_TRACE_SCOPE("invoker", "ConvolutionWrwImmediate");
         invoker(handle, invoke_ctx);
     });
 }
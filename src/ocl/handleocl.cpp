@@ -38,6 +38,7 @@
 #include <miopen/manage_ptr.hpp>
 #include <miopen/ocldeviceinfo.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
 
 #if MIOPEN_USE_MIOPENGEMM
 #include <miopen/gemm_geometry.hpp>
@@ -82,6 +83,7 @@ struct HandleImpl
     AqPtr queue         = nullptr;
     cl_device_id device = nullptr; // NOLINT
     Allocator allocator{};
+    MemoryPool memory_pool;
     KernelCache cache;
     bool enable_profiling  = false;
     float profiling_result = 0.0;
@@ -302,6 +304,8 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
     {
         MIOPEN_THROW("Allocator context can not be used with the default allocator");
     }
+    // The cached blocks belong to the previous allocator.
+    this->impl->memory_pool.Release();
     this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
     this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
 
@@ -309,6 +313,8 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
         allocatorContext == nullptr ? this->impl->context.get() : allocatorContext;
 }
 
+MemoryPool& Handle::GetMemoryPool() const { return this->impl->memory_pool; }
+
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
 
 void Handle::ResetKernelTime() const { this->impl->ResetProfilingResult(); }
@@ -369,8 +375,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::shared_ptr<const std::vector<Kernel>>
+Handle::GetKernelsImpl(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -403,6 +409,7 @@ Program Handle::LoadProgram(const std::string& program_name,
                                     is_kernel_str);
     if(hsaco.empty())
     {
+        MIOPEN_TRACE_SCOPE_ARGS("compile", "Compile", program_name << ' ' << params);
         CompileTimer ct;
         auto p = miopen::LoadProgram(miopen::GetContext(this->GetStream()),
                                      miopen::GetDevice(this->GetStream()),
@@ -453,6 +460,13 @@ bool Handle::HasProgram(const std::string& program_name, const std::string& para
     return this->impl->cache.HasProgram(program_name, params);
 }
 
+bool Handle::IsProgramReady(const std::string& program_name, const std::string& params) const
+{
+    return this->HasProgram(program_name, params) ||
+           miopen::HasBinary(
+               this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, params);
+}
+
 void Handle::AddProgram(Program prog,
                         const std::string& program_name,
                         const std::string& params) const
@@ -518,8 +532,11 @@ std::size_t Handle::GetWavefrontWidth() const
 Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
 {
     MIOPEN_HANDLE_LOCK
+    auto reused = this->impl->memory_pool.TryReuse(sz, this->GetStream());
+    if(reused)
+        return reused;
     this->Finish();
-    return this->impl->allocator(sz);
+    return this->impl->memory_pool.Allocate(this->impl->allocator, sz, this->GetStream());
 }
 
 Allocator::ManageDataPtr&
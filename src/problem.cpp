@@ -27,10 +27,13 @@
 #include <miopen/problem.hpp>
 
 #include <miopen/conv/problem_description.hpp>
+#include <miopen/conv/solver_finders.hpp>
 #include <miopen/convolution.hpp>
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/execution_context.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/find_pipeline.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/mlo_internal.hpp>
@@ -105,6 +108,18 @@ void VisitType(int id, Args... args)
     detail::VisitType<Visitor, Variant>{}(id, args...);
 }
 
+namespace {
+
+/// The problem passed to the find of the convolution, transposed for the transposed convolutions
+conv::ProblemDescription AsConvolutionForFind(const Problem& problem)
+{
+    const auto& conv_desc = boost::get<ConvolutionDescriptor>(problem.GetOperatorDescriptor());
+    return conv_desc.mode == miopenTranspose ? problem.MakeTransposed().AsConvolution()
+                                             : problem.AsConvolution();
+}
+
+} // namespace
+
 std::vector<Solution>
 Problem::FindSolutions(Handle& handle, const FindOptions& options, std::size_t max_solutions) const
 {
@@ -156,6 +171,93 @@ Problem::FindSolutions(Handle& handle, const FindOptions& options, std::size_t m
     return ret;
 }
 
+std::vector<std::vector<Solution>>
+Problem::FindSolutions(Handle& handle,
+                       const std::vector<const Problem*>& problems,
+                       const FindOptions& options,
+                       std::size_t max_solutions)
+{
+    if(problems.size() > 1 && !options.preallocated_tensors.empty())
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Preallocated tensors can not be used to find solutions to several problems.");
+
+    auto unique  = std::vector<const Problem*>{};
+    auto indices = std::vector<std::size_t>{}; // Index in unique of each problem
+    indices.reserve(problems.size());
+
+    {
+        auto known = std::unordered_map<std::string, std::size_t>{};
+        for(const auto* problem : problems)
+        {
+            const auto key      = AsConvolutionForFind(*problem).BuildConfKey().ToString();
+            const auto inserted = known.emplace(key, unique.size());
+            if(inserted.second)
+                unique.push_back(problem);
+            indices.push_back(inserted.first->second);
+        }
+    }
+
+    MIOPEN_LOG_I("Finding solutions to " << problems.size() << " problems, " << unique.size()
+                                         << " unique");
+
+    if(!options.exhaustive_search)
+        PrecompileSolutions(handle, unique);
+
+    auto unique_solutions = std::vector<std::vector<Solution>>{};
+    unique_solutions.reserve(unique.size());
+    for(const auto* problem : unique)
+        unique_solutions.emplace_back(problem->FindSolutions(handle, options, max_solutions));
+
+    auto ret = std::vector<std::vector<Solution>>{};
+    ret.reserve(problems.size());
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        ret.emplace_back(unique_solutions[indices[i]]);
+        if(problems[i] == unique[indices[i]])
+            continue;
+        for(auto& solution : ret.back())
+            solution.SetProblem(*problems[i]);
+    }
+
+    return ret;
+}
+
+void Problem::PrecompileSolutions(Handle& handle, const std::vector<const Problem*>& problems)
+{
+    auto items = std::vector<ConvPrecompileItem>{};
+
+    for(const auto* problem : problems)
+    {
+        const auto conv_problem = AsConvolutionForFind(*problem);
+        const auto& conv_desc   = conv_problem.GetConv();
+        const auto& find_mode   = conv_desc.findMode;
+        auto ctx                = ExecutionContext{&handle};
+        ctx.DetectRocm();
+        conv_problem.SetupFloats(ctx);
+
+        if(!FindPipeline::IsParallelEnabled(ctx))
+            return;
+
+        // Precompiles only what the find would compile, see FindConvolution()
+        if(find_mode.IsFast(ctx) || find_mode.IsHybrid(ctx))
+            continue;
+        if(!UserFindDbRecord{handle, conv_problem}.empty())
+            continue;
+
+        auto conv_ctx                       = ConvolutionContext{ctx};
+        conv_ctx.use_dynamic_solutions_only = find_mode.IsDynamicHybrid(ctx);
+        auto legacy_problem                 = ProblemDescription{conv_problem};
+        const auto use_winograd_only =
+            conv_desc.IsWinograd3x3SupportedAndFast(conv_ctx, legacy_problem);
+
+        items.push_back({std::move(conv_ctx), std::move(legacy_problem), use_winograd_only});
+    }
+
+    if(!items.empty())
+        ConvPrecompileCore(handle, items, GetConvSolverFinders());
+}
+
 const TensorDescriptor& Problem::GetTensorDescriptorChecked(miopenTensorArgumentId_t name,
                                                             const std::string& name_str) const
 {
@@ -244,8 +346,7 @@ std::vector<Solution> Problem::FindSolutionsImpl(Handle& handle,
     const auto& w = buffers.at(miopenTensorConvolutionW);
     const auto& y = buffers.at(miopenTensorConvolutionY);
 
-    const auto conv_problem =
-        conv_desc.mode == miopenTranspose ? MakeTransposed().AsConvolution() : AsConvolution();
+    const auto conv_problem = AsConvolutionForFind(*this);
 
     std::size_t workspace_size;
     Allocator::ManageDataPtr owned_workspace;
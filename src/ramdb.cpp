@@ -29,6 +29,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/md5.hpp>
 
 #include <boost/filesystem/operations.hpp>
@@ -281,10 +282,11 @@ boost::optional<miopen::DbRecord> RamDb::FindRecordUnsafe(const std::string& pro
 }
 
 template <class TFunc>
-static void Measure(const std::string& funcName, TFunc&& func)
+static void Measure(const char* funcName, TFunc&& func)
 {
+    MIOPEN_TRACE_SCOPE("db", funcName);
     if(!miopen::IsLogging(LoggingLevel::Info))
-        func();
+        return func();
 
     const auto start = std::chrono::high_resolution_clock::now();
     func();
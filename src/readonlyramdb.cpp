@@ -26,6 +26,7 @@
 
 #include <miopen/readonlyramdb.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/errors.hpp>
 
 #if MIOPEN_EMBED_DB
@@ -34,10 +35,11 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
-#include <fstream>
+#include <algorithm>
 #include <mutex>
-#include <sstream>
 #include <map>
 
 namespace miopen {
@@ -51,6 +53,10 @@ bool& rordb_embed_fs_override()
 }
 } // namespace debug
 
+ReadonlyRamDb::ReadonlyRamDb(std::string path) : db_path(path) {}
+
+ReadonlyRamDb::~ReadonlyRamDb() = default;
+
 ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path, bool warn_if_unreadable)
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
@@ -78,8 +84,9 @@ ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path, bool warn_if_un
 }
 
 template <class TFunc>
-static auto Measure(const std::string& funcName, TFunc&& func)
+static auto Measure(const char* funcName, TFunc&& func)
 {
+    MIOPEN_TRACE_SCOPE("db", funcName);
     if(!miopen::IsLogging(LoggingLevel::Info))
         return func();
 
@@ -90,28 +97,29 @@ static auto Measure(const std::string& funcName, TFunc&& func)
                                    << " ms");
 }
 
-void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable)
+void ReadonlyRamDb::ParseAndLoadDb(std::string_view data)
 {
-    if(!input_stream)
-    {
-        const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB) ? LoggingLevel::Warning
-                                                                             : LoggingLevel::Info;
-        MIOPEN_LOG(log_level, "File is unreadable: " << db_path);
-        return;
-    }
+    cache.reserve(std::count(data.begin(), data.end(), '\n') + 1);
 
-    auto line   = std::string{};
     auto n_line = 0;
 
-    while(std::getline(input_stream, line))
+    while(!data.empty())
     {
         ++n_line;
 
+        const auto line_size = data.find('\n');
+        auto line            = data.substr(0, line_size);
+        data.remove_prefix(line_size == std::string_view::npos ? data.size() : line_size + 1);
+
+        // Files are mapped as binary data, so CR of CRLF line endings has to be skipped here.
+        if(!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
         if(line.empty())
             continue;
 
         const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+        const bool is_key   = (key_size != std::string_view::npos && key_size != 0);
 
         if(!is_key)
         {
@@ -131,6 +139,9 @@ void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
     Measure("Prefetch", [this, warn_if_unreadable]() {
         if(db_path.empty())
             return;
+        binary = BinaryDb::TryLoad(db_path, BinaryDb::KeyKind::Text);
+        if(binary)
+            return;
         constexpr bool isEmbedded = MIOPEN_EMBED_DB;
         // cppcheck-suppress knownConditionTrueFalse
         if(!debug::rordb_embed_fs_override() && isEmbedded)
@@ -146,14 +157,34 @@ void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
             const auto& p = it_p->second;
             ptrdiff_t sz  = p.second - p.first;
             MIOPEN_LOG_I2("Loading In Memory file: " << filepath);
-            auto input_stream = std::stringstream(std::string(p.first, sz));
-            ParseAndLoadDb(input_stream, warn_if_unreadable);
+            // The embedded data lives as long as the library, no need to copy it.
+            ParseAndLoadDb(std::string_view{p.first, static_cast<std::size_t>(sz)});
 #endif
         }
         else
         {
-            auto input_stream = std::ifstream{db_path};
-            ParseAndLoadDb(input_stream, warn_if_unreadable);
+            namespace bip = boost::interprocess;
+
+            try
+            {
+                // Mapping of an empty file is an error, and there is nothing to load anyway.
+                if(boost::filesystem::file_size(db_path) == 0)
+                    return;
+                const auto file = bip::file_mapping{db_path.c_str(), bip::read_only};
+                mapping         = std::make_unique<bip::mapped_region>(file, bip::read_only);
+            }
+            catch(const std::exception& ex)
+            {
+                const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                                           ? LoggingLevel::Warning
+                                           : LoggingLevel::Info;
+                MIOPEN_LOG(log_level, "File is unreadable: " << db_path);
+                MIOPEN_LOG_I2(ex.what());
+                return;
+            }
+
+            ParseAndLoadDb(std::string_view{static_cast<const char*>(mapping->get_address()),
+                                            mapping->get_size()});
         }
     });
 }
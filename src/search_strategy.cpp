@@ -0,0 +1,404 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_strategy.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/generic_search_controls.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+namespace miopen {
+namespace solver {
+
+SearchStrategyKind GetTuningStrategy()
+{
+    static const auto strategy = []() {
+        const char* const value = GetStringEnv(MIOPEN_TUNING_STRATEGY{});
+        if(value == nullptr || std::strlen(value) == 0 || std::strcmp(value, "exhaustive") == 0)
+            return SearchStrategyKind::Exhaustive;
+        if(std::strcmp(value, "halving") == 0)
+            return SearchStrategyKind::SuccessiveHalving;
+        if(std::strcmp(value, "random") == 0)
+            return SearchStrategyKind::Random;
+        if(std::strcmp(value, "local") == 0)
+            return SearchStrategyKind::Local;
+        MIOPEN_LOG_W("Unknown MIOPEN_TUNING_STRATEGY: " << value << ", using exhaustive");
+        return SearchStrategyKind::Exhaustive;
+    }();
+    return strategy;
+}
+
+SearchSpace::SearchSpace(std::vector<std::string> configs,
+                         boost::optional<std::size_t> default_index_)
+    : default_index(default_index_)
+{
+    fields.reserve(configs.size());
+    for(const auto& config : configs)
+    {
+        auto stream = std::istringstream{config};
+        auto field  = std::string{};
+        fields.emplace_back();
+        while(std::getline(stream, field, ','))
+            fields.back().push_back(field);
+    }
+}
+
+std::uint64_t SearchSpace::HashWithout(std::size_t index, std::size_t skipped) const
+{
+    // FNV-1a
+    auto hash      = std::uint64_t{14695981039346656037ULL};
+    const auto add = [&](unsigned char byte) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+    for(std::size_t i = 0; i < fields[index].size(); ++i)
+    {
+        if(i == skipped)
+        {
+            add(1);
+            continue;
+        }
+        for(const auto c : fields[index][i])
+            add(static_cast<unsigned char>(c));
+        add(0);
+    }
+    return hash;
+}
+
+std::vector<std::size_t> SearchSpace::GetNeighbours(std::size_t index) const
+{
+    if(neighbourhoods.empty())
+    {
+        for(std::size_t i = 0; i < fields.size(); ++i)
+            for(std::size_t j = 0; j < fields[i].size(); ++j)
+                neighbourhoods.emplace(HashWithout(i, j), i);
+    }
+
+    const auto& config = fields[index];
+    auto neighbours    = std::vector<std::size_t>{};
+    for(std::size_t j = 0; j < config.size(); ++j)
+    {
+        const auto range = neighbourhoods.equal_range(HashWithout(index, j));
+        for(auto it = range.first; it != range.second; ++it)
+        {
+            const auto& other = fields[it->second];
+            if(it->second == index || other.size() != config.size() || other[j] == config[j])
+                continue;
+            // Hashes may collide
+            auto differences = std::size_t{0};
+            for(std::size_t k = 0; k < config.size(); ++k)
+                if(other[k] != config[k])
+                    ++differences;
+            if(differences == 1)
+                neighbours.push_back(it->second);
+        }
+    }
+    return neighbours;
+}
+
+namespace {
+
+constexpr auto failed_time = std::numeric_limits<float>::max();
+
+std::vector<std::size_t> Shuffled(std::size_t size, std::mt19937& rng)
+{
+    auto indices = std::vector<std::size_t>(size);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::shuffle(indices.begin(), indices.end(), rng);
+    return indices;
+}
+
+std::vector<SearchRequest> MakeRequests(const std::vector<std::size_t>& indices, std::size_t runs)
+{
+    auto requests = std::vector<SearchRequest>{};
+    requests.reserve(indices.size());
+    for(const auto index : indices)
+        requests.push_back({index, runs});
+    return requests;
+}
+
+/// Evaluates the configs in random order.
+class ExhaustiveSearch final : public SearchStrategy
+{
+public:
+    ExhaustiveSearch(const SearchSpace& space, std::size_t max_configs, std::mt19937& rng)
+        : order(Shuffled(space.Size(), rng))
+    {
+        order.resize(std::min(order.size(), max_configs));
+    }
+
+    std::vector<SearchRequest> NextBatch() override
+    {
+        if(done)
+            return {};
+        done = true;
+        return MakeRequests(order, 0);
+    }
+
+    void Report(const SearchRequest&, float) override {}
+
+    std::size_t GetMaxEvaluations() const override { return order.size(); }
+
+private:
+    std::vector<std::size_t> order;
+    bool done = false;
+};
+
+/// Evaluates random configs until the best time stops improving.
+class RandomSearch final : public SearchStrategy
+{
+public:
+    RandomSearch(const SearchSpace& space, std::size_t max_configs, std::mt19937& rng)
+        : order(Shuffled(space.Size(), rng))
+    {
+        order.resize(std::min(order.size(), max_configs));
+        patience = std::max<std::size_t>(64, order.size() / 10);
+    }
+
+    std::vector<SearchRequest> NextBatch() override
+    {
+        if(next == order.size())
+            return {};
+        if(next - last_improvement >= patience)
+        {
+            MIOPEN_LOG_I("No improvement within " << patience << " configs, stopping after "
+                                                  << next);
+            return {};
+        }
+        const auto size  = std::min(batch_size, order.size() - next);
+        const auto first = order.begin() + next;
+        next += size;
+        return MakeRequests({first, first + size}, 0);
+    }
+
+    void Report(const SearchRequest&, float time) override
+    {
+        ++evaluated;
+        // Differences within the noise of measurements are not improvements
+        if(time < best_time * improvement)
+        {
+            best_time        = time;
+            last_improvement = evaluated;
+        }
+    }
+
+    std::size_t GetMaxEvaluations() const override { return order.size(); }
+
+private:
+    static constexpr std::size_t batch_size = 16;
+    static constexpr float improvement      = 0.99f;
+
+    std::vector<std::size_t> order;
+    std::size_t patience;
+    std::size_t next             = 0;
+    std::size_t evaluated        = 0;
+    std::size_t last_improvement = 0;
+    float best_time              = failed_time;
+};
+
+/// Times random configs roughly, then repeatedly keeps the best third of them and times it
+/// more precisely. The last few configs get the precise measurement.
+class SuccessiveHalving final : public SearchStrategy
+{
+public:
+    SuccessiveHalving(const SearchSpace& space, std::size_t max_configs, std::mt19937& rng)
+        : candidates(Shuffled(space.Size(), rng))
+    {
+        candidates.resize(std::min(candidates.size(), max_configs));
+        max_evaluations = candidates.size();
+    }
+
+    std::vector<SearchRequest> NextBatch() override
+    {
+        if(done)
+            return {};
+
+        if(!results.empty())
+        {
+            std::stable_sort(results.begin(), results.end(), [](auto&& left, auto&& right) {
+                return left.second < right.second;
+            });
+            const auto survivors = (results.size() + eta - 1) / eta;
+            candidates.clear();
+            for(std::size_t i = 0; i < survivors && results[i].second != failed_time; ++i)
+                candidates.push_back(results[i].first);
+            results.clear();
+            runs = std::min(runs * eta, max_runs);
+        }
+
+        if(candidates.empty())
+            return {};
+
+        done = candidates.size() <= eta;
+        max_evaluations += done ? 0 : (candidates.size() + eta - 1) / eta;
+        MIOPEN_LOG_I2("Evaluating " << candidates.size() << " configs, runs: " << runs);
+        return MakeRequests(candidates, done ? 0 : runs);
+    }
+
+    void Report(const SearchRequest& request, float time) override
+    {
+        results.emplace_back(request.index, time);
+    }
+
+    std::size_t GetMaxEvaluations() const override { return max_evaluations; }
+
+private:
+    static constexpr std::size_t eta      = 3;
+    static constexpr std::size_t max_runs = 9;
+
+    std::vector<std::size_t> candidates;
+    std::vector<std::pair<std::size_t, float>> results;
+    std::size_t runs = 1;
+    std::size_t max_evaluations;
+    bool done = false;
+};
+
+/// Hill climbing from the default config: evaluates the neighbours of the current config and
+/// moves to the best of them while it's faster. Restarts from random configs at local optimums,
+/// and stops after a few restarts which have not found a better config.
+class LocalSearch final : public SearchStrategy
+{
+public:
+    LocalSearch(const SearchSpace& space_, std::size_t max_configs_, std::mt19937& rng)
+        : space(space_),
+          max_configs(std::min(space_.Size(), max_configs_)),
+          evaluated(space_.Size(), false),
+          starts(Shuffled(space_.Size(), rng))
+    {
+    }
+
+    std::vector<SearchRequest> NextBatch() override
+    {
+        if(batch_best && (!current || batch_best_time < current_time))
+        {
+            current      = batch_best;
+            current_time = batch_best_time;
+        }
+        batch_best      = boost::none;
+        batch_best_time = failed_time;
+
+        if(n_evaluated >= max_configs)
+            return {};
+
+        if(current)
+        {
+            auto neighbours = std::vector<std::size_t>{};
+            for(const auto neighbour : space.GetNeighbours(*current))
+                if(!evaluated[neighbour] && n_evaluated + neighbours.size() < max_configs)
+                    neighbours.push_back(neighbour);
+            if(!neighbours.empty())
+                return Evaluate(neighbours);
+
+            // Local optimum
+            if(current_time < best_time)
+            {
+                best_time = current_time;
+                restarts  = 0;
+            }
+            else if(++restarts > max_restarts)
+            {
+                MIOPEN_LOG_I("No improvement after " << max_restarts << " restarts, stopping after "
+                                                     << n_evaluated);
+                return {};
+            }
+            current = boost::none;
+        }
+
+        const auto default_index = space.GetDefault();
+        if(default_index && !evaluated[*default_index])
+            return Evaluate({*default_index});
+        while(next_start < starts.size() && evaluated[starts[next_start]])
+            ++next_start;
+        if(next_start == starts.size())
+            return {};
+        return Evaluate({starts[next_start]});
+    }
+
+    void Report(const SearchRequest& request, float time) override
+    {
+        if(!batch_best || time < batch_best_time)
+        {
+            batch_best      = request.index;
+            batch_best_time = time;
+        }
+    }
+
+    std::size_t GetMaxEvaluations() const override { return max_configs; }
+
+private:
+    static constexpr std::size_t max_restarts = 2;
+
+    const SearchSpace& space;
+    std::size_t max_configs;
+    std::vector<bool> evaluated;
+    std::size_t n_evaluated = 0;
+    std::vector<std::size_t> starts;
+    std::size_t next_start = 0;
+    std::size_t restarts   = 0;
+    float best_time        = failed_time;
+    boost::optional<std::size_t> current;
+    float current_time = failed_time;
+    boost::optional<std::size_t> batch_best;
+    float batch_best_time = failed_time;
+
+    std::vector<SearchRequest> Evaluate(const std::vector<std::size_t>& indices)
+    {
+        for(const auto index : indices)
+            evaluated[index] = true;
+        n_evaluated += indices.size();
+        return MakeRequests(indices, 0);
+    }
+};
+
+} // namespace
+
+std::unique_ptr<SearchStrategy> MakeSearchStrategy(SearchStrategyKind kind,
+                                                   const SearchSpace& space,
+                                                   std::size_t max_configs,
+                                                   std::uint32_t seed)
+{
+    auto rng = std::mt19937{seed};
+    switch(kind)
+    {
+    case SearchStrategyKind::Exhaustive:
+        return std::make_unique<ExhaustiveSearch>(space, max_configs, rng);
+    case SearchStrategyKind::SuccessiveHalving:
+        return std::make_unique<SuccessiveHalving>(space, max_configs, rng);
+    case SearchStrategyKind::Random: return std::make_unique<RandomSearch>(space, max_configs, rng);
+    case SearchStrategyKind::Local: return std::make_unique<LocalSearch>(space, max_configs, rng);
+    }
+    MIOPEN_THROW(miopenStatusInternalError);
+}
+
+} // namespace solver
+} // namespace miopen
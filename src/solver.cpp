@@ -31,6 +31,7 @@
 #include <miopen/pooling/solvers.hpp>
 #include <miopen/fusion/solvers.hpp>
 
+#include <miopen/binary_cache.hpp>
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/db.hpp>
 #include <miopen/env.hpp>
@@ -39,6 +40,7 @@
 #include <miopen/stringutils.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <ostream>
@@ -61,8 +63,10 @@ std::ostream& operator<<(std::ostream& os, const KernelInfo& k)
 
 std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels)
 {
+    MIOPEN_TRACE_SCOPE_ARGS("compile", "PrecompileKernels", kernels.size() << " kernels");
     CompileTimer ct;
     std::vector<Program> programs(kernels.size());
+    const KernelCacheBatch kernel_cache_batch{h.GetTargetProperties(), h.GetMaxComputeUnits()};
 
     // clang-format off
     par_for_strided(kernels.size(),
@@ -754,17 +754,16 @@ ConvSolution ConvBinWinoRxS<Winodata, Winofilter>::GetSolution(
     const PerformanceConfigConvBinWinogradRxS& config) const
 {
     const auto n_groups = config.n_groups;
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static bool IsWarned;
-    if(!IsWarned)
-    {
+    // Checked once, the solutions may be searched for concurrently
+    static const auto is_warned = [&]() {
         if(ctx.GetStream().GetMaxHardwareComputeUnits() > MAX_CU_LIMIT)
             MIOPEN_LOG_WE(SolverDbId()
                           << ": GPU has " << ctx.GetStream().GetMaxHardwareComputeUnits()
                           << "CUs, but this solver supports max " << MAX_CU_LIMIT
                           << "and thus may show sub-optimal performance.");
-        IsWarned = true;
-    }
+        return true;
+    }();
+    std::ignore = is_warned;
 
     ConvSolution result;
 
@@ -57,6 +57,8 @@ int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_r
 }
 namespace miopen {
 
+using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+
 class SQLite::impl
 {
     struct SQLiteCloser
@@ -185,6 +187,40 @@ public:
 
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+
+    /// There are only a few distinct queries, so the limit is reached only if values are
+    /// inlined into the queries instead of being bound.
+    static constexpr std::size_t max_cached_statements = 64;
+
+    // Declared after ptrDb, so the cached statements are finalized before the db is closed.
+    std::mutex statements_mutex;
+    std::unordered_multimap<std::string, sqlite3_stmt_ptr> statements;
+    /// Held by the statements and the transactions for their lifetime. Otherwise statements of
+    /// other threads would join an open transaction of the shared connection and be lost on its
+    /// rollback. It is recursive, so the thread which runs the transaction issues statements.
+    std::recursive_mutex connection_mutex;
+
+    /// Returns nullptr if there is no cached statement for the query.
+    sqlite3_stmt_ptr TakeStatement(const std::string& query)
+    {
+        std::lock_guard<std::mutex> lock{statements_mutex};
+        const auto it = statements.find(query);
+        if(it == statements.end())
+            return nullptr;
+        auto stmt = std::move(it->second);
+        statements.erase(it);
+        return stmt;
+    }
+
+    void ReleaseStatement(const std::string& query, sqlite3_stmt_ptr stmt)
+    {
+        sqlite3_reset(stmt.get());
+        sqlite3_clear_bindings(stmt.get());
+
+        std::lock_guard<std::mutex> lock{statements_mutex};
+        if(statements.size() < max_cached_statements)
+            statements.emplace(query, std::move(stmt));
+    }
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -207,6 +243,7 @@ SQLite::result_type SQLite::Exec(const std::string& query) const
     SQLite::result_type res;
     MIOPEN_LOG_T(std::this_thread::get_id() << ":" << query);
     {
+        const std::lock_guard<std::recursive_mutex> lock{pImpl->connection_mutex};
         auto rc = Retry([&]() {
             return sqlite3_exec(pImpl->ptrDb.get(),
                                 query.c_str(),
@@ -274,13 +311,45 @@ std::string SQLite::ErrorMessage() const
 }
 bool SQLite::Valid() const { return pImpl->isValid; }
 
+SQLite::Transaction::Transaction(const SQLite& sql_)
+    : sql(sql_), lock(sql.pImpl->connection_mutex)
+{
+    // Write lock is taken immediately, so that the transaction doesn't fail on upgrade of a
+    // read lock if another process writes to the db in the meantime.
+    sql.Exec("BEGIN IMMEDIATE;");
+}
+
+SQLite::Transaction::~Transaction()
+{
+    if(finished)
+        return;
+
+    try
+    {
+        sql.Exec("ROLLBACK;");
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to rollback the transaction: " << ex.what());
+    }
+}
+
+void SQLite::Transaction::Commit()
+{
+    sql.Exec("COMMIT;");
+    finished = true;
+}
+
 class SQLite::Statement::impl
 {
-    using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
     sqlite3_stmt_ptr Prepare(const SQLite& sql, const std::string& query)
     {
+        auto cached = db->TakeStatement(query);
+        MIOPEN_LOG_I2(query << (cached ? " (cached)" : ""));
+        if(cached)
+            return cached;
+
         sqlite3_stmt* ptr = nullptr;
-        MIOPEN_LOG_I2(query);
         auto rc =
             sqlite3_prepare_v2(sql.pImpl->ptrDb.get(), query.c_str(), query.size(), &ptr, nullptr);
         if(rc != SQLITE_OK)
@@ -292,10 +361,14 @@ class SQLite::Statement::impl
     }
 
 public:
-    impl(const SQLite& sql, const std::string& query) { ptrStmt = Prepare(sql, query); }
-    impl(const SQLite& sql, const std::string& query, const std::vector<std::string>& vals)
+    impl(const SQLite& sql, const std::string& query_)
+        : lock(sql.pImpl->connection_mutex), db(sql.pImpl.get()), query(query_)
     {
         ptrStmt = Prepare(sql, query);
+    }
+    impl(const SQLite& sql, const std::string& query_, const std::vector<std::string>& vals)
+        : impl(sql, query_)
+    {
         int cnt = 1;
         for(auto& kinder : vals)
         {
@@ -306,7 +379,15 @@ public:
         }
         MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
     }
+    ~impl() { db->ReleaseStatement(query, std::move(ptrStmt)); }
 
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
+    // Declared first, so the statement is reset before the connection is released.
+    std::unique_lock<std::recursive_mutex> lock;
+    SQLite::impl* db;
+    std::string query;
     sqlite3_stmt_ptr ptrStmt = nullptr;
 };
 
@@ -376,6 +457,15 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system_)
     if(DisableUserDbFileIO && !is_system)
         return;
 
+    if(is_system)
+        binary = BinaryDb::TryLoad(filename_, BinaryDb::KeyKind::SQLiteConfig);
+    if(binary && binary->GetSchema() != BinaryDb::SQLiteSchema())
+    {
+        MIOPEN_LOG_W("Binary database has unexpected config fields, ignored: "
+                     << binary->GetPath());
+        binary.reset();
+    }
+
     if(dbInvalid)
     {
         if(filename.empty())
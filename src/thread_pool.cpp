@@ -0,0 +1,259 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/thread_pool.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+struct ThreadPool::impl
+{
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // One queue per worker and the last one for the tasks submitted from other threads
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::atomic<std::size_t> queued{0};
+    bool stop = false;
+
+    static thread_local const impl* current_pool;
+    static thread_local std::size_t current_worker;
+
+    std::size_t Shared() const { return workers.size(); }
+    std::size_t CurrentQueue() const;
+    void Push(std::size_t index, std::function<void()> task);
+    bool TryTake(std::size_t index, std::function<void()>& task);
+    bool RunOne(std::size_t index);
+    void Work(std::size_t index);
+};
+
+thread_local const ThreadPool::impl* ThreadPool::impl::current_pool = nullptr;
+thread_local std::size_t ThreadPool::impl::current_worker           = 0;
+
+std::size_t ThreadPool::impl::CurrentQueue() const
+{
+    return current_pool == this ? current_worker : Shared();
+}
+
+void ThreadPool::impl::Push(std::size_t index, std::function<void()> task)
+{
+    {
+        const std::lock_guard<std::mutex> lock{queues[index]->mutex};
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        ++queued;
+    }
+    work_cv.notify_one();
+}
+
+bool ThreadPool::impl::TryTake(std::size_t index, std::function<void()>& task)
+{
+    if(queued == 0)
+        return false;
+
+    const auto take = [&](std::size_t queue, bool newest) {
+        auto& q = *queues[queue];
+        const std::lock_guard<std::mutex> lock{q.mutex};
+        if(q.tasks.empty())
+            return false;
+        if(newest)
+        {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        --queued;
+        return true;
+    };
+
+    if(index != Shared() && take(index, true))
+        return true;
+    if(take(Shared(), false))
+        return true;
+    for(std::size_t i = 1; i <= workers.size(); ++i)
+    {
+        const auto victim = (index + i) % (workers.size() + 1);
+        if(victim != index && victim != Shared() && take(victim, false))
+            return true;
+    }
+    return false;
+}
+
+bool ThreadPool::impl::RunOne(std::size_t index)
+{
+    std::function<void()> task;
+    if(!TryTake(index, task))
+        return false;
+    task();
+    return true;
+}
+
+void ThreadPool::impl::Work(std::size_t index)
+{
+    current_pool   = this;
+    current_worker = index;
+
+    while(true)
+    {
+        if(RunOne(index))
+            continue;
+        std::unique_lock<std::mutex> lock{mutex};
+        work_cv.wait(lock, [&]() { return stop || queued > 0; });
+        if(stop && queued == 0)
+            return;
+    }
+}
+
+ThreadPool::ThreadPool(std::size_t workers) : pImpl{std::make_unique<impl>()}
+{
+    for(std::size_t i = 0; i <= workers; ++i)
+        pImpl->queues.push_back(std::make_unique<impl::Queue>());
+    pImpl->workers.reserve(workers);
+    for(std::size_t i = 0; i < workers; ++i)
+        pImpl->workers.emplace_back([this, i]() { pImpl->Work(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard<std::mutex> lock{pImpl->mutex};
+        pImpl->stop = true;
+    }
+    pImpl->work_cv.notify_all();
+    for(auto& worker : pImpl->workers)
+        worker.join();
+}
+
+ThreadPool& ThreadPool::Global()
+{
+    static ThreadPool pool{[]() {
+        const std::size_t hw = std::thread::hardware_concurrency();
+        const auto workers   = std::max<std::size_t>(hw, 2) - 1;
+        MIOPEN_LOG_I2("Starting " << workers << " worker threads");
+        return workers;
+    }()};
+    return pool;
+}
+
+std::size_t ThreadPool::Size() const { return pImpl->workers.size(); }
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+    pImpl->Push(pImpl->CurrentQueue(), std::move(task));
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool_) : pool(pool_) {}
+
+TaskGroup::~TaskGroup()
+{
+    RunPendingUntil([&]() { return state->pending == 0; });
+}
+
+bool TaskGroup::RunOne(State& state, std::unique_lock<std::mutex>& lock)
+{
+    if(state.tasks.empty())
+        return false;
+    auto task = std::move(state.tasks.front());
+    state.tasks.pop_front();
+    lock.unlock();
+
+    std::exception_ptr error;
+    try
+    {
+        task();
+    }
+    catch(...)
+    {
+        error = std::current_exception();
+    }
+    // Captures may refer to the objects of the waiting thread
+    task = nullptr;
+
+    lock.lock();
+    if(error && !state.error)
+        state.error = error;
+    --state.pending;
+    state.task_done.notify_all();
+    return true;
+}
+
+void TaskGroup::Run(std::function<void()> task)
+{
+    {
+        const std::lock_guard<std::mutex> lock{state->mutex};
+        state->tasks.push_back(std::move(task));
+        ++state->pending;
+    }
+    // Runs one of the tasks of the group, unless the waiters have run them all already
+    pool.Submit([state_ = state]() {
+        std::unique_lock<std::mutex> lock{state_->mutex};
+        RunOne(*state_, lock);
+    });
+}
+
+void TaskGroup::Wait()
+{
+    RunPendingUntil([&]() { return state->pending == 0; });
+    std::exception_ptr error;
+    {
+        const std::lock_guard<std::mutex> lock{state->mutex};
+        std::swap(error, state->error);
+    }
+    if(error)
+        std::rethrow_exception(error);
+}
+
+void TaskGroup::RunPendingUntil(const std::function<bool()>& done)
+{
+    std::unique_lock<std::mutex> lock{state->mutex};
+    while(!done())
+    {
+        if(!RunOne(*state, lock))
+            state->task_done.wait(lock);
+    }
+}
+
+} // namespace miopen
@@ -30,6 +30,26 @@
 #include <miopen/errors.hpp>
 #include <miopen/logger.hpp>
 
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ; // NOLINT (readability-redundant-declaration)
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define MIOPEN_HAS_SPAWN_ADDCHDIR 1
+#else
+#define MIOPEN_HAS_SPAWN_ADDCHDIR 0
+#endif
+#endif
+
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SAVE_TEMP_DIR)
 
 namespace miopen {
@@ -46,6 +66,120 @@ void SystemCmd(std::string cmd)
 #endif
 }
 
+std::vector<std::string> SplitCommandLine(const std::string& args)
+{
+    auto ret     = std::vector<std::string>{};
+    auto current = std::string{};
+    auto in_word = false;
+    auto quote   = '\0';
+
+    for(std::size_t i = 0; i < args.size(); ++i)
+    {
+        const auto c = args[i];
+        if(quote != '\0')
+        {
+            if(c == quote)
+                quote = '\0';
+            else if(c == '\\' && quote == '"' && i + 1 < args.size())
+                current += args[++i];
+            else
+                current += c;
+        }
+        else if(c == '\'' || c == '"')
+        {
+            quote   = c;
+            in_word = true;
+        }
+        else if(c == '\\' && i + 1 < args.size())
+        {
+            current += args[++i];
+            in_word = true;
+        }
+        else if(std::isspace(static_cast<unsigned char>(c)) != 0)
+        {
+            if(in_word)
+                ret.push_back(std::move(current));
+            current.clear();
+            in_word = false;
+        }
+        else
+        {
+            current += c;
+            in_word = true;
+        }
+    }
+
+    if(quote != '\0')
+        MIOPEN_THROW("Unterminated quote in: " + args);
+    if(in_word)
+        ret.push_back(std::move(current));
+    return ret;
+}
+
+namespace {
+
+#ifdef __linux__
+/// Starts the program directly, without a shell, and waits for it. Returns the exit code.
+int Spawn(const std::string& exe,
+          const std::vector<std::string>& args,
+          const boost::filesystem::path& cwd,
+          bool quiet)
+{
+    auto argv = std::vector<char*>{};
+    argv.reserve(args.size() + 2);
+    argv.push_back(const_cast<char*>(exe.c_str())); // NOLINT (cppcoreguidelines-pro-type-const-cast)
+    for(const auto& arg : args)
+        argv.push_back(const_cast<char*>(arg.c_str())); // NOLINT
+    argv.push_back(nullptr);
+
+    pid_t pid;
+    int status;
+
+#if MIOPEN_HAS_SPAWN_ADDCHDIR
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addchdir_np(&actions, cwd.c_str());
+    if(quiet)
+    {
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+        posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+    }
+    const auto error = posix_spawnp(&pid, exe.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if(error != 0)
+        MIOPEN_THROW("Can't start " + exe + ": " + std::strerror(error));
+#else
+    // Changing the directory of the child requires fork() before glibc 2.29
+    pid = fork();
+    if(pid < 0)
+        MIOPEN_THROW("Can't start " + exe + ": " + std::strerror(errno));
+    if(pid == 0)
+    {
+        if(chdir(cwd.c_str()) != 0)
+            _exit(127);
+        if(quiet)
+        {
+            const auto null = open("/dev/null", O_WRONLY); // NOLINT (cppcoreguidelines-pro-type-vararg)
+            dup2(null, STDOUT_FILENO);
+            dup2(null, STDERR_FILENO);
+        }
+        execvp(exe.c_str(), argv.data());
+        _exit(127);
+    }
+#endif
+
+    while(waitpid(pid, &status, 0) < 0)
+    {
+        if(errno != EINTR)
+            MIOPEN_THROW("Can't wait for " + exe + ": " + std::strerror(errno));
+    }
+
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+#endif
+
+} // namespace
+
 TmpDir::TmpDir(std::string prefix)
     : path(boost::filesystem::temp_directory_path() /
            boost::filesystem::unique_path("miopen-" + prefix + "-%%%%-%%%%-%%%%-%%%%"))
@@ -60,15 +194,25 @@ TmpDir& TmpDir::operator=(TmpDir&& other) noexcept
     return *this;
 }
 
-void TmpDir::Execute(std::string exe, std::string args) const
+void TmpDir::Execute(std::string exe, std::string args, bool quiet) const
 {
     if(miopen::IsEnabled(MIOPEN_DEBUG_SAVE_TEMP_DIR{}))
     {
         MIOPEN_LOG_I2(this->path.string());
     }
+    MIOPEN_LOG_I2("cd " << this->path.string() << "; " << exe << " " << args);
+// We shouldn't call system commands
+#if defined(MIOPEN_USE_CLANG_TIDY) || !defined(__linux__)
+    (void)quiet;
     std::string cd  = "cd " + this->path.string() + "; ";
-    std::string cmd = cd + exe + " " + args; // + " > /dev/null";
+    std::string cmd = cd + exe + " " + args;
     SystemCmd(cmd);
+#else
+    // Spawning the program directly saves a shell per build, which adds up when many kernels
+    // are compiled in parallel.
+    if(Spawn(exe, SplitCommandLine(args), this->path, quiet) != 0)
+        MIOPEN_THROW("Can't execute " + exe + " " + args);
+#endif
 }
 
 TmpDir::~TmpDir()
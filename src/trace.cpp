@@ -0,0 +1,213 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/trace.hpp>
+#include <miopen/env.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+namespace miopen {
+namespace trace {
+
+/// "%p" in the path is replaced with the process id.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_FILE)
+
+namespace {
+
+struct Event
+{
+    const char* category;
+    const char* name;
+    Clock::time_point start;
+    Clock::duration duration; // Negative for the instant events
+    std::string args;
+};
+
+int GetThreadId()
+{
+#ifdef __linux__
+    thread_local const int id = syscall(SYS_gettid); // NOLINT
+    return id;
+#else
+    static std::atomic<int> next{0};
+    thread_local const int id = ++next;
+    return id;
+#endif
+}
+
+int GetProcessId()
+{
+#ifdef __linux__
+    return getpid();
+#else
+    return 0;
+#endif
+}
+
+struct ThreadEvents
+{
+    int thread_id = GetThreadId();
+    std::mutex mutex; // Taken by the writer only for a moment
+    std::vector<Event> events;
+};
+
+class Tracer
+{
+public:
+    static Tracer& Instance()
+    {
+        // Leaked, so the threads which trace during the static destruction do not outlive it.
+        // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+        static auto* const instance = new Tracer{};
+        return *instance;
+    }
+
+    void Add(Event&& event)
+    {
+        auto& thread = LocalEvents();
+        const std::lock_guard<std::mutex> lock{thread.mutex};
+        thread.events.push_back(std::move(event));
+    }
+
+    void Write()
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+
+        std::ofstream file{path};
+        if(!file)
+        {
+            std::cerr << "Unable to write the trace: " << path << std::endl;
+            return;
+        }
+
+        const auto pid = GetProcessId();
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file << std::fixed << std::setprecision(3);
+        auto first = true;
+        for(const auto& thread : threads)
+        {
+            const std::lock_guard<std::mutex> thread_lock{thread->mutex};
+            for(const auto& event : thread->events)
+            {
+                using us = std::chrono::duration<double, std::micro>;
+                file << (first ? "" : ",\n") << R"({"cat":)" << Quote(event.category)
+                     << R"(,"name":)" << Quote(event.name) << R"(,"pid":)" << pid
+                     << R"(,"tid":)" << thread->thread_id << R"(,"ts":)"
+                     << us{event.start - origin}.count();
+                if(event.duration.count() < 0)
+                    file << R"(,"ph":"i","s":"t")";
+                else
+                    file << R"(,"ph":"X","dur":)" << us{event.duration}.count();
+                if(!event.args.empty())
+                    file << R"(,"args":{"detail":)" << Quote(event.args) << '}';
+                file << '}';
+                first = false;
+            }
+        }
+        file << "\n]}\n";
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadEvents>> threads;
+    std::string path;
+    Clock::time_point origin = Clock::now();
+
+    Tracer()
+    {
+        path             = GetStringEnv(MIOPEN_TRACE_FILE{});
+        const auto found = path.find("%p");
+        if(found != std::string::npos)
+            path.replace(found, 2, std::to_string(GetProcessId()));
+        std::atexit([]() { Instance().Write(); });
+    }
+
+    ThreadEvents& LocalEvents()
+    {
+        thread_local const auto events = [this]() {
+            auto created = std::make_shared<ThreadEvents>();
+            const std::lock_guard<std::mutex> lock{mutex};
+            threads.push_back(created);
+            return created;
+        }();
+        return *events;
+    }
+
+    static std::string Quote(const std::string& value) { return nlohmann::json(value).dump(); }
+};
+
+} // namespace
+
+bool IsEnabledImpl()
+{
+    if(GetStringEnv(MIOPEN_TRACE_FILE{}) == nullptr)
+        return false;
+    // Sets the origin of the timeline before the first span starts.
+    Tracer::Instance();
+    return true;
+}
+
+void AddSpan(const char* category, const char* name, Clock::time_point start, std::string args)
+{
+    const auto end = Clock::now();
+    Tracer::Instance().Add({category, name, start, end - start, std::move(args)});
+}
+
+void AddInstant(const char* category, const char* name, std::string args)
+{
+    Tracer::Instance().Add({category, name, Clock::now(), Clock::duration{-1}, std::move(args)});
+}
+
+void Flush()
+{
+    if(IsEnabled())
+        Tracer::Instance().Write();
+}
+
+std::string Span::FormatArgs(const std::function<void(std::ostream&)>& format_args)
+{
+    std::ostringstream ss;
+    format_args(ss);
+    return ss.str();
+}
+
+} // namespace trace
+} // namespace miopen
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 
+#include "cpu_bn.hpp"
 #include "driver.hpp"
 #include "get_handle.hpp"
 #include "tensor_holder.hpp"
@@ -43,8 +44,6 @@
 #include <miopen/tensor.hpp>
 #include <utility>
 #include <cfloat>
-// Run CPU emulations in hierarchical reduction mode.
-#define MIO_HEIRARCH_SEL 1
 #define MIO_BN_TEST_EXPAVGFACTOR 0.1
 #define MIO_BN_TEST_EPSILON 1e-5 // FLT_EPSILON
 #define MIO_BN_SP_TEST_DEBUG 0
@@ -110,113 +109,17 @@ struct verify_forward_train_bn_spatial
         auto out        = input;
         std::fill(out.begin(), out.end(), 0);
 
-        const unsigned int in_cstride = height * width;
-        const auto nhw                = double(in_cstride * n_batch);
-
-        par_for(channels, 1, [&](int cidx) {
-            double elemStd        = 0.;
-            double variance_accum = 0.;
-            double mean_accum     = 0.;
-            double invVar         = 0.;
-            double newRunMean     = 0.;
-            double adjust         = 0.;
-
-#if(MIO_HEIRARCH_SEL == 1)
-            std::vector<double> variance_accum_arr(height, 0.0);
-            std::vector<double> mean_accum_arr(height, 0.0);
-            std::vector<double> dshift_accum_arr(height, 0.0);
-            std::vector<double> dscale_accum_arr(height, 0.0);
-#endif
-
-#if(MIO_HEIRARCH_SEL == 0)
-            // process the batch per channel
-            for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-            { // via mini_batch
-                for(std::size_t row = 0; row < height; row++)
-                { // via rows
-                    for(std::size_t column = 0; column < width; column++)
-                    { // via columns
-                        // #1 calculate the mean
-                        // iterating through the stack of images in the mini_batch
-                        mean_accum += input(bidx, cidx, row, column);
-                    } // end for (column)
-                }     // end for (row)
-            }         // end for (n)
-#else
-            for(std::size_t row = 0; row < height; row++){ //via rows
-                for(std::size_t column = 0; column < width; column++){// via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++){ //via mini_batch
-                        mean_accum_arr[row] += input(bidx,cidx,row,column);
-                    }
-                }// for (column)
-            }// for (row)
-            for(std::size_t i = 0; i<height; i++) mean_accum += mean_accum_arr[i];
-#endif
-            mean_accum /= nhw;
-
-            elemStd        = 0.;
-            variance_accum = 0.;
-
-#if(MIO_HEIRARCH_SEL == 0)
-            // #2 calculate the variances
-            // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-            for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-            { // via mini_batch
-                for(std::size_t row = 0; row < height; row++)
-                { // via rows
-                    for(std::size_t column = 0; column < width; column++)
-                    { // via columns
-                        // using out buffer as scratchpad
-                        out(bidx, cidx, row, column) = elemStd =
-                            (input(bidx, cidx, row, column) - mean_accum); // (x_i - mean)
-                        variance_accum += (elemStd * elemStd);             // sum{ (x_i - mean)^2 }
-                    }                                                      // end for (column)
-                }                                                          // end for (row)
-            }                                                              // end for(n)
-
-#else
-            for(std::size_t row = 0; row < height; row++){ //via rows
-                for(std::size_t column = 0; column < width; column++){// via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++){ //via mini_batch
-                        out(bidx,cidx,row,column) = elemStd = input(bidx,cidx,row,column) - mean_accum;
-                        variance_accum_arr[row] += elemStd*elemStd;
-                    }
-                }// for (column)
-            }// for (row)
-            for(std::size_t i = 0; i<height; i++) variance_accum += variance_accum_arr[i];
-#endif
-            variance_accum /= nhw; // (1/N)*sum{ (x_i - mean)^2 }
-            // #3 add epsilon for numeric stability, sqr_root, and invert
-            invVar = 1.0 / sqrt(variance_accum + epsilon);
-
-            // #4 apply the normalization
-            // x_hat = (x_i - mean) / sqrt(variance_accum + epsilon)
-            for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-            { // via mini_batch
-                for(std::size_t row = 0; row < height; row++)
-                { // via rows
-                    for(std::size_t column = 0; column < width; column++)
-                    { // via columns
-                        // #5 Gamma and Beta adjust
-                        // y_i = gamma*x_hat + beta
-                        out(bidx, cidx, row, column) =
-                            scale(0, cidx, 0, 0) * (invVar * out(bidx, cidx, row, column)) +
-                            shift(0, cidx, 0, 0);
-                    } // for (column)
-                }     // for (row)
-            }         // end for(n_batchs)
-
-            saveMean(0, cidx, 0, 0)   = mean_accum;
-            saveInvVar(0, cidx, 0, 0) = invVar;
-
-            newRunMean             = runMean(0, cidx, 0, 0) * (1 - expAvgFactor);
-            runMean(0, cidx, 0, 0) = mean_accum * expAvgFactor + newRunMean; // newMean*factor + tmp
-            // var(n+1) = p * var(n-1) + (1 - p)*(b/b-1)*var(n)
-            adjust = (n_batch * height * width == 1) ? variance_accum
-                                                     : (nhw / (nhw - 1)) * variance_accum;
-            runVar(0, cidx, 0, 0) =
-                (1 - expAvgFactor) * runVar(0, cidx, 0, 0) + expAvgFactor * adjust;
-        });
+        cpu_bn_forward_train(cpu_bn_geometry{input.desc, miopenBNSpatial},
+                             input.data.data(),
+                             out.data.data(),
+                             scale.data.data(),
+                             shift.data.data(),
+                             epsilon,
+                             expAvgFactor,
+                             runMean.data.data(),
+                             runVar.data.data(),
+                             saveMean.data.data(),
+                             saveInvVar.data.data());
 
 #if(MIO_BN_TIME_EVERYTHING == 1)
         auto t_end = std::chrono::high_resolution_clock::now();
@@ -374,71 +277,12 @@ struct verify_forward_infer_bn_spatial_recalc
         auto out = input;
         std::fill(out.begin(), out.end(), 0);
 
-        const unsigned int in_cstride = height * width;
-        const auto nhw                = double(in_cstride * n_batch);
-
-        par_for(channels, 1, [&](int cidx) {
-            double elemStd        = 0.;
-            double variance_accum = 0.;
-            double mean_accum     = 0.;
-            double inhat          = 0.;
-            double invVar         = 0.;
-
-            // process the batch per channel
-            for(std::size_t row = 0; row < height; row++)
-            { // via rows
-                for(std::size_t column = 0; column < width; column++)
-                { // via columns
-                    // #1 calculate the mean
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-                    { // via mini_batch
-                        // iterating through the stack of images in the mini_batch
-                        mean_accum += input(bidx, cidx, row, column);
-                    } // end for (n)
-                }     // end for (column)
-            }         // end for (row)
-            mean_accum /= nhw;
-
-            elemStd        = 0.;
-            variance_accum = 0.;
-            // #2 calculate the variances
-            // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-            for(std::size_t row = 0; row < height; row++)
-            { // via rows
-                for(std::size_t column = 0; column < width; column++)
-                { // via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-                    { // via mini_batch
-                        // using out buffer as scratchpad
-                        out(bidx, cidx, row, column) = elemStd =
-                            (input(bidx, cidx, row, column) - mean_accum); // (x_i - mean)
-                        variance_accum += (elemStd * elemStd);             // sum{ (x_i - mean)^2 }
-                    }                                                      // end for(n)
-                }                                                          // end for (column)
-            }                                                              // end for (row)
-            variance_accum /= nhw; // (1/N)*sum{ (x_i - mean)^2 }
-
-            // #3 add epsilon for numeric stability, sqr_root, and invert
-            invVar = 1.0 / sqrt(variance_accum + epsilon);
-
-            // #4 apply the normalization
-            // x_hat = (x_i - mean) / sqrt(variance_accum - epsilon)
-            for(std::size_t row = 0; row < height; row++)
-            { // via rows
-                for(std::size_t column = 0; column < width; column++)
-                { // via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-                    { // via mini_batch
-                        elemStd =
-                            out(bidx, cidx, row, column); // using saved values from output tensor
-                        inhat = elemStd * invVar;
-                        // #5 Gamma and Beta adjust // y_i = gamma*x_hat + beta
-                        out(bidx, cidx, row, column) =
-                            scale(0, cidx, 0, 0) * inhat + shift(0, cidx, 0, 0);
-                    } // end for(n_batchs)
-                }     // for (column)
-            }         // for (row)
-        });
+        cpu_bn_forward_infer(cpu_bn_geometry{input.desc, miopenBNSpatial},
+                             input.data.data(),
+                             out.data.data(),
+                             scale.data.data(),
+                             shift.data.data(),
+                             epsilon);
 
 #if(MIO_BN_TIME_EVERYTHING == 1)
         auto t_end = std::chrono::high_resolution_clock::now();
@@ -527,29 +371,14 @@ struct verify_forward_infer_bn_spatial_use_est
         auto out = input;
         std::fill(out.begin(), out.end(), 0);
 
-        par_for(channels, 1, [&](int cidx) {
-            double elemStd  = 0.;
-            double variance = estVar(0, cidx, 0, 0);
-            double mean     = estMean(0, cidx, 0, 0);
-            double inhat    = 0.;
-            double invVar   = 1.0 / sqrt(variance + epsilon);
-
-            // process the batch per channel
-            for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-            { // via mini_batch
-                for(std::size_t row = 0; row < height; row++)
-                { // via rows
-                    for(std::size_t column = 0; column < width; column++)
-                    { // via columns
-
-                        elemStd = input(bidx, cidx, row, column) - mean;
-                        inhat   = elemStd * invVar;
-                        out(bidx, cidx, row, column) =
-                            scale(0, cidx, 0, 0) * inhat + shift(0, cidx, 0, 0);
-                    }
-                }
-            }
-        });
+        cpu_bn_forward_infer(cpu_bn_geometry{input.desc, miopenBNSpatial},
+                             input.data.data(),
+                             out.data.data(),
+                             scale.data.data(),
+                             shift.data.data(),
+                             epsilon,
+                             estMean.data.data(),
+                             estVar.data.data());
 #if(MIO_BN_TIME_EVERYTHING == 1)
         auto t_end = std::chrono::high_resolution_clock::now();
 
@@ -651,141 +480,14 @@ struct verify_backward_bn_spatial_recalc
         auto dshift = tensor<U>{ss_n_batch, ss_channels, ss_height, ss_width};
         std::fill(dshift.begin(), dshift.end(), 0);
 
-        const unsigned int in_cstride = height * width;
-        const auto nhw                = double(in_cstride * n_batch);
-
-        par_for(channels, 1, [&](int cidx) {
-            double elemStd = 0.;
-            unsigned int xhat_index;
-            double mean     = 0.;
-            double invVar   = 0.;
-            double dyelem   = 0.;
-            double variance = 0.;
-
-            std::vector<double> xhat(n_batch * in_cstride, 0.0);
-
-#if(MIO_HEIRARCH_SEL == 1)
-            std::vector<double> variance_accum_arr(height, 0.0);
-            std::vector<double> mean_accum_arr(height, 0.0);
-            std::vector<double> dshift_accum_arr(height, 0.0);
-            std::vector<double> dscale_accum_arr(height, 0.0);
-#endif
-
-// process the batch per channel
-#if(MIO_HEIRARCH_SEL == 0)
-            for(std::size_t row = 0; row < height; row++)
-            { // via rows
-                for(std::size_t column = 0; column < width; column++)
-                { // via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-                    { // via mini_batch
-                        // #1 calculate the mean
-                        mean += x_input(bidx, cidx, row, column);
-                    }
-                } // for (column)
-            }     // for (row)
-#else
-            for(std::size_t row = 0; row < height; row++){ //via rows
-                for(std::size_t column = 0; column < width; column++){// via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++){ //via mini_batch
-                        mean_accum_arr[row] += x_input(bidx,cidx,row,column);
-                    }
-                }// for (column)
-            }// for (row)
-            for(std::size_t i = 0; i<height; i++) mean += mean_accum_arr[i];
-#endif
-            mean /= nhw;
-
-            elemStd  = 0.;
-            variance = 0.;
-#if(MIO_HEIRARCH_SEL == 0)
-            for(std::size_t row = 0; row < height; row++)
-            { // via rows
-                for(std::size_t column = 0; column < width; column++)
-                { // via columns
-                    // #2 calculate the variances
-                    // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-                    { // via mini_batch
-                        // per (x-dims) channel load a block of data into LDS
-                        elemStd = x_input(bidx, cidx, row, column) - mean; // (x_i - mean)
-                        variance += elemStd * elemStd;                     // sum{ (x_i - mean)^2 }
-                    }                                                      // end for(n)
-                }                                                          // for (column)
-            }                                                              // for (row)
-#else
-            for(std::size_t row = 0; row < height; row++){ //via rows
-                for(std::size_t column = 0; column < width; column++){// via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++){ //via mini_batch
-                        elemStd = x_input(bidx,cidx,row,column) - mean;
-                        variance_accum_arr[row] += elemStd*elemStd;
-                    }
-                }// for (column)
-            }// for (row)
-            for(std::size_t i = 0; i<height; i++) variance += variance_accum_arr[i];
-#endif
-            variance /= nhw; // (1/(N*H*W))*sum{ (x_i - mean)^2 }
-            invVar = 1. / double(sqrt(variance + epsilon));
-
-            dscale(0, cidx, 0, 0) = 0.;
-
-#if(MIO_HEIRARCH_SEL == 0)
-            for(std::size_t row = 0; row < height; row++)
-            { // via rows
-                for(std::size_t column = 0; column < width; column++)
-                { // via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-                    { // via mini_batch
-                        xhat_index = in_cstride * bidx + (width * row + column);
-                        // per (x-dims) channel load a block of data into LDS
-                        elemStd          = x_input(bidx, cidx, row, column) - mean; // (x_i - mean)
-                        xhat[xhat_index] = elemStd * invVar;
-                        dyelem           = dy_input(bidx, cidx, row, column);
-                        dshift(0, cidx, 0, 0) += dyelem;
-                        dscale(0, cidx, 0, 0) += xhat[xhat_index] * dyelem;
-                    } // end for(n_batch)
-                }     // for (column)
-            }         // for (row)
-#else
-
-            for(std::size_t row = 0; row < height; row++){ //via rows
-                for(std::size_t column = 0; column < width; column++){// via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++){ //via mini_batch
-                        xhat_index = in_cstride*bidx + (width*row + column);
-                        //per (x-dims) channel load a block of data into LDS
-                        elemStd             = x_input(bidx,cidx,row,column) - mean;// (x_i - mean)
-                        xhat[xhat_index]    = elemStd*invVar;
-                        dyelem              = dy_input(bidx,cidx,row,column);
-                        dshift_accum_arr[row] += dyelem;
-                        dscale_accum_arr[row] += xhat[xhat_index]*dyelem;
-                        //dscale_accum_arr[row] += x_input(bidx,cidx,row,column);;//dscale_accum_arr[row] += xhat[xhat_index];
-                        //dscale_accum_arr[row] += 1.0;//DEBUG
-                    }
-                }// for (column)
-            }// for (row)
-            for(std::size_t i = 0; i<height; i++) {
-                dshift(0,cidx,0,0) += dshift_accum_arr[i];
-                dscale(0,cidx,0,0) += dscale_accum_arr[i];
-            }
-#endif
-
-            for(std::size_t row = 0; row < height; row++)
-            { // via rows
-                for(std::size_t column = 0; column < width; column++)
-                { // via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-                    { // via mini_batch
-                        xhat_index = in_cstride * bidx + (width * row + column);
-
-                        double tmp1 =
-                            nhw * dy_input(bidx, cidx, row, column) - dshift(0, cidx, 0, 0);
-                        double tmp2                     = -xhat[xhat_index] * dscale(0, cidx, 0, 0);
-                        double tmp3                     = (scale(0, cidx, 0, 0) * invVar) / nhw;
-                        dx_out(bidx, cidx, row, column) = tmp3 * (tmp2 + tmp1);
-                    } // end for(n_batchs)
-                }     // for (column)
-            }         // for (row)
-        });           // for (channel)
+        cpu_bn_backward(cpu_bn_geometry{x_input.desc, miopenBNSpatial},
+                        x_input.data.data(),
+                        dy_input.data.data(),
+                        dx_out.data.data(),
+                        scale.data.data(),
+                        dscale.data.data(),
+                        dshift.data.data(),
+                        epsilon);
 
 #if(MIO_BN_TIME_EVERYTHING == 1)
         auto t_end = std::chrono::high_resolution_clock::now();
@@ -920,83 +622,16 @@ struct verify_backward_bn_spatial_use_saved
         auto dshift = tensor<U>{ss_n_batch, ss_channels, ss_height, ss_width};
         std::fill(dshift.begin(), dshift.end(), 0);
 
-        const unsigned int in_cstride = height * width;
-        const auto nhw                = double(in_cstride * n_batch);
-
-        par_for(channels, 1, [&](int cidx) {
-            double elemStd = 0.;
-            unsigned int xhat_index;
-            double mean   = savedMean(0, cidx, 0, 0);   // HxW elements
-            double invVar = savedInvVar(0, cidx, 0, 0); // HxW elements
-            double dyelem = 0.;
-
-            std::vector<double> xhat(n_batch * in_cstride, 0.0);
-
-#if(MIO_HEIRARCH_SEL == 1)
-            std::vector<double> dshift_accum_arr(height, 0.0);
-            std::vector<double> dscale_accum_arr(height, 0.0);
-#endif
-
-            // process the batch per channel
-            dscale(0, cidx, 0, 0) = 0.;
-
-#if(MIO_HEIRARCH_SEL == 0)
-            for(std::size_t row = 0; row < height; row++)
-            { // via rows
-                for(std::size_t column = 0; column < width; column++)
-                { // via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-                    { // via mini_batch
-                        xhat_index = in_cstride * bidx + (width * row + column);
-                        // per (x-dims) channel load a block of data into LDS
-                        elemStd          = x_input(bidx, cidx, row, column) - mean; // (x_i - mean)
-                        xhat[xhat_index] = elemStd * invVar;
-                        dyelem           = dy_input(bidx, cidx, row, column);
-                        dshift(0, cidx, 0, 0) += dyelem;
-                        dscale(0, cidx, 0, 0) += xhat[xhat_index] * dyelem;
-                    } // end for(n_batch)
-                }     // for (column)
-            }         // for (row)
-#else
-
-            for(std::size_t row = 0; row < height; row++){ //via rows
-                for(std::size_t column = 0; column < width; column++){// via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++){ //via mini_batch
-                        xhat_index = in_cstride*bidx + (width*row + column);
-                        //per (x-dims) channel load a block of data into LDS
-                        elemStd             = x_input(bidx,cidx,row,column) - mean;// (x_i - mean)
-                        xhat[xhat_index]    = elemStd*invVar;
-                        //printf("xhat[%d]: %lf\n",xhat_index,xhat[xhat_index]);
-                        dyelem              = dy_input(bidx,cidx,row,column);
-                        dshift_accum_arr[row] += dyelem;
-                        dscale_accum_arr[row] += xhat[xhat_index]*dyelem;
-                        //dscale_accum_arr[row] += 1.0;//DEBUG
-                    }
-                }// for (column)
-            }// for (row)
-            for(std::size_t i = 0; i<height; i++) {
-                dshift(0,cidx,0,0) += dshift_accum_arr[i];
-                dscale(0,cidx,0,0) += dscale_accum_arr[i];
-            }
-#endif
-
-            for(std::size_t row = 0; row < height; row++)
-            { // via rows
-                for(std::size_t column = 0; column < width; column++)
-                { // via columns
-                    for(std::size_t bidx = 0; bidx < n_batch; bidx++)
-                    { // via mini_batch
-                        xhat_index = in_cstride * bidx + (width * row + column);
-
-                        double tmp1 =
-                            nhw * dy_input(bidx, cidx, row, column) - dshift(0, cidx, 0, 0);
-                        double tmp2                     = -xhat[xhat_index] * dscale(0, cidx, 0, 0);
-                        double tmp3                     = (scale(0, cidx, 0, 0) * invVar) / nhw;
-                        dx_out(bidx, cidx, row, column) = tmp3 * (tmp2 + tmp1);
-                    } // end for(n_batchs)
-                }     // for (column)
-            }         // for (row)
-        });           // for (channel)
+        cpu_bn_backward(cpu_bn_geometry{x_input.desc, miopenBNSpatial},
+                        x_input.data.data(),
+                        dy_input.data.data(),
+                        dx_out.data.data(),
+                        scale.data.data(),
+                        dscale.data.data(),
+                        dshift.data.data(),
+                        MIO_BN_TEST_EPSILON,
+                        savedMean.data.data(),
+                        savedInvVar.data.data());
 #if(MIO_BN_TIME_EVERYTHING == 1)
         auto t_end = std::chrono::high_resolution_clock::now();
 
@@ -27,9 +27,15 @@
 #include <miopen/binary_cache.hpp>
 #include <miopen/kern_db.hpp>
 #include <miopen/temp_file.hpp>
+#include <miopen/tmp_dir.hpp>
 
 #include <miopen/md5.hpp>
 #include "test.hpp"
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <thread>
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 #include "random.hpp"
 #endif
@@ -89,6 +95,48 @@ void check_bz2_decompress()
     EXPECT(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+void check_lz_compress()
+{
+    std::string to_compress;
+    bool success = false;
+    std::string cmprsd;
+    // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+    CHECK(throws([&]() { cmprsd = miopen::lz::compress(to_compress, &success); }));
+
+    // Random data does not shrink
+    to_compress = random_string(4096);
+    cmprsd      = miopen::lz::compress(to_compress, &success);
+    EXPECT(!success);
+    EXPECT(cmprsd == to_compress);
+
+    to_compress = random_string(1024);
+    to_compress += to_compress + to_compress + to_compress;
+    cmprsd = miopen::lz::compress(to_compress, &success);
+    EXPECT(success);
+    EXPECT(cmprsd.size() < to_compress.size());
+}
+
+void check_lz_decompress()
+{
+    const auto chunk    = random_string(300);
+    auto orig_str       = chunk + std::string(1000, 'a') + chunk + random_string(17) + chunk;
+    bool success        = false;
+    auto compressed_str = miopen::lz::compress(orig_str, &success);
+    EXPECT(success);
+
+    auto decompressed_str = miopen::lz::decompress(compressed_str, orig_str.size());
+    EXPECT(decompressed_str == orig_str);
+
+    // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+    CHECK(throws([&]() { decompressed_str = miopen::lz::decompress(compressed_str, 10); }));
+    // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+    CHECK(throws([&]() {
+        decompressed_str = miopen::lz::decompress(compressed_str.substr(0, 100), orig_str.size());
+    }));
+
+    EXPECT(decompressed_str == miopen::lz::decompress(compressed_str, orig_str.size() + 10));
+}
+
 void check_kern_db()
 {
     miopen::KernelConfig cfg0;
@@ -135,8 +183,201 @@ void check_kern_db()
         CHECK(err_db.RemoveRecordUnsafe(cfg0));
     }
 }
+
+void check_kern_db_batch()
+{
+    miopen::KernelConfig cfg0;
+    cfg0.kernel_name = "kernel1";
+    cfg0.kernel_args = random_string(512);
+    cfg0.kernel_blob = random_string(8192);
+
+    miopen::KernelConfig cfg1 = cfg0;
+    cfg1.kernel_name          = "kernel2";
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    miopen::KernDb batch_db(std::string(temp_file), false);
+    miopen::KernDb other_db(std::string(temp_file), false);
+
+    batch_db.BeginBatch();
+    batch_db.BeginBatch();
+    CHECK(batch_db.StoreRecordUnsafe(cfg0));
+    CHECK(batch_db.StoreRecordUnsafe(cfg1));
+    // Pending records are visible only through the same object
+    auto readout = batch_db.FindRecordUnsafe(cfg0);
+    CHECK(readout);
+    CHECK(readout.get() == cfg0.kernel_blob);
+    CHECK(!other_db.FindRecordUnsafe(cfg0));
+    CHECK(batch_db.HasRecord(cfg0));
+    CHECK(!other_db.HasRecord(cfg0));
+    CHECK(batch_db.RemoveRecordUnsafe(cfg1));
+    CHECK(!batch_db.FindRecordUnsafe(cfg1));
+
+    batch_db.EndBatch();
+    CHECK(!other_db.FindRecordUnsafe(cfg0));
+    batch_db.EndBatch();
+
+    readout = other_db.FindRecordUnsafe(cfg0);
+    CHECK(readout);
+    CHECK(readout.get() == cfg0.kernel_blob);
+    CHECK(!other_db.FindRecordUnsafe(cfg1));
+}
+
+void check_sqlite_transaction_isolation()
+{
+    miopen::TempFile temp_file("tmp-sqlite");
+    miopen::SQLite sql{std::string(temp_file), false};
+    sql.Exec("CREATE TABLE `t` (`id` INTEGER PRIMARY KEY ASC);");
+
+    std::thread writer;
+    {
+        auto transaction = miopen::SQLite::Transaction{sql};
+        sql.Exec("INSERT INTO `t` (`id`) VALUES (1);");
+        // A statement of another thread on the connection waits for the transaction,
+        // instead of joining it and being rolled back with it
+        writer = std::thread{[&]() {
+            auto stmt = miopen::SQLite::Statement{sql, "INSERT INTO `t` (`id`) VALUES (2);"};
+            CHECK(stmt.Step(sql) == SQLITE_DONE);
+        }};
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    writer.join();
+
+    const auto rows = sql.Exec("SELECT `id` FROM `t`;");
+    CHECK(rows.size() == 1);
+    CHECK(rows.front().at("id") == "2");
+}
+
+void check_kern_db_codecs()
+{
+    miopen::KernelConfig cfg0;
+    cfg0.kernel_name = "kernel1";
+    cfg0.kernel_args = random_string(512);
+    cfg0.kernel_blob = random_string(2048) + std::string(4096, 'x');
+
+    miopen::KernelConfig cfg1 = cfg0;
+    cfg1.kernel_name          = "kernel2";
+
+    miopen::KernelConfig cfg2 = cfg0;
+    cfg2.kernel_name          = "kernel3";
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    {
+        // Table of a version without the codec column
+        miopen::SQLite sql{std::string(temp_file), false};
+        sql.Exec("CREATE TABLE `kern_db` (`id` INTEGER PRIMARY KEY ASC,"
+                 "`kernel_name` TEXT NOT NULL,`kernel_args` TEXT NOT NULL,"
+                 "`kernel_blob` BLOB NOT NULL,`kernel_hash` TEXT NOT NULL,"
+                 "`uncompressed_size` INT NOT NULL);");
+    }
+    {
+        // Inserts a bzip2 row the way old versions do
+        miopen::SQLite sql{std::string(temp_file), false};
+        bool success = false;
+        auto stmt    = miopen::SQLite::Statement{
+            sql,
+            "INSERT INTO kern_db(kernel_name, kernel_args, kernel_blob, kernel_hash, "
+            "uncompressed_size) VALUES(?, ?, ?, ?, ?);"};
+        stmt.BindText(1, cfg2.kernel_name);
+        stmt.BindText(2, cfg2.kernel_args);
+        stmt.BindBlob(3, miopen::compress(cfg2.kernel_blob, &success));
+        stmt.BindText(4, miopen::md5(cfg2.kernel_blob));
+        stmt.BindInt64(5, cfg2.kernel_blob.size());
+        CHECK(success);
+        CHECK(stmt.Step(sql) == SQLITE_DONE);
+    }
+
+    miopen::KernDb bz2_db(std::string(temp_file), false, miopen::KernelCodec::Bzip2);
+    miopen::KernDb lz_db(std::string(temp_file), false, miopen::KernelCodec::Lz);
+
+    CHECK(bz2_db.StoreRecordUnsafe(cfg0));
+    CHECK(lz_db.StoreRecordUnsafe(cfg1));
+
+    // Every row is readable whatever codec it was written with
+    for(auto* db : {&bz2_db, &lz_db})
+    {
+        for(const auto& cfg : {cfg0, cfg1, cfg2})
+        {
+            auto readout = db->FindRecordUnsafe(cfg);
+            CHECK(readout);
+            CHECK(readout.get() == cfg.kernel_blob);
+        }
+    }
+}
+
+void check_kern_db_lru()
+{
+    std::vector<miopen::KernelConfig> cfgs(4);
+    for(std::size_t i = 0; i < cfgs.size(); ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        cfgs[i].kernel_args = random_string(64);
+        cfgs[i].kernel_blob = random_string(1024);
+    }
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    // Random blobs do not shrink, so they are stored as is
+    miopen::KernDb db(std::string(temp_file), false, miopen::KernelCodec::Lz);
+    for(const auto& cfg : cfgs)
+        CHECK(db.StoreRecordUnsafe(cfg));
+    EXPECT(db.GetSize() == 4 * 1024);
+
+    // The kernels were last used in their order, then the oldest one is loaded again
+    for(std::size_t i = 0; i < cfgs.size(); ++i)
+    {
+        db.sql.Exec("UPDATE kern_db SET last_access = " + std::to_string(i + 1) +
+                    " WHERE kernel_name = '" + cfgs[i].kernel_name + "';");
+    }
+    CHECK(db.FindRecordUnsafe(cfgs[0]));
+    // Checking for a kernel is not a use of it
+    CHECK(db.HasRecord(cfgs[1]));
+
+    EXPECT(db.Shrink(4 * 1024) == 0);
+    EXPECT(db.Shrink(2 * 1024 + 1000) == 2);
+    EXPECT(db.GetSize() == 2 * 1024);
+    EXPECT(db.FindRecordUnsafe(cfgs[0]));
+    EXPECT(!db.FindRecordUnsafe(cfgs[1]));
+    EXPECT(!db.FindRecordUnsafe(cfgs[2]));
+    EXPECT(db.FindRecordUnsafe(cfgs[3]));
+    EXPECT(!db.HasRecord(cfgs[1]));
+
+    db.Vacuum();
+    EXPECT(db.GetSize() == 2 * 1024);
+    EXPECT(db.Shrink(0) == 2);
+    EXPECT(db.GetSize() == 0);
+}
 #endif
 
+void check_cache_directory_lru()
+{
+    namespace fs = boost::filesystem;
+    const miopen::TmpDir dir{"cache"};
+    const auto now = std::time(nullptr);
+
+    std::vector<fs::path> files;
+    for(auto i = 0; i < 4; ++i)
+    {
+        // Laid out like GetCacheFile()
+        const auto id   = std::to_string(i);
+        const auto file = dir.path / miopen::md5("gfx:args" + id) / ("kernel" + id + ".o");
+        fs::create_directories(file.parent_path());
+        std::ofstream{file.string()} << std::string(1000, 'x');
+        fs::last_write_time(file, now - 100 + i);
+        files.push_back(file);
+    }
+    // Not a kernel of the cache, must not be evicted
+    fs::create_directories(dir.path / "include-dir");
+    std::ofstream{(dir.path / "include-dir" / "header.h").string()} << std::string(8000, 'x');
+
+    EXPECT(miopen::ShrinkCacheDirectory(dir.path, 4000) == 0);
+    EXPECT(miopen::ShrinkCacheDirectory(dir.path, 2500) == 2);
+    EXPECT(!fs::exists(files[0]));
+    EXPECT(!fs::exists(files[1]));
+    EXPECT(!fs::exists(files[0].parent_path()));
+    EXPECT(fs::exists(files[2]));
+    EXPECT(fs::exists(files[3]));
+    EXPECT(fs::exists(dir.path / "include-dir" / "header.h"));
+}
+
 void check_cache_file()
 {
     auto p = miopen::GetCacheFile("gfx", "base", "args", false);
@@ -154,9 +395,16 @@ int main()
 {
     check_cache_file();
     check_cache_str();
+    check_cache_directory_lru();
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
     check_bz2_compress();
     check_bz2_decompress();
+    check_lz_compress();
+    check_lz_decompress();
     check_kern_db();
+    check_kern_db_batch();
+    check_sqlite_transaction_isolation();
+    check_kern_db_codecs();
+    check_kern_db_lru();
 #endif
 }
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compile_queue.hpp>
+#include <miopen/errors.hpp>
+
+#include "test.hpp"
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using State = miopen::CompileQueue::State;
+
+void check_dedup()
+{
+    miopen::CompileQueue queue{2};
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> runs{0};
+
+    EXPECT(queue.GetState("a") == State::None);
+    EXPECT(queue.Push("a", [&]() {
+        released.wait();
+        ++runs;
+    }));
+    EXPECT(queue.GetState("a") == State::Pending);
+    // A pending job is not queued again
+    EXPECT(!queue.Push("a", [&]() { ++runs; }));
+
+    release.set_value();
+    queue.Wait();
+    EXPECT(runs == 1);
+    EXPECT(queue.GetState("a") == State::None);
+
+    // Done jobs may be queued again
+    EXPECT(queue.Push("a", [&]() { ++runs; }));
+    queue.Wait();
+    EXPECT(runs == 2);
+}
+
+void check_failure()
+{
+    miopen::CompileQueue queue{1};
+    std::atomic<int> runs{0};
+
+    EXPECT(queue.Push("a", [&]() {
+        ++runs;
+        MIOPEN_THROW("build failed");
+    }));
+    queue.Wait();
+    EXPECT(queue.GetState("a") == State::Failed);
+    // Failed jobs are not retried
+    EXPECT(!queue.Push("a", [&]() { ++runs; }));
+    queue.Wait();
+    EXPECT(runs == 1);
+}
+
+void check_many()
+{
+    miopen::CompileQueue queue{4};
+    std::atomic<int> runs{0};
+    for(auto i = 0; i < 100; ++i)
+        queue.Push(std::to_string(i), [&]() { ++runs; });
+    queue.Wait();
+    EXPECT(runs == 100);
+}
+
+void check_destruction()
+{
+    std::atomic<int> runs{0};
+    {
+        miopen::CompileQueue queue{1};
+        std::promise<void> start;
+        queue.Push("slow", [&]() {
+            start.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds{100});
+            ++runs;
+        });
+        // Not started when the queue is destroyed, so dropped
+        for(auto i = 0; i < 10; ++i)
+            queue.Push(std::to_string(i), [&]() { ++runs; });
+        start.get_future().wait();
+    }
+    EXPECT(runs == 1);
+}
+
+/// Stand-in for the invoker cache and the compiler of the immediate mode: the builds register
+/// their result and are counted, the first one waits until it is released.
+struct background_build
+{
+    miopen::CompileQueue queue{2};
+    std::mutex mutex;
+    boost::optional<int> registered;
+    std::atomic<int> builds{0};
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    int Get(bool has_fallback)
+    {
+        return miopen::GetOrBuildInBackground(
+            queue,
+            "key",
+            [&]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                return registered;
+            },
+            [&]() { return has_fallback ? boost::optional<int>{-1} : boost::none; },
+            [&]() { return false; },
+            [this]() {
+                ++builds;
+                released.wait();
+                std::lock_guard<std::mutex> lock(mutex);
+                registered = 42;
+                return 42;
+            });
+    }
+};
+
+void check_fallback_then_upgrade()
+{
+    background_build b;
+
+    // Queued, served by the fallback meanwhile
+    EXPECT(b.Get(true) == -1);
+    EXPECT(b.queue.GetState("key") == State::Pending);
+    EXPECT(b.Get(true) == -1);
+
+    // Without a fallback the build in flight is waited for rather than repeated
+    auto waiting = std::async(std::launch::async, [&]() { return b.Get(false); });
+    EXPECT(waiting.wait_for(std::chrono::milliseconds{50}) == std::future_status::timeout);
+    b.release.set_value();
+    EXPECT(waiting.get() == 42);
+    EXPECT(b.builds == 1);
+
+    // Upgraded to the built result
+    b.queue.Wait();
+    EXPECT(b.Get(true) == 42);
+    EXPECT(b.Get(false) == 42);
+    EXPECT(b.builds == 1);
+}
+
+void check_build_without_fallback()
+{
+    background_build b;
+    b.release.set_value();
+
+    // Nothing to serve the call meanwhile, so the build is synchronous
+    EXPECT(b.Get(false) == 42);
+    EXPECT(b.queue.GetState("key") == State::None);
+    EXPECT(b.Get(true) == 42);
+    EXPECT(b.builds == 1);
+}
+
+int main()
+{
+    check_dedup();
+    check_failure();
+    check_many();
+    check_destruction();
+    check_fallback_then_upgrade();
+    check_build_without_fallback();
+}
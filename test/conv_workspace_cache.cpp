@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/find_controls.hpp>
+#include <miopen/miopen.h>
+
+#include "test.hpp"
+
+#include <array>
+#include <vector>
+
+/// Workspace sizes of an fp16 convolution in the three directions, in normal find mode where
+/// they are cached in the handle, with the given deterministic and fp16 alt impl attributes.
+std::array<std::size_t, 3> QueryWorkspaces(miopenHandle_t handle, int deterministic, int fp16alt)
+{
+    miopenTensorDescriptor_t x;
+    miopenTensorDescriptor_t w;
+    miopenTensorDescriptor_t y;
+    miopenConvolutionDescriptor_t conv;
+    miopenCreateTensorDescriptor(&x);
+    miopenCreateTensorDescriptor(&w);
+    miopenCreateTensorDescriptor(&y);
+    miopenCreateConvolutionDescriptor(&conv);
+
+    miopenSet4dTensorDescriptor(x, miopenHalf, 16, 64, 28, 28);
+    miopenSet4dTensorDescriptor(w, miopenHalf, 64, 64, 3, 3);
+    miopenInitConvolutionDescriptor(conv, miopenConvolution, 1, 1, 1, 1, 1, 1);
+    miopenSetConvolutionAttribute(conv, MIOPEN_CONVOLUTION_ATTRIB_DETERMINISTIC, deterministic);
+    miopenSetConvolutionAttribute(conv, MIOPEN_CONVOLUTION_ATTRIB_FP16_ALT_IMPL, fp16alt);
+    miopen::deref(conv).findMode.Set(miopen::FindMode::Values::Normal);
+
+    int n, c, h, wd;
+    miopenGetConvolutionForwardOutputDim(conv, x, w, &n, &c, &h, &wd);
+    miopenSet4dTensorDescriptor(y, miopenHalf, n, c, h, wd);
+
+    auto sizes = std::array<std::size_t, 3>{};
+    EXPECT(miopenConvolutionForwardGetWorkSpaceSize(handle, w, x, conv, y, &sizes[0]) ==
+           miopenStatusSuccess);
+    EXPECT(miopenConvolutionBackwardDataGetWorkSpaceSize(handle, y, w, conv, x, &sizes[1]) ==
+           miopenStatusSuccess);
+    EXPECT(miopenConvolutionBackwardWeightsGetWorkSpaceSize(handle, y, x, conv, w, &sizes[2]) ==
+           miopenStatusSuccess);
+
+    miopenDestroyConvolutionDescriptor(conv);
+    miopenDestroyTensorDescriptor(y);
+    miopenDestroyTensorDescriptor(w);
+    miopenDestroyTensorDescriptor(x);
+    return sizes;
+}
+
+/// The same shape with other attributes must not reuse the cached size: each query of a handle
+/// which already answered for other attributes must match the one of a fresh handle.
+void check_attributes_are_keyed()
+{
+    const std::vector<std::array<int, 2>> attributes = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+
+    std::vector<std::array<std::size_t, 3>> expected;
+    for(const auto& a : attributes)
+    {
+        miopenHandle_t fresh;
+        miopenCreate(&fresh);
+        expected.push_back(QueryWorkspaces(fresh, a[0], a[1]));
+        miopenDestroy(fresh);
+    }
+
+    miopenHandle_t shared;
+    miopenCreate(&shared);
+    for(auto pass = 0; pass < 2; ++pass)
+    {
+        for(std::size_t i = 0; i < attributes.size(); ++i)
+        {
+            // Reverse order on the second pass, so every entry is queried after every other
+            const auto k = pass == 0 ? i : attributes.size() - 1 - i;
+            EXPECT(QueryWorkspaces(shared, attributes[k][0], attributes[k][1]) == expected[k]);
+        }
+    }
+    miopenDestroy(shared);
+}
+
+int main()
+{
+    check_attributes_are_keyed();
+    return 0;
+}
@@ -0,0 +1,294 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_bn.hpp"
+#include "random.hpp"
+#include "test.hpp"
+
+#include <half.hpp>
+#include <miopen/tensor_layout.hpp>
+
+#include <cmath>
+#include <vector>
+
+/// Problem of the references, the lengths of the data being N, C and the spatial size
+struct cpu_bn_problem
+{
+    std::size_t n;
+    std::size_t c;
+    std::size_t spatial;
+    bool channels_last;
+    miopenBatchNormMode_t mode;
+    double offset;
+
+    std::size_t Size() const { return n * c * spatial; }
+
+    /// Offset of element (b, ch, s) in the data
+    std::size_t Index(std::size_t b, std::size_t ch, std::size_t s) const
+    {
+        return channels_last ? (b * spatial + s) * c + ch : (b * c + ch) * spatial + s;
+    }
+
+    /// Parameter of element (ch, s), in the order of the data when per activation
+    std::size_t Param(std::size_t ch, std::size_t s) const
+    {
+        if(mode == miopenBNSpatial)
+            return ch;
+        return channels_last ? s * c + ch : ch * spatial + s;
+    }
+
+    std::size_t Params() const { return mode == miopenBNSpatial ? c : c * spatial; }
+
+    cpu_bn_geometry Geometry() const
+    {
+        return mode == miopenBNSpatial ? cpu_bn_geometry::Spatial(n, c, spatial, channels_last)
+                                       : cpu_bn_geometry::PerActivation(n, c, spatial);
+    }
+
+    /// Calls f(index, param) for every element, the elements of a parameter being visited in a row
+    template <class F>
+    void ForEach(F f) const
+    {
+        for(std::size_t ch = 0; ch < c; ++ch)
+            for(std::size_t s = 0; s < spatial; ++s)
+                for(std::size_t b = 0; b < n; ++b)
+                    f(Index(b, ch, s), Param(ch, s));
+    }
+};
+
+/// Two pass statistics of the elements of each parameter
+struct cpu_bn_naive_stats
+{
+    std::vector<double> mean;
+    std::vector<double> variance;
+    double count;
+
+    template <class T>
+    cpu_bn_naive_stats(const cpu_bn_problem& p, const std::vector<T>& x)
+        : mean(p.Params()), variance(p.Params())
+    {
+        count = static_cast<double>(p.Size() / p.Params());
+        p.ForEach([&](auto i, auto f) { mean[f] += static_cast<double>(x[i]); });
+        for(auto& m : mean)
+            m /= count;
+        p.ForEach([&](auto i, auto f) {
+            const auto d = static_cast<double>(x[i]) - mean[f];
+            variance[f] += d * d;
+        });
+        for(auto& v : variance)
+            v /= count;
+    }
+};
+
+template <class T>
+std::vector<T> make_cpu_bn_data(std::size_t size, double offset)
+{
+    std::vector<T> data(size);
+    for(auto& v : data)
+        v = static_cast<T>(offset + GET_RAND() / static_cast<double>(RAND_MAX) - 0.5);
+    return data;
+}
+
+template <class T>
+bool cpu_bn_near(const std::vector<T>& result, const std::vector<double>& expected, double tol)
+{
+    if(result.size() != expected.size())
+        return false;
+    for(std::size_t i = 0; i < result.size(); ++i)
+    {
+        const auto r = static_cast<double>(result[i]);
+        if(std::abs(r - expected[i]) > tol * std::max(1., std::abs(expected[i])))
+            return false;
+    }
+    return true;
+}
+
+/// The outputs of the engine must match the direct two pass formulas
+template <class T, class Tout>
+void check_cpu_bn(const cpu_bn_problem& p, double tol)
+{
+    const double epsilon = 1e-5;
+    const double factor  = 0.1;
+    const auto g         = p.Geometry();
+
+    const auto x     = make_cpu_bn_data<T>(p.Size(), p.offset);
+    const auto dy    = make_cpu_bn_data<T>(p.Size(), 0.);
+    const auto scale = make_cpu_bn_data<double>(p.Params(), 1.);
+    const auto bias  = make_cpu_bn_data<double>(p.Params(), 0.);
+    const auto stats = cpu_bn_naive_stats{p, x};
+    const auto m     = stats.count;
+
+    std::vector<double> inv_var(p.Params());
+    for(std::size_t f = 0; f < p.Params(); ++f)
+        inv_var[f] = 1. / std::sqrt(stats.variance[f] + epsilon);
+
+    // Forward training
+    std::vector<double> y_ref(p.Size());
+    p.ForEach([&](auto i, auto f) {
+        y_ref[i] = scale[f] * (static_cast<double>(x[i]) - stats.mean[f]) * inv_var[f] + bias[f];
+    });
+    std::vector<double> run_mean_ref(p.Params(), 0.5);
+    std::vector<double> run_var_ref(p.Params(), 2.);
+    for(std::size_t f = 0; f < p.Params(); ++f)
+    {
+        const auto unbiased = m == 1. ? stats.variance[f] : stats.variance[f] * m / (m - 1.);
+        run_mean_ref[f]     = (1. - factor) * run_mean_ref[f] + factor * stats.mean[f];
+        run_var_ref[f]      = (1. - factor) * run_var_ref[f] + factor * unbiased;
+    }
+
+    std::vector<Tout> y(p.Size());
+    std::vector<double> run_mean(p.Params(), 0.5);
+    std::vector<double> run_var(p.Params(), 2.);
+    std::vector<double> save_mean(p.Params());
+    std::vector<double> save_inv_var(p.Params());
+    cpu_bn_forward_train(g,
+                         x.data(),
+                         y.data(),
+                         scale.data(),
+                         bias.data(),
+                         epsilon,
+                         factor,
+                         run_mean.data(),
+                         run_var.data(),
+                         save_mean.data(),
+                         save_inv_var.data());
+    EXPECT(cpu_bn_near(y, y_ref, tol));
+    EXPECT(cpu_bn_near(save_mean, stats.mean, 1e-12));
+    EXPECT(cpu_bn_near(save_inv_var, inv_var, 1e-9));
+    EXPECT(cpu_bn_near(run_mean, run_mean_ref, 1e-12));
+    EXPECT(cpu_bn_near(run_var, run_var_ref, 1e-9));
+
+    // Inference, with the batch statistics then with estimates
+    std::fill(y.begin(), y.end(), Tout{});
+    cpu_bn_forward_infer(g, x.data(), y.data(), scale.data(), bias.data(), epsilon);
+    EXPECT(cpu_bn_near(y, y_ref, tol));
+
+    p.ForEach([&](auto i, auto f) {
+        y_ref[i] = scale[f] * (static_cast<double>(x[i]) - run_mean[f]) /
+                       std::sqrt(run_var[f] + epsilon) +
+                   bias[f];
+    });
+    cpu_bn_forward_infer(g,
+                         x.data(),
+                         y.data(),
+                         scale.data(),
+                         bias.data(),
+                         epsilon,
+                         run_mean.data(),
+                         run_var.data());
+    EXPECT(cpu_bn_near(y, y_ref, tol));
+
+    // Backward, with the saved statistics then recomputing them
+    std::vector<double> dbias_ref(p.Params());
+    std::vector<double> dscale_ref(p.Params());
+    p.ForEach([&](auto i, auto f) {
+        const auto xhat = (static_cast<double>(x[i]) - stats.mean[f]) * inv_var[f];
+        dbias_ref[f] += static_cast<double>(dy[i]);
+        dscale_ref[f] += xhat * static_cast<double>(dy[i]);
+    });
+    std::vector<double> dx_ref(p.Size());
+    p.ForEach([&](auto i, auto f) {
+        const auto xhat = (static_cast<double>(x[i]) - stats.mean[f]) * inv_var[f];
+        dx_ref[i]       = scale[f] * inv_var[f] / m *
+                    (m * static_cast<double>(dy[i]) - dbias_ref[f] - xhat * dscale_ref[f]);
+    });
+
+    for(const auto saved : {true, false})
+    {
+        std::vector<Tout> dx(p.Size());
+        std::vector<double> dscale(p.Params(), 1.);
+        std::vector<double> dbias(p.Params(), 1.);
+        if(saved)
+            cpu_bn_backward(g,
+                            x.data(),
+                            dy.data(),
+                            dx.data(),
+                            scale.data(),
+                            dscale.data(),
+                            dbias.data(),
+                            epsilon,
+                            save_mean.data(),
+                            save_inv_var.data());
+        else
+            cpu_bn_backward(g,
+                            x.data(),
+                            dy.data(),
+                            dx.data(),
+                            scale.data(),
+                            dscale.data(),
+                            dbias.data(),
+                            epsilon);
+        EXPECT(cpu_bn_near(dx, dx_ref, tol));
+        EXPECT(cpu_bn_near(dscale, dscale_ref, 1e-9));
+        EXPECT(cpu_bn_near(dbias, dbias_ref, 1e-9));
+    }
+}
+
+void check_cpu_bn_problems()
+{
+    // Runs shorter and longer than the lanes and the chunks, channels past a block of features,
+    // and data far from zero for the stability of the statistics.
+    const std::vector<cpu_bn_problem> problems = {
+        {2, 3, 35, false, miopenBNSpatial, 0.},
+        {3, 2, 300, false, miopenBNSpatial, 1000.},
+        {2, 70, 150, true, miopenBNSpatial, 1000.},
+        {1, 5, 1, false, miopenBNSpatial, 0.},
+        {4, 3, 5 * 6 * 7, false, miopenBNSpatial, 10.},
+        {4, 3, 5 * 6 * 7, true, miopenBNSpatial, 10.},
+        {3, 4, 35, false, miopenBNPerActivation, 0.},
+        {300, 2, 40, false, miopenBNPerActivation, 1000.},
+        {5, 3, 4 * 5 * 6, true, miopenBNPerActivation, 10.},
+        {1, 2, 3, false, miopenBNPerActivation, 0.},
+    };
+    for(const auto& problem : problems)
+    {
+        check_cpu_bn<double, double>(problem, 1e-9);
+        check_cpu_bn<float, float>(problem, 1e-5);
+    }
+    check_cpu_bn<half_float::half, double>(problems[2], 1e-9);
+}
+
+void check_cpu_bn_geometry()
+{
+    const auto nchw = miopen::TensorDescriptor{miopenFloat, {2, 3, 4, 5}};
+    const auto g0   = cpu_bn_geometry{nchw, miopenBNSpatial};
+    EXPECT(g0.outer == 2 && g0.features == 3 && g0.inner == 20);
+    const auto g1 = cpu_bn_geometry{nchw, miopenBNPerActivation};
+    EXPECT(g1.outer == 2 && g1.features == 60 && g1.inner == 1);
+
+    const std::vector<std::size_t> lens = {2, 3, 4, 5, 6};
+    std::vector<std::size_t> strides;
+    miopen::tensor_layout_to_strides(lens, "NCDHW", "NDHWC", strides);
+    const auto ndhwc = miopen::TensorDescriptor{miopenFloat, lens, strides};
+    const auto g2    = cpu_bn_geometry{ndhwc, miopenBNSpatial};
+    EXPECT(g2.outer == 240 && g2.features == 3 && g2.inner == 1);
+}
+
+int main()
+{
+    check_cpu_bn_problems();
+    check_cpu_bn_geometry();
+}
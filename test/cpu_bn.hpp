@@ -0,0 +1,497 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_BN_HPP
+#define GUARD_CPU_BN_HPP
+
+#include <miopen/errors.hpp>
+#include <miopen/miopen.h>
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Host batch normalization shared by MIOpenDriver -V 1 and the batch normalization tests.
+//
+// The data of a packed tensor is seen as outer x features x inner, the statistics of a feature
+// being taken over outer and inner:
+// - spatial NCHW/NCDHW:        N x C x (D)HW
+// - spatial NHWC/NDHWC:        N(D)HW x C x 1
+// - per activation (any):      N x C(D)HW x 1, the parameters following the order of the data.
+// The statistics are computed in a single pass over the input, by chunks whose moments are
+// merged with Welford's update (Chan et al.), in double. The loops over the contiguous dimension
+// (inner, or the features of a row when inner is 1) are vectorized by the compiler, the features
+// are distributed over the par_for thread pool.
+
+// Width of the partial sums over a contiguous run. They let the compiler vectorize the
+// reductions without reassociating them.
+constexpr std::size_t cpu_bn_lanes = 8;
+// Elements (or rows) whose moments are accumulated around a common shift before being merged.
+constexpr std::size_t cpu_bn_chunk = 256;
+// Features of a task when the features are contiguous.
+constexpr std::size_t cpu_bn_feature_block = 64;
+
+struct cpu_bn_geometry
+{
+    std::size_t outer    = 1;
+    std::size_t features = 1;
+    std::size_t inner    = 1;
+
+    cpu_bn_geometry() = default;
+    cpu_bn_geometry(std::size_t outer_, std::size_t features_, std::size_t inner_)
+        : outer(outer_), features(features_), inner(inner_)
+    {
+    }
+
+    /// Lengths and strides of x, which must be packed
+    cpu_bn_geometry(const miopen::TensorDescriptor& x, miopenBatchNormMode_t mode)
+    {
+        const auto& lens = x.GetLengths();
+        if(lens.size() < 2 || !x.IsPacked())
+            MIOPEN_THROW(miopenStatusBadParm, "Host batch norm expects a packed N, C, ... tensor");
+        std::size_t spatial = 1;
+        for(std::size_t i = 2; i < lens.size(); ++i)
+            spatial *= lens[i];
+        const auto channels_last = lens[1] > 1 && x.GetStrides()[1] == 1;
+        *this = mode == miopenBNSpatial ? Spatial(lens[0], lens[1], spatial, channels_last)
+                                        : PerActivation(lens[0], lens[1], spatial);
+    }
+
+    static cpu_bn_geometry
+    Spatial(std::size_t n, std::size_t c, std::size_t spatial, bool channels_last = false)
+    {
+        return channels_last ? cpu_bn_geometry{n * spatial, c, 1} : cpu_bn_geometry{n, c, spatial};
+    }
+
+    static cpu_bn_geometry PerActivation(std::size_t n, std::size_t c, std::size_t spatial)
+    {
+        return {n, c * spatial, 1};
+    }
+
+    /// Number of elements normalized together
+    std::size_t Count() const { return outer * inner; }
+};
+
+/// Mean and sum of the squared deviations of a set of elements
+struct cpu_bn_moments
+{
+    double count = 0.;
+    double mean  = 0.;
+    double m2    = 0.;
+
+    void Merge(double n, double n_mean, double n_m2)
+    {
+        if(n == 0.)
+            return;
+        const auto total = count + n;
+        const auto delta = n_mean - mean;
+        mean += delta * n / total;
+        m2 += n_m2 + delta * delta * count * n / total;
+        count = total;
+    }
+
+    /// Biased variance
+    double Variance() const { return count == 0. ? 0. : m2 / count; }
+};
+
+/// Runs f(begin, end) over ranges of features on the thread pool: one feature per task when
+/// inner is contiguous, blocks of features otherwise.
+template <class F>
+void cpu_bn_par_features(const cpu_bn_geometry& g, F f)
+{
+    const auto block  = g.inner == 1 ? cpu_bn_feature_block : 1;
+    const auto blocks = (g.features + block - 1) / block;
+    miopen::par_for(blocks, miopen::min_grain{1}, [&](auto b) {
+        const auto begin = static_cast<std::size_t>(b) * block;
+        f(begin, std::min(g.features, begin + block));
+    });
+}
+
+/// Accumulates the moments of x[0, n)
+template <class T>
+void cpu_bn_accumulate_run(const T* x, std::size_t n, cpu_bn_moments& moments)
+{
+    for(std::size_t begin = 0; begin < n; begin += cpu_bn_chunk)
+    {
+        const auto len           = std::min(cpu_bn_chunk, n - begin);
+        const T* p               = x + begin;
+        const double shift       = static_cast<double>(p[0]);
+        double sum[cpu_bn_lanes] = {};
+        double sq[cpu_bn_lanes]  = {};
+        std::size_t i            = 0;
+        for(; i + cpu_bn_lanes <= len; i += cpu_bn_lanes)
+        {
+            for(std::size_t l = 0; l < cpu_bn_lanes; ++l)
+            {
+                const auto d = static_cast<double>(p[i + l]) - shift;
+                sum[l] += d;
+                sq[l] += d * d;
+            }
+        }
+        for(; i < len; ++i)
+        {
+            const auto d = static_cast<double>(p[i]) - shift;
+            sum[0] += d;
+            sq[0] += d * d;
+        }
+        double s = 0.;
+        double q = 0.;
+        for(std::size_t l = 0; l < cpu_bn_lanes; ++l)
+        {
+            s += sum[l];
+            q += sq[l];
+        }
+        const auto m = s / len;
+        moments.Merge(len, shift + m, std::max(q - s * m, 0.));
+    }
+}
+
+/// Accumulates the moments of the features [f0, f1) when they are contiguous, a row at a time
+template <class T>
+void cpu_bn_accumulate_rows(
+    const cpu_bn_geometry& g, const T* x, std::size_t f0, std::size_t f1, cpu_bn_moments* moments)
+{
+    const auto width = f1 - f0;
+    std::vector<double> shift(width);
+    std::vector<double> sum(width);
+    std::vector<double> sq(width);
+    for(std::size_t begin = 0; begin < g.outer; begin += cpu_bn_chunk)
+    {
+        const auto rows = std::min(cpu_bn_chunk, g.outer - begin);
+        const T* first  = x + begin * g.features + f0;
+        for(std::size_t f = 0; f < width; ++f)
+            shift[f] = static_cast<double>(first[f]);
+        std::fill(sum.begin(), sum.end(), 0.);
+        std::fill(sq.begin(), sq.end(), 0.);
+        for(std::size_t r = 0; r < rows; ++r)
+        {
+            const T* row = first + r * g.features;
+            for(std::size_t f = 0; f < width; ++f)
+            {
+                const auto d = static_cast<double>(row[f]) - shift[f];
+                sum[f] += d;
+                sq[f] += d * d;
+            }
+        }
+        for(std::size_t f = 0; f < width; ++f)
+        {
+            const auto m = sum[f] / rows;
+            moments[f].Merge(rows, shift[f] + m, std::max(sq[f] - sum[f] * m, 0.));
+        }
+    }
+}
+
+template <class T>
+std::vector<cpu_bn_moments> cpu_bn_compute_moments(const cpu_bn_geometry& g, const T* x)
+{
+    std::vector<cpu_bn_moments> moments(g.features);
+    cpu_bn_par_features(g, [&](std::size_t f0, std::size_t f1) {
+        if(g.inner == 1)
+        {
+            cpu_bn_accumulate_rows(g, x, f0, f1, moments.data() + f0);
+            return;
+        }
+        for(std::size_t f = f0; f < f1; ++f)
+            for(std::size_t o = 0; o < g.outer; ++o)
+                cpu_bn_accumulate_run(x + (o * g.features + f) * g.inner, g.inner, moments[f]);
+    });
+    return moments;
+}
+
+/// Sums of dy and of dy * (x - mean) of every feature
+template <class T>
+void cpu_bn_compute_gradients(const cpu_bn_geometry& g,
+                              const T* x,
+                              const T* dy,
+                              const std::vector<double>& mean,
+                              std::vector<double>& sum_dy,
+                              std::vector<double>& sum_dy_xmu)
+{
+    sum_dy.assign(g.features, 0.);
+    sum_dy_xmu.assign(g.features, 0.);
+    cpu_bn_par_features(g, [&](std::size_t f0, std::size_t f1) {
+        if(g.inner == 1)
+        {
+            for(std::size_t o = 0; o < g.outer; ++o)
+            {
+                const T* xr  = x + o * g.features;
+                const T* dyr = dy + o * g.features;
+                for(std::size_t f = f0; f < f1; ++f)
+                {
+                    const auto d = static_cast<double>(dyr[f]);
+                    sum_dy[f] += d;
+                    sum_dy_xmu[f] += d * (static_cast<double>(xr[f]) - mean[f]);
+                }
+            }
+            return;
+        }
+        for(std::size_t f = f0; f < f1; ++f)
+        {
+            double s[cpu_bn_lanes] = {};
+            double p[cpu_bn_lanes] = {};
+            for(std::size_t o = 0; o < g.outer; ++o)
+            {
+                const auto offset = (o * g.features + f) * g.inner;
+                const T* xr       = x + offset;
+                const T* dyr      = dy + offset;
+                std::size_t j     = 0;
+                for(; j + cpu_bn_lanes <= g.inner; j += cpu_bn_lanes)
+                {
+                    for(std::size_t l = 0; l < cpu_bn_lanes; ++l)
+                    {
+                        const auto d = static_cast<double>(dyr[j + l]);
+                        s[l] += d;
+                        p[l] += d * (static_cast<double>(xr[j + l]) - mean[f]);
+                    }
+                }
+                for(; j < g.inner; ++j)
+                {
+                    const auto d = static_cast<double>(dyr[j]);
+                    s[0] += d;
+                    p[0] += d * (static_cast<double>(xr[j]) - mean[f]);
+                }
+            }
+            for(std::size_t l = 0; l < cpu_bn_lanes; ++l)
+            {
+                sum_dy[f] += s[l];
+                sum_dy_xmu[f] += p[l];
+            }
+        }
+    });
+}
+
+/// Per feature coefficients of out = scale * (x - mean) + shift + dy_scale * dy
+struct cpu_bn_coefficients
+{
+    std::vector<double> mean;
+    std::vector<double> scale;
+    std::vector<double> shift;
+    std::vector<double> dy_scale;
+
+    explicit cpu_bn_coefficients(std::size_t features)
+        : mean(features), scale(features), shift(features), dy_scale(features)
+    {
+    }
+};
+
+template <bool HasDy, class T, class Tout>
+void cpu_bn_apply_impl(const cpu_bn_geometry& g,
+                       const T* x,
+                       const T* dy,
+                       Tout* out,
+                       const cpu_bn_coefficients& k)
+{
+    auto value = [&](std::size_t i, std::size_t f) {
+        auto v = k.scale[f] * (static_cast<double>(x[i]) - k.mean[f]) + k.shift[f];
+        if(HasDy)
+            v += k.dy_scale[f] * static_cast<double>(dy[i]);
+        return static_cast<Tout>(v);
+    };
+    if(g.inner == 1)
+    {
+        miopen::par_for(g.outer, miopen::min_grain{1}, [&](auto o) {
+            const auto offset = static_cast<std::size_t>(o) * g.features;
+            for(std::size_t f = 0; f < g.features; ++f)
+                out[offset + f] = value(offset + f, f);
+        });
+        return;
+    }
+    miopen::par_for(g.outer * g.features, miopen::min_grain{1}, [&](auto of) {
+        const auto offset = static_cast<std::size_t>(of) * g.inner;
+        const auto f      = static_cast<std::size_t>(of) % g.features;
+        for(std::size_t j = 0; j < g.inner; ++j)
+            out[offset + j] = value(offset + j, f);
+    });
+}
+
+/// Writes out element-wise, dy being ignored when it is null
+template <class T, class Tout>
+void cpu_bn_apply(const cpu_bn_geometry& g,
+                  const T* x,
+                  const T* dy,
+                  Tout* out,
+                  const cpu_bn_coefficients& k)
+{
+    if(dy == nullptr)
+        cpu_bn_apply_impl<false>(g, x, dy, out, k);
+    else
+        cpu_bn_apply_impl<true>(g, x, dy, out, k);
+}
+
+/// Normalizes x with the statistics of the batch, saves them (save_mean and save_inv_var) and
+/// updates the running averages (run_mean and run_var) when the pointers are not null.
+template <class Tx, class Ty, class Ts, class Tp>
+void cpu_bn_forward_train(const cpu_bn_geometry& g,
+                          const Tx* x,
+                          Ty* y,
+                          const Ts* scale,
+                          const Ts* bias,
+                          double epsilon,
+                          double exp_avg_factor,
+                          Tp* run_mean,
+                          Tp* run_var,
+                          Tp* save_mean,
+                          Tp* save_inv_var)
+{
+    const auto moments = cpu_bn_compute_moments(g, x);
+    const auto count   = static_cast<double>(g.Count());
+    auto k             = cpu_bn_coefficients{g.features};
+    for(std::size_t f = 0; f < g.features; ++f)
+    {
+        const auto variance = moments[f].Variance();
+        const auto inv_var  = 1. / std::sqrt(variance + epsilon);
+        k.mean[f]           = moments[f].mean;
+        k.scale[f]          = static_cast<double>(scale[f]) * inv_var;
+        k.shift[f]          = static_cast<double>(bias[f]);
+        if(save_mean != nullptr && save_inv_var != nullptr)
+        {
+            save_mean[f]    = static_cast<Tp>(moments[f].mean);
+            save_inv_var[f] = static_cast<Tp>(inv_var);
+        }
+        if(run_mean != nullptr && run_var != nullptr)
+        {
+            const auto unbiased = count == 1. ? variance : variance * count / (count - 1.);
+            const auto keep     = 1. - exp_avg_factor;
+            run_mean[f]         = static_cast<Tp>(keep * static_cast<double>(run_mean[f]) +
+                                          exp_avg_factor * moments[f].mean);
+            run_var[f] =
+                static_cast<Tp>(keep * static_cast<double>(run_var[f]) + exp_avg_factor * unbiased);
+        }
+    }
+    cpu_bn_apply(g, x, static_cast<const Tx*>(nullptr), y, k);
+}
+
+/// Normalizes x with the estimated statistics, or with the statistics of the batch when
+/// est_mean or est_var is null.
+template <class Tx, class Ty, class Ts, class Tp>
+void cpu_bn_forward_infer(const cpu_bn_geometry& g,
+                          const Tx* x,
+                          Ty* y,
+                          const Ts* scale,
+                          const Ts* bias,
+                          double epsilon,
+                          const Tp* est_mean,
+                          const Tp* est_var)
+{
+    const auto estimated = est_mean != nullptr && est_var != nullptr;
+    const auto moments =
+        estimated ? std::vector<cpu_bn_moments>{} : cpu_bn_compute_moments(g, x);
+    auto k = cpu_bn_coefficients{g.features};
+    for(std::size_t f = 0; f < g.features; ++f)
+    {
+        const auto variance = estimated ? static_cast<double>(est_var[f]) : moments[f].Variance();
+        k.mean[f]           = estimated ? static_cast<double>(est_mean[f]) : moments[f].mean;
+        k.scale[f]          = static_cast<double>(scale[f]) / std::sqrt(variance + epsilon);
+        k.shift[f]          = static_cast<double>(bias[f]);
+    }
+    cpu_bn_apply(g, x, static_cast<const Tx*>(nullptr), y, k);
+}
+
+/// Normalizes x with the statistics of the batch
+template <class Tx, class Ty, class Ts>
+void cpu_bn_forward_infer(
+    const cpu_bn_geometry& g, const Tx* x, Ty* y, const Ts* scale, const Ts* bias, double epsilon)
+{
+    cpu_bn_forward_infer(g,
+                         x,
+                         y,
+                         scale,
+                         bias,
+                         epsilon,
+                         static_cast<const Ts*>(nullptr),
+                         static_cast<const Ts*>(nullptr));
+}
+
+/// Gradients of the batch normalization of x, with the saved statistics, or with the statistics
+/// of the batch when saved_mean or saved_inv_var is null. dscale and dbias are assigned.
+template <class Tx, class Tdx, class Ts, class Tp>
+void cpu_bn_backward(const cpu_bn_geometry& g,
+                     const Tx* x,
+                     const Tx* dy,
+                     Tdx* dx,
+                     const Ts* scale,
+                     Tp* dscale,
+                     Tp* dbias,
+                     double epsilon,
+                     const Tp* saved_mean,
+                     const Tp* saved_inv_var)
+{
+    const auto saved   = saved_mean != nullptr && saved_inv_var != nullptr;
+    const auto moments = saved ? std::vector<cpu_bn_moments>{} : cpu_bn_compute_moments(g, x);
+    const auto count   = static_cast<double>(g.Count());
+    auto k             = cpu_bn_coefficients{g.features};
+    std::vector<double> inv_var(g.features);
+    for(std::size_t f = 0; f < g.features; ++f)
+    {
+        k.mean[f]  = saved ? static_cast<double>(saved_mean[f]) : moments[f].mean;
+        inv_var[f] = saved ? static_cast<double>(saved_inv_var[f])
+                           : 1. / std::sqrt(moments[f].Variance() + epsilon);
+    }
+
+    std::vector<double> sum_dy;
+    std::vector<double> sum_dy_xmu;
+    cpu_bn_compute_gradients(g, x, dy, k.mean, sum_dy, sum_dy_xmu);
+
+    // dx = scale * inv_var / M * (M * dy - dbias - xhat * dscale)
+    for(std::size_t f = 0; f < g.features; ++f)
+    {
+        const auto ds = sum_dy_xmu[f] * inv_var[f];
+        const auto si = static_cast<double>(scale[f]) * inv_var[f];
+        dbias[f]      = static_cast<Tp>(sum_dy[f]);
+        dscale[f]     = static_cast<Tp>(ds);
+        k.dy_scale[f] = si;
+        k.scale[f]    = -si * inv_var[f] * ds / count;
+        k.shift[f]    = -si * sum_dy[f] / count;
+    }
+    cpu_bn_apply(g, x, dy, dx, k);
+}
+
+/// Gradients of the batch normalization of x with the statistics of the batch
+template <class Tx, class Tdx, class Ts, class Tp>
+void cpu_bn_backward(const cpu_bn_geometry& g,
+                     const Tx* x,
+                     const Tx* dy,
+                     Tdx* dx,
+                     const Ts* scale,
+                     Tp* dscale,
+                     Tp* dbias,
+                     double epsilon)
+{
+    cpu_bn_backward(g,
+                    x,
+                    dy,
+                    dx,
+                    scale,
+                    dscale,
+                    dbias,
+                    epsilon,
+                    static_cast<const Tp*>(nullptr),
+                    static_cast<const Tp*>(nullptr));
+}
+
+#endif // GUARD_CPU_BN_HPP
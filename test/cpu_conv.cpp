@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_conv.hpp"
+#include "random.hpp"
+#include "test.hpp"
+
+#include <half.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/// Problem of the references, lengths in the NCHW order
+struct cpu_conv_problem
+{
+    std::vector<std::size_t> in_lens;
+    std::vector<std::size_t> wei_lens;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    std::size_t group_count;
+    miopenTensorLayout_t layout;
+
+    std::vector<std::size_t> out_lens() const
+    {
+        std::vector<std::size_t> lens{in_lens[0], wei_lens[0]};
+        for(std::size_t i = 0; i < pads.size(); ++i)
+        {
+            const auto filter = dilations[i] * (wei_lens[i + 2] - 1) + 1;
+            lens.push_back((in_lens[i + 2] + 2 * pads[i] - filter) / strides[i] + 1);
+        }
+        return lens;
+    }
+};
+
+template <class T>
+tensor<T> make_cpu_conv_tensor(const std::vector<std::size_t>& lens, miopenTensorLayout_t layout)
+{
+    const auto channels_last = layout == miopenTensorNHWC || layout == miopenTensorNDHWC;
+    auto t = channels_last ? tensor<T>{miopen_type<T>{}, layout, lens} : tensor<T>{lens};
+    if(std::is_integral<T>{})
+        t.generate([](auto...) { return GET_RAND() % 17 - 8; });
+    else
+        t.generate([](auto...) { return GET_RAND() / static_cast<double>(RAND_MAX) - 0.5; });
+    return t;
+}
+
+/// The implicit GEMM references must give the same results as the direct loops
+template <class Tin, class Tout = Tin>
+void check_cpu_conv(const cpu_conv_problem& problem)
+{
+    using Tacc    = typename cpu_convolution_acc_type<Tin, Tin, Tout>::type;
+    const auto& p = problem;
+
+    auto in  = make_cpu_conv_tensor<Tin>(p.in_lens, p.layout);
+    auto wei = make_cpu_conv_tensor<Tin>(p.wei_lens, p.layout);
+    auto out = make_cpu_conv_tensor<Tout>(p.out_lens(), p.layout);
+
+    const auto run = [&](auto conv_dim) {
+        constexpr std::size_t n = decltype(conv_dim)::value;
+
+        auto fwd_gemm   = out;
+        auto fwd_direct = out;
+        cpu_convolution_forward_gemm<n, Tacc>(
+            in, wei, fwd_gemm, p.pads, p.strides, p.dilations, p.group_count);
+        cpu_convolution_forward_direct<n, Tacc>(
+            in, wei, fwd_direct, p.pads, p.strides, p.dilations, p.group_count);
+        EXPECT(fwd_gemm.data == fwd_direct.data);
+
+        if(!std::is_same<Tin, Tout>{})
+            return;
+
+        auto bwd_gemm   = in;
+        auto bwd_direct = in;
+        cpu_convolution_backward_data_gemm<n, Tacc>(
+            bwd_gemm, wei, out, p.pads, p.strides, p.dilations, p.group_count);
+        cpu_convolution_backward_data_direct<n, Tacc>(
+            bwd_direct, wei, out, p.pads, p.strides, p.dilations, p.group_count);
+        EXPECT(bwd_gemm.data == bwd_direct.data);
+
+        auto wrw_gemm   = wei;
+        auto wrw_direct = wei;
+        cpu_convolution_backward_weight_gemm<n, Tacc>(
+            in, wrw_gemm, out, p.pads, p.strides, p.dilations, p.group_count);
+        cpu_convolution_backward_weight_direct<n, Tacc>(
+            in, wrw_direct, out, p.pads, p.strides, p.dilations, p.group_count);
+        EXPECT(wrw_gemm.data == wrw_direct.data);
+    };
+
+    switch(p.pads.size())
+    {
+    case 1: run(std::integral_constant<std::size_t, 1>{}); break;
+    case 2: run(std::integral_constant<std::size_t, 2>{}); break;
+    case 3: run(std::integral_constant<std::size_t, 3>{}); break;
+    default: MIOPEN_THROW("Unsupported convolution dimension");
+    }
+}
+
+void check_cpu_conv_2d()
+{
+    // Padded, strided, grouped and dilated, with tiles of the GEMMs left partial
+    const std::vector<cpu_conv_problem> problems = {
+        {{2, 6, 9, 7}, {4, 3, 3, 3}, {1, 1}, {2, 2}, {1, 1}, 2, miopenTensorNCHW},
+        {{1, 8, 11, 13}, {8, 1, 3, 3}, {2, 1}, {1, 1}, {2, 1}, 8, miopenTensorNCHW},
+        {{2, 40, 10, 9}, {70, 40, 1, 1}, {0, 0}, {1, 1}, {1, 1}, 1, miopenTensorNCHW},
+        {{2, 6, 9, 7}, {4, 3, 3, 3}, {1, 1}, {2, 2}, {1, 1}, 2, miopenTensorNHWC},
+        {{1, 5, 12, 10}, {6, 5, 5, 3}, {2, 0}, {1, 3}, {2, 2}, 1, miopenTensorNHWC},
+    };
+    for(const auto& problem : problems)
+    {
+        check_cpu_conv<float>(problem);
+        check_cpu_conv<half_float::half>(problem);
+    }
+    check_cpu_conv<int8_t, int32_t>(problems[0]);
+    check_cpu_conv<int8_t, float>(problems[3]);
+}
+
+void check_cpu_conv_deep()
+{
+    // The GEMMs of all the directions run over more than one tile of cpu_conv_gemm_tile_k
+    static_assert(cpu_conv_gemm_tile_k < 4 * 9 * 9, "The problems must exceed a k tile");
+    const std::vector<cpu_conv_problem> problems = {
+        {{2, 4, 12, 12}, {4, 4, 9, 9}, {4, 4}, {1, 1}, {1, 1}, 1, miopenTensorNCHW},
+        {{2, 8, 11, 13}, {8, 4, 9, 9}, {4, 4}, {1, 1}, {1, 1}, 2, miopenTensorNHWC},
+    };
+    for(const auto& problem : problems)
+    {
+        check_cpu_conv<float>(problem);
+        check_cpu_conv<half_float::half>(problem);
+    }
+    check_cpu_conv<int8_t, int32_t>(problems[0]);
+}
+
+void check_cpu_conv_nd()
+{
+    const std::vector<cpu_conv_problem> problems = {
+        {{2, 4, 19}, {6, 2, 4}, {1}, {2}, {2}, 2, miopenTensorNCHW},
+        {{1, 4, 5, 6, 7}, {3, 4, 3, 2, 3}, {1, 0, 1}, {1, 2, 1}, {1, 1, 2}, 1, miopenTensorNCDHW},
+        {{2, 4, 5, 6, 7}, {4, 2, 3, 3, 3}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, 2, miopenTensorNDHWC},
+    };
+    for(const auto& problem : problems)
+        check_cpu_conv<float>(problem);
+}
+
+int main()
+{
+    check_cpu_conv_2d();
+    check_cpu_conv_deep();
+    check_cpu_conv_nd();
+}
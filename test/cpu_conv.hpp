@@ -36,6 +36,7 @@
 #include <miopen/tensor.hpp>
 #include <utility>
 
+#include "cpu_conv_gemm.hpp"
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
 #include <miopen/functional.hpp>
@@ -70,13 +71,13 @@ template <std::size_t ConvDim,
           typename Twei,
           typename Tout,
           typename Range>
-void cpu_convolution_forward_impl(const tensor<Tin>& in,
-                                  const tensor<Twei>& wei,
-                                  tensor<Tout>& out,
-                                  const Range& pads,
-                                  const Range& strides,
-                                  const Range& dilations,
-                                  std::size_t group_count)
+void cpu_convolution_forward_direct(const tensor<Tin>& in,
+                                    const tensor<Twei>& wei,
+                                    tensor<Tout>& out,
+                                    const Range& pads,
+                                    const Range& strides,
+                                    const Range& dilations,
+                                    std::size_t group_count)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
@@ -182,13 +183,13 @@ template <std::size_t ConvDim,
           typename Twei,
           typename Tout,
           typename Range>
-void cpu_convolution_backward_data_impl(tensor<Tin>& in,
-                                        const tensor<Twei>& wei,
-                                        const tensor<Tout>& out,
-                                        const Range& pads,
-                                        const Range& strides,
-                                        const Range& dilations,
-                                        std::size_t group_count)
+void cpu_convolution_backward_data_direct(tensor<Tin>& in,
+                                          const tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
@@ -272,13 +273,13 @@ template <std::size_t ConvDim,
           typename Twei,
           typename Tout,
           typename Range>
-void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
-                                          tensor<Twei>& wei,
-                                          const tensor<Tout>& out,
-                                          const Range& pads,
-                                          const Range& strides,
-                                          const Range& dilations,
-                                          std::size_t group_count)
+void cpu_convolution_backward_weight_direct(const tensor<Tin>& in,
+                                            tensor<Twei>& wei,
+                                            const tensor<Tout>& out,
+                                            const Range& pads,
+                                            const Range& strides,
+                                            const Range& dilations,
+                                            std::size_t group_count)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
@@ -350,6 +351,81 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
     });
 }
 
+/// The vectorized layouts are not addressed by the strides, only the direct loops handle them
+template <typename Tin, typename Twei, typename Tout>
+bool cpu_convolution_use_gemm(const tensor<Tin>& in,
+                              const tensor<Twei>& wei,
+                              const tensor<Tout>& out)
+{
+    return !in.desc.IsVectorized() && !wei.desc.IsVectorized() && !out.desc.IsVectorized();
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_forward_impl(const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count)
+{
+    if(cpu_convolution_use_gemm(in, wei, out))
+        cpu_convolution_forward_gemm<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count);
+    else
+        cpu_convolution_forward_direct<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count);
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_data_impl(tensor<Tin>& in,
+                                        const tensor<Twei>& wei,
+                                        const tensor<Tout>& out,
+                                        const Range& pads,
+                                        const Range& strides,
+                                        const Range& dilations,
+                                        std::size_t group_count)
+{
+    if(cpu_convolution_use_gemm(in, wei, out))
+        cpu_convolution_backward_data_gemm<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count);
+    else
+        cpu_convolution_backward_data_direct<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count);
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
+                                          tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
+{
+    if(cpu_convolution_use_gemm(in, wei, out))
+        cpu_convolution_backward_weight_gemm<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count);
+    else
+        cpu_convolution_backward_weight_direct<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count);
+}
+
 template <typename Tin, typename Twei, typename Tout, typename Range>
 void cpu_convolution_forward(std::size_t spatial_dim,
                              const tensor<Tin>& in,
@@ -0,0 +1,477 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_CONV_GEMM_HPP
+#define GUARD_CPU_CONV_GEMM_HPP
+
+#include "tensor_holder.hpp"
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+// Implicit GEMM versions of the direct references of cpu_conv.hpp. Every result element is
+// accumulated in the same order as by the direct loops, the padding being multiplied as zeros, so
+// the results are identical to theirs when the accumulator is exact for the products (double for
+// fp32 and lower precisions, int32 for int8).
+
+// Tiles of the GEMMs: the im2col block of tile_k rows by tile_n columns stays in L2 while the
+// rows of the result are updated.
+constexpr std::size_t cpu_conv_gemm_tile_m = 32;
+constexpr std::size_t cpu_conv_gemm_tile_n = 64;
+constexpr std::size_t cpu_conv_gemm_tile_k = 256;
+
+/// C[m][n] += A[m][k] * B[k][n], with B and C packed by rows of n. Each element of C is
+/// accumulated in the order of k. Four rows of C are updated per pass over B, the innermost loops
+/// are vectorized by the compiler.
+template <class T>
+void cpu_gemm_block(std::size_t m,
+                    std::size_t n,
+                    std::size_t k,
+                    const T* a,
+                    std::size_t lda,
+                    const T* b,
+                    T* c)
+{
+    std::size_t i = 0;
+    for(; i + 4 <= m; i += 4)
+    {
+        const T* a0 = a + i * lda;
+        const T* a1 = a0 + lda;
+        const T* a2 = a1 + lda;
+        const T* a3 = a2 + lda;
+        T* c0       = c + i * n;
+        T* c1       = c0 + n;
+        T* c2       = c1 + n;
+        T* c3       = c2 + n;
+        for(std::size_t l = 0; l < k; ++l)
+        {
+            const T* bl = b + l * n;
+            const T x0  = a0[l];
+            const T x1  = a1[l];
+            const T x2  = a2[l];
+            const T x3  = a3[l];
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                const T y = bl[j];
+                c0[j] += x0 * y;
+                c1[j] += x1 * y;
+                c2[j] += x2 * y;
+                c3[j] += x3 * y;
+            }
+        }
+    }
+    for(; i < m; ++i)
+    {
+        const T* ai = a + i * lda;
+        T* ci       = c + i * n;
+        for(std::size_t l = 0; l < k; ++l)
+        {
+            const T* bl = b + l * n;
+            const T x   = ai[l];
+            for(std::size_t j = 0; j < n; ++j)
+                ci[j] += x * bl[j];
+        }
+    }
+}
+
+/// Spatial dimensions of a convolution. Pixels are numbered in the row-major order of ford, and
+/// addressed by the offsets given by the strides of the tensors, whatever their layout.
+template <std::size_t ConvDim>
+struct cpu_conv_geometry
+{
+    using index = std::array<std::ptrdiff_t, ConvDim>;
+
+    index in_lens{};
+    index wei_lens{};
+    index out_lens{};
+    index in_strides{};
+    index wei_strides{};
+    index out_strides{};
+    index pads{};
+    index strides{};
+    index dilations{};
+
+    template <class Range>
+    cpu_conv_geometry(const miopen::TensorDescriptor& in,
+                      const miopen::TensorDescriptor& wei,
+                      const miopen::TensorDescriptor& out,
+                      const Range& pads_,
+                      const Range& strides_,
+                      const Range& dilations_)
+    {
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            in_lens[i]     = in.GetLengths()[i + 2];
+            wei_lens[i]    = wei.GetLengths()[i + 2];
+            out_lens[i]    = out.GetLengths()[i + 2];
+            in_strides[i]  = in.GetStrides()[i + 2];
+            wei_strides[i] = wei.GetStrides()[i + 2];
+            out_strides[i] = out.GetStrides()[i + 2];
+            pads[i]        = pads_[i];
+            strides[i]     = strides_[i];
+            dilations[i]   = dilations_[i];
+        }
+    }
+
+    static std::size_t size(const index& lens)
+    {
+        return std::accumulate(
+            lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    }
+
+    static index coords(std::size_t pixel, const index& lens)
+    {
+        index x{};
+        for(auto i = ConvDim; i-- > 0;)
+        {
+            x[i] = pixel % lens[i];
+            pixel /= lens[i];
+        }
+        return x;
+    }
+
+    static std::ptrdiff_t offset(const index& x, const index& tensor_strides)
+    {
+        return std::inner_product(x.begin(), x.end(), tensor_strides.begin(), std::ptrdiff_t{0});
+    }
+
+    /// Offset of the input pixel under the filter position r for the output pixel o, -1 if it is
+    /// in the padding
+    std::ptrdiff_t in_offset(const index& o, const index& r) const
+    {
+        std::ptrdiff_t result = 0;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            const auto x = o[i] * strides[i] + r[i] * dilations[i] - pads[i];
+            if(x < 0 || x >= in_lens[i])
+                return -1;
+            result += x * in_strides[i];
+        }
+        return result;
+    }
+
+    /// Offset of the output pixel reading the input pixel x through the filter position r, -1 if
+    /// there is none
+    std::ptrdiff_t out_offset(const index& x, const index& r) const
+    {
+        std::ptrdiff_t result = 0;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            const auto o = x[i] + pads[i] - r[i] * dilations[i];
+            if(o < 0 || o % strides[i] != 0 || o / strides[i] >= out_lens[i])
+                return -1;
+            result += o / strides[i] * out_strides[i];
+        }
+        return result;
+    }
+};
+
+/// The weights of each group as a matrix of the output channels by the input channels and the
+/// filter positions, or of the input channels by the output channels and the filter positions
+/// when transposed.
+template <typename Tacc, std::size_t ConvDim, typename Twei>
+std::vector<Tacc> cpu_conv_pack_weights(const tensor<Twei>& wei,
+                                        const cpu_conv_geometry<ConvDim>& geo,
+                                        std::size_t group_count,
+                                        bool transpose)
+{
+    const std::size_t k_per_group = wei.desc.GetLengths()[0] / group_count;
+    const std::size_t c_per_group = wei.desc.GetLengths()[1];
+    const std::size_t wei_size    = geo.size(geo.wei_lens);
+    const std::size_t k_stride    = wei.desc.GetStrides()[0];
+    const std::size_t c_stride    = wei.desc.GetStrides()[1];
+
+    std::vector<Tacc> packed(group_count * k_per_group * c_per_group * wei_size);
+    miopen::par_for(group_count * k_per_group, [&](std::size_t gk) {
+        const auto g = gk / k_per_group;
+        const auto k = gk % k_per_group;
+        for(std::size_t c = 0; c < c_per_group; ++c)
+        {
+            for(std::size_t r = 0; r < wei_size; ++r)
+            {
+                const auto src = gk * k_stride + c * c_stride +
+                                 geo.offset(geo.coords(r, geo.wei_lens), geo.wei_strides);
+                const auto dst = transpose
+                                     ? ((g * c_per_group + c) * k_per_group + k) * wei_size + r
+                                     : (gk * c_per_group + c) * wei_size + r;
+                packed[dst] = Tacc(wei.data[src]);
+            }
+        }
+    });
+    return packed;
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_forward_gemm(const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count)
+{
+    const auto geo =
+        cpu_conv_geometry<ConvDim>{in.desc, wei.desc, out.desc, pads, strides, dilations};
+    const std::size_t n_len       = out.desc.GetLengths()[0];
+    const std::size_t k_per_group = wei.desc.GetLengths()[0] / group_count;
+    const std::size_t c_per_group = wei.desc.GetLengths()[1];
+    const std::size_t wei_size    = geo.size(geo.wei_lens);
+    const std::size_t out_size    = geo.size(geo.out_lens);
+    const std::size_t gemm_k      = c_per_group * wei_size;
+    const std::size_t tiles       = (out_size + cpu_conv_gemm_tile_n - 1) / cpu_conv_gemm_tile_n;
+
+    const auto a = cpu_conv_pack_weights<Tacc>(wei, geo, group_count, false);
+
+    // GEMM of the weights by the im2col of a tile of the output pixels, per image and group
+    miopen::par_for(n_len * group_count * tiles, miopen::min_grain{1}, [&](std::size_t task) {
+        const auto tile = task % tiles;
+        const auto g    = task / tiles % group_count;
+        const auto n    = task / tiles / group_count;
+        const auto j0   = tile * cpu_conv_gemm_tile_n;
+        const auto nb   = std::min(cpu_conv_gemm_tile_n, out_size - j0);
+
+        std::vector<std::ptrdiff_t> in_offsets(wei_size * nb);
+        std::vector<std::ptrdiff_t> out_offsets(nb);
+        for(std::size_t j = 0; j < nb; ++j)
+        {
+            const auto o   = geo.coords(j0 + j, geo.out_lens);
+            out_offsets[j] = geo.offset(o, geo.out_strides);
+            for(std::size_t r = 0; r < wei_size; ++r)
+                in_offsets[r * nb + j] = geo.in_offset(o, geo.coords(r, geo.wei_lens));
+        }
+
+        const auto* src = in.data.data() + n * in.desc.GetStrides()[0] +
+                          g * c_per_group * in.desc.GetStrides()[1];
+        std::vector<Tacc> b(cpu_conv_gemm_tile_k * nb);
+        std::vector<Tacc> c(k_per_group * nb, Tacc{0});
+        for(std::size_t l0 = 0; l0 < gemm_k; l0 += cpu_conv_gemm_tile_k)
+        {
+            const auto kb = std::min(cpu_conv_gemm_tile_k, gemm_k - l0);
+            for(std::size_t l = 0; l < kb; ++l)
+            {
+                const auto* channel = src + (l0 + l) / wei_size * in.desc.GetStrides()[1];
+                const auto* offsets = in_offsets.data() + (l0 + l) % wei_size * nb;
+                for(std::size_t j = 0; j < nb; ++j)
+                    b[l * nb + j] = offsets[j] < 0 ? Tacc{0} : Tacc(channel[offsets[j]]);
+            }
+            cpu_gemm_block(k_per_group,
+                           nb,
+                           kb,
+                           a.data() + g * k_per_group * gemm_k + l0,
+                           gemm_k,
+                           b.data(),
+                           c.data());
+        }
+
+        auto* dst = out.data.data() + n * out.desc.GetStrides()[0] +
+                    g * k_per_group * out.desc.GetStrides()[1];
+        for(std::size_t k = 0; k < k_per_group; ++k)
+        {
+            for(std::size_t j = 0; j < nb; ++j)
+                dst[k * out.desc.GetStrides()[1] + out_offsets[j]] = c[k * nb + j];
+        }
+    });
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_data_gemm(tensor<Tin>& in,
+                                        const tensor<Twei>& wei,
+                                        const tensor<Tout>& out,
+                                        const Range& pads,
+                                        const Range& strides,
+                                        const Range& dilations,
+                                        std::size_t group_count)
+{
+    const auto geo =
+        cpu_conv_geometry<ConvDim>{in.desc, wei.desc, out.desc, pads, strides, dilations};
+    const std::size_t n_len       = in.desc.GetLengths()[0];
+    const std::size_t k_per_group = wei.desc.GetLengths()[0] / group_count;
+    const std::size_t c_per_group = wei.desc.GetLengths()[1];
+    const std::size_t wei_size    = geo.size(geo.wei_lens);
+    const std::size_t in_size     = geo.size(geo.in_lens);
+    const std::size_t gemm_k      = k_per_group * wei_size;
+    const std::size_t tiles       = (in_size + cpu_conv_gemm_tile_n - 1) / cpu_conv_gemm_tile_n;
+
+    const auto a = cpu_conv_pack_weights<Tacc>(wei, geo, group_count, true);
+
+    // GEMM of the transposed weights by the output pixels read by a tile of the input pixels
+    miopen::par_for(n_len * group_count * tiles, miopen::min_grain{1}, [&](std::size_t task) {
+        const auto tile = task % tiles;
+        const auto g    = task / tiles % group_count;
+        const auto n    = task / tiles / group_count;
+        const auto j0   = tile * cpu_conv_gemm_tile_n;
+        const auto nb   = std::min(cpu_conv_gemm_tile_n, in_size - j0);
+
+        std::vector<std::ptrdiff_t> out_offsets(wei_size * nb);
+        std::vector<std::ptrdiff_t> in_offsets(nb);
+        for(std::size_t j = 0; j < nb; ++j)
+        {
+            const auto x  = geo.coords(j0 + j, geo.in_lens);
+            in_offsets[j] = geo.offset(x, geo.in_strides);
+            for(std::size_t r = 0; r < wei_size; ++r)
+                out_offsets[r * nb + j] = geo.out_offset(x, geo.coords(r, geo.wei_lens));
+        }
+
+        const auto* src = out.data.data() + n * out.desc.GetStrides()[0] +
+                          g * k_per_group * out.desc.GetStrides()[1];
+        std::vector<Tacc> b(cpu_conv_gemm_tile_k * nb);
+        std::vector<Tacc> c(c_per_group * nb, Tacc{0});
+        for(std::size_t l0 = 0; l0 < gemm_k; l0 += cpu_conv_gemm_tile_k)
+        {
+            const auto kb = std::min(cpu_conv_gemm_tile_k, gemm_k - l0);
+            for(std::size_t l = 0; l < kb; ++l)
+            {
+                const auto* channel = src + (l0 + l) / wei_size * out.desc.GetStrides()[1];
+                const auto* offsets = out_offsets.data() + (l0 + l) % wei_size * nb;
+                for(std::size_t j = 0; j < nb; ++j)
+                    b[l * nb + j] = offsets[j] < 0 ? Tacc{0} : Tacc(channel[offsets[j]]);
+            }
+            cpu_gemm_block(c_per_group,
+                           nb,
+                           kb,
+                           a.data() + g * c_per_group * gemm_k + l0,
+                           gemm_k,
+                           b.data(),
+                           c.data());
+        }
+
+        auto* dst = in.data.data() + n * in.desc.GetStrides()[0] +
+                    g * c_per_group * in.desc.GetStrides()[1];
+        for(std::size_t ch = 0; ch < c_per_group; ++ch)
+        {
+            for(std::size_t j = 0; j < nb; ++j)
+                dst[ch * in.desc.GetStrides()[1] + in_offsets[j]] = c[ch * nb + j];
+        }
+    });
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_weight_gemm(const tensor<Tin>& in,
+                                          tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
+{
+    using index = typename cpu_conv_geometry<ConvDim>::index;
+    const auto geo =
+        cpu_conv_geometry<ConvDim>{in.desc, wei.desc, out.desc, pads, strides, dilations};
+    const std::size_t n_len       = out.desc.GetLengths()[0];
+    const std::size_t k_per_group = wei.desc.GetLengths()[0] / group_count;
+    const std::size_t c_per_group = wei.desc.GetLengths()[1];
+    const std::size_t wei_size    = geo.size(geo.wei_lens);
+    const std::size_t out_size    = geo.size(geo.out_lens);
+    const std::size_t gemm_n      = c_per_group * wei_size;
+    const std::size_t gemm_k      = n_len * out_size;
+    const std::size_t m_tiles = (k_per_group + cpu_conv_gemm_tile_m - 1) / cpu_conv_gemm_tile_m;
+    const std::size_t n_tiles = (gemm_n + cpu_conv_gemm_tile_n - 1) / cpu_conv_gemm_tile_n;
+
+    const auto in_n_stride  = in.desc.GetStrides()[0];
+    const auto in_c_stride  = in.desc.GetStrides()[1];
+    const auto out_n_stride = out.desc.GetStrides()[0];
+    const auto out_k_stride = out.desc.GetStrides()[1];
+
+    // GEMM of the output channels by the im2col of the input, reduced over the images and the
+    // output pixels, per tile of the output channels and of the input channels by filter positions
+    miopen::par_for(group_count * m_tiles * n_tiles, miopen::min_grain{1}, [&](std::size_t task) {
+        const auto n_tile = task % n_tiles;
+        const auto m_tile = task / n_tiles % m_tiles;
+        const auto g      = task / n_tiles / m_tiles;
+        const auto k0     = m_tile * cpu_conv_gemm_tile_m;
+        const auto mb     = std::min(cpu_conv_gemm_tile_m, k_per_group - k0);
+        const auto j0     = n_tile * cpu_conv_gemm_tile_n;
+        const auto nb     = std::min(cpu_conv_gemm_tile_n, gemm_n - j0);
+
+        std::vector<index> filter_pos(nb);
+        std::vector<std::ptrdiff_t> channel_offsets(nb);
+        for(std::size_t j = 0; j < nb; ++j)
+        {
+            filter_pos[j]      = geo.coords((j0 + j) % wei_size, geo.wei_lens);
+            channel_offsets[j] = ((j0 + j) / wei_size + g * c_per_group) * in_c_stride;
+        }
+
+        const auto* src = out.data.data() + (g * k_per_group + k0) * out_k_stride;
+        std::vector<Tacc> a(mb * cpu_conv_gemm_tile_k);
+        std::vector<Tacc> b(cpu_conv_gemm_tile_k * nb);
+        std::vector<Tacc> c(mb * nb, Tacc{0});
+        for(std::size_t l0 = 0; l0 < gemm_k; l0 += cpu_conv_gemm_tile_k)
+        {
+            const auto kb = std::min(cpu_conv_gemm_tile_k, gemm_k - l0);
+            for(std::size_t l = 0; l < kb; ++l)
+            {
+                const auto n      = (l0 + l) / out_size;
+                const auto o      = geo.coords((l0 + l) % out_size, geo.out_lens);
+                const auto* image = in.data.data() + n * in_n_stride;
+                const auto* grad  = src + n * out_n_stride + geo.offset(o, geo.out_strides);
+                for(std::size_t k = 0; k < mb; ++k)
+                    a[k * kb + l] = Tacc(grad[k * out_k_stride]);
+                for(std::size_t j = 0; j < nb; ++j)
+                {
+                    const auto offset = geo.in_offset(o, filter_pos[j]);
+                    b[l * nb + j] =
+                        offset < 0 ? Tacc{0} : Tacc(image[channel_offsets[j] + offset]);
+                }
+            }
+            cpu_gemm_block(mb, nb, kb, a.data(), kb, b.data(), c.data());
+        }
+
+        const auto k_stride = wei.desc.GetStrides()[0];
+        const auto c_stride = wei.desc.GetStrides()[1];
+        for(std::size_t k = 0; k < mb; ++k)
+        {
+            for(std::size_t j = 0; j < nb; ++j)
+            {
+                const auto offset = (g * k_per_group + k0 + k) * k_stride +
+                                    (j0 + j) / wei_size * c_stride +
+                                    geo.offset(filter_pos[j], geo.wei_strides);
+                wei.data[offset] = c[k * nb + j];
+            }
+        }
+    });
+}
+
+#endif
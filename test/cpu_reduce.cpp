@@ -0,0 +1,235 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_reduce.hpp"
+#include "random.hpp"
+#include "test.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+/// Problem of the references, the input being packed in the order of its dimensions listed from
+/// the outermost to the innermost, the output being packed
+struct cpu_reduce_problem
+{
+    std::vector<std::size_t> lens;
+    std::vector<std::size_t> order;
+    std::vector<std::size_t> reduce_dims;
+
+    std::vector<std::size_t> InStrides() const
+    {
+        std::vector<std::size_t> strides(lens.size());
+        std::size_t stride = 1;
+        for(auto d = order.rbegin(); d != order.rend(); ++d)
+        {
+            strides[*d] = stride;
+            stride *= lens[*d];
+        }
+        return strides;
+    }
+
+    std::vector<std::size_t> OutLengths() const
+    {
+        auto out_lens = lens;
+        for(auto d : reduce_dims)
+            out_lens[d] = 1;
+        return out_lens;
+    }
+
+    std::vector<std::size_t> OutStrides() const
+    {
+        const auto out_lens = OutLengths();
+        std::vector<std::size_t> strides(lens.size());
+        std::size_t stride = 1;
+        for(auto d = lens.size(); d-- > 0;)
+        {
+            strides[d] = stride;
+            stride *= out_lens[d];
+        }
+        return strides;
+    }
+
+    static std::size_t Size(const std::vector<std::size_t>& l)
+    {
+        return std::accumulate(l.begin(), l.end(), std::size_t{1}, std::multiplies<>{});
+    }
+};
+
+/// Multiples of 1/8 in [-2, 2], whose sums are exact, or factors whose products are exact for MUL
+template <class T>
+std::vector<T> make_cpu_reduce_data(std::size_t size, miopenReduceTensorOp_t op, bool with_nans)
+{
+    std::vector<T> data(size);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        if(op == MIOPEN_REDUCE_TENSOR_MUL)
+            data[i] = static_cast<T>(std::vector<double>{0.5, 1., 2., -1.}[GET_RAND() % 4]);
+        else
+            data[i] = static_cast<T>((GET_RAND() % 33 - 16) / 8.);
+        if(with_nans && GET_RAND() % 29 == 0)
+            data[i] = std::numeric_limits<T>::quiet_NaN();
+    }
+    return data;
+}
+
+template <class T>
+bool cpu_reduce_near(const std::vector<T>& result, const std::vector<T>& expected, double tol)
+{
+    for(std::size_t i = 0; i < result.size(); ++i)
+    {
+        const auto r = static_cast<double>(result[i]);
+        const auto e = static_cast<double>(expected[i]);
+        if(std::isnan(r) || std::isnan(e))
+        {
+            if(std::isnan(r) != std::isnan(e))
+                return false;
+        }
+        else if(r != e && std::abs(r - e) > tol * std::max(1., std::abs(e)))
+            return false;
+    }
+    return true;
+}
+
+/// The engine must match the element by element reduction, exactly for MIN, MAX and AMAX
+template <class T, class compType>
+void check_cpu_reduce(const cpu_reduce_problem& p,
+                      miopenReduceTensorOp_t op,
+                      miopenNanPropagation_t nanOpt,
+                      bool with_nans,
+                      float alpha,
+                      float beta,
+                      double tol)
+{
+    const auto in_strides  = p.InStrides();
+    const auto out_lens    = p.OutLengths();
+    const auto out_strides = p.OutStrides();
+    const auto in          = make_cpu_reduce_data<T>(p.Size(p.lens), op, with_nans);
+    const auto out         = make_cpu_reduce_data<T>(p.Size(out_lens), op, false);
+    const bool extreme     = op == MIOPEN_REDUCE_TENSOR_MIN || op == MIOPEN_REDUCE_TENSOR_MAX ||
+                         op == MIOPEN_REDUCE_TENSOR_AMAX;
+
+    auto expected         = out;
+    auto result           = out;
+    auto expected_indices = std::vector<int>(out.size(), -1);
+    auto result_indices   = std::vector<int>(out.size(), -1);
+
+    reduce::cpu_reduce_direct<compType>(p.lens,
+                                        in_strides,
+                                        out_lens,
+                                        out_strides,
+                                        op,
+                                        nanOpt,
+                                        alpha,
+                                        in.data(),
+                                        beta,
+                                        expected.data(),
+                                        extreme ? expected_indices.data() : nullptr);
+    reduce::cpu_reduce<compType>(p.lens,
+                                 in_strides,
+                                 out_lens,
+                                 out_strides,
+                                 op,
+                                 nanOpt,
+                                 alpha,
+                                 in.data(),
+                                 beta,
+                                 result.data(),
+                                 extreme ? result_indices.data() : nullptr);
+
+    EXPECT(cpu_reduce_near(result, expected, extreme ? 0. : tol));
+    EXPECT(result_indices == expected_indices);
+}
+
+void check_cpu_reduce_problems()
+{
+    // Contiguous and strided runs shorter and longer than the lanes, rows past a block of
+    // outputs, length-1 and non-adjacent reduced dimensions, and transposed layouts.
+    const std::vector<cpu_reduce_problem> problems = {
+        {{2, 3, 4, 5}, {0, 1, 2, 3}, {2, 3}},
+        {{2, 3, 4, 5}, {0, 1, 2, 3}, {1}},
+        {{2, 3, 4, 5}, {0, 1, 2, 3}, {0}},
+        {{2, 3, 4, 5}, {0, 1, 2, 3}, {0, 1, 2, 3}},
+        {{3, 4, 5, 6}, {0, 2, 3, 1}, {1}},
+        {{3, 70, 5, 6}, {0, 2, 3, 1}, {2, 3}},
+        {{4, 1, 9, 33}, {0, 1, 2, 3}, {0, 2}},
+        {{2, 3, 4, 5, 6}, {0, 1, 2, 3, 4}, {1, 3}},
+        {{5, 7, 100}, {2, 0, 1}, {2}},
+        {{6, 50}, {1, 0}, {0}},
+        {{4, 5, 6}, {1, 2, 0}, {1}},
+        {{2, 1000}, {0, 1}, {1}},
+        {{1000}, {0}, {0}},
+    };
+    const auto ops = {MIOPEN_REDUCE_TENSOR_ADD,
+                      MIOPEN_REDUCE_TENSOR_MUL,
+                      MIOPEN_REDUCE_TENSOR_MIN,
+                      MIOPEN_REDUCE_TENSOR_MAX,
+                      MIOPEN_REDUCE_TENSOR_AMAX,
+                      MIOPEN_REDUCE_TENSOR_AVG,
+                      MIOPEN_REDUCE_TENSOR_NORM1,
+                      MIOPEN_REDUCE_TENSOR_NORM2};
+
+    for(const auto& problem : problems)
+        for(const auto op : ops)
+            for(const auto nanOpt : {MIOPEN_NOT_PROPAGATE_NAN, MIOPEN_PROPAGATE_NAN})
+                for(const auto with_nans : {false, true})
+                {
+                    check_cpu_reduce<double, double>(
+                        problem, op, nanOpt, with_nans, 1.0f, 0.0f, 1e-12);
+                    check_cpu_reduce<float, float>(
+                        problem, op, nanOpt, with_nans, 2.0f, 0.5f, 1e-6);
+                    check_cpu_reduce<float, double>(
+                        problem, op, nanOpt, with_nans, 1.0f, 0.5f, 1e-12);
+                }
+}
+
+/// The sums are compensated: 2^20 times 0.1f sums to 2^20 * 0.1f in float, where the sequential
+/// sum is off by about 1%.
+void check_cpu_reduce_compensation()
+{
+    const auto p     = cpu_reduce_problem{{1u << 20}, {0}, {0}};
+    const auto in    = std::vector<float>(p.lens[0], 0.1f);
+    const auto exact = static_cast<double>(0.1f) * p.lens[0];
+    float out        = 0.f;
+    reduce::cpu_reduce<float>(p.lens,
+                              p.InStrides(),
+                              p.OutLengths(),
+                              p.OutStrides(),
+                              MIOPEN_REDUCE_TENSOR_ADD,
+                              MIOPEN_NOT_PROPAGATE_NAN,
+                              1.0f,
+                              in.data(),
+                              0.0f,
+                              &out,
+                              static_cast<int*>(nullptr));
+    EXPECT(std::abs(out - exact) < 1e-6 * exact);
+}
+
+int main()
+{
+    check_cpu_reduce_problems();
+    check_cpu_reduce_compensation();
+}
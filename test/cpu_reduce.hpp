@@ -0,0 +1,558 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_REDUCE_HPP
+#define GUARD_CPU_REDUCE_HPP
+
+#include "cpu_reduce_util.hpp"
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+// Host tensor reduction shared by MIOpenDriver -V 1 and the reduction tests.
+//
+// The dimensions are split into invariant ones (same input and output length) and reduced ones,
+// length-1 dimensions are dropped and neighbours of the same kind whose strides allow it are
+// merged, so a packed NCHW reduction over HW is a single run of N*C outputs by H*W contiguous
+// elements. The outputs are distributed over the par_for thread pool. When the innermost reduced
+// dimension is contiguous, each output is accumulated in cpu_reduce_lanes partial results the
+// compiler can keep in vector registers; otherwise, when the innermost invariant dimension is
+// contiguous, a row of outputs is accumulated at once. The sums (ADD, AVG, NORM1, NORM2) are
+// compensated (Kahan). MIN, MAX and AMAX keep the flattened index of the first extreme element
+// along the reduced dimensions, or of the last NaN when the NaNs are propagated, like the GPU.
+
+namespace reduce {
+
+// Partial results of an output when the reduced elements are contiguous
+constexpr std::size_t cpu_reduce_lanes = 8;
+// Outputs accumulated together when the invariant elements are contiguous
+constexpr std::size_t cpu_reduce_row_block = 64;
+
+/// Invariant and reduced dimensions of a reduction, outermost first, after dropping the
+/// length-1 dimensions and merging the ones which can be addressed by a single stride.
+struct cpu_reduce_layout
+{
+    std::vector<std::size_t> inv_lens;
+    std::vector<std::size_t> inv_in_strides;
+    std::vector<std::size_t> inv_out_strides;
+    std::vector<std::size_t> red_lens;
+    std::vector<std::size_t> red_strides;
+    std::size_t outputs = 1;
+    std::size_t reduced = 1;
+
+    cpu_reduce_layout(const std::vector<std::size_t>& inLengths,
+                      const std::vector<std::size_t>& inStrides,
+                      const std::vector<std::size_t>& outLengths,
+                      const std::vector<std::size_t>& outStrides)
+    {
+        assert(inLengths.size() == outLengths.size());
+
+        for(std::size_t i = 0; i < inLengths.size(); ++i)
+        {
+            const auto len = inLengths[i];
+            if(len == 1)
+                continue;
+            if(len == outLengths[i])
+            {
+                outputs *= len;
+                if(!inv_lens.empty() && inv_in_strides.back() == len * inStrides[i] &&
+                   inv_out_strides.back() == len * outStrides[i])
+                {
+                    inv_lens.back() *= len;
+                    inv_in_strides.back()  = inStrides[i];
+                    inv_out_strides.back() = outStrides[i];
+                    continue;
+                }
+                inv_lens.push_back(len);
+                inv_in_strides.push_back(inStrides[i]);
+                inv_out_strides.push_back(outStrides[i]);
+            }
+            else
+            {
+                assert(outLengths[i] == 1);
+                reduced *= len;
+                if(!red_lens.empty() && red_strides.back() == len * inStrides[i])
+                {
+                    red_lens.back() *= len;
+                    red_strides.back() = inStrides[i];
+                    continue;
+                }
+                red_lens.push_back(len);
+                red_strides.push_back(inStrides[i]);
+            }
+        }
+
+        if(red_lens.empty())
+        {
+            red_lens.push_back(1);
+            red_strides.push_back(1);
+        }
+    }
+
+    /// Input and output offsets of the i-th output in row-major order
+    void OutputOffsets(std::size_t i, std::size_t& in_offset, std::size_t& out_offset) const
+    {
+        in_offset  = 0;
+        out_offset = 0;
+        for(auto d = inv_lens.size(); d-- > 0;)
+        {
+            const auto k = i % inv_lens[d];
+            i /= inv_lens[d];
+            in_offset += k * inv_in_strides[d];
+            out_offset += k * inv_out_strides[d];
+        }
+    }
+
+    /// Calls f(offset, index) for the first element of each run along the innermost reduced
+    /// dimension, index being its flattened position among the reduced elements.
+    template <class F>
+    void ForEachRun(F f) const
+    {
+        const auto outer = red_lens.size() - 1;
+        const auto runs  = reduced / red_lens.back();
+        std::vector<std::size_t> pos(outer, 0);
+        std::size_t offset = 0;
+
+        for(std::size_t r = 0; r < runs; ++r)
+        {
+            f(offset, r * red_lens.back());
+            for(auto d = outer; d-- > 0;)
+            {
+                offset += red_strides[d];
+                if(++pos[d] < red_lens[d])
+                    break;
+                offset -= red_lens[d] * red_strides[d];
+                pos[d] = 0;
+            }
+        }
+    }
+};
+
+/// Compensated sum
+template <typename compType>
+struct cpu_reduce_sum
+{
+    compType sum          = convert_type<compType>(0.0f);
+    compType compensation = convert_type<compType>(0.0f);
+
+    cpu_reduce_sum() = default;
+    explicit cpu_reduce_sum(compType zero) : sum(zero) {}
+
+    void Add(compType x, std::size_t)
+    {
+        using std::isfinite;
+        const compType y = x - compensation;
+        const compType t = sum + y;
+        // once the sum overflows or meets a NaN, the compensation would only turn it into a NaN
+        compensation = isfinite(t) ? compType((t - sum) - y) : convert_type<compType>(0.0f);
+        sum          = t;
+    }
+
+    void Merge(const cpu_reduce_sum& other)
+    {
+        Add(other.sum, 0);
+        Add(-other.compensation, 0);
+    }
+
+    compType Value() const { return sum - compensation; }
+    int Index() const { return 0; }
+};
+
+template <typename compType>
+struct cpu_reduce_product
+{
+    compType product = convert_type<compType>(1.0f);
+
+    cpu_reduce_product() = default;
+    explicit cpu_reduce_product(compType one) : product(one) {}
+
+    void Add(compType x, std::size_t) { product = product * x; }
+    void Merge(const cpu_reduce_product& other) { product = product * other.product; }
+    compType Value() const { return product; }
+    int Index() const { return 0; }
+};
+
+/// MIN (IsMin) or MAX/AMAX with the index of the selected element
+template <typename compType, bool IsMin, bool PropagateNan>
+struct cpu_reduce_extreme
+{
+    compType value    = convert_type<compType>(0.0f);
+    std::size_t index = 0;
+
+    cpu_reduce_extreme() = default;
+    explicit cpu_reduce_extreme(compType init) : value(init) {}
+
+    static bool Better(compType a, compType b) { return IsMin ? a < b : b < a; }
+
+    void Add(compType x, std::size_t i)
+    {
+        using std::isnan;
+        if((PropagateNan && isnan(x)) || Better(x, value))
+        {
+            value = x;
+            index = i;
+        }
+    }
+
+    /// Same result as adding the elements of other after the ones of this accumulator, whatever
+    /// the order of their indices
+    void Merge(const cpu_reduce_extreme& other)
+    {
+        using std::isnan;
+        if(PropagateNan && (isnan(value) || isnan(other.value)))
+        {
+            if(isnan(other.value) && (!isnan(value) || other.index > index))
+            {
+                value = other.value;
+                index = other.index;
+            }
+            return;
+        }
+        if(Better(other.value, value) || (!Better(value, other.value) && other.index < index))
+        {
+            value = other.value;
+            index = other.index;
+        }
+    }
+
+    compType Value() const { return value; }
+    int Index() const { return static_cast<int>(index); }
+};
+
+struct cpu_reduce_identity
+{
+    template <typename T>
+    T operator()(T x) const
+    {
+        return x;
+    }
+};
+
+struct cpu_reduce_abs
+{
+    template <typename T>
+    T operator()(T x) const
+    {
+        using std::abs;
+        return abs(x);
+    }
+};
+
+struct cpu_reduce_square
+{
+    template <typename T>
+    T operator()(T x) const
+    {
+        return x * x;
+    }
+};
+
+template <typename compType, typename Acc, typename PreOp, typename Tin, typename Tout>
+struct cpu_reduce_kernel
+{
+    const cpu_reduce_layout& layout;
+    Acc init;
+    PreOp pre;
+    miopenReduceTensorOp_t reduceOp;
+    float alpha;
+    const Tin* in;
+    float beta;
+    Tout* out;
+    int* indices;
+
+    void Run() const
+    {
+        if(layout.red_strides.back() != 1 && !layout.inv_lens.empty() &&
+           layout.inv_in_strides.back() == 1)
+            RunRows();
+        else
+            RunOutputs();
+    }
+
+    compType Load(const Tin* p) const { return pre(convert_type<compType>(*p)); }
+
+    /// One output per task, the innermost reduced dimension being split over the lanes when it
+    /// is contiguous
+    void RunOutputs() const
+    {
+        const auto n      = layout.red_lens.back();
+        const auto stride = layout.red_strides.back();
+
+        miopen::par_for(layout.outputs, miopen::min_grain{1}, [&](auto o) {
+            std::size_t in_offset, out_offset;
+            layout.OutputOffsets(o, in_offset, out_offset);
+
+            auto lanes = std::array<Acc, cpu_reduce_lanes>{};
+            lanes.fill(init);
+
+            layout.ForEachRun([&](std::size_t offset, std::size_t index) {
+                const auto* p = in + in_offset + offset;
+                std::size_t j = 0;
+                if(stride == 1)
+                {
+                    for(; j + cpu_reduce_lanes <= n; j += cpu_reduce_lanes)
+                        for(std::size_t l = 0; l < cpu_reduce_lanes; ++l)
+                            lanes[l].Add(Load(p + j + l), index + j + l);
+                }
+                for(; j < n; ++j)
+                    lanes[0].Add(Load(p + j * stride), index + j);
+            });
+
+            for(std::size_t l = 1; l < cpu_reduce_lanes; ++l)
+                lanes[0].Merge(lanes[l]);
+            Store(lanes[0], out_offset);
+        });
+    }
+
+    /// Blocks of cpu_reduce_row_block outputs contiguous in the input per task
+    void RunRows() const
+    {
+        const auto row    = layout.inv_lens.back();
+        const auto rows   = layout.outputs / row;
+        const auto blocks = (row + cpu_reduce_row_block - 1) / cpu_reduce_row_block;
+        const auto n      = layout.red_lens.back();
+        const auto stride = layout.red_strides.back();
+
+        miopen::par_for(rows * blocks, miopen::min_grain{1}, [&](auto task) {
+            const auto begin = (task % blocks) * cpu_reduce_row_block;
+            const auto width = std::min(cpu_reduce_row_block, row - begin);
+            std::size_t in_offset, out_offset;
+            layout.OutputOffsets((task / blocks) * row + begin, in_offset, out_offset);
+
+            auto accs = std::array<Acc, cpu_reduce_row_block>{};
+            std::fill_n(accs.begin(), width, init);
+
+            layout.ForEachRun([&](std::size_t offset, std::size_t index) {
+                for(std::size_t k = 0; k < n; ++k)
+                {
+                    const auto* p = in + in_offset + offset + k * stride;
+                    for(std::size_t j = 0; j < width; ++j)
+                        accs[j].Add(Load(p + j), index + k);
+                }
+            });
+
+            const auto out_stride = layout.inv_out_strides.back();
+            for(std::size_t j = 0; j < width; ++j)
+                Store(accs[j], out_offset + j * out_stride);
+        });
+    }
+
+    void Store(const Acc& acc, std::size_t offset) const
+    {
+        using std::sqrt;
+
+        compType accuVal = acc.Value();
+
+        if(reduceOp == MIOPEN_REDUCE_TENSOR_NORM2)
+            accuVal = sqrt(accuVal);
+        else if(reduceOp == MIOPEN_REDUCE_TENSOR_AVG)
+            accuVal = accuVal / convert_type<compType>(static_cast<float>(layout.reduced));
+
+        // scale the accumulated value
+        if(!float_equal_one(alpha))
+            accuVal *= convert_type<compType>(alpha);
+
+        // scale the prior dst value and add it to the accumulated value
+        if(!float_equal_zero(beta))
+            accuVal += convert_type<compType>(out[offset]) * convert_type<compType>(beta);
+
+        out[offset] = convert_type<Tout>(accuVal);
+        if(indices != nullptr)
+            indices[offset] = acc.Index();
+    }
+};
+
+/// Reduces in into out, whose lengths are the ones of in or 1. The indices of MIN, MAX and
+/// AMAX are stored when indices is not null.
+template <typename compType, typename Tin, typename Tout>
+void cpu_reduce(const std::vector<std::size_t>& inLengths,
+                const std::vector<std::size_t>& inStrides,
+                const std::vector<std::size_t>& outLengths,
+                const std::vector<std::size_t>& outStrides,
+                miopenReduceTensorOp_t reduceOp,
+                miopenNanPropagation_t nanOpt,
+                float alpha,
+                const Tin* in,
+                float beta,
+                Tout* out,
+                int* indices)
+{
+    const auto layout    = cpu_reduce_layout{inLengths, inStrides, outLengths, outStrides};
+    const auto init      = ReduceOpZeroVal<compType>(reduceOp);
+    const auto propagate = nanOpt == MIOPEN_PROPAGATE_NAN;
+
+    const auto run = [&](auto acc, auto pre) {
+        using Kernel = cpu_reduce_kernel<compType, decltype(acc), decltype(pre), Tin, Tout>;
+        Kernel{layout, acc, pre, reduceOp, alpha, in, beta, out, indices}.Run();
+    };
+    const auto run_extreme = [&](auto is_min, auto pre) {
+        constexpr bool IsMin = decltype(is_min)::value;
+        if(propagate)
+            run(cpu_reduce_extreme<compType, IsMin, true>{init}, pre);
+        else
+            run(cpu_reduce_extreme<compType, IsMin, false>{init}, pre);
+    };
+
+    switch(reduceOp)
+    {
+    case MIOPEN_REDUCE_TENSOR_ADD:
+    case MIOPEN_REDUCE_TENSOR_AVG:
+        run(cpu_reduce_sum<compType>{init}, cpu_reduce_identity{});
+        break;
+    case MIOPEN_REDUCE_TENSOR_NORM1: run(cpu_reduce_sum<compType>{init}, cpu_reduce_abs{}); break;
+    case MIOPEN_REDUCE_TENSOR_NORM2:
+        run(cpu_reduce_sum<compType>{init}, cpu_reduce_square{});
+        break;
+    case MIOPEN_REDUCE_TENSOR_MUL:
+        run(cpu_reduce_product<compType>{init}, cpu_reduce_identity{});
+        break;
+    case MIOPEN_REDUCE_TENSOR_MIN: run_extreme(std::true_type{}, cpu_reduce_identity{}); break;
+    case MIOPEN_REDUCE_TENSOR_MAX: run_extreme(std::false_type{}, cpu_reduce_identity{}); break;
+    case MIOPEN_REDUCE_TENSOR_AMAX: run_extreme(std::false_type{}, cpu_reduce_abs{}); break;
+    }
+}
+
+/// Element by element reduction walking the materialized index spaces, kept as the reference
+/// of the cpu_reduce test and speedtest.
+template <typename compType, typename Tin, typename Tout>
+void cpu_reduce_direct(const std::vector<std::size_t>& inLengths,
+                       const std::vector<std::size_t>& inStrides,
+                       const std::vector<std::size_t>& outLengths,
+                       const std::vector<std::size_t>& outStrides,
+                       miopenReduceTensorOp_t reduceOp,
+                       miopenNanPropagation_t nanOpt,
+                       float alpha,
+                       const Tin* in,
+                       float beta,
+                       Tout* out,
+                       int* indices)
+{
+    std::vector<std::size_t> invariantLengths;
+    std::vector<std::size_t> toReduceLengths;
+
+    std::vector<int> invariantDims;
+    std::vector<int> toReduceDims;
+
+    for(std::size_t i = 0; i < inLengths.size(); i++)
+        if(inLengths[i] == outLengths[i])
+            invariantDims.push_back(i);
+        else
+            toReduceDims.push_back(i);
+
+    for(const auto dim : invariantDims)
+        invariantLengths.push_back(inLengths[dim]);
+    for(const auto dim : toReduceDims)
+        toReduceLengths.push_back(inLengths[dim]);
+
+    std::size_t divider = std::accumulate(
+        toReduceLengths.begin(), toReduceLengths.end(), std::size_t{1}, std::multiplies<>{});
+
+    const bool need_indices =
+        indices != nullptr &&
+        (reduceOp == MIOPEN_REDUCE_TENSOR_MIN || reduceOp == MIOPEN_REDUCE_TENSOR_MAX ||
+         reduceOp == MIOPEN_REDUCE_TENSOR_AMAX);
+
+    auto opReduce   = ReduceOpFn<compType>(reduceOp);
+    auto opReduce2  = ReduceOpFn2<compType>(reduceOp);
+    auto PreUnaryOp = PreUnaryOpFn<compType>(reduceOp, divider);
+    auto PosUnaryOp = PosUnaryOpFn<compType>(reduceOp, divider);
+
+    std::vector<std::vector<std::size_t>> indexes_1, indexes_2;
+
+    if(invariantDims.empty())
+        indexes_1.emplace_back();
+    else
+        get_all_indexes(invariantLengths, 0, indexes_1);
+    get_all_indexes(toReduceLengths, 0, indexes_2);
+
+    // go through indexes of the invariant dimensions
+    for(const auto& index_1 : indexes_1)
+    {
+        std::vector<std::size_t> src_index(inLengths.size(), 0);
+        std::vector<std::size_t> dst_index(inLengths.size(), 0);
+
+        for(std::size_t k = 0; k < invariantDims.size(); k++)
+            dst_index[invariantDims[k]] = index_1[k];
+
+        auto dst_offset = get_offset_from_index(outStrides, dst_index);
+
+        // generate the part of the index belonging to the invariant dims
+        for(std::size_t k = 0; k < invariantDims.size(); k++)
+            src_index[invariantDims[k]] = index_1[k];
+
+        compType accuVal = ReduceOpZeroVal<compType>(reduceOp);
+        int accuIndex    = 0;
+
+        // go through indexes of the toReduce dimensions
+        for(const auto& index_2 : indexes_2)
+        {
+            // generate the part of the index belonging to the toReduce dims
+            for(std::size_t k = 0; k < toReduceDims.size(); k++)
+                src_index[toReduceDims[k]] = index_2[k];
+
+            auto src_offset = get_offset_from_index(inStrides, src_index);
+
+            auto currVal = convert_type<compType>(in[src_offset]);
+
+            PreUnaryOp(currVal);
+
+            if(need_indices)
+            {
+                int currIndex = get_flatten_offset(toReduceLengths, index_2);
+                binop_with_nan_check2(nanOpt, opReduce2, accuVal, currVal, accuIndex, currIndex);
+            }
+            else
+                binop_with_nan_check(nanOpt, opReduce, accuVal, currVal);
+        };
+
+        if(!need_indices)
+            PosUnaryOp(accuVal);
+
+        // scale the accumulated value
+        if(!float_equal_one(alpha))
+            accuVal *= convert_type<compType>(alpha);
+
+        // scale the prior dst value and add it to the accumulated value
+        if(!float_equal_zero(beta))
+            accuVal += convert_type<compType>(out[dst_offset]) * convert_type<compType>(beta);
+
+        // store the reduced value to dst location
+        out[dst_offset] = convert_type<Tout>(accuVal);
+        if(need_indices)
+            indices[dst_offset] = accuIndex;
+    };
+}
+
+} // namespace reduce
+
+#endif
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/heuristics/dense_net.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "test.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Encodes like fdeep: base64 of the little-endian floats.
+static nlohmann::json EncodeFloats(const std::vector<float>& values)
+{
+    const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::vector<std::uint8_t> bytes(values.size() * sizeof(float));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    std::string encoded;
+    for(std::size_t i = 0; i < bytes.size(); i += 3)
+    {
+        const auto n        = std::min<std::size_t>(3, bytes.size() - i);
+        std::uint32_t group = bytes[i] << 16;
+        if(n > 1)
+            group |= bytes[i + 1] << 8;
+        if(n > 2)
+            group |= bytes[i + 2];
+        for(std::size_t j = 0; j < 4; ++j)
+            encoded += j <= n ? alphabet[(group >> (18 - 6 * j)) & 63] : '=';
+    }
+    // Split in chunks as fdeep does
+    auto chunks = nlohmann::json::array();
+    for(std::size_t i = 0; i < encoded.size(); i += 16)
+        chunks.push_back(encoded.substr(i, 16));
+    return chunks;
+}
+
+struct Dense
+{
+    std::string name;
+    std::string input;
+    std::size_t in;
+    std::size_t out;
+    std::vector<float> weights;
+    std::vector<float> bias;
+
+    std::vector<float> operator()(const std::vector<float>& x) const
+    {
+        std::vector<float> y(bias);
+        for(std::size_t o = 0; o < out; ++o)
+            for(std::size_t i = 0; i < in; ++i)
+                y[o] += x[i] * weights[i * out + o];
+        return y;
+    }
+};
+
+static nlohmann::json Layer(const std::string& class_name,
+                            const std::string& name,
+                            nlohmann::json config,
+                            const std::vector<std::string>& inputs)
+{
+    auto inbound = nlohmann::json::array();
+    for(const auto& input : inputs)
+        inbound.push_back({input, 0, 0, nlohmann::json::object()});
+    config["name"] = name;
+    return {{"class_name", class_name},
+            {"name", name},
+            {"config", config},
+            {"inbound_nodes", inputs.empty() ? nlohmann::json::array() : nlohmann::json{inbound}}};
+}
+
+/// input -> dense_a -> relu -> dense_b -+-> add -> dense_out (sigmoid)
+///       \-------------------> dense_c -/
+static void check_forward()
+{
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+    auto make_dense = [&](const std::string& name, const std::string& input, std::size_t in,
+                          std::size_t out) {
+        Dense dense{name, input, in, out, std::vector<float>(in * out), std::vector<float>(out)};
+        std::generate(dense.weights.begin(), dense.weights.end(), [&]() { return dist(gen); });
+        std::generate(dense.bias.begin(), dense.bias.end(), [&]() { return dist(gen); });
+        return dense;
+    };
+    const auto dense_a   = make_dense("dense_a", "input", 5, 11);
+    const auto dense_b   = make_dense("dense_b", "relu", 11, 7);
+    const auto dense_c   = make_dense("dense_c", "input", 5, 7);
+    const auto dense_out = make_dense("dense_out", "add", 7, 3);
+
+    auto layers = nlohmann::json::array();
+    auto params = nlohmann::json::object();
+    layers.push_back(Layer("InputLayer", "input", {{"batch_input_shape", {nullptr, 5}}}, {}));
+    auto add_dense = [&](const Dense& dense, const std::string& activation) {
+        layers.push_back(
+            Layer("Dense",
+                  dense.name,
+                  {{"units", dense.out}, {"activation", activation}, {"use_bias", true}},
+                  {dense.input}));
+        params[dense.name] = {{"weights", EncodeFloats(dense.weights)},
+                              {"bias", EncodeFloats(dense.bias)}};
+    };
+    add_dense(dense_a, "linear");
+    layers.push_back(Layer("ReLU",
+                           "relu",
+                           {{"max_value", nullptr}, {"negative_slope", 0.0}, {"threshold", 0.0}},
+                           {"dense_a"}));
+    add_dense(dense_b, "linear");
+    add_dense(dense_c, "linear");
+    layers.push_back(Layer("Add", "add", nlohmann::json::object(), {"dense_b", "dense_c"}));
+    add_dense(dense_out, "sigmoid");
+
+    const nlohmann::json model = {
+        {"architecture",
+         {{"class_name", "Functional"},
+          {"config",
+           {{"layers", layers},
+            {"input_layers", {{"input", 0, 0}}},
+            {"output_layers", {{"dense_out", 0, 0}}}}}}},
+        {"trainable_params", params}};
+
+    const miopen::TempFile file{"dense_net"};
+    std::ofstream(file.Path()) << model;
+    const auto net = miopen::ai::DenseNet::Load(file.Path());
+    EXPECT(net != nullptr);
+    EXPECT(net->InputSize() == 5);
+    EXPECT(net->OutputSize() == 3);
+
+    // Crosses the tile of the batch
+    const std::size_t batch = 13;
+    std::vector<float> inputs(batch * 5);
+    std::generate(inputs.begin(), inputs.end(), [&]() { return dist(gen); });
+    const auto outputs = net->Forward(inputs, batch);
+    EXPECT(outputs.size() == batch * 3);
+
+    for(std::size_t b = 0; b < batch; ++b)
+    {
+        const std::vector<float> x(inputs.begin() + b * 5, inputs.begin() + (b + 1) * 5);
+        auto hidden = dense_a(x);
+        for(auto& h : hidden)
+            h = std::max(h, 0.0f);
+        auto sum            = dense_b(hidden);
+        const auto shortcut = dense_c(x);
+        for(std::size_t i = 0; i < sum.size(); ++i)
+            sum[i] += shortcut[i];
+        auto expected = dense_out(sum);
+
+        const auto single = net->Forward(x, 1);
+        for(std::size_t o = 0; o < 3; ++o)
+        {
+            expected[o] = 1.0f / (1.0f + std::exp(-expected[o]));
+            EXPECT(std::abs(outputs[b * 3 + o] - expected[o]) < 1e-5f);
+            EXPECT(std::abs(single[o] - outputs[b * 3 + o]) < 1e-6f);
+        }
+    }
+
+    // Models with other layers are left to fdeep
+    auto lstm = model;
+    lstm["architecture"]["config"]["layers"][2]["class_name"] = "LSTM";
+    std::ofstream(file.Path()) << lstm;
+    EXPECT(miopen::ai::DenseNet::Load(file.Path()) == nullptr);
+}
+
+int main() { check_forward(); }
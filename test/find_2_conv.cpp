@@ -117,7 +117,8 @@ private:
 
         AddConvTensorDescriptors(problem);
 
-        std::ignore          = TestFindSolutions(handle, problem);
+        std::ignore = TestFindSolutions(handle, problem);
+        TestFindSolutionsBatch(handle, problem);
         const auto solutions = TestFindSolutionsWithOptions(handle, problem);
 
         TestSolutionAttributes(solutions);
@@ -163,6 +164,46 @@ private:
         return solutions;
     }
 
+    void TestFindSolutionsBatch(miopenHandle_t handle, miopenProblem_t problem)
+    {
+        std::cerr << "Testing miopenFindSolutionsBatch..." << std::endl;
+
+        constexpr std::size_t max_solutions = 100;
+        // The duplicate is solved once and gets a copy of the solutions
+        const auto problems = std::vector<miopenProblem_t>{problem, problem};
+        auto solutions      = std::vector<miopenSolution_t>(problems.size() * max_solutions);
+        auto found          = std::vector<std::size_t>(problems.size());
+
+        EXPECT_EQUAL(miopenFindSolutionsBatch(handle,
+                                              problems.size(),
+                                              problems.data(),
+                                              nullptr,
+                                              solutions.data(),
+                                              found.data(),
+                                              max_solutions),
+                     miopenStatusSuccess);
+        EXPECT_EQUAL(found[0], found[1]);
+
+        for(std::size_t i = 0; i < found[0]; ++i)
+        {
+            uint64_t solver_id_0;
+            uint64_t solver_id_1;
+
+            EXPECT_EQUAL(miopenGetSolutionSolverId(solutions[i], &solver_id_0),
+                         miopenStatusSuccess);
+            EXPECT_EQUAL(miopenGetSolutionSolverId(solutions[max_solutions + i], &solver_id_1),
+                         miopenStatusSuccess);
+            EXPECT_EQUAL(solver_id_0, solver_id_1);
+        }
+
+        for(std::size_t i = 0; i < problems.size(); ++i)
+            for(std::size_t j = 0; j < found[i]; ++j)
+                EXPECT_EQUAL(miopenDestroySolution(solutions[i * max_solutions + j]),
+                             miopenStatusSuccess);
+
+        std::cerr << "Finished testing miopenFindSolutionsBatch." << std::endl;
+    }
+
     std::vector<miopenSolution_t> TestFindSolutionsWithOptions(miopenHandle_t handle,
                                                                miopenProblem_t problem)
     {
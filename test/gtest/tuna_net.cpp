@@ -107,6 +107,36 @@ void TestSolverPredictionModel(miopen::ProblemDescription& problem, std::size_t
 #endif
 }
 
+/// The predictions are cached by the problem, but whether TunaNet applies depends on the
+/// context: a query in a context where none of its solvers can run must neither be answered
+/// from the cache nor hide the prediction from later queries in other contexts.
+void TestSolverPredictionContext(miopen::ProblemDescription& problem)
+{
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+    auto&& handle      = get_handle();
+    std::string device = handle.GetDeviceName();
+    if(device != "gfx908")
+        GTEST_SKIP();
+    miopen::ConvolutionContext ctx;
+    ctx.SetStream(&handle);
+    ctx.DetectRocm();
+    auto no_kernels                    = ctx;
+    no_kernels.use_asm_kernels         = false;
+    no_kernels.use_hip_kernels         = false;
+    no_kernels.use_opencl_convolutions = false;
+
+    using miopen::ai::immed_mode::PredictSolver;
+    ASSERT_TRUE(PredictSolver(problem, no_kernels, device).empty());
+    const auto solvers = PredictSolver(problem, ctx, device);
+    ASSERT_FALSE(solvers.empty());
+    ASSERT_TRUE(PredictSolver(problem, no_kernels, device).empty());
+    ASSERT_EQ(PredictSolver(problem, ctx, device), solvers);
+#else
+    std::ignore = problem;
+    GTEST_SKIP();
+#endif
+}
+
 TEST_P(TunaNetTestFloat, Gfx908TestSolverPredictionModelFloat)
 {
     TestSolverPredictionModel(problem, expected_solver);
@@ -122,6 +152,12 @@ TEST_P(TunaNetTestBF16, Gfx908TestSolverPredictionModelBF16)
     TestSolverPredictionModel(problem, expected_solver);
 }
 
+// The 5x5 problem is only handled by asm solvers among the ones TunaNet predicts
+TEST_P(TunaNetTestHalf, Gfx908TestSolverPredictionContextHalf)
+{
+    TestSolverPredictionContext(problem);
+}
+
 INSTANTIATE_TEST_SUITE_P(Gfx908TestSolverPredictionModelFloatTest,
                          TunaNetTestFloat,
                          testing::ValuesIn(GetGfx908FloatTestCases()));
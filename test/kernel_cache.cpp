@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kernel_cache.hpp>
+
+#include "test.hpp"
+
+#include <string>
+
+void check_snapshot()
+{
+    miopen::KernelCache cache;
+    const auto key = miopen::KernelCache::Key{"algorithm", "config"};
+
+    EXPECT(cache.GetKernels(key.first, key.second)->empty());
+
+    cache.AddKernel(key, miopen::Kernel{}, 0);
+    const auto snapshot = cache.GetKernels(key.first, key.second);
+    EXPECT(snapshot->size() == 1);
+
+    // Changes of the kernels replace them, the snapshot taken before stays as it was
+    cache.AddKernel(key, miopen::Kernel{}, 2);
+    EXPECT(cache.GetKernels(key.first, key.second)->size() == 3);
+    EXPECT(snapshot->size() == 1);
+
+    cache.ClearKernels(key.first, key.second);
+    EXPECT(cache.GetKernels(key.first, key.second)->empty());
+    EXPECT(snapshot->size() == 1);
+}
+
+int main() { check_snapshot(); }
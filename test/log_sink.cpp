@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/log_sink.hpp>
+
+#include "test.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+void check_format()
+{
+    miopen::logger::Record record;
+    record.category = "Info";
+    record.function = "Run";
+    record.message  = "done";
+    EXPECT(miopen::logger::FormatRecord(record, "MIOpen: ") == "MIOpen: Info [Run] done\n");
+    record.raw = true;
+    EXPECT(miopen::logger::FormatRecord(record, "MIOpen: ") == "MIOpen: done\n");
+
+    EXPECT(miopen::logger::MakePrefix("MIOpen", boost::none, boost::none) == "MIOpen: ");
+    EXPECT(miopen::logger::MakePrefix("MIOpen", 42, boost::none) == "42 MIOpen: ");
+    EXPECT(miopen::logger::MakePrefix("MIOpen", boost::none, 1.5f) == "MIOpen   1.500: ");
+}
+
+void check_binary()
+{
+    std::vector<miopen::logger::Record> records(3);
+    for(auto i = 0; i < 3; ++i)
+    {
+        records[i].time_ns   = 1000 * i;
+        records[i].thread_id = 7 + i;
+        records[i].level     = miopen::LoggingLevel::Warning;
+        records[i].raw       = i == 2;
+        records[i].category  = "Warning";
+        records[i].function  = "f" + std::to_string(i);
+        records[i].message   = std::string(i * 100, 'x');
+    }
+
+    std::stringstream stream;
+    miopen::logger::WriteBinaryHeader(stream);
+    for(const auto& record : records)
+        miopen::logger::WriteBinaryRecord(stream, record);
+
+    const auto library = miopen::logger::ReadBinaryHeader(stream);
+    EXPECT(library && *library == miopen::logger::LibraryName());
+    for(const auto& expected : records)
+    {
+        miopen::logger::Record record;
+        EXPECT(miopen::logger::ReadBinaryRecord(stream, record));
+        EXPECT(record.time_ns == expected.time_ns);
+        EXPECT(record.thread_id == expected.thread_id);
+        EXPECT(record.level == expected.level);
+        EXPECT(record.raw == expected.raw);
+        EXPECT(record.category == expected.category);
+        EXPECT(record.function == expected.function);
+        EXPECT(record.message == expected.message);
+    }
+    miopen::logger::Record record;
+    EXPECT(!miopen::logger::ReadBinaryRecord(stream, record));
+
+    std::stringstream text{"MIOpen: Info [Run] done\n"};
+    EXPECT(!miopen::logger::ReadBinaryHeader(text));
+}
+
+int main()
+{
+    check_format();
+    check_binary();
+}
@@ -0,0 +1,255 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/handle.hpp>
+#include <miopen/memory_pool.hpp>
+#include <miopen/miopen.h>
+
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <vector>
+
+/// Host memory standing in for the device memory behind the pool.
+struct mock_allocator
+{
+    std::set<void*> live;
+    std::size_t allocations = 0;
+    std::size_t frees       = 0;
+    std::size_t last_size   = 0;
+    int failures            = 0;
+
+    static void* allocate(void* ctx, std::size_t n)
+    {
+        auto& self = *static_cast<mock_allocator*>(ctx);
+        if(self.failures > 0)
+        {
+            self.failures--;
+            return nullptr;
+        }
+        auto p = std::malloc(n);
+        self.live.insert(p);
+        self.allocations++;
+        self.last_size = n;
+        return p;
+    }
+
+    static void deallocate(void* ctx, void* p)
+    {
+        auto& self = *static_cast<mock_allocator*>(ctx);
+        CHECK(self.live.erase(p) == 1);
+        self.frees++;
+        std::free(p);
+    }
+
+    miopen::Allocator get() { return {&allocate, &deallocate, this}; }
+};
+
+static const auto stream_a = reinterpret_cast<miopenAcceleratorQueue_t>(1);
+static const auto stream_b = reinterpret_cast<miopenAcceleratorQueue_t>(2);
+
+struct test_size_classes
+{
+    void run() const
+    {
+        EXPECT(miopen::MemoryPool::GetSizeClass(1) == 256);
+        EXPECT(miopen::MemoryPool::GetSizeClass(256) == 256);
+        EXPECT(miopen::MemoryPool::GetSizeClass(257) == 320);
+        EXPECT(miopen::MemoryPool::GetSizeClass(512) == 512);
+        EXPECT(miopen::MemoryPool::GetSizeClass(513) == 640);
+        EXPECT(miopen::MemoryPool::GetSizeClass(1000) == 1024);
+        for(std::size_t size = 1; size < (1 << 20); size = size * 3 / 2 + 1)
+        {
+            const auto size_class = miopen::MemoryPool::GetSizeClass(size);
+            EXPECT(size_class >= size);
+            EXPECT(size_class <= std::max<std::size_t>(256, size + size / 4));
+        }
+    }
+};
+
+struct test_disabled
+{
+    void run() const
+    {
+        mock_allocator device;
+        miopen::MemoryPool pool{0};
+        auto p = pool.Allocate(device.get(), 42, stream_a);
+        EXPECT(device.last_size == 42);
+        p = nullptr;
+        EXPECT(device.live.empty());
+        const auto stats = pool.GetStats();
+        EXPECT(stats.misses == 0);
+        EXPECT(stats.peak_bytes == 0);
+    }
+};
+
+struct test_reuse
+{
+    void run() const
+    {
+        mock_allocator device;
+        miopen::MemoryPool pool{1 << 20};
+
+        auto p        = pool.Allocate(device.get(), 1000, stream_a);
+        const auto pa = p.get();
+        EXPECT(device.last_size == 1024);
+        p = nullptr;
+        EXPECT(device.frees == 0);
+        EXPECT(pool.GetStats().bytes_cached == 1024);
+
+        // Same size class on the same stream
+        p = pool.Allocate(device.get(), 900, stream_a);
+        EXPECT(p.get() == pa);
+        // Blocks freed on another stream may still be in use by it
+        auto q = pool.Allocate(device.get(), 900, stream_b);
+        EXPECT(q.get() != pa);
+        // Another size class
+        auto r = pool.TryReuse(1200, stream_b);
+        EXPECT(r == nullptr);
+
+        const auto stats = pool.GetStats();
+        EXPECT(stats.hits == 1);
+        EXPECT(stats.misses == 2);
+        EXPECT(stats.bytes_in_use == 2048);
+        EXPECT(stats.bytes_cached == 0);
+        EXPECT(device.allocations == 2);
+    }
+};
+
+struct test_limit
+{
+    void run() const
+    {
+        mock_allocator device;
+        miopen::MemoryPool pool{4096};
+
+        std::vector<miopen::Allocator::ManageDataPtr> buffers;
+        for(auto i = 0; i < 4; ++i)
+            buffers.push_back(pool.Allocate(device.get(), 1024, stream_a));
+        const auto newest = buffers.back().get();
+        buffers.clear();
+        EXPECT(pool.GetStats().bytes_cached == 4096);
+
+        // The two least recently freed blocks make room for the new one
+        auto p = pool.Allocate(device.get(), 2048, stream_a);
+        auto stats = pool.GetStats();
+        EXPECT(stats.releases == 2);
+        EXPECT(stats.bytes_cached == 2048);
+        EXPECT(stats.peak_bytes == 4096);
+        EXPECT(device.frees == 2);
+        EXPECT(device.live.count(newest) == 1);
+
+        // A block beyond the limit is not cached
+        auto large = pool.Allocate(device.get(), 8192, stream_a);
+        large      = nullptr;
+        EXPECT(pool.GetStats().bytes_cached <= 4096 - 2048);
+
+        pool.SetLimit(0);
+        EXPECT(pool.GetStats().bytes_cached == 0);
+        p = nullptr;
+        EXPECT(device.live.empty());
+    }
+};
+
+struct test_allocation_failure
+{
+    void run() const
+    {
+        mock_allocator device;
+        miopen::MemoryPool pool{1 << 20};
+
+        pool.Allocate(device.get(), 1000, stream_a);
+        device.failures = 1;
+        auto p          = pool.Allocate(device.get(), 5000, stream_a);
+        EXPECT(p != nullptr);
+        EXPECT(pool.GetStats().releases == 1);
+        EXPECT(pool.GetStats().bytes_cached == 0);
+
+        device.failures = 1;
+        // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+        CHECK(throws([&] { p = pool.Allocate(device.get(), 5000, stream_b); }));
+    }
+};
+
+struct test_buffer_outlives_pool
+{
+    void run() const
+    {
+        mock_allocator device;
+        auto pool = std::make_unique<miopen::MemoryPool>(1 << 20);
+        auto p    = pool->Allocate(device.get(), 1000, stream_a);
+        pool.reset();
+        EXPECT(device.live.size() == 1);
+        p = nullptr;
+        EXPECT(device.live.empty());
+    }
+};
+
+struct test_handle
+{
+    void run() const
+    {
+        mock_allocator device;
+        {
+            miopen::Handle h{};
+            h.SetAllocator(&mock_allocator::allocate, &mock_allocator::deallocate, &device);
+            EXPECT(miopenSetMemoryPoolLimit(&h, 1 << 20) == miopenStatusSuccess);
+
+            auto p        = h.Create(1000);
+            const auto pa = p.get();
+            p             = nullptr;
+            p             = h.Create(1000);
+            EXPECT(p.get() == pa);
+            p = nullptr;
+
+            miopenMemoryPoolStats_t stats;
+            EXPECT(miopenGetMemoryPoolStats(&h, &stats) == miopenStatusSuccess);
+            EXPECT(stats.limit == 1 << 20);
+            EXPECT(stats.hits == 1);
+            EXPECT(stats.misses == 1);
+            EXPECT(stats.bytes_cached == 1024);
+            EXPECT(device.allocations == 1);
+
+            EXPECT(miopenReleaseMemoryPool(&h) == miopenStatusSuccess);
+            EXPECT(device.live.empty());
+
+            p = h.Create(1000);
+        }
+        EXPECT(device.live.empty());
+    }
+};
+
+int main()
+{
+    run_test<test_size_classes>();
+    run_test<test_disabled>();
+    run_test<test_reuse>();
+    run_test<test_limit>();
+    run_test<test_allocation_failure>();
+    run_test<test_buffer_outlives_pool>();
+    run_test<test_handle>();
+}
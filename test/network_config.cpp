@@ -0,0 +1,67 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+
+#include "test.hpp"
+
+#include <string>
+
+miopen::conv::ProblemDescription MakeProblem(int size, miopen::conv::Direction direction)
+{
+    const auto conv = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    const auto x    = miopen::TensorDescriptor{miopenFloat, {1, 64, size, size}};
+    const auto w    = miopen::TensorDescriptor{miopenFloat, {64, 64, 3, 3}};
+    const auto y    = miopen::TensorDescriptor{miopenFloat, {1, 64, size, size}};
+    return direction == miopen::conv::Direction::Forward
+               ? miopen::conv::ProblemDescription{x, w, y, conv, direction}
+               : miopen::conv::ProblemDescription{y, w, x, conv, direction};
+}
+
+void check_matches_string(const miopen::conv::ProblemDescription& problem)
+{
+    std::string str;
+    problem.BuildConfKey(str);
+    const auto config = problem.BuildConfKey();
+    EXPECT(config.ToString() == str);
+    EXPECT(config == miopen::NetworkConfig{str});
+    EXPECT(config.Hash() == miopen::NetworkConfig{str}.Hash());
+}
+
+int main()
+{
+    const auto fwd = MakeProblem(14, miopen::conv::Direction::Forward);
+    const auto bwd = MakeProblem(14, miopen::conv::Direction::BackwardData);
+
+    check_matches_string(fwd);
+    check_matches_string(bwd);
+    // The second call finds the interned config
+    check_matches_string(fwd);
+
+    EXPECT(fwd.BuildConfKey() != bwd.BuildConfKey());
+    EXPECT(fwd.BuildConfKey() != MakeProblem(15, miopen::conv::Direction::Forward).BuildConfKey());
+    EXPECT(miopen::NetworkConfig{} == miopen::NetworkConfig{""});
+}
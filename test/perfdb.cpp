@@ -27,8 +27,10 @@
 #include "test.hpp"
 #include "driver.hpp"
 
+#include <miopen/binary_db.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/indexedtextdb.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/ramdb.hpp>
 #include <miopen/readonlyramdb.hpp>
@@ -42,6 +44,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <iterator>
 #include <mutex>
 #include <limits>
 #include <random>
@@ -100,8 +103,9 @@ struct ArgsHelper
 
     struct db_class
     {
-        static constexpr const char* db    = "db";
-        static constexpr const char* ramdb = "ramdb";
+        static constexpr const char* db         = "db";
+        static constexpr const char* ramdb      = "ramdb";
+        static constexpr const char* indexed_db = "indexeddb";
 
         template <class TDb>
         static constexpr std::enable_if_t<std::is_same<TDb, PlainTextDb>::value, const char*> Get()
@@ -114,6 +118,13 @@ struct ArgsHelper
         {
             return ramdb;
         }
+
+        template <class TDb>
+        static constexpr std::enable_if_t<std::is_same<TDb, IndexedTextDb>::value, const char*>
+        Get()
+        {
+            return indexed_db;
+        }
     };
 };
 
@@ -626,6 +637,210 @@ public:
     }
 };
 
+class DbCompactTest : public DbTest
+{
+public:
+    DbCompactTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default,
+                          "Test",
+                          "Testing " << ArgsHelper::db_class::Get<IndexedTextDb>()
+                                     << " for compatibility of in-place updates and compaction...");
+
+        const TestData other_key(10, 20);
+        const TestData longer_value(1000, 2000);
+
+        {
+            IndexedTextDb db(temp_file);
+            EXPECT(db.Update(key(), id0(), value0()));
+            EXPECT(db.Update(other_key, id0(), value0()));
+            // Same size, rewritten in place.
+            EXPECT(db.Update(key(), id0(), value1()));
+            // Larger size, moved to the end of the file.
+            EXPECT(db.Update(other_key, id1(), longer_value));
+            EXPECT(db.Update(key(), id1(), longer_value));
+        }
+
+        const auto validate = [&](auto& db) {
+            TestData read;
+            EXPECT(db.Load(key(), id0(), read));
+            EXPECT_EQUAL(value1(), read);
+            EXPECT(db.Load(key(), id1(), read));
+            EXPECT_EQUAL(longer_value, read);
+            EXPECT(db.Load(other_key, id0(), read));
+            EXPECT_EQUAL(value0(), read);
+            EXPECT(db.Load(other_key, id1(), read));
+            EXPECT_EQUAL(longer_value, read);
+        };
+
+        {
+            PlainTextDb db(temp_file);
+            validate(db);
+        }
+
+        const auto size_before = boost::filesystem::file_size(temp_file.Path());
+
+        {
+            IndexedTextDb db(temp_file);
+            EXPECT(db.Compact());
+            validate(db);
+        }
+
+        EXPECT(boost::filesystem::file_size(temp_file.Path()) < size_before);
+
+        PlainTextDb db(temp_file);
+        validate(db);
+    }
+};
+
+class DbNoTrailingLfTest : public DbTest
+{
+public:
+    DbNoTrailingLfTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default,
+                          "Test",
+                          "Testing " << ArgsHelper::db_class::Get<IndexedTextDb>()
+                                     << " for in-place updates of the last line without LF...");
+
+        const TestData other_key(10, 20);
+
+        {
+            IndexedTextDb db(temp_file);
+            EXPECT(db.Update(key(), id0(), value0()));
+        }
+
+        // Files edited by hand may lack the final line feed.
+        const auto size = boost::filesystem::file_size(temp_file.Path());
+        boost::filesystem::resize_file(temp_file.Path(), size - 1);
+
+        {
+            IndexedTextDb db(temp_file);
+            // Same size, rewritten in place along with the line feed.
+            EXPECT(db.Update(key(), id0(), value1()));
+            EXPECT_EQUAL(boost::filesystem::file_size(temp_file.Path()), size);
+            EXPECT(db.Update(other_key, id0(), value0()));
+
+            TestData read;
+            EXPECT(db.Load(other_key, id0(), read));
+            EXPECT_EQUAL(value0(), read);
+        }
+
+        {
+            std::ifstream file(temp_file.Path());
+            const auto contents = std::string{std::istreambuf_iterator<char>{file}, {}};
+            // No empty line is inserted before the appended record.
+            EXPECT(contents.find("\n\n") == std::string::npos);
+        }
+
+        PlainTextDb db(temp_file);
+        TestData read;
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(value1(), read);
+        EXPECT(db.Load(other_key, id0(), read));
+        EXPECT_EQUAL(value0(), read);
+    }
+};
+
+class DbBinaryTest : public DbTest
+{
+public:
+    DbBinaryTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    ~DbBinaryTest() override { std::remove(BinaryDb::GetPath(temp_file).c_str()); }
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Testing binary db...");
+
+        const TestData other_key(10, 20);
+        const std::array<std::pair<const std::string, TestData>, 1> other_data{
+            {{id2(), value2()}}};
+
+        RawWrite(temp_file, key(), common_data());
+        {
+            std::ofstream(temp_file.Path(), std::ios::out | std::ios::app)
+                << other_key.x << ',' << other_key.y << '=' << id2() << ':' << value2().x << ','
+                << value2().y << std::endl;
+        }
+
+        Convert();
+
+        {
+            const auto db = BinaryDb::TryLoad(temp_file, BinaryDb::KeyKind::Text);
+            EXPECT(db != nullptr);
+            EXPECT_EQUAL(db->GetSize(), std::size_t{2});
+            ValidateSingleEntry(key(), common_data(), *db);
+            ValidateSingleEntry(other_key, other_data, *db);
+            EXPECT(!db->FindRecord(TestData(100, 200)));
+        }
+
+        // Keys of the other kind are not interchangeable.
+        EXPECT(BinaryDb::TryLoad(temp_file, BinaryDb::KeyKind::SQLiteConfig) == nullptr);
+
+        // Records of the same size, but different contents.
+        static const std::array<std::pair<const std::string, TestData>, 2> swapped_data{{
+            {id1(), value0()},
+            {id0(), value1()},
+        }};
+
+        {
+            // Binary file is preferred over the text one.
+            TempFile other_file{"miopen.tests.perfdb.other"};
+            RawWrite(other_file, key(), swapped_data);
+            BinaryDb::Write(BinaryDb::GetPath(temp_file),
+                            BinaryDb::KeyKind::Text,
+                            "",
+                            BinaryDb::Source::FromFile(temp_file),
+                            BinaryDb::ReadTextDb(other_file));
+#if MIOPEN_EMBED_DB
+            TestRordbEmbedFsOverrideLock rordb_embed_fs_override;
+#endif
+            const auto& db = ReadonlyRamDb::GetCached(temp_file, true);
+            ValidateSingleEntry(key(), swapped_data, db);
+        }
+
+        Convert();
+        const auto source = BinaryDb::Source::FromFile(temp_file);
+
+        // Binary file is outdated, even though the size and the modification time are the same.
+        RawWrite(temp_file, key(), swapped_data);
+        {
+            std::ofstream(temp_file.Path(), std::ios::out | std::ios::app)
+                << other_key.x << ',' << other_key.y << '=' << id2() << ':' << value2().x << ','
+                << value2().y << std::endl;
+        }
+        boost::filesystem::last_write_time(temp_file.Path(), source.mtime);
+        EXPECT_EQUAL(boost::filesystem::file_size(temp_file.Path()), source.size);
+        EXPECT(BinaryDb::TryLoad(temp_file, BinaryDb::KeyKind::Text) == nullptr);
+
+        // Same contents, but the source was modified after the conversion.
+        Convert();
+        boost::filesystem::last_write_time(temp_file.Path(), source.mtime + 10);
+        EXPECT(BinaryDb::TryLoad(temp_file, BinaryDb::KeyKind::Text) == nullptr);
+
+        // Source db is missing.
+        Convert();
+        EXPECT(BinaryDb::TryLoad(temp_file, BinaryDb::KeyKind::Text) != nullptr);
+        std::remove(temp_file.Path().c_str());
+        EXPECT(BinaryDb::TryLoad(temp_file, BinaryDb::KeyKind::Text) == nullptr);
+    }
+
+private:
+    void Convert() const
+    {
+        BinaryDb::Write(BinaryDb::GetPath(temp_file),
+                        BinaryDb::KeyKind::Text,
+                        "",
+                        BinaryDb::Source::FromFile(temp_file),
+                        BinaryDb::ReadTextDb(temp_file));
+    }
+};
+
 class DBMultiThreadedTestWork
 {
 public:
@@ -1514,6 +1729,9 @@ struct PerfDbDriver : test_driver
                     mt_child_id, mt_child_db_path, test_write);
             else if(mt_child_db_class == ArgsHelper::db_class::ramdb)
                 DbMultiProcessTest<RamDb>::WorkItem(mt_child_id, mt_child_db_path, test_write);
+            else if(mt_child_db_class == ArgsHelper::db_class::indexed_db)
+                DbMultiProcessTest<IndexedTextDb>::WorkItem(
+                    mt_child_id, mt_child_db_path, test_write);
             return;
         }
 
@@ -1521,6 +1739,10 @@ struct PerfDbDriver : test_driver
 
         DbTests<RamDb>(temp_file);
         DbTests<PlainTextDb>(temp_file);
+        DbTests<IndexedTextDb>(temp_file);
+        DbCompactTest{temp_file}.Run();
+        DbNoTrailingLfTest{temp_file}.Run();
+        DbBinaryTest{temp_file}.Run();
         MultiFileDbTests(temp_file);
     }
 
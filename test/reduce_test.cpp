@@ -41,7 +41,7 @@
 #include <iostream>
 #include <type_traits>
 
-#include "cpu_reduce_util.hpp"
+#include "cpu_reduce.hpp"
 
 /// Not reproducible with ROCm 4.1 and 4.2.
 #define WORKAROUND_GPU_NUMERIC_ERROR \
@@ -180,155 +180,21 @@ struct verify_reduce_with_indices
     template <typename compType>
     std::tuple<tensor<T>, tensor<int>> cpuImpl() const
     {
-        using reduce::binop_with_nan_check;
-        using reduce::binop_with_nan_check2;
-        using reduce::convert_type;
-        using reduce::float_equal_one;
-        using reduce::float_equal_zero;
-        using reduce::PosUnaryOpFn;
-        using reduce::PreUnaryOpFn;
-        using reduce::ReduceOpFn2;
-        using reduce::ReduceOpZeroVal;
-
-        auto inLengths  = input.desc.GetLengths();
-        auto outLengths = output.desc.GetLengths();
-        auto inStrides  = input.desc.GetStrides();
-        auto outStrides = output.desc.GetStrides();
-
         // replicate
         auto res         = output;
         auto res_indices = indices;
 
-        std::vector<std::size_t> invariantLengths;
-        std::vector<std::size_t> toReduceLengths;
-
-        std::vector<int> invariantDims;
-        std::vector<int> toReduceDims;
-
-        for(int i = 0; i < inLengths.size(); i++)
-            if(inLengths[i] == outLengths[i])
-                invariantDims.push_back(i);
-            else
-                toReduceDims.push_back(i);
-
-        invariantLengths.resize(invariantDims.size());
-        for(int i = 0; i < invariantDims.size(); i++)
-            invariantLengths[i] = inLengths[invariantDims[i]];
-
-        toReduceLengths.resize(toReduceDims.size());
-        for(int i = 0; i < toReduceDims.size(); i++)
-            toReduceLengths[i] = inLengths[toReduceDims[i]];
-
-        bool reduceAllDims = invariantDims.empty();
-
-        auto opReduce = ReduceOpFn2<compType>(reduceOp);
-
-        std::size_t divider = std::accumulate(
-            toReduceLengths.begin(), toReduceLengths.end(), std::size_t{1}, std::multiplies<>{});
-
-        auto PreUnaryOp = PreUnaryOpFn<compType>(reduceOp, divider);
-
-        if(reduceAllDims)
-        {
-            std::vector<std::vector<std::size_t>> indexes_1;
-
-            get_all_indexes(inLengths, 0, indexes_1);
-
-            compType accuVal = ReduceOpZeroVal<compType>(reduceOp);
-            int accuIndex    = 0;
-
-            // go through indexes of the invariant dimensions
-            for(const auto& src_index : indexes_1)
-            {
-                auto src_offset = get_offset_from_index(inStrides, src_index);
-
-                auto currVal = convert_type<compType>(input.data[src_offset]);
-
-                // unary operation before reducing, only needed by AMAX. For MIN/MAX, nothing is
-                // actually done
-                PreUnaryOp(currVal);
-
-                int currIndex = get_flatten_offset(inLengths, src_index);
-                binop_with_nan_check2(nanOpt, opReduce, accuVal, currVal, accuIndex, currIndex);
-            };
-
-            // scale the accumulated value
-            if(!float_equal_one(alpha))
-                accuVal *= convert_type<compType>(alpha);
-
-            // scale the prior dst value and add it to the accumulated value
-            if(!float_equal_zero(beta))
-            {
-                accuVal += convert_type<compType>(output.data[0]) * convert_type<compType>(beta);
-            };
-
-            // store the reduced value to dst location
-            res.data[0]         = convert_type<T>(accuVal);
-            res_indices.data[0] = accuIndex;
-        }
-        else
-        {
-            std::vector<std::vector<std::size_t>> indexes_1, indexes_2;
-
-            get_all_indexes(invariantLengths, 0, indexes_1);
-            get_all_indexes(toReduceLengths, 0, indexes_2);
-
-            // go through indexes of the invariant dimensions
-            for(const auto& index_1 : indexes_1)
-            {
-                std::vector<std::size_t> src_index;
-                std::vector<std::size_t> dst_index;
-
-                src_index.resize(inLengths.size());
-                dst_index.resize(inLengths.size());
-
-                std::fill(dst_index.begin(), dst_index.end(), 0);
-
-                for(int k = 0; k < invariantDims.size(); k++)
-                    dst_index[invariantDims[k]] = index_1[k];
-
-                auto dst_offset = get_offset_from_index(outStrides, dst_index);
-
-                // generate the part of the index belonging to the invariant dims
-                for(int k = 0; k < invariantDims.size(); k++)
-                    src_index[invariantDims[k]] = index_1[k];
-
-                compType accuVal = ReduceOpZeroVal<compType>(reduceOp);
-                int accuIndex    = 0;
-
-                // go through indexes of the toReduce dimensions
-                for(const auto& index_2 : indexes_2)
-                {
-                    // generate the part of the index belonging to the toReduce dims
-                    for(int k = 0; k < toReduceDims.size(); k++)
-                        src_index[toReduceDims[k]] = index_2[k];
-
-                    auto src_offset = get_offset_from_index(inStrides, src_index);
-
-                    auto currVal = convert_type<compType>(input.data[src_offset]);
-
-                    // unary operation before reducing, only needed by AMAX. For MIN/MAX, nothing is
-                    // actually done
-                    PreUnaryOp(currVal);
-
-                    auto currIndex = get_flatten_offset(toReduceLengths, index_2);
-                    binop_with_nan_check2(nanOpt, opReduce, accuVal, currVal, accuIndex, currIndex);
-                };
-
-                // scale the accumulated value
-                if(!float_equal_one(alpha))
-                    accuVal *= convert_type<compType>(alpha);
-
-                // scale the prior dst value and add it to the accumulated value
-                if(!float_equal_zero(beta))
-                    accuVal += convert_type<compType>(output.data[dst_offset]) *
-                               convert_type<compType>(beta);
-
-                // store the reduced value to dst location
-                res.data[dst_offset]         = convert_type<T>(accuVal);
-                res_indices.data[dst_offset] = accuIndex; // store the index
-            };
-        };
+        reduce::cpu_reduce<compType>(input.desc.GetLengths(),
+                                     input.desc.GetStrides(),
+                                     output.desc.GetLengths(),
+                                     output.desc.GetStrides(),
+                                     reduceOp,
+                                     nanOpt,
+                                     alpha,
+                                     input.data.data(),
+                                     beta,
+                                     res.data.data(),
+                                     res_indices.data.data());
 
         return (std::make_tuple(res, res_indices));
     }
@@ -474,147 +340,20 @@ struct verify_reduce_no_indices
     template <typename compType>
     tensor<T> cpuImpl() const
     {
-        using reduce::binop_with_nan_check;
-        using reduce::binop_with_nan_check2;
-        using reduce::convert_type;
-        using reduce::float_equal_one;
-        using reduce::float_equal_zero;
-        using reduce::PosUnaryOpFn;
-        using reduce::PreUnaryOpFn;
-        using reduce::ReduceOpFn;
-        using reduce::ReduceOpZeroVal;
-
-        auto inLengths  = input.desc.GetLengths();
-        auto outLengths = output.desc.GetLengths();
-        auto inStrides  = input.desc.GetStrides();
-        auto outStrides = output.desc.GetStrides();
-
         // replicate
         auto res = output;
 
-        std::vector<std::size_t> invariantLengths;
-        std::vector<std::size_t> toReduceLengths;
-
-        std::vector<int> invariantDims;
-        std::vector<int> toReduceDims;
-
-        for(int i = 0; i < inLengths.size(); i++)
-            if(inLengths[i] == outLengths[i])
-                invariantDims.push_back(i);
-            else
-                toReduceDims.push_back(i);
-
-        invariantLengths.resize(invariantDims.size());
-        for(int i = 0; i < invariantDims.size(); i++)
-            invariantLengths[i] = inLengths[invariantDims[i]];
-
-        toReduceLengths.resize(toReduceDims.size());
-        for(int i = 0; i < toReduceDims.size(); i++)
-            toReduceLengths[i] = inLengths[toReduceDims[i]];
-
-        bool reduceAllDims = invariantDims.empty();
-
-        auto opReduce = ReduceOpFn<compType>(reduceOp);
-
-        std::size_t divider = std::accumulate(
-            toReduceLengths.begin(), toReduceLengths.end(), std::size_t{1}, std::multiplies<>{});
-
-        auto PreUnaryOp = PreUnaryOpFn<compType>(reduceOp, divider);
-        auto PosUnaryOp = PosUnaryOpFn<compType>(reduceOp, divider);
-
-        if(reduceAllDims)
-        {
-            std::vector<std::vector<std::size_t>> indexes_1;
-
-            get_all_indexes(inLengths, 0, indexes_1);
-
-            compType accuVal = ReduceOpZeroVal<compType>(reduceOp);
-
-            // go through indexes of the invariant dimensions
-            for(const auto& src_index : indexes_1)
-            {
-                auto src_offset = get_offset_from_index(inStrides, src_index);
-
-                auto currVal = convert_type<compType>(input.data[src_offset]);
-
-                PreUnaryOp(currVal);
-
-                binop_with_nan_check(nanOpt, opReduce, accuVal, currVal);
-            };
-
-            PosUnaryOp(accuVal);
-
-            // scale the accumulated value
-            if(!float_equal_one(alpha))
-                accuVal *= convert_type<compType>(alpha);
-
-            // scale the prior dst value and add it to the accumulated value
-            if(!float_equal_zero(beta))
-                accuVal += convert_type<compType>(output.data[0]) * convert_type<compType>(beta);
-
-            // store the reduced value to dst location
-            res.data[0] = convert_type<T>(accuVal);
-        }
-        else
-        {
-            std::vector<std::vector<std::size_t>> indexes_1, indexes_2;
-
-            get_all_indexes(invariantLengths, 0, indexes_1);
-            get_all_indexes(toReduceLengths, 0, indexes_2);
-
-            // go through indexes of the invariant dimensions
-            for(const auto& index_1 : indexes_1)
-            {
-                std::vector<std::size_t> src_index;
-                std::vector<std::size_t> dst_index;
-
-                src_index.resize(inLengths.size());
-                dst_index.resize(inLengths.size());
-
-                std::fill(dst_index.begin(), dst_index.end(), 0);
-
-                for(int k = 0; k < invariantDims.size(); k++)
-                    dst_index[invariantDims[k]] = index_1[k];
-
-                auto dst_offset = get_offset_from_index(outStrides, dst_index);
-
-                // generate the part of the index belonging to the invariant dims
-                for(int k = 0; k < invariantDims.size(); k++)
-                    src_index[invariantDims[k]] = index_1[k];
-
-                compType accuVal = ReduceOpZeroVal<compType>(reduceOp);
-
-                // go through indexes of the toReduce dimensions
-                for(const auto& index_2 : indexes_2)
-                {
-                    // generate the part of the index belonging to the toReduce dims
-                    for(int k = 0; k < toReduceDims.size(); k++)
-                        src_index[toReduceDims[k]] = index_2[k];
-
-                    auto src_offset = get_offset_from_index(inStrides, src_index);
-
-                    auto currVal = convert_type<compType>(input.data[src_offset]);
-
-                    PreUnaryOp(currVal);
-
-                    binop_with_nan_check(nanOpt, opReduce, accuVal, currVal);
-                };
-
-                PosUnaryOp(accuVal);
-
-                // scale the accumulated value
-                if(!float_equal_one(alpha))
-                    accuVal *= convert_type<compType>(alpha);
-
-                // scale the prior dst value and add it to the accumulated value
-                if(!float_equal_zero(beta))
-                    accuVal += convert_type<compType>(output.data[dst_offset]) *
-                               convert_type<compType>(beta);
-
-                // store the reduced value to dst location
-                res.data[dst_offset] = convert_type<T>(accuVal);
-            };
-        };
+        reduce::cpu_reduce<compType>(input.desc.GetLengths(),
+                                     input.desc.GetStrides(),
+                                     output.desc.GetLengths(),
+                                     output.desc.GetStrides(),
+                                     reduceOp,
+                                     nanOpt,
+                                     alpha,
+                                     input.data.data(),
+                                     beta,
+                                     res.data.data(),
+                                     static_cast<int*>(nullptr));
 
         return (res);
     }
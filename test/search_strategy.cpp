@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_strategy.hpp>
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+using miopen::solver::SearchStrategyKind;
+
+// 8x8 grid of "x,y" configs, the time is a bowl around (5,2), (0,0) is the default
+miopen::solver::SearchSpace MakeGrid()
+{
+    std::vector<std::string> configs;
+    for(int x = 0; x < 8; ++x)
+        for(int y = 0; y < 8; ++y)
+            configs.push_back(std::to_string(x) + "," + std::to_string(y));
+    return {configs, std::size_t{0}};
+}
+
+float GridTime(std::size_t index)
+{
+    const auto x = static_cast<float>(index / 8) - 5;
+    const auto y = static_cast<float>(index % 8) - 2;
+    if(index == 63)
+        return std::numeric_limits<float>::max(); // failed
+    return 1.0f + x * x + y * y;
+}
+
+void check_neighbours()
+{
+    const auto space = MakeGrid();
+    auto neighbours  = space.GetNeighbours(3 * 8 + 4);
+    std::sort(neighbours.begin(), neighbours.end());
+    auto expected = std::vector<std::size_t>{};
+    for(std::size_t i = 0; i < 8; ++i)
+    {
+        if(i != 3)
+            expected.push_back(i * 8 + 4);
+        if(i != 4)
+            expected.push_back(3 * 8 + i);
+    }
+    std::sort(expected.begin(), expected.end());
+    EXPECT(neighbours == expected);
+}
+
+// Returns the best config measured precisely
+std::size_t Search(SearchStrategyKind kind, std::size_t max_configs)
+{
+    const auto space    = MakeGrid();
+    const auto strategy = miopen::solver::MakeSearchStrategy(kind, space, max_configs, 42);
+    std::set<std::size_t> evaluated;
+    auto best      = std::numeric_limits<float>::max();
+    auto best_idx  = space.Size();
+    auto n_batches = 0;
+
+    for(auto batch = strategy->NextBatch(); !batch.empty(); batch = strategy->NextBatch())
+    {
+        EXPECT(++n_batches < 1000);
+        for(const auto& request : batch)
+        {
+            EXPECT(request.index < space.Size());
+            evaluated.insert(request.index);
+            const auto time = GridTime(request.index);
+            if(request.runs == 0 && time < best)
+            {
+                best     = time;
+                best_idx = request.index;
+            }
+            strategy->Report(request, time);
+        }
+    }
+
+    EXPECT(evaluated.size() <= max_configs);
+    EXPECT(evaluated.size() <= strategy->GetMaxEvaluations());
+    return best_idx;
+}
+
+void check_strategies()
+{
+    const auto optimum = std::size_t{5 * 8 + 2};
+    EXPECT(Search(SearchStrategyKind::Exhaustive, 1000) == optimum);
+    EXPECT(Search(SearchStrategyKind::SuccessiveHalving, 1000) == optimum);
+    EXPECT(Search(SearchStrategyKind::Random, 1000) == optimum);
+    EXPECT(Search(SearchStrategyKind::Local, 1000) == optimum);
+
+    // The limit is respected
+    for(const auto kind : {SearchStrategyKind::Exhaustive,
+                           SearchStrategyKind::SuccessiveHalving,
+                           SearchStrategyKind::Random,
+                           SearchStrategyKind::Local})
+        EXPECT(Search(kind, 10) < 64);
+}
+
+int main()
+{
+    check_neighbours();
+    check_strategies();
+}
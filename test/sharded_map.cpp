@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/sharded_map.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <string>
+#include <utility>
+
+using Map = miopen::ShardedMap<std::string, int>;
+
+void check_basic()
+{
+    Map map;
+    EXPECT(map.Find("a") == nullptr);
+
+    const auto inserted = map.Emplace("a", 1);
+    EXPECT(inserted.second);
+    EXPECT(*inserted.first == 1);
+
+    // Emplace does not replace
+    const auto existing = map.Emplace("a", 2);
+    EXPECT(!existing.second);
+    EXPECT(existing.first == inserted.first);
+    EXPECT(*map.Find("a") == 1);
+
+    map.Update("a", [](int& value, bool is_new) {
+        EXPECT(!is_new);
+        value = 3;
+    });
+    EXPECT(*map.Find("a") == 3);
+    EXPECT(map.Read("a", [](const int* value) { return value != nullptr && *value == 3; }));
+
+    EXPECT(map.Erase("a"));
+    EXPECT(!map.Erase("a"));
+    EXPECT(map.Find("a") == nullptr);
+}
+
+struct CollidingHash
+{
+    std::size_t operator()(const std::string&) const { return 42; }
+};
+
+void check_collisions()
+{
+    miopen::ShardedMap<std::string, int, CollidingHash> map;
+    for(auto i = 0; i < 100; ++i)
+        map.Emplace(std::to_string(i), i);
+    for(auto i = 0; i < 100; ++i)
+        EXPECT(*map.Find(std::to_string(i)) == i);
+    EXPECT(map.Erase("50"));
+    EXPECT(map.Find("50") == nullptr);
+    EXPECT(*map.Find("51") == 51);
+}
+
+void check_concurrent()
+{
+    Map map;
+    const auto n = 1000;
+    std::atomic<int> inserted{0};
+    std::atomic<int> found{0};
+    miopen::TaskGroup tasks;
+    for(auto t = 0; t < 8; ++t)
+    {
+        tasks.Run([&]() {
+            for(auto i = 0; i < n; ++i)
+            {
+                if(map.Emplace(std::to_string(i), i).second)
+                    ++inserted;
+                const auto value = map.Find(std::to_string(i));
+                if(value != nullptr && *value == i)
+                    ++found;
+            }
+        });
+    }
+    tasks.Wait();
+    EXPECT(inserted == n);
+    EXPECT(found == 8 * n);
+}
+
+int main()
+{
+    check_basic();
+    check_collisions();
+    check_concurrent();
+}
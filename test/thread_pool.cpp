@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/par_for.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+void check_par_for()
+{
+    std::vector<int> data(1000, 0);
+    miopen::par_for(data.size(), 1, [&](auto i) { data[i] += 1; });
+    EXPECT(std::all_of(data.begin(), data.end(), [](auto x) { return x == 1; }));
+
+    miopen::par_for_strided(data.size(), miopen::max_threads{4}, [&](auto i) { data[i] += 1; });
+    EXPECT(std::all_of(data.begin(), data.end(), [](auto x) { return x == 2; }));
+}
+
+void check_nested_par_for()
+{
+    // Enough nesting to exhaust any pool which would block in the outer loop
+    const std::size_t n = 64;
+    std::atomic<std::size_t> count{0};
+    miopen::par_for(n, 1, [&](auto) {
+        miopen::par_for(n, 1, [&](auto) { miopen::par_for(n, 1, [&](auto) { ++count; }); });
+    });
+    EXPECT(count == n * n * n);
+}
+
+void check_task_group_exception()
+{
+    miopen::TaskGroup tasks;
+    std::atomic<int> count{0};
+    for(auto i = 0; i < 16; ++i)
+    {
+        tasks.Run([&, i]() {
+            ++count;
+            if(i == 7)
+                throw std::runtime_error("task failed");
+        });
+    }
+    // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+    CHECK(throws([&]() { tasks.Wait(); }));
+    EXPECT(count == 16);
+    // The error is reported once
+    tasks.Wait();
+}
+
+void check_run_pending_until()
+{
+    // Waiting from inside of the tasks for a condition set by the tasks of another group must
+    // not starve the pool even if there are more waiters than workers.
+    auto& pool           = miopen::ThreadPool::Global();
+    const auto n_waiters = pool.Size() + 4;
+    std::atomic<std::size_t> done{0};
+    miopen::TaskGroup tasks;
+    for(std::size_t i = 0; i < n_waiters; ++i)
+    {
+        tasks.Run([&]() {
+            std::atomic<bool> ready{false};
+            miopen::TaskGroup inner;
+            inner.Run([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                ready = true;
+            });
+            inner.RunPendingUntil([&]() { return ready.load(); });
+            ++done;
+        });
+    }
+    tasks.Wait();
+    EXPECT(done == n_waiters);
+}
+
+void check_wait_runs_own_tasks()
+{
+    // Without workers the tasks are run only by the waiters, each of them by its own group
+    miopen::ThreadPool pool{0};
+    auto mine_ran  = false;
+    auto other_ran = false;
+    miopen::TaskGroup mine{pool};
+    miopen::TaskGroup other{pool};
+    other.Run([&]() { other_ran = true; });
+    mine.Run([&]() { mine_ran = true; });
+    mine.Wait();
+    EXPECT(mine_ran);
+    EXPECT(!other_ran);
+    other.Wait();
+    EXPECT(other_ran);
+}
+
+int main()
+{
+    check_par_for();
+    check_nested_par_for();
+    check_task_group_exception();
+    check_run_pending_until();
+    check_wait_runs_own_tasks();
+}
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tmp_dir.hpp>
+
+#include "test.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace bf = boost::filesystem;
+
+static std::string ReadFile(const bf::path& path)
+{
+    auto file = std::ifstream{path.string()};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+void check_split_command_line()
+{
+    using Args = std::vector<std::string>;
+    EXPECT(miopen::SplitCommandLine("") == Args{});
+    EXPECT(miopen::SplitCommandLine("  -c   -O3 ") == (Args{"-c", "-O3"}));
+    EXPECT(miopen::SplitCommandLine("-DA='x y' \"-DB=\\\"z\\\"\"") ==
+           (Args{"-DA=x y", "-DB=\"z\""}));
+    EXPECT(miopen::SplitCommandLine("a\\ b '' c") == (Args{"a b", "", "c"}));
+    // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+    CHECK(throws([]() { std::ignore = miopen::SplitCommandLine("'unterminated"); }));
+}
+
+// A stand-in for the compiler: writes its arguments to the file after -o in the working
+// directory and fails when asked to.
+void check_execute()
+{
+#ifdef __linux__
+    const auto dir      = miopen::TmpDir{"execute"};
+    const auto compiler = dir.path / "fake_compiler.sh";
+    {
+        auto script = std::ofstream{compiler.string()};
+        script << "#!/bin/sh\n"
+                  "out=''\n"
+                  "prev=''\n"
+                  "for arg in \"$@\"; do\n"
+                  "  if [ \"$prev\" = '-o' ]; then out=\"$arg\"; fi\n"
+                  "  if [ \"$arg\" = '--fail' ]; then echo failed >&2; exit 1; fi\n"
+                  "  prev=\"$arg\"\n"
+                  "done\n"
+                  "printf '%s\\n' \"$@\" > \"$out\"\n";
+    }
+    bf::permissions(compiler, bf::owner_all);
+
+    // Shell syntax is passed to the program as is
+    dir.Execute(compiler.string(), "-c 'a b' ;echo -o out.txt");
+    EXPECT(ReadFile(dir.path / "out.txt") == "-c\na b\n;echo\n-o\nout.txt\n");
+
+    // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+    CHECK(throws([&]() { dir.Execute(compiler.string(), "--fail", true); }));
+    // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+    CHECK(throws([&]() { dir.Execute((dir.path / "missing").string(), "", true); }));
+#endif
+}
+
+int main()
+{
+    check_split_command_line();
+    check_execute();
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/errors.hpp>
+#include <miopen/temp_file.hpp>
+#include <miopen/trace.hpp>
+
+#include "test.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+void check_trace(const std::string& path)
+{
+    EXPECT(miopen::trace::IsEnabled());
+
+    std::thread worker{[]() {
+        MIOPEN_TRACE_SCOPE_ARGS("db", "Worker", "key: " << 42);
+        MIOPEN_TRACE_EVENT("kernel_cache", "Hit", "gemm");
+    }};
+    {
+        MIOPEN_TRACE_SCOPE("api", "Outer");
+        MIOPEN_TRACE_SCOPE("compile", "Inner");
+    }
+    worker.join();
+    miopen::trace::Flush();
+
+    std::ifstream file{path};
+    EXPECT(file.good());
+    const auto trace  = nlohmann::json::parse(file);
+    const auto events = trace.at("traceEvents");
+    EXPECT(events.size() == 4);
+
+    auto find = [&](const std::string& name) {
+        for(const auto& event : events)
+            if(event.at("name") == name)
+                return event;
+        MIOPEN_THROW("Missing trace event: " + name);
+    };
+
+    const auto outer = find("Outer");
+    const auto inner = find("Inner");
+    EXPECT(outer.at("cat") == "api");
+    EXPECT(outer.at("ph") == "X");
+    EXPECT(outer.at("tid") == inner.at("tid"));
+    EXPECT(outer.at("ts").get<double>() >= 0);
+    EXPECT(outer.at("ts").get<double>() <= inner.at("ts").get<double>());
+    EXPECT(outer.at("ts").get<double>() + outer.at("dur").get<double>() >=
+           inner.at("ts").get<double>() + inner.at("dur").get<double>());
+
+    const auto worker_span = find("Worker");
+    EXPECT(worker_span.at("tid") != outer.at("tid"));
+    EXPECT(worker_span.at("args").at("detail") == "key: 42");
+
+    const auto hit = find("Hit");
+    EXPECT(hit.at("ph") == "i");
+    EXPECT(hit.at("cat") == "kernel_cache");
+    EXPECT(hit.at("args").at("detail") == "gemm");
+}
+
+int main()
+{
+    // Static, so the file outlives the write at exit.
+    static const miopen::TempFile trace_file{"trace"};
+    const auto path = std::string(trace_file);
+    // Before the first use latches the setting.
+    setenv("MIOPEN_TRACE_FILE", path.c_str(), 1); // NOLINT (concurrency-mt-unsafe)
+    check_trace(path);
+}
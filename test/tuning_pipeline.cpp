@@ -0,0 +1,88 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/generic_search.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+// Producers compile on the pool and the consumer benchmarks, like in GenericSearch
+void check_lookahead(std::size_t lookahead, std::size_t agents, std::size_t items)
+{
+    miopen::solver::TuningPipeline pipeline{lookahead, agents};
+    ThreadSafeQueue<std::size_t> queue;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> in_flight{0};
+    std::atomic<std::size_t> max_in_flight{0};
+    miopen::TaskGroup group;
+
+    std::function<void()> agent = [&]() {
+        if(!pipeline.TryAcquire([&]() { group.Run(agent); }))
+            return;
+        const auto idx = next++;
+        if(idx >= items)
+        {
+            pipeline.Release();
+            return;
+        }
+        const auto now = ++in_flight;
+        auto prev      = max_in_flight.load();
+        while(prev < now && !max_in_flight.compare_exchange_weak(prev, now)) {}
+        queue.push(std::size_t{idx});
+        group.Run(agent);
+    };
+
+    for(std::size_t i = 0; i < agents; ++i)
+        group.Run(agent);
+
+    std::vector<bool> seen(items, false);
+    for(std::size_t i = 0; i < items; ++i)
+    {
+        std::size_t idx = 0;
+        group.RunPendingUntil([&]() { return queue.try_pop(idx); });
+        EXPECT(!seen[idx]);
+        seen[idx] = true;
+        std::this_thread::yield();
+        --in_flight;
+        pipeline.Release();
+    }
+    group.Wait();
+
+    EXPECT(std::all_of(seen.begin(), seen.end(), [](auto x) { return x; }));
+    EXPECT(max_in_flight <= lookahead);
+}
+
+int main()
+{
+    check_lookahead(1, 1, 100);
+    check_lookahead(1, 8, 100);
+    check_lookahead(4, 8, 1000);
+    check_lookahead(64, 4, 1000);
+}
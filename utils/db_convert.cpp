@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Converts a system find-db or perf-db into the pre-indexed binary format read by
+/// miopen::BinaryDb. The output is placed next to the input by default, where the library
+/// looks for it.
+///
+/// Usage: MIOpenDbConvert <input.fdb.txt|input.db.txt|input.db> [<output>]
+
+#include <miopen/binary_db.hpp>
+#include <miopen/config.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static bool IsSQLiteFile(const std::string& path)
+{
+    static const char sqlite_magic[] = "SQLite format 3";
+    char buffer[sizeof(sqlite_magic)] = {};
+    std::ifstream file{path, std::ios::binary};
+    return file.read(buffer, sizeof(buffer)) &&
+           std::memcmp(buffer, sqlite_magic, sizeof(sqlite_magic)) == 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <input db> [<output>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string input  = argv[1];
+    const std::string output = argc > 2 ? argv[2] : miopen::BinaryDb::GetPath(input);
+
+    try
+    {
+        auto kind    = miopen::BinaryDb::KeyKind::Text;
+        auto schema  = std::string{};
+        auto records = std::vector<miopen::DbRecord>{};
+
+        if(IsSQLiteFile(input))
+        {
+#if MIOPEN_ENABLE_SQLITE
+            kind    = miopen::BinaryDb::KeyKind::SQLiteConfig;
+            schema  = miopen::BinaryDb::SQLiteSchema();
+            records = miopen::BinaryDb::ReadSQLitePerfDb(input);
+#else
+            std::cerr << input << ": SQLite databases are not supported by this build"
+                      << std::endl;
+            return EXIT_FAILURE;
+#endif
+        }
+        else
+        {
+            records = miopen::BinaryDb::ReadTextDb(input);
+        }
+
+        miopen::BinaryDb::Write(
+            output, kind, schema, miopen::BinaryDb::Source::FromFile(input), records);
+        std::cout << input << " -> " << output << ": " << records.size() << " records"
+                  << std::endl;
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Converts a binary log written with MIOPEN_LOG_BINARY_FILE into the text log. Each line
+/// gets the thread id and, with --elapsed, the time since the previous line in ms.
+///
+/// Usage: MIOpenLogDecode [--elapsed] <input> [<output>]
+
+#include <miopen/log_sink.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    auto args    = std::vector<std::string>(argv + 1, argv + argc);
+    auto elapsed = false;
+    if(!args.empty() && args.front() == "--elapsed")
+    {
+        elapsed = true;
+        args.erase(args.begin());
+    }
+    if(args.empty() || args.size() > 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " [--elapsed] <input> [<output>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input{args[0], std::ios::binary};
+    if(!input)
+    {
+        std::cerr << "Unable to open " << args[0] << std::endl;
+        return EXIT_FAILURE;
+    }
+    const auto library = miopen::logger::ReadBinaryHeader(input);
+    if(!library)
+    {
+        std::cerr << args[0] << " is not a binary MIOpen log" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream output_file;
+    if(args.size() > 1)
+        output_file.open(args[1]);
+    std::ostream& output = args.size() > 1 ? output_file : std::cout;
+
+    auto record    = miopen::logger::Record{};
+    auto last_time = std::int64_t{0};
+    auto n_records = std::size_t{0};
+    while(input.peek() != std::char_traits<char>::eof())
+    {
+        if(!miopen::logger::ReadBinaryRecord(input, record))
+        {
+            std::cerr << args[0] << ": truncated after " << n_records << " records" << std::endl;
+            return EXIT_FAILURE;
+        }
+        auto elapsed_ms = boost::optional<float>{};
+        if(elapsed)
+            elapsed_ms = n_records == 0 ? 0.0f : (record.time_ns - last_time) / 1.0e6f;
+        last_time = record.time_ns;
+        ++n_records;
+        output << miopen::logger::FormatRecord(
+            record, miopen::logger::MakePrefix(*library, record.thread_id, elapsed_ms));
+    }
+
+    return output ? EXIT_SUCCESS : EXIT_FAILURE;
+}
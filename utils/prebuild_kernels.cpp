@@ -0,0 +1,423 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Fills the kernel cache with the kernels of convolutions listed as MIOpenDriver command
+/// lines, e.g. test/perf_models/*.txt or the logs written with MIOPEN_ENABLE_LOGGING_CMD=1.
+/// Kernels of all the applicable solutions are built for the target given by --arch and
+/// --num-cu (MIOPEN_DEVICE_ARCH and MIOPEN_DEVICE_CU). With the HIP backend they override the
+/// architecture and the CU count of the device, so a working GPU (of any target) is required.
+/// A HIPNOGPU build of the tool doesn't need a GPU at all, the target is given only by these
+/// options, so both are required there.
+/// The binaries are written to the user kernel cache in --cache-dir, the file can be installed
+/// as the system kernel cache (<arch>_<num_cu>.kdb) afterwards.
+///
+/// Usage: MIOpenPrebuildKernels [--arch <gfx>] [--num-cu <n>] [--jobs <n>] [--cache-dir <dir>]
+///                              <list>...
+
+#include <miopen/any_solver.hpp>
+#include <miopen/binary_cache.hpp>
+#include <miopen/config.h>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Layer = std::map<std::string, std::string>;
+
+/// Long names of the MIOpenDriver options used to describe the problem
+const std::map<char, std::string>& ShortOptions()
+{
+    static const auto options = std::map<char, std::string>{
+        {'_', "spatial_dim"},   {'n', "batchsize"},     {'c', "in_channels"},
+        {'!', "in_d"},          {'H', "in_h"},          {'W', "in_w"},
+        {'k', "out_channels"},  {'@', "fil_d"},         {'y', "fil_h"},
+        {'x', "fil_w"},         {'#', "conv_stride_d"}, {'u', "conv_stride_h"},
+        {'v', "conv_stride_w"}, {'$', "pad_d"},         {'p', "pad_h"},
+        {'q', "pad_w"},         {'^', "dilation_d"},    {'l', "dilation_h"},
+        {'j', "dilation_w"},    {'g', "group_count"},   {'F', "forw"},
+        {'m', "mode"},          {'z', "pad_mode"},      {'I', "in_layout"},
+        {'O', "out_layout"},    {'f', "fil_layout"},
+    };
+    return options;
+}
+
+/// Returns false if there is no convolution command in the line
+bool ParseLayer(const std::string& line, Layer& layer)
+{
+    auto stream = std::istringstream{line};
+    auto token  = std::string{};
+
+    while(stream >> token)
+    {
+        if(token == "conv" || token == "convfp16" || token == "convbfp16")
+            break;
+    }
+    if(!stream)
+        return false;
+    layer["command"] = token;
+
+    while(stream >> token)
+    {
+        auto name = std::string{};
+        if(token.size() > 2 && token.compare(0, 2, "--") == 0)
+        {
+            name = token.substr(2);
+        }
+        else if(token.size() == 2 && token[0] == '-')
+        {
+            const auto option = ShortOptions().find(token[1]);
+            if(option != ShortOptions().end())
+                name = option->second;
+        }
+
+        auto value = std::string{};
+        stream >> value;
+        if(!name.empty())
+            layer[name] = value;
+    }
+    return true;
+}
+
+bool ParseInt(const std::string& str, int& value)
+{
+    auto stream = std::istringstream{str};
+    return (stream >> value) && stream.eof();
+}
+
+int Get(const Layer& layer, const std::string& name, int fallback)
+{
+    const auto it = layer.find(name);
+    if(it == layer.end())
+        return fallback;
+    auto value = 0;
+    if(!ParseInt(it->second, value))
+        MIOPEN_THROW("Invalid value of " + name + ": " + it->second);
+    return value;
+}
+
+std::string Get(const Layer& layer, const std::string& name, const std::string& fallback)
+{
+    const auto it = layer.find(name);
+    return it == layer.end() || it->second.empty() ? fallback : it->second;
+}
+
+miopenTensorLayout_t GetLayout(const std::string& layout)
+{
+    if(layout == "NHWC")
+        return miopenTensorNHWC;
+    if(layout == "NDHWC")
+        return miopenTensorNDHWC;
+    if(layout == "NCDHW")
+        return miopenTensorNCDHW;
+    return miopenTensorNCHW;
+}
+
+/// Throws if the layer is not supported
+std::vector<miopen::conv::ProblemDescription> MakeProblems(const Layer& layer)
+{
+    if(Get(layer, "mode", "conv") != "conv" || Get(layer, "pad_mode", "default") != "default")
+        MIOPEN_THROW("only the default convolutions are supported");
+
+    const auto& command = layer.at("command");
+    const auto type     = command == "convfp16"    ? miopenHalf
+                          : command == "convbfp16" ? miopenBFloat16
+                                                   : miopenFloat;
+
+    const auto is_3d   = Get(layer, "spatial_dim", 2) == 3;
+    const auto groups  = Get(layer, "group_count", 1);
+    const auto spatial = [&](const std::string& name, int fallback) {
+        auto values = std::vector<int>{};
+        if(is_3d)
+            values.push_back(Get(layer, name + "_d", fallback));
+        values.push_back(Get(layer, name + "_h", fallback));
+        values.push_back(Get(layer, name + "_w", fallback));
+        return values;
+    };
+    const auto lengths = [&](int n, int c, const std::string& prefix) {
+        auto values = spatial(prefix, 1);
+        values.insert(values.begin(), {n, c});
+        return values;
+    };
+
+    const auto default_layout = is_3d ? "NCDHW" : "NCHW";
+    const auto x              = miopen::TensorDescriptor{
+        type,
+        GetLayout(Get(layer, "in_layout", default_layout)),
+        lengths(Get(layer, "batchsize", 100), Get(layer, "in_channels", 3), "in")};
+    const auto w = miopen::TensorDescriptor{
+        type,
+        GetLayout(Get(layer, "fil_layout", default_layout)),
+        lengths(Get(layer, "out_channels", 32), Get(layer, "in_channels", 3) / groups, "fil")};
+
+    const auto conv_desc = miopen::ConvolutionDescriptor{spatial("pad", 0),
+                                                         spatial("conv_stride", 1),
+                                                         spatial("dilation", 1),
+                                                         std::vector<int>(is_3d ? 3 : 2, 0),
+                                                         groups};
+    const auto y = conv_desc.GetForwardOutputTensorWithLayout(
+        x, w, Get(layer, "out_layout", default_layout), type);
+
+    // Same bits as the --forw option of MIOpenDriver, 0 is all the directions
+    const auto forw      = Get(layer, "forw", 0);
+    auto problems        = std::vector<miopen::conv::ProblemDescription>{};
+    const auto requested = [&](int bit) { return forw == 0 || (forw & bit) != 0; };
+    if(requested(1))
+        problems.emplace_back(x, w, y, conv_desc, miopen::conv::Direction::Forward);
+    if(requested(2))
+        problems.emplace_back(y, w, x, conv_desc, miopen::conv::Direction::BackwardData);
+    if(requested(4))
+        problems.emplace_back(y, w, x, conv_desc, miopen::conv::Direction::BackwardWeights);
+    return problems;
+}
+
+struct Kernels
+{
+    std::vector<miopen::solver::KernelInfo> list;
+    std::set<std::pair<std::string, std::string>> known;
+    std::size_t solutions = 0;
+    std::size_t failures  = 0;
+
+    /// Collects the kernels of all the applicable solutions
+    void Add(miopen::Handle& handle, const miopen::conv::ProblemDescription& problem)
+    {
+        auto ctx = miopen::ExecutionContext{&handle};
+        ctx.DetectRocm();
+        problem.SetupFloats(ctx);
+        ctx.do_search              = false;
+        ctx.disable_search_enforce = true;
+
+        const auto legacy_ctx     = miopen::ConvolutionContext{ctx};
+        const auto legacy_problem = miopen::ProblemDescription{problem};
+        auto db                   = miopen::GetDb(ctx);
+
+        const auto& ids =
+            miopen::solver::GetSolversByPrimitive(miopen::solver::Primitive::Convolution);
+        for(const auto& id : ids)
+        {
+            try
+            {
+                const auto solver = id.GetSolver();
+                if(!solver.IsApplicable(legacy_ctx, legacy_problem))
+                    continue;
+                const auto solution = solver.FindSolution(legacy_ctx, legacy_problem, db, {});
+                if(!solution.Succeeded())
+                    continue;
+                ++solutions;
+                for(const auto& kernel : solution.construction_params)
+                    if(known.emplace(kernel.kernel_file, kernel.comp_options).second)
+                        list.push_back(kernel);
+            }
+            catch(const std::exception& ex)
+            {
+                ++failures;
+                std::cerr << id.ToString() << ": " << ex.what() << std::endl;
+            }
+        }
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    auto lists = std::vector<std::string>{};
+    auto jobs  = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    auto usage = argc < 2;
+
+    for(auto i = 1; i < argc; ++i)
+    {
+        const auto arg          = std::string{argv[i]};
+        const auto has_value    = i + 1 < argc;
+        const auto set_env_from = [&](const char* name) { setenv(name, argv[++i], 1); };
+
+        if(arg == "--arch" && has_value)
+            set_env_from("MIOPEN_DEVICE_ARCH");
+        else if(arg == "--num-cu" && has_value)
+            set_env_from("MIOPEN_DEVICE_CU");
+        else if(arg == "--cache-dir" && has_value)
+            set_env_from("MIOPEN_CUSTOM_CACHE_DIR");
+        else if(arg == "--jobs" && has_value)
+        {
+            auto value = 0;
+            if(ParseInt(argv[++i], value) && value > 0)
+                jobs = value;
+            else
+                usage = true;
+        }
+        else if(arg.compare(0, 2, "--") != 0)
+            lists.push_back(arg);
+        else
+            usage = true;
+    }
+
+#if MIOPEN_MODE_NOGPU
+    // There is no device to take the rest of the target description from
+    const auto is_set = [](const char* name) {
+        const char* const value = std::getenv(name);
+        return value != nullptr && *value != '\0';
+    };
+    if(!is_set("MIOPEN_DEVICE_ARCH") || !is_set("MIOPEN_DEVICE_CU"))
+        usage = true;
+#endif
+
+    if(usage || lists.empty())
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--arch <gfx>] [--num-cu <n>] [--jobs <n>] [--cache-dir <dir>] <list>..."
+                  << std::endl;
+#if MIOPEN_MODE_NOGPU
+        std::cerr << "--arch and --num-cu are required by the HIPNOGPU build" << std::endl;
+#endif
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        if(miopen::IsCacheDisabled())
+        {
+            std::cerr << "The kernel cache is disabled" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        auto handle  = miopen::Handle{};
+        auto kernels = Kernels{};
+        auto lines   = std::size_t{0};
+        auto skipped = std::size_t{0};
+
+        for(const auto& list : lists)
+        {
+            auto file = std::ifstream{list};
+            if(!file)
+            {
+                std::cerr << "Can't open " << list << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            auto line = std::string{};
+            while(std::getline(file, line))
+            {
+                auto layer = Layer{};
+                if(!ParseLayer(line, layer))
+                    continue;
+                ++lines;
+                try
+                {
+                    for(const auto& problem : MakeProblems(layer))
+                        kernels.Add(handle, problem);
+                }
+                catch(const std::exception& ex)
+                {
+                    ++skipped;
+                    std::cerr << "Skipped: " << line << ": " << ex.what() << std::endl;
+                }
+            }
+        }
+
+        // Kernels already in the cache are not rebuilt, which makes the reruns cheap
+        auto missing = std::vector<miopen::solver::KernelInfo>{};
+        std::copy_if(kernels.list.begin(),
+                     kernels.list.end(),
+                     std::back_inserter(missing),
+                     [&](const miopen::solver::KernelInfo& kernel) {
+                         return !handle.IsProgramReady(kernel.kernel_file, kernel.comp_options);
+                     });
+
+        std::cout << "Problems: " << lines - skipped << " (" << skipped
+                  << " skipped), solutions: " << kernels.solutions
+                  << ", unique kernels: " << kernels.list.size()
+                  << ", cached: " << kernels.list.size() - missing.size()
+                  << ", to build: " << missing.size() << std::endl;
+
+        // Written in chunks, so an interrupted run keeps most of its work
+        constexpr std::size_t chunk = 256;
+        auto built                  = std::atomic<std::size_t>{0};
+        auto failed                 = std::atomic<std::size_t>{0};
+        const auto start            = std::chrono::steady_clock::now();
+
+        for(std::size_t first = 0; first < missing.size(); first += chunk)
+        {
+            const auto count = std::min(chunk, missing.size() - first);
+            const miopen::KernelCacheBatch batch{handle.GetTargetProperties(),
+                                                 handle.GetMaxComputeUnits()};
+            miopen::par_for_strided(count, miopen::max_threads{jobs}, [&](auto i) {
+                const auto& kernel = missing[first + i];
+                try
+                {
+                    handle.LoadProgram(kernel.kernel_file, kernel.comp_options, false, "");
+                    ++built;
+                }
+                catch(const std::exception& ex)
+                {
+                    ++failed;
+                    std::cerr << kernel.kernel_file << " " << kernel.comp_options << ": "
+                              << ex.what() << std::endl;
+                }
+            });
+            std::cout << "Built " << built << "/" << missing.size() << std::endl;
+        }
+
+        const auto time = std::chrono::steady_clock::now() - start;
+        std::cout << "Built: " << built << ", failed: " << failed << ", solver errors: "
+                  << kernels.failures << ", time: "
+                  << std::chrono::duration_cast<std::chrono::seconds>(time).count() << " s"
+                  << std::endl;
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        std::cout << "Kernel cache: "
+                  << (miopen::GetCachePath(false) / (handle.GetDbBasename() + ".ukdb")).string()
+                  << std::endl;
+#else
+        std::cout << "Kernel cache: " << miopen::GetCachePath(false).string() << std::endl;
+#endif
+        return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}